@@ -28,50 +28,226 @@ namespace kiwi
     //                                  CONSOLE HISTORY                                 //
     // ================================================================================ //
     
-    ConsoleHistory::ConsoleHistory(engine::Instance& instance) :
+    ConsoleHistory::ConsoleHistory(engine::Instance& instance, size_t capacity) :
     m_instance(instance),
-    m_sort(ConsoleHistory::ByIndex)
+    m_sort(ConsoleHistory::ByIndex),
+    m_capacity(std::max(capacity, size_t(1))),
+    m_suppressed(0)
     {
         m_instance.addConsoleListener(*this);
+        startTimerHz(30);
     }
     
     ConsoleHistory::~ConsoleHistory()
     {
+        stopTimer();
         m_instance.removeConsoleListener(*this);
         m_messages.clear();
     }
     
-    void ConsoleHistory::newConsoleMessage(engine::Console::Message const& message)
+    void ConsoleHistory::setCapacity(size_t capacity)
     {
-        if(!message.text.empty())
         {
-            bool changed = false;
+            std::lock_guard<std::mutex> guard(m_message_mutex);
+            m_capacity = std::max(capacity, size_t(1));
+            removeOldestMessages();
+        }
+        
+        m_listeners.call(&Listener::consoleHistoryChanged, *this);
+    }
+    
+    size_t ConsoleHistory::getCapacity() const
+    {
+        return m_capacity;
+    }
+    
+    uint64_t ConsoleHistory::getNumberOfSuppressedMessages() const
+    {
+        return m_suppressed;
+    }
+    
+    void ConsoleHistory::timerCallback()
+    {
+        m_instance.processConsole(m_batch_size);
+        
+        const uint64_t suppressed = m_instance.getNumberOfSuppressedConsoleMessages();
+        
+        if(suppressed != m_suppressed)
+        {
             {
                 std::lock_guard<std::mutex> guard(m_message_mutex);
-                
-                if(!m_messages.empty())
+                addSuppressedMessages(suppressed);
+                removeOldestMessages();
+            }
+            
+            m_listeners.call(&Listener::consoleHistoryChanged, *this);
+        }
+    }
+    
+    void ConsoleHistory::newConsoleMessages(std::vector<engine::Console::Message> const& messages)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_message_mutex);
+            
+            for(auto const& message : messages)
+            {
+                addMessage(message);
+            }
+            
+            removeOldestMessages();
+        }
+        
+        m_listeners.call(&Listener::consoleHistoryChanged, *this);
+    }
+    
+    void ConsoleHistory::addMessage(engine::Console::Message const& message)
+    {
+        if(message.text.empty())
+        {
+            return;
+        }
+        
+        if(MessageHolder* last = getLastMessage())
+        {
+            auto& last_message = last->m_message;
+            if(!last->m_suppressed
+               && last_message.text == message.text
+               && last_message.type == message.type)
+            {
+                last->m_repeat_times++;
+                return;
+            }
+        }
+        
+        appendMessage({message, 0, false});
+    }
+    
+    void ConsoleHistory::addSuppressedMessages(uint64_t suppressed)
+    {
+        m_suppressed = suppressed;
+        
+        engine::Console::Message message {"console: " + std::to_string(suppressed) + " messages suppressed",
+            engine::Console::Message::Type::Warning};
+        
+        // the count is updated while no other message has been received.
+        MessageHolder* last = getLastMessage();
+        
+        if(last != nullptr && last->m_suppressed)
+        {
+            last->m_message = std::move(message);
+            return;
+        }
+        
+        appendMessage({std::move(message), 0, true});
+    }
+    
+    void ConsoleHistory::removeOldestMessages()
+    {
+        while(m_present.count() > m_capacity)
+        {
+            removeMessage(m_present.select(0));
+        }
+        
+        compact();
+    }
+    
+    ConsoleHistory::MessageHolder* ConsoleHistory::getLastMessage()
+    {
+        if(!m_messages.empty() && m_present.contains(m_messages.size() - 1))
+        {
+            return &m_messages.back();
+        }
+        
+        return nullptr;
+    }
+    
+    void ConsoleHistory::appendMessage(MessageHolder&& holder)
+    {
+        const size_t id = m_messages.size();
+        
+        m_messages.emplace_back(std::move(holder));
+        m_present.push_back();
+        
+        for(auto& view : m_views)
+        {
+            if(view.m_built)
+            {
+                view.m_positions.push_back(view.m_ids.size());
+                view.m_ids.push_back(id);
+                view.m_present.push_back();
+            }
+        }
+    }
+    
+    void ConsoleHistory::removeMessage(size_t id)
+    {
+        if(m_present.erase(id))
+        {
+            for(auto& view : m_views)
+            {
+                if(view.m_built)
                 {
-                    auto& last = m_messages.back();
-                    auto& last_message = last.m_message;
-                    if(last_message.text == message.text
-                       && last_message.type == message.type)
-                    {
-                        last.m_repeat_times++;
-                        changed = true;
-                    }
+                    view.m_present.erase(view.m_positions[id]);
                 }
+            }
+        }
+    }
+    
+    void ConsoleHistory::compact()
+    {
+        if(m_messages.size() < 1024 || m_present.count() * 2 > m_messages.size())
+        {
+            return;
+        }
+        
+        const size_t removed = m_messages.size();
+        std::vector<size_t> ids(m_messages.size(), removed);
+        std::vector<MessageHolder> messages;
+        messages.reserve(m_present.count());
+        
+        for(size_t id = 0; id < m_messages.size(); ++id)
+        {
+            if(m_present.contains(id))
+            {
+                ids[id] = messages.size();
+                messages.emplace_back(std::move(m_messages[id]));
+            }
+        }
+        
+        m_messages.swap(messages);
+        m_present = tool::OrderStatistics(m_messages.size());
+        
+        for(auto& view : m_views)
+        {
+            if(!view.m_built)
+            {
+                continue;
+            }
+            
+            size_t position = 0;
+            size_t sorted = 0;
+            
+            for(size_t i = 0; i < view.m_ids.size(); ++i)
+            {
+                const size_t id = ids[view.m_ids[i]];
                 
-                if(!changed)
+                if(id != removed)
                 {
-                    m_messages.push_back({message, m_messages.size() + 1});
-                    changed = true;
+                    sorted += (i < view.m_sorted) ? 1 : 0;
+                    view.m_ids[position++] = id;
                 }
             }
             
-            if(changed)
+            view.m_ids.resize(position);
+            view.m_sorted = sorted;
+            view.m_positions.assign(m_messages.size(), 0);
+            
+            for(size_t i = 0; i < view.m_ids.size(); ++i)
             {
-                m_listeners.call(&Listener::consoleHistoryChanged, *this);
+                view.m_positions[view.m_ids[i]] = i;
             }
+            
+            view.m_present = tool::OrderStatistics(view.m_ids.size());
         }
     }
     
@@ -80,6 +256,15 @@ namespace kiwi
         {
             std::lock_guard<std::mutex> guard(m_message_mutex);
             m_messages.clear();
+            m_present.clear();
+            
+            for(auto& view : m_views)
+            {
+                view.m_ids.clear();
+                view.m_positions.clear();
+                view.m_present.clear();
+                view.m_sorted = 0;
+            }
         }
         
         m_listeners.call(&Listener::consoleHistoryChanged, *this);
@@ -87,15 +272,26 @@ namespace kiwi
     
     size_t ConsoleHistory::size()
     {
-        return m_messages.size();
+        std::lock_guard<std::mutex> guard(m_message_mutex);
+        return m_present.count();
+    }
+    
+    size_t ConsoleHistory::getId(size_t row)
+    {
+        if(View* view = getView(m_sort))
+        {
+            return view->m_ids[view->m_present.select(row)];
+        }
+        
+        return m_present.select(row);
     }
     
     std::pair<engine::Console::Message const*, size_t> ConsoleHistory::get(size_t index)
     {
         std::lock_guard<std::mutex> guard(m_message_mutex);
-        if(index < m_messages.size())
+        if(index < m_present.count())
         {
-            auto const& msg = m_messages[index];
+            auto const& msg = m_messages[getId(index)];
             return {&msg.m_message, msg.m_repeat_times};
         }
         
@@ -104,109 +300,181 @@ namespace kiwi
     
     void ConsoleHistory::erase(size_t index)
     {
-        if(index < m_messages.size())
         {
+            std::lock_guard<std::mutex> guard(m_message_mutex);
+            
+            if(index >= m_present.count())
             {
-                std::lock_guard<std::mutex> guard(m_message_mutex);
-                m_messages.erase(m_messages.begin() + index);
-                std::sort(m_messages.begin(), m_messages.end(), compareIndex);
-                
-                for(size_t i = 0; i < m_messages.size(); i++)
-                {
-                    m_messages[i-1].m_index = i;
-                }
-                
-                this->sort(m_sort);
+                return;
             }
             
-            m_listeners.call(&Listener::consoleHistoryChanged, *this);
+            removeMessage(getId(index));
+            compact();
         }
+        
+        m_listeners.call(&Listener::consoleHistoryChanged, *this);
     }
     
     void ConsoleHistory::erase(size_t begin, size_t last)
     {
-        if(begin < last && last < m_messages.size())
         {
+            std::lock_guard<std::mutex> guard(m_message_mutex);
+            
+            if(!(begin < last && last < m_present.count()))
             {
-                std::lock_guard<std::mutex> guard(m_message_mutex);
-                m_messages.erase(m_messages.begin() + begin, m_messages.begin() + last);
-                std::sort(m_messages.begin(), m_messages.end(), compareIndex);
-                for(size_t i = 0; i < m_messages.size(); i++)
-                {
-                    m_messages[i].m_index = i+1;
-                }
-                
-                sort(m_sort);
+                return;
             }
             
-            m_listeners.call(&Listener::consoleHistoryChanged, *this);
+            // the ids are collected first since the rows move as the messages are removed.
+            std::vector<size_t> ids;
+            ids.reserve(last - begin);
+            
+            for(size_t row = begin; row < last; ++row)
+            {
+                ids.push_back(getId(row));
+            }
+            
+            for(size_t id : ids)
+            {
+                removeMessage(id);
+            }
+            
+            compact();
         }
+        
+        m_listeners.call(&Listener::consoleHistoryChanged, *this);
     }
     
     void ConsoleHistory::erase(std::vector<size_t>& indices)
     {
-        size_t max = m_messages.size();
-        std::sort(indices.begin(), indices.end());
-        std::reverse(indices.begin(), indices.end());
-        
-        for(size_t i = 0; i < indices.size(); i++)
         {
-            if(indices[i] < max)
+            std::lock_guard<std::mutex> guard(m_message_mutex);
+            
+            std::vector<size_t> ids;
+            ids.reserve(indices.size());
+            
+            for(size_t row : indices)
             {
-                std::lock_guard<std::mutex> guard(m_message_mutex);
-                m_messages.erase(m_messages.begin() + indices[i]);
-                --max;
+                if(row < m_present.count())
+                {
+                    ids.push_back(getId(row));
+                }
             }
-        }
-        
-        {
-            std::lock_guard<std::mutex> guard(m_message_mutex);
-            std::sort(m_messages.begin(), m_messages.end(), compareIndex);
-            for(size_t i = 0; i < m_messages.size(); i++)
+            
+            for(size_t id : ids)
             {
-                m_messages[i].m_index = i+1;
+                removeMessage(id);
             }
-            sort(m_sort);
+            
+            compact();
         }
         
         m_listeners.call(&Listener::consoleHistoryChanged, *this);
     }
     
-    bool ConsoleHistory::compareIndex(MessageHolder const& i, MessageHolder const& j)
+    bool ConsoleHistory::compare(Sort type, size_t first, size_t second) const
     {
-        return i.m_index < j.m_index;
+        auto const& i = m_messages[first].m_message;
+        auto const& j = m_messages[second].m_message;
+        
+        // the messages with the same key stay in the order of reception.
+        if(type == ByType && i.type != j.type)
+        {
+            return i.type < j.type;
+        }
+        
+        if(type == ByText)
+        {
+            const int result = i.text.compare(j.text);
+            
+            if(result != 0)
+            {
+                return result < 0;
+            }
+        }
+        
+        return first < second;
     }
     
-    bool ConsoleHistory::compareText(MessageHolder const& i, MessageHolder const& j)
+    ConsoleHistory::View* ConsoleHistory::getView(Sort type)
     {
-        std::string first = i.m_message.text;
-        std::string second = j.m_message.text;
-        
-        return first.compare(second);
+        switch(type)
+        {
+            case ByType: return &m_views[0];
+            case ByText: return &m_views[1];
+            default: return nullptr;
+        }
     }
     
-    bool ConsoleHistory::compareType(MessageHolder const& i, MessageHolder const& j)
+    void ConsoleHistory::sortView(Sort type)
     {
-        engine::Console::Message::Type first = i.m_message.type;
-        engine::Console::Message::Type second = j.m_message.type;
+        View* view = getView(type);
         
-        return first < second;
+        if(view == nullptr)
+        {
+            return;
+        }
+        
+        auto& ids = view->m_ids;
+        
+        if(!view->m_built)
+        {
+            ids.clear();
+            view->m_sorted = 0;
+            
+            for(size_t id = 0; id < m_messages.size(); ++id)
+            {
+                if(m_present.contains(id))
+                {
+                    ids.push_back(id);
+                }
+            }
+        }
+        else
+        {
+            // the removed messages are dropped, the ids received since the last sort are merged.
+            size_t position = 0;
+            size_t sorted = 0;
+            
+            for(size_t i = 0; i < ids.size(); ++i)
+            {
+                if(m_present.contains(ids[i]))
+                {
+                    sorted += (i < view->m_sorted) ? 1 : 0;
+                    ids[position++] = ids[i];
+                }
+            }
+            
+            ids.resize(position);
+            view->m_sorted = sorted;
+        }
+        
+        auto less = [this, type](size_t first, size_t second)
+        {
+            return compare(type, first, second);
+        };
+        
+        std::sort(ids.begin() + view->m_sorted, ids.end(), less);
+        std::inplace_merge(ids.begin(), ids.begin() + view->m_sorted, ids.end(), less);
+        
+        view->m_positions.assign(m_messages.size(), 0);
+        
+        for(size_t i = 0; i < ids.size(); ++i)
+        {
+            view->m_positions[ids[i]] = i;
+        }
+        
+        view->m_present = tool::OrderStatistics(ids.size());
+        view->m_sorted = ids.size();
+        view->m_built = true;
     }
     
     void ConsoleHistory::sort(Sort type)
     {
+        std::lock_guard<std::mutex> guard(m_message_mutex);
+        
         m_sort = type;
-        switch(m_sort)
-        {
-            case ByIndex:
-            { std::sort(m_messages.begin(), m_messages.end(), compareIndex); break; }
-                
-            case ByType:
-            { std::sort(m_messages.begin(), m_messages.end(), compareType); break; }
-                
-            case ByText:
-            { std::sort(m_messages.begin(), m_messages.end(), compareText); break; }
-        }
+        sortView(type);
     }
     
     void ConsoleHistory::addListener(ConsoleHistory::Listener& listener)
@@ -21,8 +21,12 @@
 
 #pragma once
 
+#include <juce_events/juce_events.h>
+
 #include <KiwiEngine/KiwiEngine_Instance.h>
 
+#include <KiwiTool/KiwiTool_OrderStatistics.h>
+
 namespace kiwi
 {
     // ================================================================================ //
@@ -31,7 +35,11 @@ namespace kiwi
     
     //! @brief The Console History listen to the Console and keep an history of the messages.
     //! @details It expose methods to fetch messages sorted by date, message or by type.
-    class ConsoleHistory : public engine::Console::Listener
+    //! The messages of the Console are fetched by batches at the rate of the user interface,
+    //! the oldest messages are removed once the capacity of the history is reached.
+    //! The messages keep their place once received, the removed ones are only marked so that
+    //! the rows of the history are found and removed in logarithmic time.
+    class ConsoleHistory : public engine::Console::Listener, private juce::Timer
     {
     public:
         class Listener;
@@ -47,11 +55,22 @@ namespace kiwi
     public:
         
         //! @brief Constructor.
-        ConsoleHistory(engine::Instance& instance);
+        //! @param capacity The maximum number of messages of the history.
+        ConsoleHistory(engine::Instance& instance, size_t capacity = 10000);
         
         //! @brief Destructor.
         ~ConsoleHistory();
         
+        //! @brief Sets the maximum number of messages of the history.
+        //! @details The oldest messages are removed if the history exceeds the capacity.
+        void setCapacity(size_t capacity);
+        
+        //! @brief Returns the maximum number of messages of the history.
+        size_t getCapacity() const;
+        
+        //! @brief Returns the number of messages suppressed by the Console.
+        uint64_t getNumberOfSuppressedMessages() const;
+        
         //! @brief Clear the messages.
         void clear();
         
@@ -75,6 +94,8 @@ namespace kiwi
         void erase(std::vector<size_t>& indices);
         
         //! @brief Sort the messages by index, type or text.
+        //! @details The sorted views are kept, the messages received since the last sort
+        //! are merged into the view.
         //! @param sort The type of sorting method.
         //! @see History::Sort
         void sort(Sort type = ByIndex);
@@ -90,23 +111,74 @@ namespace kiwi
         struct MessageHolder
         {
             engine::Console::Message    m_message;
-            size_t                      m_index;
             size_t                      m_repeat_times;
+            bool                        m_suppressed;   // counts the suppressed messages
         };
         
-        static bool compareIndex(MessageHolder const& i, MessageHolder const& j);
-        static bool compareText(MessageHolder const& i, MessageHolder const& j);
-        static bool compareType(MessageHolder const& i, MessageHolder const& j);
+        //! @brief The ids of the messages sorted by type or by text.
+        //! @details A view is built the first time its sort is selected, then the messages
+        //! received are appended to the view unsorted until it is sorted again.
+        struct View
+        {
+            std::vector<size_t>         m_ids;          // the ids in the order of the view
+            std::vector<size_t>         m_positions;    // the position of an id in the view
+            tool::OrderStatistics       m_present;
+            size_t                      m_sorted = 0;   // the number of ids sorted
+            bool                        m_built = false;
+        };
+        
+        //! @internal Returns true if the message with the first id comes before the second.
+        bool compare(Sort type, size_t first, size_t second) const;
+        
+        //! @internal Returns the view of a sort, null if the sort is by index.
+        View* getView(Sort type);
+        
+        //! @internal Returns the id of the message at a row of the current sort.
+        size_t getId(size_t row);
+        
+        //! @internal Sorts the ids of a view and removes the ids of the messages removed.
+        void sortView(Sort type);
+        
+        //! @internal Appends a message at the end of the history and the views.
+        void appendMessage(MessageHolder&& holder);
+        
+        //! @internal Marks a message as removed in the history and the views.
+        void removeMessage(size_t id);
+        
+        //! @internal Frees the removed messages once they are the majority.
+        //! @details The ids change, the order of the views is kept.
+        void compact();
+        
+        //! @internal Returns the last message received, null if it has been removed.
+        MessageHolder* getLastMessage();
         
         //! @internal Receive the messages from the Console and dispatch changes to listeners.
-        void newConsoleMessage(engine::Console::Message const& message) final override;
+        void newConsoleMessages(std::vector<engine::Console::Message> const& messages) final override;
+        
+        //! @internal Fetches a batch of messages from the Console.
+        void timerCallback() final override;
+        
+        //! @internal Appends a message or increments the repeat times of the last one.
+        void addMessage(engine::Console::Message const& message);
+        
+        //! @internal Appends or updates the message that counts the suppressed messages.
+        void addSuppressedMessages(uint64_t suppressed);
+        
+        //! @internal Removes the oldest messages that exceed the capacity.
+        void removeOldestMessages();
         
     private:
         
+        static constexpr size_t     m_batch_size = 1024;
+        
         engine::Instance&           m_instance;
         std::mutex                  m_message_mutex;
-        std::vector<MessageHolder>  m_messages;
+        std::vector<MessageHolder>  m_messages;     // by id, in the order of reception
+        tool::OrderStatistics       m_present;
+        View                        m_views[2];     // by type and by text
         Sort                        m_sort;
+        size_t                      m_capacity;
+        uint64_t                    m_suppressed;
         tool::Listeners<Listener>   m_listeners;
     };
     
@@ -37,9 +37,17 @@ namespace kiwi
     m_input_matrix(nullptr),
     m_output_matrix(nullptr),
     m_chains(),
+    m_thread_pool(nullptr),
     m_is_playing(false),
     m_mutex()
     {
+        const size_t number_of_cores = std::thread::hardware_concurrency();
+        
+        if (number_of_cores > 1)
+        {
+            m_thread_pool.reset(new dsp::ThreadPool(number_of_cores - 1));
+        }
+        
         juce::ScopedPointer<juce::XmlElement> previous_settings(getGlobalProperties().getXmlValue("Audio Settings"));
         
         if (previous_settings)
@@ -64,6 +72,9 @@ namespace kiwi
     {
         if(std::find(m_chains.begin(), m_chains.end(), &chain) == m_chains.cend())
         {
+            // chains are only performed in parallel by the workers of the thread pool.
+            chain.setParallel(m_thread_pool != nullptr);
+            
             if (m_is_playing)
             {
                 juce::AudioIODevice * const device = getCurrentAudioDevice();
@@ -73,6 +84,12 @@ namespace kiwi
             {
                 juce::GenericScopedLock<juce::CriticalSection> lock(getAudioCallbackLock());
                 m_chains.push_back(&chain);
+                
+                // the pool must not allocate its schedules on the audio thread.
+                if (m_thread_pool)
+                {
+                    m_thread_pool->reserve(m_chains.size());
+                }
             }
         }
     }
@@ -125,14 +142,25 @@ namespace kiwi
         {
             input_signal.copy((*m_input_matrix)[channel]);
         }
+        else
+        {
+            input_signal.fill(0.);
+        }
     }
     
     
     void DspDeviceManager::tick() const noexcept
     {
-        for(dsp::Chain* chain : m_chains)
+        if (m_thread_pool)
+        {
+            m_thread_pool->tick(m_chains);
+        }
+        else
         {
-            chain->tick();
+            for(dsp::Chain* chain : m_chains)
+            {
+                chain->tick();
+            }
         }
     }
     
@@ -23,6 +23,7 @@
 
 #include <KiwiDsp/KiwiDsp_Signal.h>
 #include <KiwiDsp/KiwiDsp_Chain.h>
+#include <KiwiDsp/KiwiDsp_ThreadPool.h>
 #include <KiwiEngine/KiwiEngine_AudioControler.h>
 
 #include <juce_audio_devices/juce_audio_devices.h>
@@ -100,7 +101,8 @@ namespace kiwi
         // ================================================================================ //
         
         //! @brief Ticks all the chains.
-        //! @details Called at each dsp cycle.
+        //! @details Called at each dsp cycle. If the machine has several cores the chains
+        //! are performed concurrently by a thread pool.
         void tick() const noexcept;
         
     private: // members
@@ -108,6 +110,7 @@ namespace kiwi
         std::unique_ptr<dsp::Buffer>                m_input_matrix;
         std::unique_ptr<dsp::Buffer>                m_output_matrix;
         std::vector<dsp::Chain*>                    m_chains;
+        std::unique_ptr<dsp::ThreadPool>            m_thread_pool;
         bool                                        m_is_playing;
         mutable std::mutex                          m_mutex;
     };
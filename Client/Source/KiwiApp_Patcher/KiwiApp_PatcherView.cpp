@@ -48,6 +48,7 @@ namespace kiwi
     , m_instance(instance)
     , m_patcher_model(patcher)
     , m_view_model(view)
+    , m_selection(instance.getUserId(), view)
     , m_viewport(nullptr)
     , m_hittester(*this)
     , m_mouse_handler(*this)
@@ -81,8 +82,12 @@ namespace kiwi
         
         m_local_objects_selection.clear();
         m_local_links_selection.clear();
-        m_distant_objects_selection.clear();
-        m_distant_links_selection.clear();
+        
+        m_links_grid.clear();
+        m_objects_grid.clear();
+        
+        m_link_views.clear();
+        m_object_frames.clear();
         
         m_links.clear();
         m_objects.clear();
@@ -558,14 +563,7 @@ namespace kiwi
     
     std::set<uint64_t> PatcherView::getDistantSelection(ObjectFrame const& object) const
     {
-        std::set<uint64_t> distant_selection;
-        
-        if (m_distant_objects_selection.find(object.getModel().ref()) != m_distant_objects_selection.end())
-        {
-            distant_selection = m_distant_objects_selection.at(object.getModel().ref());
-        }
-        
-        return distant_selection;
+        return m_selection.getUsers(object.getModel());
     }
     
     bool PatcherView::isSelected(LinkView const& link) const
@@ -1064,8 +1062,7 @@ namespace kiwi
         if(&m_manager == &manager)
         {
             auto& patcher = manager.getPatcher();
-            checkObjectsSelectionChanges(patcher);
-            checkLinksSelectionChanges(patcher);
+            checkSelectionChanges(patcher);
         }
     }
     
@@ -1141,8 +1138,7 @@ namespace kiwi
         if(!view.removed() && &view == &m_view_model)
         {
             checkViewInfos(view);
-            checkObjectsSelectionChanges(patcher);
-            checkLinksSelectionChanges(patcher);
+            checkSelectionChanges(patcher);
         }
         
         // delete LinkView for each removed links
@@ -1231,234 +1227,68 @@ namespace kiwi
         }
     }
     
-    void PatcherView::checkObjectsSelectionChanges(model::Patcher& patcher)
+    void PatcherView::checkSelectionChanges(model::Patcher& patcher)
     {
-        const auto connected_users = m_manager.getConnectedUsers();
+        m_selection.update(patcher, m_manager.getConnectedUsers());
         
-        std::set<flip::Ref>                     new_local_objects_selection;
-        std::map<flip::Ref, std::set<uint64_t>> new_distant_objects_selection;
+        auto const& changed_objects = m_selection.getChangedObjects();
+        auto const& changed_links = m_selection.getChangedLinks();
         
-        for(auto& object_m : patcher.getObjects())
+        if(changed_objects.empty() && changed_links.empty())
         {
-            if(!object_m.removed())
-            {
-                std::set<uint64_t> selected_for_users;
-                
-                for(auto& user : patcher.getUsers())
-                {
-                    bool selected_for_local_view = false;
-                    bool selected_for_other_view = false;
-                    
-                    const uint64_t user_id = user.getId();
-                    const bool is_distant_user = user_id != m_instance.getUserId();
-                    const bool is_connected = (connected_users.find(user_id) != connected_users.end());
-                    
-                    if(is_distant_user && !is_connected)
-                    {
-                        continue;
-                    }
-                    
-                    for(auto& view : user.getViews())
-                    {
-                        const bool is_local_view = (&m_view_model == &view);
-                        const bool is_selected = view.isSelected(object_m);
-                        
-                        if(is_selected)
-                        {
-                            if(is_distant_user)
-                            {
-                                selected_for_other_view = true;
-                                
-                                // an object is considered selected for a given user
-                                // when it's selected in at least one of its patcher's views.
-                                break;
-                            }
-                            else if(is_local_view)
-                            {
-                                selected_for_local_view = true;
-                            }
-                            else
-                            {
-                                selected_for_other_view = true;
-                            }
-                        }
-                    }
-                    
-                    if(selected_for_local_view)
-                    {
-                        new_local_objects_selection.emplace(object_m.ref());
-                    }
-                    
-                    if(selected_for_other_view)
-                    {
-                        selected_for_users.emplace(user_id);
-                    }
-                }
-                
-                new_distant_objects_selection.insert({object_m.ref(), selected_for_users});
-            }
+            return;
         }
         
-        std::set<ObjectFrame*> updated_objects;
+        // update the local selection
         
-        // check diff between old and new distant selection
-        // and notify objects if their selection state changed
-        for(auto& local_object_uptr : m_objects)
+        for(auto const* object_m : changed_objects)
         {
-            model::Object const& local_object_m = local_object_uptr->getModel();
-            
-            // local diff
-            const bool old_local_selected_state = m_local_objects_selection.find(local_object_m.ref()) != m_local_objects_selection.end();
-            
-            bool new_local_selected_state = new_local_objects_selection.find(local_object_m.ref()) != new_local_objects_selection.end();
-            
-            if(old_local_selected_state != new_local_selected_state)
+            if(m_selection.isSelectedLocally(*object_m))
             {
-                updated_objects.insert(local_object_uptr.get());
-                selectionChanged();
+                m_local_objects_selection.emplace(object_m->ref());
             }
-            
-            // distant diff
-            bool distant_selection_changed_for_object = false;
-            for(auto distant_it : new_distant_objects_selection)
+            else
             {
-                flip::Ref const& distant_object_lookup_ref = distant_it.first;
-                
-                if(distant_object_lookup_ref == local_object_uptr->getModel().ref())
-                {
-                    distant_selection_changed_for_object =
-                    m_distant_objects_selection[distant_object_lookup_ref] != distant_it.second;
-                    
-                    // notify object
-                    if(distant_selection_changed_for_object)
-                    {
-                        updated_objects.insert(local_object_uptr.get());
-                        selectionChanged();
-                    }
-                }
+                m_local_objects_selection.erase(object_m->ref());
             }
         }
         
-        // cache new selection state
-        std::swap(m_distant_objects_selection, new_distant_objects_selection);
-        std::swap(m_local_objects_selection, new_local_objects_selection);
-        
-        // call objects reaction.
-        
-        for(auto object_frame : updated_objects)
+        for(auto const* link_m : changed_links)
         {
-            object_frame->selectionChanged();
+            if(m_selection.isSelectedLocally(*link_m))
+            {
+                m_local_links_selection.emplace(link_m->ref());
+            }
+            else
+            {
+                m_local_links_selection.erase(link_m->ref());
+            }
         }
-    }
-    
-    void PatcherView::checkLinksSelectionChanges(model::Patcher& patcher)
-    {
-        const auto connected_users = m_manager.getConnectedUsers();
         
-        std::set<flip::Ref>                     new_local_links_selection;
-        std::map<flip::Ref, std::set<uint64_t>> new_distant_links_selection;
+        selectionChanged();
         
-        for(auto& link_m : patcher.getLinks())
+        // call objects and links reaction, removed models have no view anymore.
+        
+        for(auto const* object_m : changed_objects)
         {
-            if(link_m.removed()) break;
-            
-            std::set<uint64_t> selected_for_users;
+            const auto it = m_object_frames.find(object_m);
             
-            for(auto& user : patcher.getUsers())
+            if(it != m_object_frames.end())
             {
-                bool selected_for_local_view = false;
-                bool selected_for_other_view = false;
-                
-                const uint64_t user_id = user.getId();
-                const bool is_distant_user = user_id != m_instance.getUserId();
-                const bool is_connected = (connected_users.find(user_id) != connected_users.end());
-                
-                if(is_distant_user && !is_connected)
-                {
-                    continue;
-                }
-                
-                for(auto& view : user.getViews())
-                {
-                    const bool is_local_view = (&m_view_model == &view);
-                    const bool is_selected = view.isSelected(link_m);
-                    
-                    if(is_selected)
-                    {
-                        if(is_distant_user)
-                        {
-                            selected_for_other_view = true;
-                            
-                            // a link is considered selected for a given user
-                            // when it's selected in at least one of its patcher's views.
-                            break;
-                        }
-                        else if(is_local_view)
-                        {
-                            selected_for_local_view = true;
-                        }
-                        else
-                        {
-                            selected_for_other_view = true;
-                        }
-                    }
-                }
-                
-                if(selected_for_local_view)
-                {
-                    new_local_links_selection.emplace(link_m.ref());
-                }
-                
-                if(selected_for_other_view)
-                {
-                    selected_for_users.emplace(user_id);
-                }
+                it->second->selectionChanged();
             }
-            
-            new_distant_links_selection.insert({link_m.ref(), selected_for_users});
         }
         
-        // check diff between old and new distant selection
-        // and notify links if their selection state changed
-        for(auto& local_link_uptr : m_links)
+        for(auto const* link_m : changed_links)
         {
-            model::Link const& local_link_m = local_link_uptr->getModel();
-            
-            // local diff
-            const bool old_local_selected_state = m_local_links_selection.find(local_link_m.ref()) != m_local_links_selection.end();
-            
-            bool new_local_selected_state = new_local_links_selection.find(local_link_m.ref()) != new_local_links_selection.end();
+            const auto it = m_link_views.find(link_m);
             
-            if(old_local_selected_state != new_local_selected_state)
+            if(it != m_link_views.end())
             {
-                local_link_uptr->localSelectionChanged(new_local_selected_state);
-                selectionChanged();
-            }
-            
-            // distant diff
-            bool distant_selection_changed_for_link = false;
-            for(auto distant_it : new_distant_links_selection)
-            {
-                flip::Ref const& distant_link_lookup_ref = distant_it.first;
-                
-                if(distant_link_lookup_ref == local_link_uptr->getModel().ref())
-                {
-                    distant_selection_changed_for_link =
-                    m_distant_links_selection[distant_link_lookup_ref] != distant_it.second;
-                    
-                    // notify link
-                    if(distant_selection_changed_for_link)
-                    {
-                        local_link_uptr->distantSelectionChanged(distant_it.second);
-                        selectionChanged();
-                    }
-                }
+                it->second->localSelectionChanged(m_selection.isSelectedLocally(*link_m));
+                it->second->distantSelectionChanged(m_selection.getUsers(*link_m));
             }
         }
-        
-        // cache new selection state
-        std::swap(m_distant_links_selection, new_distant_links_selection);
-        std::swap(m_local_links_selection, new_local_links_selection);
     }
     
     void PatcherView::selectionChanged()
@@ -1476,7 +1306,24 @@ namespace kiwi
             
             auto of = std::make_unique<ObjectFrame>(*this, Factory::createObjectView(object));
             
-            auto& object_frame = **(m_objects.emplace(it, std::move(of)));
+            const auto object_it = m_objects.emplace(it, std::move(of));
+            auto& object_frame = **object_it;
+            
+            m_object_frames[&object] = &object_frame;
+            
+            const auto bounds = object_frame.getBounds();
+            const ObjectsGrid::Bounds grid_bounds {bounds.getX(), bounds.getY(), bounds.getWidth(), bounds.getHeight()};
+            
+            if(object_it + 1 != m_objects.end())
+            {
+                m_objects_grid.insertBelow(&object_frame, grid_bounds, (object_it + 1)->get());
+            }
+            else
+            {
+                m_objects_grid.insert(&object_frame, grid_bounds);
+            }
+            
+            object_frame.addComponentListener(this);
             
             addAndMakeVisible(object_frame, zorder);
         }
@@ -1507,9 +1354,15 @@ namespace kiwi
                 m_hittester.reset();
             }
             
+            m_lasso.remove(*object_view);
+            m_object_frames.erase(&object);
+            
             juce::ComponentAnimator& animator = juce::Desktop::getInstance().getAnimator();
             animator.animateComponent(object_view, object_view->getBounds(), 0., 200., true, 0.8, 1.);
             
+            object_view->removeComponentListener(this);
+            m_objects_grid.remove(object_view);
+            
             removeChildComponent(object_view);
             m_objects.erase(it);
         }
@@ -1524,6 +1377,13 @@ namespace kiwi
             auto result = m_links.emplace(m_links.end(), new LinkView(*this, link));
             
             LinkView& link_view = *result->get();
+            
+            m_link_views[&link] = &link_view;
+            
+            const auto bounds = link_view.getBounds();
+            m_links_grid.insert(&link_view, {bounds.getX(), bounds.getY(), bounds.getWidth(), bounds.getHeight()});
+            link_view.addComponentListener(this);
+            
             addAndMakeVisible(link_view);
         }
     }
@@ -1545,7 +1405,15 @@ namespace kiwi
         
         if(it != m_links.cend())
         {
-            removeChildComponent(it->get());
+            LinkView* link_view = it->get();
+            
+            m_lasso.remove(*link_view);
+            m_link_views.erase(&link);
+            
+            link_view->removeComponentListener(this);
+            m_links_grid.remove(link_view);
+            
+            removeChildComponent(link_view);
             m_links.erase(it);
         }
     }
@@ -1585,16 +1453,41 @@ namespace kiwi
         return m_links;
     }
     
+    PatcherView::ObjectsGrid const& PatcherView::getObjectsGrid() const
+    {
+        return m_objects_grid;
+    }
+    
+    PatcherView::LinksGrid const& PatcherView::getLinksGrid() const
+    {
+        return m_links_grid;
+    }
+    
+    void PatcherView::componentMovedOrResized(juce::Component& component,
+                                              bool /*was_moved*/, bool /*was_resized*/)
+    {
+        const auto bounds = component.getBounds();
+        
+        if(auto* object_frame = dynamic_cast<ObjectFrame*>(&component))
+        {
+            m_objects_grid.setBounds(object_frame, {bounds.getX(), bounds.getY(), bounds.getWidth(), bounds.getHeight()});
+        }
+        else if(auto* link_view = dynamic_cast<LinkView*>(&component))
+        {
+            m_links_grid.setBounds(link_view, {bounds.getX(), bounds.getY(), bounds.getWidth(), bounds.getHeight()});
+        }
+    }
+    
     ObjectFrame* PatcherView::getObject(model::Object const& object)
     {
-        const auto it = findObject(object);
-        return (it != m_objects.cend()) ? it->get() : nullptr;
+        const auto it = m_object_frames.find(&object);
+        return (it != m_object_frames.cend()) ? it->second : nullptr;
     }
     
     LinkView* PatcherView::getLink(model::Link const& link)
     {
-        const auto it = findLink(link);
-        return (it != m_links.cend()) ? it->get() : nullptr;
+        const auto it = m_link_views.find(&link);
+        return (it != m_link_views.cend()) ? it->second : nullptr;
     }
     
     // ================================================================================ //
@@ -24,6 +24,9 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include <KiwiModel/KiwiModel_Patcher.h>
+#include <KiwiModel/KiwiModel_PatcherSelection.h>
+
+#include <KiwiTool/KiwiTool_SpatialGrid.h>
 
 #include <KiwiApp_Patcher/KiwiApp_PatcherViewMouseHandler.h>
 
@@ -50,6 +53,7 @@ namespace kiwi
     : public juce::Component
     , public juce::ApplicationCommandTarget
     , public PatcherManager::Listener
+    , public juce::ComponentListener
     {
     public:
         
@@ -75,6 +79,9 @@ namespace kiwi
         using ObjectFrames = std::vector<std::unique_ptr<ObjectFrame>>;
         using LinkViews = std::vector<std::unique_ptr<LinkView>>;
         
+        using ObjectsGrid = tool::SpatialGrid<ObjectFrame*>;
+        using LinksGrid = tool::SpatialGrid<LinkView*>;
+        
         //! @brief Returns the PatcherManager.
         PatcherManager& usePatcherManager();
         
@@ -90,6 +97,14 @@ namespace kiwi
         //! @brief Returns the LinkViews.
         LinkViews const& getLinks() const;
         
+        //! @brief Returns the spatial index of the Objects' frames bounds.
+        //! @details The frames are found in the same order as in getObjects.
+        ObjectsGrid const& getObjectsGrid() const;
+        
+        //! @brief Returns the spatial index of the LinkViews bounds.
+        //! @details The links are found in the same order as in getLinks.
+        LinksGrid const& getLinksGrid() const;
+        
         //! @brief Returns the Object's frame corresponding to a given Object model.
         ObjectFrame* getObject(model::Object const& object);
         
@@ -180,6 +195,14 @@ namespace kiwi
         //! @brief Called when one or more users are connecting or disconnecting to the Patcher Document.
         void connectedUserChanged(PatcherManager& manager) override;
         
+        // ================================================================================ //
+        //                                COMPONENT LISTENER                                //
+        // ================================================================================ //
+        
+        //! @brief Updates the spatial index when an object frame or a link view moves.
+        void componentMovedOrResized(juce::Component& component,
+                                     bool was_moved, bool was_resized) override;
+        
         // ================================================================================ //
         //                                  MODEL OBSERVER                                  //
         // ================================================================================ //
@@ -193,11 +216,9 @@ namespace kiwi
         //! @brief Check patcher view information changes (lock_status...).
         void checkViewInfos(model::Patcher::View& view);
         
-        //! @brief Check the patcher objects selection changes.
-        void checkObjectsSelectionChanges(model::Patcher& patcher);
-        
-        //! @brief Check the patcher objects selection changes.
-        void checkLinksSelectionChanges(model::Patcher& patcher);
+        //! @brief Check the patcher objects and links selection changes.
+        //! @details Only the objects and links whose selection changed are notified.
+        void checkSelectionChanges(model::Patcher& patcher);
         
         //! @internal Object model has just been added to the document.
         void addObjectView(model::Object& object, int zorder = -1);
@@ -400,11 +421,15 @@ namespace kiwi
         ObjectFrames                                m_objects;
         LinkViews                                   m_links;
         
+        std::unordered_map<model::Object const*, ObjectFrame*>  m_object_frames;
+        std::unordered_map<model::Link const*, LinkView*>       m_link_views;
+        ObjectsGrid                                 m_objects_grid;
+        LinksGrid                                   m_links_grid;
+        
         std::set<flip::Ref>                         m_local_objects_selection;
         std::set<flip::Ref>                         m_local_links_selection;
         
-        std::map<flip::Ref, std::set<uint64_t>>     m_distant_objects_selection;
-        std::map<flip::Ref, std::set<uint64_t>>     m_distant_links_selection;
+        model::PatcherSelection                     m_selection;
         
         std::unique_ptr<PatcherViewport>            m_viewport = nullptr;
         HitTester                                   m_hittester;
@@ -80,19 +80,21 @@ namespace kiwi
     {
         reset();
         
-        const auto& objects = m_patcher.getObjects();
-        for(auto it = objects.rbegin(); it != objects.rend(); ++it)
+        // only the objects whose bounds contain the point are tested, from the top.
+        m_patcher.getObjectsGrid().find(point.x, point.y, m_found_objects);
+        
+        for(auto it = m_found_objects.rbegin(); it != m_found_objects.rend(); ++it)
         {
-            auto& box_uptr = *it;
-            if(box_uptr)
+            ObjectFrame* box = *it;
+            if(box)
             {
-                const auto box_bounds = box_uptr->getBounds();
+                const auto box_bounds = box->getBounds();
                 if(box_bounds.contains(point.x, point.y))
                 {
                     const auto relative_point = point - box_bounds.getPosition();
-                    if(box_uptr->hitTest(relative_point, *this))
+                    if(box->hitTest(relative_point, *this))
                     {
-                        m_object = box_uptr.get();
+                        m_object = box;
                         m_target = Target::Box;
                         return true;
                     }
@@ -107,20 +109,22 @@ namespace kiwi
     {
         reset();
         
-        const auto& links = m_patcher.getLinks();
-        for(auto it = links.rbegin(); it != links.rend(); ++it)
+        // the curve of a link is only computed if the point is in its bounds.
+        m_patcher.getLinksGrid().find(point.x, point.y, m_found_links);
+        
+        for(auto it = m_found_links.rbegin(); it != m_found_links.rend(); ++it)
         {
-            auto& link_uptr = *it;
-            if(link_uptr)
+            LinkView* link = *it;
+            if(link)
             {
-                const auto link_bounds = link_uptr->getBounds();
+                const auto link_bounds = link->getBounds();
                 if(link_bounds.contains(point.x, point.y))
                 {
                     const auto relative_point = point - link_bounds.getPosition();
-                    if(link_uptr->hitTest(relative_point, *this))
+                    if(link->hitTest(relative_point, *this))
                     {
                         m_zone = HitTester::Zone::Inside;
-                        m_link = link_uptr.get();
+                        m_link = link;
                         m_target = Target::Link;
                         m_index = 0;
                         return true;
@@ -143,11 +147,14 @@ namespace kiwi
     {
         objects.clear();
         
-        for(auto& box_uptr : m_patcher.getObjects())
+        m_patcher.getObjectsGrid().find({rect.getX(), rect.getY(), rect.getWidth(), rect.getHeight()},
+                                        m_found_objects);
+        
+        for(ObjectFrame* box : m_found_objects)
         {
-            if(box_uptr && box_uptr->hitTest(rect))
+            if(box && box->hitTest(rect))
             {
-                objects.push_back(box_uptr.get());
+                objects.push_back(box);
             }
         }
     }
@@ -156,11 +163,14 @@ namespace kiwi
     {
         links.clear();
         
-        for(auto& link_uptr : m_patcher.getLinks())
+        m_patcher.getLinksGrid().find({rect.getX(), rect.getY(), rect.getWidth(), rect.getHeight()},
+                                      m_found_links);
+        
+        for(LinkView* link : m_found_links)
         {
-            if(link_uptr && link_uptr->hitTest(rect.toFloat()))
+            if(link && link->hitTest(rect.toFloat()))
             {
-                links.push_back(link_uptr.get());
+                links.push_back(link);
             }
         }
     }
@@ -169,6 +169,9 @@ namespace kiwi
         int                 m_border	= Border::None;
         size_t              m_index     = 0;
         
+        std::vector<ObjectFrame*>   m_found_objects;
+        std::vector<LinkView*>      m_found_links;
+        
         friend class LinkView;
         friend class ObjectFrame;
     };
@@ -19,6 +19,8 @@
  ==============================================================================
  */
 
+#include <unordered_set>
+
 #include <KiwiApp_Patcher/KiwiApp_Objects/KiwiApp_ObjectFrame.h>
 
 #include "KiwiApp_PatcherViewLasso.h"
@@ -104,70 +106,86 @@ namespace kiwi
         
         if(preserve)
         {
+            // only the objects and links that were or are in the lasso may change.
+            
             if(include_objects)
             {
-                PatcherView::ObjectFrames const& objects = m_patcher.getObjects();
-                
                 HitTester hit(m_patcher);
                 std::vector<ObjectFrame*> lasso_objects;
                 hit.testObjects(bounds, lasso_objects);
                 
-                for(auto& object_frame_uptr : objects)
+                std::unordered_set<ObjectFrame*> in_lasso_objects(lasso_objects.begin(), lasso_objects.end());
+                
+                for(ObjectFrame* object : m_lasso_objects)
                 {
-                    if(object_frame_uptr)
+                    if(in_lasso_objects.count(object) == 0)
                     {
-                        ObjectFrame& object = *object_frame_uptr.get();
-                        
-                        const bool is_selected = object.isSelected();
-                        const bool was_selected = m_objects.find(object.getModel().ref()) != m_objects.end();
-                        
-                        const bool in_lasso = std::find(lasso_objects.begin(), lasso_objects.end(), &object) != lasso_objects.end();
-                        
-                        if (!is_selected && (was_selected != in_lasso))
-                        {
-                            m_patcher.selectObject(object);
-                            selection_changed = true;
-                        }
-                        else if(is_selected && (was_selected == in_lasso))
-                        {
-                            m_patcher.unselectObject(object);
-                            selection_changed = true;
-                        }
+                        lasso_objects.push_back(object);
                     }
                 }
+                
+                for(ObjectFrame* object_ptr : lasso_objects)
+                {
+                    ObjectFrame& object = *object_ptr;
+                    
+                    const bool is_selected = object.isSelected();
+                    const bool was_selected = m_objects.find(object.getModel().ref()) != m_objects.end();
+                    
+                    const bool in_lasso = in_lasso_objects.count(&object) != 0;
+                    
+                    if (!is_selected && (was_selected != in_lasso))
+                    {
+                        m_patcher.selectObject(object);
+                        selection_changed = true;
+                    }
+                    else if(is_selected && (was_selected == in_lasso))
+                    {
+                        m_patcher.unselectObject(object);
+                        selection_changed = true;
+                    }
+                }
+                
+                m_lasso_objects.swap(in_lasso_objects);
             }
             
             if(include_links)
             {
-                PatcherView::LinkViews const& links = m_patcher.getLinks();
-                
                 HitTester hit(m_patcher);
                 std::vector<LinkView*> lasso_links;
                 hit.testLinks(bounds, lasso_links);
                 
-                for(auto& link_view_uptr : links)
+                std::unordered_set<LinkView*> in_lasso_links(lasso_links.begin(), lasso_links.end());
+                
+                for(LinkView* link : m_lasso_links)
                 {
-                    if(link_view_uptr)
+                    if(in_lasso_links.count(link) == 0)
                     {
-                        LinkView& link = *link_view_uptr.get();
-                        
-                        const bool is_selected = link.isSelected();
-                        const bool was_selected = m_links.find(link.getModel().ref()) != m_links.end();
-                        
-                        const bool in_lasso = std::find(lasso_links.begin(), lasso_links.end(), &link) != lasso_links.end();
-                        
-                        if (!is_selected && (was_selected != in_lasso))
-                        {
-                            m_patcher.selectLink(link);
-                            selection_changed = true;
-                        }
-                        else if(is_selected && (was_selected == in_lasso))
-                        {
-                            m_patcher.unselectLink(link);
-                            selection_changed = true;
-                        }
+                        lasso_links.push_back(link);
                     }
                 }
+                
+                for(LinkView* link_ptr : lasso_links)
+                {
+                    LinkView& link = *link_ptr;
+                    
+                    const bool is_selected = link.isSelected();
+                    const bool was_selected = m_links.find(link.getModel().ref()) != m_links.end();
+                    
+                    const bool in_lasso = in_lasso_links.count(&link) != 0;
+                    
+                    if (!is_selected && (was_selected != in_lasso))
+                    {
+                        m_patcher.selectLink(link);
+                        selection_changed = true;
+                    }
+                    else if(is_selected && (was_selected == in_lasso))
+                    {
+                        m_patcher.unselectLink(link);
+                        selection_changed = true;
+                    }
+                }
+                
+                m_lasso_links.swap(in_lasso_links);
             }
             
             if(selection_changed)
@@ -203,5 +221,18 @@ namespace kiwi
         
         m_objects.clear();
         m_links.clear();
+        
+        m_lasso_objects.clear();
+        m_lasso_links.clear();
+    }
+    
+    void Lasso::remove(ObjectFrame& object)
+    {
+        m_lasso_objects.erase(&object);
+    }
+    
+    void Lasso::remove(LinkView& link)
+    {
+        m_lasso_links.erase(&link);
     }
 }
@@ -26,6 +26,7 @@
 #include <juce_gui_extra/juce_gui_extra.h>
 
 #include <set>
+#include <unordered_set>
 
 #include "../KiwiApp_Components/KiwiApp_TooltipWindow.h"
 
@@ -33,6 +34,7 @@ namespace kiwi
 {
     class PatcherView;
     class ObjectFrame;
+    class LinkView;
     
     // ================================================================================ //
     //										LASSO                                       //
@@ -69,6 +71,12 @@ namespace kiwi
         //! Retrieve Returns true if the Lasso is performing the selection.
         bool isPerforming() const noexcept;
         
+        //! @brief Forgets an object that is removed from the patcher view.
+        void remove(ObjectFrame& object);
+        
+        //! @brief Forgets a link that is removed from the patcher view.
+        void remove(LinkView& link);
+        
     private: // members
         
         PatcherView&        m_patcher;
@@ -76,6 +84,10 @@ namespace kiwi
         std::set<flip::Ref> m_objects;
         std::set<flip::Ref> m_links;
         
+        // the objects and links in the lasso at the previous step.
+        std::unordered_set<ObjectFrame*>    m_lasso_objects;
+        std::unordered_set<LinkView*>       m_lasso_links;
+        
         juce::Point<int>    m_start;
         bool				m_dragging;
     };
@@ -99,24 +99,70 @@ namespace kiwi
             size_t vectorsize = chain.getVectorSize();
             
             // ======================================================================== //
-            //                    PREPARES INLETS, INPUT BUFFER                         //
+            //                    PREPARES INLETS, OUTLETS AND BUFFERS                  //
             // ======================================================================== //
             
+            prepareInlets(chain);
+            
+            prepareOutlets(chain);
+            
+            // ======================================================================== //
+            //                  INITIALIZE INFO FOR PREPARING PROCESSOR                 //
+            // ======================================================================== //
+            
+            std::vector<bool> input_status(m_inlets.size());
+            
+            for (size_t i = 0; i < m_inlets.size(); ++i)
+            {
+                input_status[i] = !m_inlets[i].m_ties.empty();
+            }
+            
+            Processor::PrepareInfo prepare_info {samplerate, vectorsize, input_status};
+            
+            // ======================================================================== //
+            //                           PREPARE PROCESSORS                             //
+            // ======================================================================== //
+            
+            m_processor->m_call_back.reset();
+            
+            m_processor->prepare(prepare_info);
+            
+            return m_processor->shouldPerform();
+        }
+        
+        void Chain::Node::prepareInlets(Chain& chain)
+        {
             std::vector<Signal::sPtr> inputs;
             
             for(Pin& inlet : m_inlets)
             {
+                m_buffer_copy[inlet.m_index].clear();
+                
                 if (inlet.m_ties.size() == 0)
                 {
                     inlet.m_signal = chain.getSignalIn();
+                    inlet.m_scratch.reset();
                 }
                 else if(inlet.m_ties.size() == 1)
                 {
                     inlet.m_signal = inlet.m_ties.begin()->m_pin.m_signal;
+                    inlet.m_scratch.reset();
                 }
                 else
                 {
-                    inlet.m_signal = chain.getSignalInlet(inlet.m_index);
+                    if(chain.m_prepared_parallel)
+                    {
+                        if(!inlet.m_scratch)
+                        {
+                            inlet.m_scratch = std::make_shared<Signal>(chain.getVectorSize());
+                        }
+                        
+                        inlet.m_signal = inlet.m_scratch;
+                    }
+                    else
+                    {
+                        inlet.m_signal = chain.getSignalInlet(inlet.m_index);
+                    }
                     
                     std::vector<std::shared_ptr<Signal>> tie_signals;
                     
@@ -132,49 +178,87 @@ namespace kiwi
             }
             
             m_inputs.setChannels(inputs);
-            
-            // ======================================================================== //
-            //                    PREPARE OUTLETS, OUTPUT BUFFER                        //
-            // ======================================================================== //
-            
+        }
+        
+        void Chain::Node::prepareOutlets(Chain& chain)
+        {
             std::vector<Signal::sPtr> outputs;
             
             for(Pin& outlet : m_outlets)
             {
                 if (outlet.m_ties.size() == 0)
                 {
-                    outlet.m_signal = chain.getSignalOutlet(outlet.m_index);
+                    if(chain.m_prepared_parallel)
+                    {
+                        if(!outlet.m_scratch)
+                        {
+                            outlet.m_scratch = std::make_shared<Signal>(chain.getVectorSize());
+                        }
+                        
+                        outlet.m_signal = outlet.m_scratch;
+                    }
+                    else
+                    {
+                        outlet.m_signal = chain.getSignalOutlet(outlet.m_index);
+                    }
                 }
                 else
                 {
-                    outlet.m_signal = std::make_shared<Signal>(vectorsize);
+                    if(!outlet.m_signal
+                       || outlet.m_signal == outlet.m_scratch
+                       || outlet.m_signal == chain.m_signal_outlet[outlet.m_index].lock())
+                    {
+                        outlet.m_signal = std::make_shared<Signal>(chain.getVectorSize());
+                    }
+                    
+                    outlet.m_scratch.reset();
                 }
                 
                 outputs.push_back(outlet.m_signal);
             }
             
             m_outputs.setChannels(outputs);
-            
-            // ======================================================================== //
-            //                  INITIALIZE INFO FOR PREPARING PROCESSOR                 //
-            // ======================================================================== //
-            
-            std::vector<bool> input_status(m_inlets.size());
-            
-            for (size_t i = 0; i < m_inlets.size(); ++i)
+        }
+        
+        bool Chain::Node::needsOutletSignals(Chain& chain) const
+        {
+            for(Pin const& outlet : m_outlets)
             {
-                input_status[i] = !m_inlets[i].m_ties.empty();
+                if(!outlet.m_ties.empty()
+                   && (!outlet.m_signal
+                       || outlet.m_signal == outlet.m_scratch
+                       || outlet.m_signal == chain.m_signal_outlet[outlet.m_index].lock()))
+                {
+                    return true;
+                }
             }
             
-            Processor::PrepareInfo prepare_info {samplerate, vectorsize, input_status};
+            return false;
+        }
+        
+        bool Chain::Node::canShareInplace(Pin const& outlet) const
+        {
+            if(!m_processor->isInplace() || outlet.m_index >= m_inlets.size())
+            {
+                return false;
+            }
             
-            // ======================================================================== //
-            //                           PREPARE PROCESSORS                             //
-            // ======================================================================== //
+            Pin const& inlet = m_inlets[outlet.m_index];
             
-            m_processor->prepare(prepare_info);
+            return inlet.m_ties.size() == 1 && inlet.m_ties.begin()->m_pin.m_ties.size() == 1;
+        }
+        
+        void Chain::Node::disconnect()
+        {
+            for(Pin& inlet : m_inlets)
+            {
+                inlet.disconnect();
+            }
             
-            return m_processor->shouldPerform();
+            for(Pin& outlet : m_outlets)
+            {
+                outlet.disconnect();
+            }
         }
         
         void Chain::Node::perform() noexcept
@@ -214,6 +298,7 @@ namespace kiwi
             for (Pin& inlet : m_inlets)
             {
                 inlet.m_signal.reset();
+                inlet.m_scratch.reset();
             }
             
             m_inputs.clear();
@@ -225,6 +310,7 @@ namespace kiwi
             for (Pin& outlet : m_outlets)
             {
                 outlet.m_signal.reset();
+                outlet.m_scratch.reset();
             }
             
             m_outputs.clear();
@@ -250,6 +336,7 @@ namespace kiwi
         m_owner(owner),
         m_index(index),
         m_signal(),
+        m_scratch(),
         m_ties()
         {
             ;
@@ -259,6 +346,7 @@ namespace kiwi
         m_owner(other.m_owner),
         m_index(other.m_index),
         m_signal(std::move(other.m_signal)),
+        m_scratch(std::move(other.m_scratch)),
         m_ties(std::move(other.m_ties))
         {
         }
@@ -311,23 +399,56 @@ namespace kiwi
         m_sample_rate(),
         m_vector_size(),
         m_state(State::NotPrepared),
-        m_tick_mutex()
+        m_update_mode(UpdateMode::Full),
+        m_parallel(false),
+        m_prepared_parallel(false),
+        m_commands(),
+        m_schedule(),
+        m_tick_schedule(nullptr),
+        m_tick_count(0),
+        m_sample_clock(),
+        m_next_index(1ul)
         {
             ;
         }
         
         Chain::~Chain()
         {
+            m_tick_schedule.store(nullptr);
             m_nodes.clear();
         }
         
+        void Chain::setUpdateMode(UpdateMode mode) noexcept
+        {
+            m_update_mode = mode;
+        }
+        
+        Chain::UpdateMode Chain::getUpdateMode() const noexcept
+        {
+            return m_update_mode;
+        }
+        
+        void Chain::setParallel(bool parallel) noexcept
+        {
+            m_parallel = parallel;
+        }
+        
+        bool Chain::isParallel() const noexcept
+        {
+            return m_parallel;
+        }
+        
         // ============================================================================ //
         //                              THE UPDATE AND PREPARE                          //
         // ============================================================================ //
         
         void Chain::update()
         {
-            if (!m_commands.empty())
+            if (!m_commands.empty() && m_update_mode == UpdateMode::Incremental && m_state == State::Prepared)
+            {
+                updateIncremental();
+            }
+            else if (!m_commands.empty())
             {
                 State prev_state = m_state;
                 
@@ -342,6 +463,8 @@ namespace kiwi
                     m_commands.pop_front();
                 }
                 
+                clearChanges();
+                
                 if (prev_state == State::Prepared || prev_state == State::Preparing)
                 {
                     prepare(prev_samplerate, prev_vectorsize);
@@ -359,11 +482,16 @@ namespace kiwi
             
             m_sample_rate = samplerate;
             m_vector_size = vector_size;
+            m_prepared_parallel = m_parallel;
             
             indexNodes();
             
             sortNodes();
             
+            allocateSignals();
+            
+            bool removed = false;
+            
             for(auto node = m_nodes.begin(); node != m_nodes.end();)
             {
                 if ((*node)->prepare(*this))
@@ -374,12 +502,571 @@ namespace kiwi
                 {
                     restackNode(**node);
                     node = m_nodes.erase(node);
+                    removed = true;
                 }
             }
             
+            if(m_prepared_parallel && removed)
+            {
+                // removed nodes may have ordered nodes that share a signal.
+                
+                std::set<Node*> nodes;
+                checkSignals(nodes);
+                bindNodes(nodes);
+            }
+            
+            m_next_index = m_nodes.empty() ? 1ul : m_nodes.back()->m_index + 1;
+            
+            publishSchedule(makeSchedule({}));
+            
             m_state = State::Prepared;
         }
         
+        void Chain::updateIncremental()
+        {
+            const size_t samplerate = getSampleRate();
+            const size_t vectorsize = getVectorSize();
+            
+            clearChanges();
+            
+            try
+            {
+                while(!m_commands.empty())
+                {
+                    m_commands.front().operator()();
+                    m_commands.pop_front();
+                }
+            }
+            catch(...)
+            {
+                release();
+                clearChanges();
+                throw;
+            }
+            
+            try
+            {
+                sortAffectedNodes();
+                
+                // Nodes which connections changed are prepared again, sources of new connections
+                // and nodes which pooled signals are no longer valid only need to be bound again.
+                
+                std::set<Node*> bind_nodes;
+                
+                for(Node* source : m_source_nodes)
+                {
+                    if(source->needsOutletSignals(*this))
+                    {
+                        bind_nodes.insert(source);
+                    }
+                }
+                
+                checkSignals(bind_nodes);
+                
+                for(Node* changed_node : m_changed_nodes)
+                {
+                    bind_nodes.erase(changed_node);
+                }
+                
+                std::set<Node*> pending(m_changed_nodes);
+                pending.insert(bind_nodes.begin(), bind_nodes.end());
+                
+                // Pending nodes are withdrawn from the tick before being modified. Nodes that stop performing
+                // are removed and their children prepared during the next pass.
+                
+                bool removed = false;
+                
+                while(!pending.empty())
+                {
+                    publishSchedule(makeSchedule(pending));
+                    
+                    m_changed_nodes.clear();
+                    
+                    for(auto node = m_nodes.begin(); node != m_nodes.end();)
+                    {
+                        Node* current = node->get();
+                        
+                        if(pending.find(current) == pending.end())
+                        {
+                            ++node;
+                        }
+                        else if(bind_nodes.find(current) != bind_nodes.end())
+                        {
+                            current->prepareInlets(*this);
+                            current->prepareOutlets(*this);
+                            ++node;
+                        }
+                        else
+                        {
+                            current->m_processor->release();
+                            
+                            if(current->prepare(*this))
+                            {
+                                ++node;
+                            }
+                            else
+                            {
+                                markChildren(*current);
+                                restackNode(*current);
+                                node = m_nodes.erase(node);
+                                removed = true;
+                            }
+                        }
+                    }
+                    
+                    std::set<Node*> children;
+                    
+                    for(Node* child : m_changed_nodes)
+                    {
+                        if(pending.find(child) == pending.end())
+                        {
+                            children.insert(child);
+                        }
+                    }
+                    
+                    bind_nodes.clear();
+                    pending.swap(children);
+                }
+                
+                if(m_prepared_parallel && removed)
+                {
+                    // removed nodes may have ordered nodes that share a signal.
+                    
+                    std::set<Node*> nodes;
+                    checkSignals(nodes);
+                    
+                    if(!nodes.empty())
+                    {
+                        publishSchedule(makeSchedule(nodes));
+                        bindNodes(nodes);
+                    }
+                }
+                
+                publishSchedule(makeSchedule({}));
+            }
+            catch(...)
+            {
+                release();
+                clearChanges();
+                
+                m_state = State::Preparing;
+                m_sample_rate = samplerate;
+                m_vector_size = vectorsize;
+                throw;
+            }
+            
+            clearChanges();
+        }
+        
+        void Chain::allocateSignals()
+        {
+            std::map<Node const*, size_t> positions;
+            
+            for(size_t position = 0; position < m_nodes.size(); ++position)
+            {
+                positions[m_nodes[position].get()] = position;
+            }
+            
+            // a signal and the positions of the nodes that read it.
+            
+            struct Use
+            {
+                Signal::sPtr            m_signal;
+                std::vector<size_t>     m_readers;
+            };
+            
+            const std::vector<std::vector<bool>> ancestors = (m_prepared_parallel
+                                                              ? getAncestors(positions)
+                                                              : std::vector<std::vector<bool>>());
+            
+            std::vector<Use> free_signals;
+            std::vector<std::vector<Use>> expiring_signals(m_nodes.size());
+            
+            // in a parallel chain the node must be performed after all the readers of the signal.
+            
+            auto take_signal = [this, &free_signals, &ancestors](size_t position)
+            {
+                for(auto use = free_signals.rbegin(); use != free_signals.rend(); ++use)
+                {
+                    if(ancestors.empty()
+                       || std::all_of(use->m_readers.begin(), use->m_readers.end(), [&ancestors, position](size_t reader)
+                    {
+                        return ancestors[position][reader];
+                    }))
+                    {
+                        Signal::sPtr signal = use->m_signal;
+                        free_signals.erase(std::next(use).base());
+                        return signal;
+                    }
+                }
+                
+                return std::make_shared<Signal>(m_vector_size);
+            };
+            
+            for(size_t position = 0; position < m_nodes.size(); ++position)
+            {
+                Node& node = *m_nodes[position];
+                
+                std::vector<Use>& expired = expiring_signals[position];
+                
+                for(Node::Pin& inlet : node.m_inlets)
+                {
+                    inlet.m_scratch.reset();
+                    
+                    if(m_prepared_parallel && inlet.m_ties.size() > 1)
+                    {
+                        inlet.m_scratch = take_signal(position);
+                        expired.push_back({inlet.m_scratch, {position}});
+                    }
+                }
+                
+                for(Node::Pin& outlet : node.m_outlets)
+                {
+                    outlet.m_signal.reset();
+                    outlet.m_scratch.reset();
+                    
+                    if(outlet.m_ties.empty())
+                    {
+                        if(m_prepared_parallel)
+                        {
+                            outlet.m_scratch = take_signal(position);
+                            expired.push_back({outlet.m_scratch, {position}});
+                        }
+                        
+                        continue;
+                    }
+                    
+                    size_t last_use = position;
+                    std::vector<size_t> readers;
+                    
+                    for(Node::Tie tie : outlet.m_ties)
+                    {
+                        readers.push_back(positions[&tie.m_pin.m_owner]);
+                        last_use = std::max(last_use, readers.back());
+                    }
+                    
+                    if(node.canShareInplace(outlet))
+                    {
+                        Signal::sPtr const& input_signal = node.m_inlets[outlet.m_index].m_ties.begin()->m_pin.m_signal;
+                        
+                        auto use = std::find_if(expired.begin(), expired.end(), [&input_signal](Use const& other)
+                        {
+                            return other.m_signal == input_signal;
+                        });
+                        
+                        if(use != expired.end())
+                        {
+                            outlet.m_signal = use->m_signal;
+                            expired.erase(use);
+                        }
+                    }
+                    
+                    if(!outlet.m_signal)
+                    {
+                        outlet.m_signal = take_signal(position);
+                    }
+                    
+                    expiring_signals[last_use].push_back({outlet.m_signal, std::move(readers)});
+                }
+                
+                // signals read for the last time by this node can be used by the next nodes.
+                
+                free_signals.insert(free_signals.end(), expired.begin(), expired.end());
+                
+                expired.clear();
+            }
+        }
+        
+        void Chain::checkSignals(std::set<Node*>& nodes)
+        {
+            struct Lifetime
+            {
+                Node::Pin*              m_pin;
+                bool                    m_outlet;
+                size_t                  m_begin;
+                size_t                  m_end;
+                std::vector<size_t>     m_readers;
+            };
+            
+            std::map<Node const*, size_t> positions;
+            
+            for(size_t position = 0; position < m_nodes.size(); ++position)
+            {
+                positions[m_nodes[position].get()] = position;
+            }
+            
+            const std::vector<std::vector<bool>> ancestors = (m_prepared_parallel
+                                                              ? getAncestors(positions)
+                                                              : std::vector<std::vector<bool>>());
+            
+            std::map<Signal const*, std::vector<Lifetime>> lifetimes;
+            
+            for(size_t position = 0; position < m_nodes.size(); ++position)
+            {
+                Node& node = *m_nodes[position];
+                
+                for(Node::Pin& inlet : node.m_inlets)
+                {
+                    if(inlet.m_ties.size() > 1 && inlet.m_scratch)
+                    {
+                        lifetimes[inlet.m_scratch.get()].push_back({&inlet, false, position, position, {position}});
+                    }
+                }
+                
+                for(Node::Pin& outlet : node.m_outlets)
+                {
+                    if(outlet.m_ties.empty())
+                    {
+                        if(outlet.m_scratch)
+                        {
+                            lifetimes[outlet.m_scratch.get()].push_back({&outlet, false, position, position, {position}});
+                        }
+                        
+                        continue;
+                    }
+                    
+                    if(!outlet.m_signal || outlet.m_signal == outlet.m_scratch)
+                        continue;
+                    
+                    size_t last_use = position;
+                    std::vector<size_t> readers;
+                    
+                    for(Node::Tie tie : outlet.m_ties)
+                    {
+                        readers.push_back(positions[&tie.m_pin.m_owner]);
+                        last_use = std::max(last_use, readers.back());
+                    }
+                    
+                    lifetimes[outlet.m_signal.get()].push_back({&outlet, true, position, last_use, std::move(readers)});
+                }
+            }
+            
+            for(auto& signal_lifetimes : lifetimes)
+            {
+                std::vector<Lifetime>& uses = signal_lifetimes.second;
+                
+                Lifetime const* owner = &uses[0];
+                
+                for(size_t i = 1; i < uses.size(); ++i)
+                {
+                    Lifetime const& lifetime = uses[i];
+                    Node& node = lifetime.m_pin->m_owner;
+                    
+                    const bool inplace = (lifetime.m_outlet
+                                          && owner->m_outlet
+                                          && lifetime.m_begin == owner->m_end
+                                          && node.canShareInplace(*lifetime.m_pin)
+                                          && &node.m_inlets[lifetime.m_pin->m_index].m_ties.begin()->m_pin
+                                          == owner->m_pin);
+                    
+                    const bool after = (lifetime.m_begin > owner->m_end
+                                        && (ancestors.empty()
+                                            || std::all_of(owner->m_readers.begin(),
+                                                           owner->m_readers.end(),
+                                                           [&ancestors, &lifetime](size_t reader)
+                    {
+                        return ancestors[lifetime.m_begin][reader];
+                    })));
+                    
+                    if(after || inplace)
+                    {
+                        owner = &lifetime;
+                    }
+                    else if(lifetime.m_outlet)
+                    {
+                        // the outlet will get its own signal when bound again.
+                        
+                        lifetime.m_pin->m_signal.reset();
+                        
+                        nodes.insert(&node);
+                        
+                        for(Node::Tie tie : lifetime.m_pin->m_ties)
+                        {
+                            nodes.insert(&tie.m_pin.m_owner);
+                        }
+                    }
+                    else
+                    {
+                        lifetime.m_pin->m_scratch.reset();
+                        
+                        nodes.insert(&node);
+                    }
+                }
+            }
+        }
+        
+        std::vector<std::vector<bool>> Chain::getAncestors(std::map<Node const*, size_t> const& positions) const
+        {
+            std::vector<std::vector<bool>> ancestors(m_nodes.size(), std::vector<bool>(m_nodes.size(), false));
+            
+            for(size_t position = 0; position < m_nodes.size(); ++position)
+            {
+                std::vector<bool>& node_ancestors = ancestors[position];
+                
+                for(Node::Pin const& inlet : m_nodes[position]->m_inlets)
+                {
+                    for(Node::Tie tie : inlet.m_ties)
+                    {
+                        auto parent = positions.find(&tie.m_pin.m_owner);
+                        
+                        if(parent == positions.end() || node_ancestors[parent->second])
+                            continue;
+                        
+                        // parents are sorted before their children.
+                        
+                        std::vector<bool> const& parent_ancestors = ancestors[parent->second];
+                        
+                        node_ancestors[parent->second] = true;
+                        
+                        for(size_t i = 0; i < parent->second; ++i)
+                        {
+                            node_ancestors[i] = node_ancestors[i] || parent_ancestors[i];
+                        }
+                    }
+                }
+            }
+            
+            return ancestors;
+        }
+        
+        void Chain::bindNodes(std::set<Node*> const& nodes)
+        {
+            // outlets are bound before the inlets of the next nodes.
+            
+            for(auto const& node : m_nodes)
+            {
+                if(nodes.find(node.get()) != nodes.end())
+                {
+                    node->prepareInlets(*this);
+                    node->prepareOutlets(*this);
+                }
+            }
+        }
+        
+        std::unique_ptr<Chain::Schedule> Chain::makeSchedule(std::set<Node*> const& excluded) const
+        {
+            std::unique_ptr<Schedule> schedule(new Schedule());
+            
+            schedule->m_sample_rate = m_sample_rate;
+            schedule->m_vector_size = m_vector_size;
+            
+            schedule->m_nodes.reserve(m_nodes.size());
+            
+            for(auto const& node : m_nodes)
+            {
+                if(excluded.find(node.get()) == excluded.end())
+                {
+                    schedule->m_nodes.push_back(node.get());
+                }
+            }
+            
+            // ======================================================================== //
+            //                             BUILD DEPENDENCIES                           //
+            // ======================================================================== //
+            
+            std::vector<Task>& tasks = schedule->m_tasks;
+            
+            tasks = std::vector<Task>(schedule->m_nodes.size());
+            
+            std::map<Node const*, Task*> node_tasks;
+            
+            for(size_t i = 0; i < tasks.size(); ++i)
+            {
+                tasks[i].m_node = schedule->m_nodes[i];
+                node_tasks[tasks[i].m_node] = &tasks[i];
+            }
+            
+            for(size_t i = 0; i < tasks.size(); ++i)
+            {
+                Task& task = tasks[i];
+                
+                std::set<Task*> predecessors;
+                
+                if(m_prepared_parallel)
+                {
+                    for(Node::Pin const& inlet : task.m_node->m_inlets)
+                    {
+                        for(Node::Tie tie : inlet.m_ties)
+                        {
+                            auto parent = node_tasks.find(&tie.m_pin.m_owner);
+                            
+                            if(parent != node_tasks.end())
+                            {
+                                predecessors.insert(parent->second);
+                            }
+                        }
+                    }
+                }
+                else if(i > 0)
+                {
+                    predecessors.insert(&tasks[i - 1]);
+                }
+                
+                if(task.m_node->m_processor->isSequential())
+                {
+                    if(schedule->m_last_sequential != nullptr)
+                    {
+                        predecessors.insert(schedule->m_last_sequential);
+                    }
+                    else
+                    {
+                        schedule->m_first_sequential = &task;
+                    }
+                    
+                    schedule->m_last_sequential = &task;
+                }
+                
+                for(Task* predecessor : predecessors)
+                {
+                    predecessor->m_successors.push_back(&task);
+                }
+                
+                task.m_dependencies = predecessors.size();
+            }
+            
+            return schedule;
+        }
+        
+        void Chain::publishSchedule(std::unique_ptr<Schedule> schedule)
+        {
+            std::unique_ptr<Schedule> previous_schedule = std::move(m_schedule);
+            
+            m_schedule = std::move(schedule);
+            
+            m_tick_schedule.store(m_schedule.get());
+            
+            // the tick count is odd while the chain is ticking.
+            
+            const size_t tick_count = m_tick_count.load();
+            
+            if(tick_count & 1)
+            {
+                while(m_tick_count.load() == tick_count)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        
+        void Chain::clearChanges()
+        {
+            m_changed_nodes.clear();
+            m_source_nodes.clear();
+            m_new_links.clear();
+            m_removed_nodes.clear();
+        }
+        
+        void Chain::markChildren(Node & node)
+        {
+            for(Node::Pin& outlet : node.m_outlets)
+            {
+                for(Node::Tie tie : outlet.m_ties)
+                {
+                    m_changed_nodes.insert(&tie.m_pin.m_owner);
+                }
+            }
+        }
+        
         void Chain::restackNode(Node & node)
         {
             // ======================================================================== //
@@ -433,7 +1120,7 @@ namespace kiwi
         
         void Chain::release()
         {
-            std::lock_guard<std::mutex> lock(m_tick_mutex);
+            publishSchedule(nullptr);
             
             m_state = State::NotPrepared;
             
@@ -456,21 +1143,44 @@ namespace kiwi
             return m_vector_size;
         }
         
+        SampleClock const& Chain::getSampleClock() const noexcept
+        {
+            return m_sample_clock;
+        }
+        
+        size_t Chain::getNumberOfSignals() const
+        {
+            std::set<Signal const*> signals;
+            
+            for(auto const& node : m_nodes)
+            {
+                for(Node::Pin const& outlet : node->m_outlets)
+                {
+                    if(!outlet.m_ties.empty() && outlet.m_signal)
+                    {
+                        signals.insert(outlet.m_signal.get());
+                    }
+                }
+            }
+            
+            return signals.size();
+        }
+        
         void Chain::tick() noexcept
         {
-            std::unique_lock<std::mutex> lock(m_tick_mutex, std::defer_lock);
+            m_tick_count.fetch_add(1);
             
-            if (m_state == State::Prepared && lock.try_lock())
+            if (Schedule const* schedule = m_tick_schedule.load())
             {
-                size_t const node_number = m_nodes.size();
+                m_sample_clock.tick(SampleClock::clock_t::now(), schedule->m_sample_rate, schedule->m_vector_size);
                 
-                for(size_t i = 0; i < node_number; ++i)
+                for(Node* node : schedule->m_nodes)
                 {
-                    m_nodes[i]->perform();
+                    node->perform();
                 }
-                
-                lock.unlock();
             }
+            
+            m_tick_count.fetch_add(1);
         }
         
         // ============================================================================ //
@@ -560,6 +1270,72 @@ namespace kiwi
             
             std::sort(m_nodes.begin(), m_nodes.end(), compare_index());
         }
+
+        void Chain::sortAffectedNodes()
+        {
+            auto new_nodes = m_nodes.end();
+            
+            while(new_nodes != m_nodes.begin() && (*(new_nodes - 1))->m_index == 0)
+            {
+                --new_nodes;
+            }
+            
+            for(; new_nodes != m_nodes.end(); ++new_nodes)
+            {
+                (*new_nodes)->m_index = m_next_index++;
+            }
+            
+            // new nodes are appended at the end of the order, then only the nodes between
+            // the destination and the source of a connection that breaks the order are sorted again.
+            
+            size_t lower_index = m_next_index;
+            size_t upper_index = 0;
+            
+            for(auto const& link : m_new_links)
+            {
+                if(link.first->m_index > link.second->m_index)
+                {
+                    lower_index = std::min(lower_index, link.second->m_index);
+                    upper_index = std::max(upper_index, link.first->m_index);
+                }
+            }
+            
+            if(upper_index == 0)
+                return;
+            
+            struct compare_index
+            {
+                bool operator()(std::unique_ptr<Node> const& node, size_t index) const
+                {
+                    return node->m_index < index;
+                }
+            };
+            
+            auto first = std::lower_bound(m_nodes.begin(), m_nodes.end(), lower_index, compare_index());
+            auto last = std::lower_bound(first, m_nodes.end(), upper_index + 1, compare_index());
+            
+            std::vector<size_t> indices;
+            
+            for(auto node = first; node != last; ++node)
+            {
+                indices.push_back((*node)->m_index);
+                (*node)->m_index = 0;
+            }
+            
+            // nodes outside the range keep their index and are ignored by the indexing.
+            
+            std::for_each(first, last, index_node());
+            
+            std::sort(first, last, [](std::unique_ptr<Node> const& l_node, std::unique_ptr<Node> const& r_node)
+            {
+                return l_node->m_index < r_node->m_index;
+            });
+            
+            for(auto node = first; node != last; ++node)
+            {
+                (*node)->m_index = indices[node - first];
+            }
+        }
         
         // ============================================================================ //
         //                                NODE MODIFICATIONS                            //
@@ -649,6 +1425,7 @@ namespace kiwi
             if (findNode(*proc) == m_nodes.end())
             {
                 m_nodes.emplace_back(Node::uPtr(new Node(proc)));
+                m_changed_nodes.insert(m_nodes.back().get());
             }
             else
             {
@@ -662,7 +1439,23 @@ namespace kiwi
             
             if (node != m_nodes.end())
             {
-                m_nodes.erase(findNode(*proc));
+                Node* removed_node = node->get();
+                
+                markChildren(*removed_node);
+                removed_node->disconnect();
+                
+                m_changed_nodes.erase(removed_node);
+                m_source_nodes.erase(removed_node);
+                
+                m_new_links.erase(std::remove_if(m_new_links.begin(), m_new_links.end(),
+                                                 [removed_node](std::pair<Node*, Node*> const& link)
+                {
+                    return link.first == removed_node || link.second == removed_node;
+                }), m_new_links.end());
+                
+                // the node may still be ticked until the schedule is swapped.
+                m_removed_nodes.emplace_back(std::move(*node));
+                m_nodes.erase(node);
             }
             else
             {
@@ -678,7 +1471,12 @@ namespace kiwi
             
             if (source_node != m_nodes.end() && dest_node != m_nodes.end())
             {
-                (*dest_node)->connectInput(inlet_index, **source_node, outlet_index);
+                if((*dest_node)->connectInput(inlet_index, **source_node, outlet_index))
+                {
+                    m_changed_nodes.insert(dest_node->get());
+                    m_source_nodes.insert(source_node->get());
+                    m_new_links.emplace_back(source_node->get(), dest_node->get());
+                }
             }
             else
             {
@@ -694,7 +1492,10 @@ namespace kiwi
             
             if (source_node != m_nodes.end() && dest_node != m_nodes.end())
             {
-                (*dest_node)->disconnectInput(inlet_index, **source_node, outlet_index);
+                if((*dest_node)->disconnectInput(inlet_index, **source_node, outlet_index))
+                {
+                    m_changed_nodes.insert(dest_node->get());
+                }
             }
             else
             {
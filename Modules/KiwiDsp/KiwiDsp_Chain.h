@@ -23,9 +23,12 @@
 
 #include <map>
 #include <queue>
+#include <functional>
+#include <thread>
 
 #include "KiwiDsp_Processor.h"
 #include "KiwiDsp_Misc.h"
+#include "KiwiDsp_SampleClock.h"
 
 namespace kiwi
 {
@@ -44,6 +47,15 @@ namespace kiwi
         
         class Chain final
         {
+        public: // classes
+            
+            //! @brief The strategies used by update to make changes effective.
+            enum class UpdateMode : uint8_t
+            {
+                Full            = 0,    ///< Releases and prepares the whole graph.
+                Incremental     = 1     ///< Only sorts and prepares the nodes affected by the changes.
+            };
+            
         public: // methods
             
             //! @brief The default constructor.
@@ -64,8 +76,31 @@ namespace kiwi
             //! a command stack that update will unstack and execute. Updating the chain will keep in it's previous
             //! state that it's to say that is the chain was prepared it will keep it that way. Update can be called
             //! concurrently with tick.
+            //! @see setUpdateMode
             void update();
             
+            //! @brief Sets the strategy used by update when the chain is prepared.
+            //! @details In full mode the whole chain is released then prepared again and tick does nothing
+            //! meanwhile. In incremental mode only the nodes affected by the changes are sorted and
+            //! prepared again, the new node order is then swapped with the one used by tick so that
+            //! the other processors keep their state and are never interrupted.
+            void setUpdateMode(UpdateMode mode) noexcept;
+            
+            //! @brief Returns the strategy used by update when the chain is prepared.
+            UpdateMode getUpdateMode() const noexcept;
+            
+            //! @brief Sets whether the chain can be performed in parallel by a ThreadPool.
+            //! @details The nodes of a parallel chain that don't depend on each other may be performed
+            //! concurrently, a signal is therefore only reused by a node that depends on all its readers.
+            //! A chain that is not parallel is still performed in order by a ThreadPool but possibly
+            //! concurrently with other chains.
+            //! The change takes effect the next time the chain is prepared.
+            //! @see ThreadPool
+            void setParallel(bool parallel) noexcept;
+            
+            //! @brief Returns true if the chain can be performed in parallel by a ThreadPool.
+            bool isParallel() const noexcept;
+            
             //! @brief Allocates memory needed for chain execution.
             //! @details The prepare method will allocate that signal that will passed through the graph.
             //! All processors prepare method will be called. If the prepare method is called twice, the second
@@ -89,6 +124,18 @@ namespace kiwi
             //! @see getSampleRate
             size_t getVectorSize() const noexcept;
             
+            //! @brief Gets the clock ticked at the beginning of each block.
+            //! @details Control threads use it to stamp events with the position of the sample at
+            //! which processors shall apply them.
+            //! @see SampleClock, EventQueue
+            SampleClock const& getSampleClock() const noexcept;
+            
+            //! @brief Gets the number of signals that carry data between the processors.
+            //! @details Connected outlets whose lifetimes don't overlap share the same signal.
+            //! In a parallel chain the readers of the signal must also be ancestors of the next outlet.
+            //! @see prepare, setParallel
+            size_t getNumberOfSignals() const;
+            
             //! @brief Adds a processor to the chain.
             //! @details Ownership is shared between caller and chain. The caller might
             //! keep a reference to the processor and update it. Calling addProcessor will add a command
@@ -119,6 +166,7 @@ namespace kiwi
             //! @details Call iteratively all the node on their perform method.
             //! if the chain is not prepared the tick will result in doing nothing.
             //! Prepare, release, updates can be made concurrently to tick.
+            //! @see ThreadPool
             void tick() noexcept;
             
         private: // classes
@@ -134,6 +182,31 @@ namespace kiwi
             
             class Node;
             
+            //! @brief A node of the schedule with the tasks that depend on it.
+            //! @details The pending count and the next sequential task are reset by the ThreadPool
+            //! before each tick.
+            struct Task
+            {
+                Node*                   m_node = nullptr;
+                std::vector<Task*>      m_successors {};
+                size_t                  m_dependencies = 0;
+                std::atomic<size_t>     m_pending {0};
+                Task*                   m_next_sequential = nullptr;
+            };
+            
+            //! @brief The ordered list of nodes performed by tick and their dependency graph.
+            //! @details A task depends on the tasks of the nodes connected to its inlets, or on the
+            //! previous task if the chain is not parallel, and on the previous sequential task.
+            struct Schedule
+            {
+                std::vector<Node*>      m_nodes {};
+                std::vector<Task>       m_tasks {};
+                Task*                   m_first_sequential = nullptr;
+                Task*                   m_last_sequential = nullptr;
+                size_t                  m_sample_rate = 0;
+                size_t                  m_vector_size = 0;
+            };
+            
         private: // methods
             
             //! @brief Functor called by indexNodes to index a node.
@@ -161,6 +234,50 @@ namespace kiwi
             //! before a chil node execution.
             void sortNodes();
             
+            //! @brief Allocates the signals of connected outlets from a pool.
+            //! @details The lifetime of an outlet signal goes from its node to its last child node
+            //! in the sorted order. Once expired a signal is reused by the next outlets or by the
+            //! output of the same index of an inplace processor that is its only reader.
+            //! In a parallel chain an expired signal is only reused by a node whose ancestors include
+            //! all its readers, fanning inlets and disconnected outlets also take their signals from
+            //! the pool. Called during prepare after sorting nodes.
+            void allocateSignals();
+            
+            //! @brief Releases pooled signals shared by outlets whose lifetimes now overlap.
+            //! @details Nodes which outlets lose their signal and their children are added to the
+            //! set of nodes to bind again. Called by updateIncremental after sorting nodes.
+            void checkSignals(std::set<Node*>& nodes);
+            
+            //! @brief Returns the ancestors of the sorted nodes.
+            //! @details The element of a node and another one is true if the latter is performed
+            //! before the node in a parallel chain.
+            std::vector<std::vector<bool>> getAncestors(std::map<Node const*, size_t> const& positions) const;
+            
+            //! @brief Binds again nodes which signals were released by checkSignals.
+            void bindNodes(std::set<Node*> const& nodes);
+            
+            //! @brief Makes changes effective without releasing the chain.
+            //! @details Only the range of nodes spanned by new connections is sorted again and only
+            //! the nodes whose connections changed are prepared again. Called by update in
+            //! incremental mode.
+            void updateIncremental();
+            
+            //! @brief Sorts again the nodes spanned by connections that break the current order.
+            //! @details The nodes outside this range keep their index.
+            void sortAffectedNodes();
+            
+            //! @brief Returns the schedule of prepared nodes excluding a set of nodes.
+            //! @details Also builds the tasks used by a ThreadPool to perform the nodes.
+            std::unique_ptr<Schedule> makeSchedule(std::set<Node*> const& excluded) const;
+            
+            //! @brief Swaps the schedule used by tick.
+            //! @details Waits for the current tick to end so that the previous schedule and the nodes
+            //! it references can be safely modified when the method returns.
+            void publishSchedule(std::unique_ptr<Schedule> schedule);
+            
+            //! @brief Clears the changes recorded by the commands.
+            void clearChanges();
+            
         private: // commands
             
             //! @brief The command that will making adding a processor effective.
@@ -183,6 +300,9 @@ namespace kiwi
             //! the chain may be able to reinsert it into the chain.
             void restackNode(Node & node);
             
+            //! @brief Marks as changed the nodes connected to the outlets of a node.
+            void markChildren(Node & node);
+            
             //! @brief Returns a allocated signal for disconnected inlets
             //! @details Since disconnected inlet never modify their signal they can share the same signal.
             //! @details The first disconnected inlet to ask this will cause it's allocation.
@@ -196,6 +316,8 @@ namespace kiwi
             //! @brief Returns an allocated signal for fanning inlets.
             //! @details Since fanning inlets always copy their parent node signal before computing.
             //! @details we can optimize and feed them the same buffer which will be overwritten before node computation.
+            //! @details In a parallel chain fanning inlets and disconnected outlets use the signal
+            //! allocated by allocateSignals instead.
             std::shared_ptr<Signal> getSignalInlet(size_t inlet_index);
             
         private: // members
@@ -204,12 +326,27 @@ namespace kiwi
             size_t                                      m_sample_rate;
             size_t                                      m_vector_size;
             State                                       m_state;
+            UpdateMode                                  m_update_mode;
+            bool                                        m_parallel;
+            bool                                        m_prepared_parallel;
             std::deque<std::function<void(void)>>       m_commands;
-            std::mutex                                  m_tick_mutex;
+            
+            std::unique_ptr<Schedule>                   m_schedule;
+            std::atomic<Schedule*>                      m_tick_schedule;
+            std::atomic<size_t>                         m_tick_count;
+            SampleClock                                 m_sample_clock;
+            size_t                                      m_next_index;
+            
+            std::set<Node*>                             m_changed_nodes;
+            std::set<Node*>                             m_source_nodes;
+            std::vector<std::pair<Node*, Node*>>        m_new_links;
+            std::vector<std::unique_ptr<Node>>          m_removed_nodes;
             
             std::weak_ptr<Signal>                       m_signal_in;
             std::map<size_t, std::weak_ptr<Signal>>     m_signal_outlet;
             std::map<size_t, std::weak_ptr<Signal>>     m_signal_inlet;
+            
+            friend class ThreadPool;
         };
         
         // ================================================================================ //
@@ -244,8 +381,21 @@ namespace kiwi
             
             //! @brief Prepare the Node object.
             //! @details Allocates and bind its memory before its computation. Call its processor prepare method.
+            //! Connected outlets that already own a signal keep it so that children nodes remain bound to it.
             bool prepare(Chain& chain);
             
+            //! @brief Binds the inlets to the signals of the connected outlets.
+            void prepareInlets(Chain& chain);
+            
+            //! @brief Allocates or shares the signals of the outlets.
+            void prepareOutlets(Chain& chain);
+            
+            //! @brief Returns true if a connected outlet doesn't own its signal yet.
+            bool needsOutletSignals(Chain& chain) const;
+            
+            //! @brief Removes all the connections of the node.
+            void disconnect();
+            
             //! @brief The digital signal processing perform method.
             //! @details Feeds the processor a buffer of sample to be processed.
             void perform() noexcept;
@@ -258,6 +408,12 @@ namespace kiwi
             class Pin;
             class Tie;
             
+        private: // methods
+            
+            //! @brief Returns true if an outlet can share its signal with the outlet feeding the inlet
+            //! of the same index.
+            bool canShareInplace(Pin const& outlet) const;
+            
         private: // members
             
             std::shared_ptr<Processor>                  m_processor;
@@ -315,6 +471,7 @@ namespace kiwi
             Node&                                                       m_owner;
             const size_t                                                m_index;
             Signal::sPtr                                                m_signal;
+            Signal::sPtr                                                m_scratch;
             std::set<Node::Tie>                                         m_ties;
             
         private: // deleted methods
@@ -0,0 +1,128 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include "KiwiDsp_DelayLine.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ================================================================================ //
+        //                                    DELAY LINE                                    //
+        // ================================================================================ //
+        
+        //! @brief Returns the smallest power of two greater or equal to a size.
+        static size_t nextPowerOfTwo(size_t size) noexcept
+        {
+            size_t result = 1;
+            
+            while(result < size)
+            {
+                result <<= 1;
+            }
+            
+            return result;
+        }
+        
+        DelayLine::DelayLine(size_t size) :
+        m_size(nextPowerOfTwo(size)),
+        m_mask(m_size - 1),
+        m_samples(new sample_t[m_size]),
+        m_head(0)
+        {
+            clear();
+        }
+        
+        size_t DelayLine::size() const noexcept
+        {
+            return m_size;
+        }
+        
+        void DelayLine::clear() noexcept
+        {
+            std::fill(m_samples.get(), m_samples.get() + m_size, sample_t(0.));
+        }
+        
+        void DelayLine::write(sample_t const* samples, size_t count) noexcept
+        {
+            while(count > 0)
+            {
+                const size_t start = m_head & m_mask;
+                const size_t block = std::min(count, m_size - start);
+                
+                std::copy(samples, samples + block, m_samples.get() + start);
+                
+                m_head += block;
+                samples += block;
+                count -= block;
+            }
+        }
+        
+        void DelayLine::locate(sample_t delay, size_t& index, sample_t& fraction) const noexcept
+        {
+            // the integer and the fractional parts are separated to keep the precision
+            // of the fractional part with long delays.
+            
+            const size_t whole = static_cast<size_t>(delay);
+            const sample_t remainder = delay - static_cast<sample_t>(whole);
+            
+            if(remainder > sample_t(0.))
+            {
+                index = m_head - whole - 1;
+                fraction = sample_t(1.) - remainder;
+            }
+            else
+            {
+                index = m_head - whole;
+                fraction = sample_t(0.);
+            }
+        }
+        
+        sample_t DelayLine::read(sample_t delay) const noexcept
+        {
+            size_t index;
+            sample_t fraction;
+            locate(delay, index, fraction);
+            
+            return interpolate(fraction, at(index - 1), at(index), at(index + 1), at(index + 2));
+        }
+        
+        void DelayLine::read(sample_t* output, size_t count, sample_t delay) const noexcept
+        {
+            size_t index;
+            sample_t fraction;
+            locate(delay + static_cast<sample_t>(count - 1), index, fraction);
+            
+            for(size_t i = 0; i < count; ++i, ++index)
+            {
+                output[i] = interpolate(fraction, at(index - 1), at(index), at(index + 1), at(index + 2));
+            }
+        }
+        
+        sample_t DelayLine::interpolate(sample_t x, sample_t y0, sample_t y1, sample_t y2, sample_t y3) noexcept
+        {
+            return y1 + sample_t(0.5) * x * (y2 - y0 + x * (sample_t(2.) * y0 - sample_t(5.) * y1
+                                                            + sample_t(4.) * y2 - y3
+                                                            + x * (sample_t(3.) * (y1 - y2) + y3 - y0)));
+        }
+    }
+}
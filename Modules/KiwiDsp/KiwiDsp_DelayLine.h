@@ -0,0 +1,98 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include "KiwiDsp_Def.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                       DELAY LINE                                     //
+        // ==================================================================================== //
+        //! @brief A circular buffer of samples read with cubic interpolation.
+        //! @details The size of the buffer is a power of two so the positions are wrapped with a
+        //! mask. Samples are written by blocks at the write head and read at a delay from it.
+        //! A delay of d samples reads the sample written d samples before the next write.
+        class DelayLine
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @details Allocates a buffer filled with zeros.
+            //! @param size The minimum number of samples, rounded up to a power of two.
+            DelayLine(size_t size);
+            
+            //! @brief Destructor.
+            ~DelayLine() = default;
+            
+            //! @brief Returns the number of samples of the buffer.
+            size_t size() const noexcept;
+            
+            //! @brief Fills the buffer with zeros.
+            void clear() noexcept;
+            
+            //! @brief Copies a block of samples at the write head and moves the write head.
+            void write(sample_t const* samples, size_t count) noexcept;
+            
+            //! @brief Reads a sample at a delay from the write head.
+            //! @details The delay must be greater or equal to 1 and lower than size() - 2.
+            sample_t read(sample_t delay) const noexcept;
+            
+            //! @brief Reads the samples of the last block written with a constant delay.
+            //! @details output[i] = read(delay + count - 1 - i), so each sample is read at the
+            //! same delay from its own position.
+            void read(sample_t* output, size_t count, sample_t delay) const noexcept;
+            
+        private: // methods
+            
+            //! @brief Returns the sample at a position.
+            sample_t at(size_t position) const noexcept
+            {
+                return m_samples[position & m_mask];
+            }
+            
+            //! @brief Computes the index and the fractional part of a delayed position.
+            void locate(sample_t delay, size_t& index, sample_t& fraction) const noexcept;
+            
+            //! @brief Interpolates between y1 and y2.
+            static sample_t interpolate(sample_t x, sample_t y0, sample_t y1, sample_t y2, sample_t y3) noexcept;
+            
+        private: // members
+            
+            const size_t                m_size;
+            const size_t                m_mask;
+            std::unique_ptr<sample_t[]> m_samples;
+            size_t                      m_head;
+            
+        private: // deleted methods
+            
+            DelayLine() = delete;
+            DelayLine(DelayLine const& other) = delete;
+            DelayLine(DelayLine && other) = delete;
+            DelayLine& operator=(DelayLine const& other) = delete;
+            DelayLine& operator=(DelayLine && other) = delete;
+        };
+    }
+}
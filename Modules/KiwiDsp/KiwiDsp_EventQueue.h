@@ -0,0 +1,205 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <cstdint>
+
+#include "KiwiDsp_Def.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      EVENT QUEUE                                     //
+        // ==================================================================================== //
+        
+        //! @brief A lock-free queue of control events stamped with a sample position.
+        //! @details A control thread pushes events with the position given by a SampleClock and
+        //! the processor pops them while it performs a block, splitting the block at the offsets of
+        //! the events. The capacity is fixed so neither side allocates. When the queue is full, for
+        //! instance because the chain isn't ticking, the oldest event is discarded to make room for
+        //! the new one so that the last state sent to the processor is never lost.
+        //! One thread shall push and another one shall pop.
+        //! @see SampleClock
+        template<class T>
+        class EventQueue final
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @param capacity The maximum number of pending events, rounded up to a power of two.
+            EventQueue(size_t capacity) :
+            m_capacity(roundCapacity(capacity)),
+            m_mask(m_capacity - 1),
+            m_slots(new Slot[m_capacity]),
+            m_last_position(0),
+            m_read(0),
+            m_write(0)
+            {
+                for(size_t i = 0; i < m_capacity; ++i)
+                {
+                    m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+                    m_slots[i].m_position.store(0, std::memory_order_relaxed);
+                }
+            }
+            
+            //! @brief Destructor.
+            ~EventQueue() = default;
+            
+            //! @brief Adds an event. Called by the control thread only.
+            //! @details Events shall be pushed in the order of their positions, an event pushed
+            //! before a later one is never applied after it.
+            //! @return false if the oldest event was discarded to make room.
+            bool push(uint64_t position, T const& value) noexcept
+            {
+                const size_t write = m_write;
+                
+                Slot& slot = m_slots[write & m_mask];
+                
+                bool discarded = false;
+                
+                while(slot.m_sequence.load(std::memory_order_acquire) != write)
+                {
+                    // the slot is released once its event is discarded or popped concurrently.
+                    
+                    discarded |= discard();
+                }
+                
+                slot.m_position.store(position, std::memory_order_relaxed);
+                slot.m_value = value;
+                slot.m_sequence.store(write + 1, std::memory_order_release);
+                
+                m_write = write + 1;
+                
+                return !discarded;
+            }
+            
+            //! @brief Removes the next event of a block. Called by the processor only.
+            //! @details Events positioned before the block are returned with an offset of zero,
+            //! events positioned after the block stay in the queue. The offsets of the successive
+            //! events of a block never decrease.
+            //! @param block_position The position of the first sample of the block.
+            //! @param block_size The number of samples of the block.
+            //! @param offset The offset of the event in the block.
+            //! @param value The value of the event.
+            //! @return false if no more event is due in the block.
+            bool pop(uint64_t block_position, size_t block_size, size_t& offset, T& value) noexcept
+            {
+                size_t read = m_read.load(std::memory_order_relaxed);
+                
+                for(;;)
+                {
+                    Slot& slot = m_slots[read & m_mask];
+                    
+                    if(slot.m_sequence.load(std::memory_order_acquire) != read + 1)
+                    {
+                        return false;
+                    }
+                    
+                    const uint64_t position = std::max(slot.m_position.load(std::memory_order_relaxed),
+                                                       m_last_position);
+                    
+                    if(position >= block_position + block_size)
+                    {
+                        return false;
+                    }
+                    
+                    // the event may have been discarded since it was read, in which case read is updated.
+                    
+                    if(m_read.compare_exchange_weak(read, read + 1, std::memory_order_relaxed))
+                    {
+                        offset = position > block_position ? static_cast<size_t>(position - block_position) : 0;
+                        value = slot.m_value;
+                        
+                        m_last_position = position;
+                        
+                        slot.m_sequence.store(read + m_capacity, std::memory_order_release);
+                        
+                        return true;
+                    }
+                }
+            }
+            
+        private: // classes
+            
+            //! @brief The sequence of a slot is its index when it's free and the index plus one
+            //! when it holds an event.
+            struct Slot
+            {
+                std::atomic<size_t>     m_sequence;
+                std::atomic<uint64_t>   m_position;
+                T                       m_value {};
+            };
+            
+        private: // methods
+            
+            //! @brief Removes the oldest event. Called by the control thread when the queue is full.
+            //! @return false if the event was popped concurrently.
+            bool discard() noexcept
+            {
+                size_t read = m_read.load(std::memory_order_relaxed);
+                
+                Slot& slot = m_slots[read & m_mask];
+                
+                if(slot.m_sequence.load(std::memory_order_acquire) == read + 1
+                   && m_read.compare_exchange_strong(read, read + 1, std::memory_order_relaxed))
+                {
+                    slot.m_sequence.store(read + m_capacity, std::memory_order_release);
+                    return true;
+                }
+                
+                return false;
+            }
+            
+            static size_t roundCapacity(size_t capacity) noexcept
+            {
+                size_t result = 1;
+                
+                while(result < capacity)
+                {
+                    result <<= 1;
+                }
+                
+                return result;
+            }
+            
+        private: // members
+            
+            const size_t                m_capacity;
+            const size_t                m_mask;
+            std::unique_ptr<Slot[]>     m_slots;
+            uint64_t                    m_last_position;
+            std::atomic<size_t>         m_read;
+            size_t                      m_write;
+            
+        private: // deleted methods
+            
+            EventQueue() = delete;
+            EventQueue(EventQueue const& other) = delete;
+            EventQueue(EventQueue && other) = delete;
+            EventQueue& operator=(EventQueue const& other) = delete;
+            EventQueue& operator=(EventQueue && other) = delete;
+        };
+    }
+}
@@ -0,0 +1,242 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include "KiwiDsp_Oscillator.h"
+
+#if defined(KIWI_DSP_FLOAT) && defined(__AVX__)
+#define KIWI_DSP_OSCILLATOR_AVX 1
+#include <immintrin.h>
+#elif defined(KIWI_DSP_FLOAT) && (defined(__SSE2__) || defined(_M_X64))
+#define KIWI_DSP_OSCILLATOR_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        namespace oscillator
+        {
+            // ================================================================================ //
+            //                                      SCALAR                                      //
+            // ================================================================================ //
+            
+            // The cosine is approximated with the Taylor series of sin(2πv) for v in [-0.25, 0.25]:
+            // cos(2πx) = sin(2π(0.25 - |u|)) where u is x minus the nearest integer.
+            
+            static const double c1 = 6.283185307179586476925286766559;
+            static const double c3 = -(c1 * c1 * c1) / 6.;
+            static const double c5 = -(c3 * c1 * c1) / 20.;
+            static const double c7 = -(c5 * c1 * c1) / 42.;
+            static const double c9 = -(c7 * c1 * c1) / 72.;
+            static const double c11 = -(c9 * c1 * c1) / 110.;
+            
+            //! @brief Rounds down without calling the library for the common values.
+            static inline sample_t floor(sample_t x) noexcept
+            {
+                // values out of the range of the integers are integers.
+                
+                if(std::abs(x) >= sample_t(4503599627370496.))
+                {
+                    return x;
+                }
+                
+                const sample_t truncated = static_cast<sample_t>(static_cast<long long>(x));
+                return truncated > x ? truncated - sample_t(1.) : truncated;
+            }
+            
+            //! @brief Returns the fractional part of a phase in [0, 1).
+            static inline sample_t wrap(sample_t x) noexcept
+            {
+                const sample_t result = x - floor(x);
+                return result < sample_t(1.) ? result : sample_t(0.);
+            }
+            
+            static inline sample_t fastCosine(sample_t x) noexcept
+            {
+                const sample_t v = sample_t(0.25) - std::abs(x - floor(x + sample_t(0.5)));
+                const sample_t v2 = v * v;
+                
+                return v * (sample_t(c1) + v2 * (sample_t(c3) + v2 * (sample_t(c5) + v2
+                            * (sample_t(c7) + v2 * (sample_t(c9) + v2 * sample_t(c11))))));
+            }
+            
+            // ================================================================================ //
+            //                                       SIMD                                       //
+            // ================================================================================ //
+            
+            #if KIWI_DSP_OSCILLATOR_AVX
+            
+            typedef __m256 vector_t;
+            static const size_t vector_size = 8;
+            
+            static inline vector_t load(float const* values) noexcept { return _mm256_loadu_ps(values); }
+            static inline void store(float* values, vector_t x) noexcept { _mm256_storeu_ps(values, x); }
+            static inline vector_t set(float value) noexcept { return _mm256_set1_ps(value); }
+            static inline vector_t indices() noexcept { return _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f); }
+            static inline vector_t add(vector_t a, vector_t b) noexcept { return _mm256_add_ps(a, b); }
+            static inline vector_t sub(vector_t a, vector_t b) noexcept { return _mm256_sub_ps(a, b); }
+            static inline vector_t mul(vector_t a, vector_t b) noexcept { return _mm256_mul_ps(a, b); }
+            static inline vector_t abs(vector_t x) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), x); }
+            static inline vector_t round(vector_t x) noexcept { return _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            static inline vector_t floor(vector_t x) noexcept { return _mm256_floor_ps(x); }
+            static inline vector_t zeroIfNotLess(vector_t x, vector_t limit) noexcept { return _mm256_and_ps(x, _mm256_cmp_ps(x, limit, _CMP_LT_OQ)); }
+            
+            #elif KIWI_DSP_OSCILLATOR_SSE
+            
+            typedef __m128 vector_t;
+            static const size_t vector_size = 4;
+            
+            static inline vector_t load(float const* values) noexcept { return _mm_loadu_ps(values); }
+            static inline void store(float* values, vector_t x) noexcept { _mm_storeu_ps(values, x); }
+            static inline vector_t set(float value) noexcept { return _mm_set1_ps(value); }
+            static inline vector_t indices() noexcept { return _mm_setr_ps(0.f, 1.f, 2.f, 3.f); }
+            static inline vector_t add(vector_t a, vector_t b) noexcept { return _mm_add_ps(a, b); }
+            static inline vector_t sub(vector_t a, vector_t b) noexcept { return _mm_sub_ps(a, b); }
+            static inline vector_t mul(vector_t a, vector_t b) noexcept { return _mm_mul_ps(a, b); }
+            static inline vector_t abs(vector_t x) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.f), x); }
+            static inline vector_t zeroIfNotLess(vector_t x, vector_t limit) noexcept { return _mm_and_ps(x, _mm_cmplt_ps(x, limit)); }
+            
+            static inline vector_t round(vector_t x) noexcept
+            {
+                // floats greater than 2^23 are integers and can't be converted to 32-bit integers.
+                
+                const vector_t rounded = _mm_cvtepi32_ps(_mm_cvtps_epi32(x));
+                const vector_t small = _mm_cmplt_ps(abs(x), _mm_set1_ps(8388608.f));
+                
+                return _mm_or_ps(_mm_and_ps(small, rounded), _mm_andnot_ps(small, x));
+            }
+            
+            static inline vector_t floor(vector_t x) noexcept
+            {
+                const vector_t rounded = round(x);
+                return _mm_sub_ps(rounded, _mm_and_ps(_mm_cmpgt_ps(rounded, x), _mm_set1_ps(1.f)));
+            }
+            
+            #endif
+            
+            #if KIWI_DSP_OSCILLATOR_AVX || KIWI_DSP_OSCILLATOR_SSE
+            
+            static inline vector_t fastCosine(vector_t x) noexcept
+            {
+                const vector_t v = sub(set(0.25f), abs(sub(x, round(x))));
+                const vector_t v2 = mul(v, v);
+                
+                vector_t result = set(float(c11));
+                result = add(mul(result, v2), set(float(c9)));
+                result = add(mul(result, v2), set(float(c7)));
+                result = add(mul(result, v2), set(float(c5)));
+                result = add(mul(result, v2), set(float(c3)));
+                result = add(mul(result, v2), set(float(c1)));
+                
+                return mul(result, v);
+            }
+            
+            #endif
+            
+            // ================================================================================ //
+            //                                      KERNELS                                     //
+            // ================================================================================ //
+            
+            sample_t phase(sample_t* output, size_t size, sample_t phase, sample_t increment) noexcept
+            {
+                phase = wrap(phase);
+                
+                size_t i = 0;
+                
+                #if KIWI_DSP_OSCILLATOR_AVX || KIWI_DSP_OSCILLATOR_SSE
+                
+                // the phases are computed from their indices so the errors don't accumulate.
+                
+                const vector_t start = set(phase);
+                const vector_t step = set(float(vector_size));
+                const vector_t one = set(1.f);
+                const vector_t increments = set(increment);
+                vector_t index = indices();
+                
+                for(; i + vector_size <= size; i += vector_size)
+                {
+                    const vector_t x = add(start, mul(index, increments));
+                    store(output + i, zeroIfNotLess(sub(x, floor(x)), one));
+                    index = add(index, step);
+                }
+                
+                #endif
+                
+                for(; i < size; ++i)
+                {
+                    output[i] = wrap(phase + static_cast<sample_t>(i) * increment);
+                }
+                
+                return wrap(phase + static_cast<sample_t>(size) * increment);
+            }
+            
+            sample_t phase(sample_t* output, size_t size, sample_t phase,
+                           sample_t const* frequencies, sample_t scale) noexcept
+            {
+                phase = wrap(phase);
+                
+                for(size_t i = 0; i < size; ++i)
+                {
+                    const sample_t increment = frequencies[i] * scale;
+                    
+                    output[i] = phase;
+                    phase += increment;
+                    
+                    if(phase >= sample_t(1.) || phase < sample_t(0.))
+                    {
+                        phase = wrap(phase);
+                    }
+                }
+                
+                return phase;
+            }
+            
+            void cosine(sample_t const* phases, sample_t* output, size_t size) noexcept
+            {
+                for(size_t i = 0; i < size; ++i)
+                {
+                    output[i] = std::cos(sample_t(2.) * pi * phases[i]);
+                }
+            }
+            
+            void fastCosine(sample_t const* phases, sample_t* output, size_t size) noexcept
+            {
+                size_t i = 0;
+                
+                #if KIWI_DSP_OSCILLATOR_AVX || KIWI_DSP_OSCILLATOR_SSE
+                
+                for(; i + vector_size <= size; i += vector_size)
+                {
+                    store(output + i, fastCosine(load(phases + i)));
+                }
+                
+                #endif
+                
+                for(; i < size; ++i)
+                {
+                    output[i] = fastCosine(phases[i]);
+                }
+            }
+        }
+    }
+}
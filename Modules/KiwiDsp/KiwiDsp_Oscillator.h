@@ -0,0 +1,67 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include "KiwiDsp_Def.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                       OSCILLATOR                                     //
+        // ==================================================================================== //
+        //! @brief Kernels used by the oscillators to compute blocks of samples.
+        //! @details The phases are expressed in periods, a phase of 1 is a full cycle.
+        //! When the samples are floats on x86, the fast kernels process several samples
+        //! at once with SSE or AVX instructions.
+        namespace oscillator
+        {
+            //! @brief Writes the phases of an oscillator with a constant increment.
+            //! @details The phases are wrapped in [0, 1).
+            //! @param output The phases.
+            //! @param size The number of samples.
+            //! @param phase The first phase.
+            //! @param increment The increment of the phase for each sample.
+            //! @return The phase following the last one.
+            sample_t phase(sample_t* output, size_t size, sample_t phase, sample_t increment) noexcept;
+            
+            //! @brief Writes the phases of an oscillator whose frequency varies.
+            //! @details The phases are wrapped in [0, 1), the increment for a sample is
+            //! the frequency multiplied by the scale, usually the inverse of the sample rate.
+            //! The output can be the frequencies.
+            //! @return The phase following the last one.
+            sample_t phase(sample_t* output, size_t size, sample_t phase,
+                           sample_t const* frequencies, sample_t scale) noexcept;
+            
+            //! @brief Computes the cosines of phases with the standard library.
+            //! @details output[i] = cos(2π * phases[i]), the output can be the phases.
+            void cosine(sample_t const* phases, sample_t* output, size_t size) noexcept;
+            
+            //! @brief Computes the cosines of phases with a polynomial approximation.
+            //! @details output[i] ≈ cos(2π * phases[i]) with an absolute error lower than 1e-6,
+            //! the output can be the phases.
+            void fastCosine(sample_t const* phases, sample_t* output, size_t size) noexcept;
+        }
+    }
+}
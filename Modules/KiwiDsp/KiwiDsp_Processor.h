@@ -131,8 +131,41 @@ namespace kiwi
                 return m_call_back != nullptr;
             }
             
+            //! @brief Returns true if the processor can compute in place.
+            //! @see setInplace
+            bool isInplace() const noexcept
+            {
+                return m_inplace;
+            }
+            
+            //! @brief Returns true if the processor must be performed sequentially.
+            //! @see setSequential
+            bool isSequential() const noexcept
+            {
+                return m_sequential;
+            }
+            
         protected: // methods
             
+            //! @brief Declares that the processor can compute in place.
+            //! @details An inplace processor accepts that each output shares its signal with the input
+            //! of the same index. It shall be declared before the chain is prepared, typically in the
+            //! constructor.
+            void setInplace(bool inplace) noexcept
+            {
+                m_inplace = inplace;
+            }
+            
+            //! @brief Declares that the processor accesses data shared with other processors.
+            //! @details When chains are performed in parallel, sequential processors are performed one
+            //! after the other in the order of the chains and of their nodes, even across chains, so
+            //! that they don't race and that their result doesn't depend on the threads.
+            //! It shall be declared before the chain is prepared, typically in the constructor.
+            void setSequential(bool sequential) noexcept
+            {
+                m_sequential = sequential;
+            }
+            
             //! @brief Constructs a callback that will bind a processor and its perform method.
             //! @details setPerformCallBack shall be called by the prepare method to set the callback
             //! that will be called when chain processes a processor.
@@ -175,6 +208,8 @@ namespace kiwi
             
             const size_t                        m_ninputs;
             const size_t                        m_noutputs;
+            bool                                m_inplace = false;
+            bool                                m_sequential = false;
             
             std::unique_ptr<IPerformCallBack>   m_call_back;
             
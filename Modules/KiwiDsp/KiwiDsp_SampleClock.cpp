@@ -0,0 +1,105 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include "KiwiDsp_SampleClock.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ================================================================================ //
+        //                                   SAMPLE CLOCK                                   //
+        // ================================================================================ //
+        
+        SampleClock::SampleClock() noexcept :
+        m_sequence(0),
+        m_position(0),
+        m_time(0),
+        m_sample_rate(0),
+        m_vector_size(0),
+        m_next_position(0)
+        {
+        }
+        
+        void SampleClock::tick(time_point_t time, size_t sample_rate, size_t vector_size) noexcept
+        {
+            const uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+            
+            m_sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            
+            m_position.store(m_next_position, std::memory_order_relaxed);
+            m_time.store(time.time_since_epoch().count(), std::memory_order_relaxed);
+            m_sample_rate.store(sample_rate, std::memory_order_relaxed);
+            m_vector_size.store(vector_size, std::memory_order_relaxed);
+            
+            m_sequence.store(sequence + 2, std::memory_order_release);
+            
+            m_next_position += vector_size;
+        }
+        
+        SampleClock::Block SampleClock::load() const noexcept
+        {
+            Block block;
+            uint64_t sequence;
+            
+            do
+            {
+                sequence = m_sequence.load(std::memory_order_acquire);
+                
+                block.m_position = m_position.load(std::memory_order_relaxed);
+                block.m_time = time_point_t(clock_t::duration(m_time.load(std::memory_order_relaxed)));
+                block.m_sample_rate = m_sample_rate.load(std::memory_order_relaxed);
+                block.m_vector_size = m_vector_size.load(std::memory_order_relaxed);
+                
+                std::atomic_thread_fence(std::memory_order_acquire);
+            }
+            while((sequence & 1) || sequence != m_sequence.load(std::memory_order_relaxed));
+            
+            return block;
+        }
+        
+        uint64_t SampleClock::getBlockPosition() const noexcept
+        {
+            return m_position.load(std::memory_order_relaxed);
+        }
+        
+        uint64_t SampleClock::getPosition(time_point_t time) const noexcept
+        {
+            const Block block = load();
+            
+            const uint64_t next_position = block.m_position + block.m_vector_size;
+            
+            if(block.m_sample_rate == 0 || block.m_vector_size == 0 || time <= block.m_time)
+            {
+                return next_position;
+            }
+            
+            const std::chrono::duration<double> elapsed = time - block.m_time;
+            
+            const double offset = std::floor(elapsed.count() * block.m_sample_rate);
+            const double last = static_cast<double>(block.m_vector_size - 1);
+            
+            return next_position + static_cast<uint64_t>(std::min(offset, last));
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <cstdint>
+
+#include "KiwiDsp_Def.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                      SAMPLE CLOCK                                    //
+        // ==================================================================================== //
+        
+        //! @brief Relates the samples performed by a chain to the time of the system clock.
+        //! @details The chain ticks the clock at the beginning of each block with the time of the
+        //! tick. The other threads use it to convert the time of a control event to the position of
+        //! the sample at which it shall be applied. An event is applied one block after its time, at
+        //! the same offset in the block, so that the events of a block keep their relative timing.
+        //! The clock is written by the thread that ticks the chain and read without locks.
+        class SampleClock final
+        {
+        public: // classes
+            
+            using clock_t = std::chrono::high_resolution_clock;
+            
+            using time_point_t = clock_t::time_point;
+            
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @details The clock starts at position zero and isn't ticking.
+            SampleClock() noexcept;
+            
+            //! @brief Destructor.
+            ~SampleClock() = default;
+            
+            //! @brief Starts a new block. Called by the thread that ticks the chain.
+            //! @param time The time of the beginning of the block.
+            //! @param sample_rate The sample rate of the block.
+            //! @param vector_size The number of samples of the block.
+            void tick(time_point_t time, size_t sample_rate, size_t vector_size) noexcept;
+            
+            //! @brief Returns the position of the first sample of the current block.
+            //! @details Shall be called while the block is performed.
+            uint64_t getBlockPosition() const noexcept;
+            
+            //! @brief Returns the position of the sample at which an event shall be applied.
+            //! @details The position is in the block following the last tick. Events older than the
+            //! last tick are applied at the beginning of this block and events later than its end,
+            //! for instance when the audio is late or stopped, at its last sample. If the clock has
+            //! never ticked, the position of the next block is returned.
+            //! @param time The time of the event.
+            uint64_t getPosition(time_point_t time) const noexcept;
+            
+        private: // classes
+            
+            //! @brief The state published at each tick.
+            struct Block
+            {
+                uint64_t        m_position;
+                time_point_t    m_time;
+                size_t          m_sample_rate;
+                size_t          m_vector_size;
+            };
+            
+        private: // methods
+            
+            //! @brief Returns a consistent copy of the state of the current block.
+            Block load() const noexcept;
+            
+        private: // members
+            
+            // the block is published with a sequence lock, the sequence is odd during a write.
+            
+            std::atomic<uint64_t>       m_sequence;
+            std::atomic<uint64_t>       m_position;
+            std::atomic<int64_t>        m_time;
+            std::atomic<size_t>         m_sample_rate;
+            std::atomic<size_t>         m_vector_size;
+            uint64_t                    m_next_position;
+            
+        private: // deleted methods
+            
+            SampleClock(SampleClock const& other) = delete;
+            SampleClock(SampleClock && other) = delete;
+            SampleClock& operator=(SampleClock const& other) = delete;
+            SampleClock& operator=(SampleClock && other) = delete;
+        };
+    }
+}
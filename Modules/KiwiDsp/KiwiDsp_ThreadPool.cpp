@@ -0,0 +1,468 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include "KiwiDsp_ThreadPool.h"
+
+#if defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#include <pthread.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <semaphore.h>
+#endif
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                  THREAD POOL::QUEUE                                  //
+        // ==================================================================================== //
+        
+        ThreadPool::Queue::Queue(size_t capacity) :
+        m_mask(static_cast<int64_t>(capacity) - 1),
+        m_tasks(new std::atomic<Chain::Task*>[capacity]),
+        m_top(0),
+        m_bottom(0)
+        {
+            assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+            
+            for(size_t i = 0; i < capacity; ++i)
+            {
+                m_tasks[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        
+        bool ThreadPool::Queue::push(Chain::Task* task) noexcept
+        {
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            const int64_t top = m_top.load(std::memory_order_acquire);
+            
+            if(bottom - top > m_mask)
+            {
+                return false;
+            }
+            
+            m_tasks[bottom & m_mask].store(task, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            
+            return true;
+        }
+        
+        Chain::Task* ThreadPool::Queue::pop() noexcept
+        {
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+            
+            if(top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            
+            Chain::Task* task = m_tasks[bottom & m_mask].load(std::memory_order_relaxed);
+            
+            if(top == bottom)
+            {
+                // the last task may be stolen concurrently.
+                
+                if(!m_top.compare_exchange_strong(top, top + 1,
+                                                  std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed))
+                {
+                    task = nullptr;
+                }
+                
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            
+            return task;
+        }
+        
+        Chain::Task* ThreadPool::Queue::steal() noexcept
+        {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+            
+            if(top >= bottom)
+            {
+                return nullptr;
+            }
+            
+            Chain::Task* task = m_tasks[top & m_mask].load(std::memory_order_relaxed);
+            
+            if(!m_top.compare_exchange_strong(top, top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            
+            return task;
+        }
+        
+        // ==================================================================================== //
+        //                                THREAD POOL::SEMAPHORE                                //
+        // ==================================================================================== //
+        
+        //! @brief A counting semaphore that only calls the system when a thread sleeps.
+        //! @details The count is an atomic integer, negative when threads wait, so posting never
+        //! locks and only wakes up the threads of the system semaphore that actually sleep.
+        class ThreadPool::Semaphore final
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            Semaphore() :
+            m_count(0)
+            {
+                #if defined(__APPLE__)
+                m_semaphore = dispatch_semaphore_create(0);
+                #elif defined(_WIN32)
+                m_semaphore = CreateSemaphore(nullptr, 0, LONG_MAX, nullptr);
+                #else
+                sem_init(&m_semaphore, 0, 0);
+                #endif
+            }
+            
+            //! @brief Destructor.
+            ~Semaphore()
+            {
+                #if defined(__APPLE__)
+                dispatch_release(m_semaphore);
+                #elif defined(_WIN32)
+                CloseHandle(m_semaphore);
+                #else
+                sem_destroy(&m_semaphore);
+                #endif
+            }
+            
+            //! @brief Increments the count and wakes up as many waiting threads.
+            void post(size_t count) noexcept
+            {
+                const int64_t previous = m_count.fetch_add(static_cast<int64_t>(count),
+                                                           std::memory_order_release);
+                
+                for(int64_t i = previous; i < 0 && i < previous + static_cast<int64_t>(count); ++i)
+                {
+                    #if defined(__APPLE__)
+                    dispatch_semaphore_signal(m_semaphore);
+                    #elif defined(_WIN32)
+                    ReleaseSemaphore(m_semaphore, 1, nullptr);
+                    #else
+                    sem_post(&m_semaphore);
+                    #endif
+                }
+            }
+            
+            //! @brief Decrements the count, sleeps if it was not positive after a short spin.
+            void wait() noexcept
+            {
+                for(size_t i = 0; i < spin_count; ++i)
+                {
+                    int64_t count = m_count.load(std::memory_order_relaxed);
+                    
+                    if(count > 0 && m_count.compare_exchange_weak(count, count - 1,
+                                                                   std::memory_order_acquire,
+                                                                   std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                }
+                
+                if(m_count.fetch_sub(1, std::memory_order_acquire) <= 0)
+                {
+                    #if defined(__APPLE__)
+                    dispatch_semaphore_wait(m_semaphore, DISPATCH_TIME_FOREVER);
+                    #elif defined(_WIN32)
+                    WaitForSingleObject(m_semaphore, INFINITE);
+                    #else
+                    while(sem_wait(&m_semaphore) != 0) {}
+                    #endif
+                }
+            }
+        
+        private: // members
+            
+            //! @brief The number of tries before sleeping.
+            static const size_t spin_count = 1024;
+            
+            std::atomic<int64_t>            m_count;
+            
+            #if defined(__APPLE__)
+            dispatch_semaphore_t            m_semaphore;
+            #elif defined(_WIN32)
+            HANDLE                          m_semaphore;
+            #else
+            sem_t                           m_semaphore;
+            #endif
+        };
+        
+        // ==================================================================================== //
+        //                                     THREAD POOL                                      //
+        // ==================================================================================== //
+        
+        //! @brief The number of tasks a queue can hold before they're performed directly.
+        static const size_t queue_capacity = 4096;
+        
+        ThreadPool::ThreadPool(size_t number_of_threads) :
+        m_queues(),
+        m_threads(),
+        m_schedules(),
+        m_semaphore(new Semaphore()),
+        m_remaining(0),
+        m_running(true),
+        m_tick_thread(),
+        m_policy(0),
+        m_priority(0),
+        m_priority_version(0)
+        {
+            for(size_t i = 0; i <= number_of_threads; ++i)
+            {
+                m_queues.emplace_back(new Queue(queue_capacity));
+            }
+            
+            for(size_t i = 1; i <= number_of_threads; ++i)
+            {
+                m_threads.emplace_back(&ThreadPool::run, this, i);
+            }
+        }
+        
+        ThreadPool::~ThreadPool()
+        {
+            m_running.store(false);
+            
+            m_semaphore->post(m_threads.size());
+            
+            for(std::thread& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+        
+        size_t ThreadPool::getNumberOfThreads() const noexcept
+        {
+            return m_threads.size();
+        }
+        
+        void ThreadPool::reserve(size_t number_of_chains)
+        {
+            m_schedules.reserve(number_of_chains);
+        }
+        
+        void ThreadPool::tick(std::vector<Chain*> const& chains) noexcept
+        {
+            size_t number_of_tasks = 0;
+            Chain::Task* last_sequential = nullptr;
+            
+            const SampleClock::time_point_t time = SampleClock::clock_t::now();
+            
+            publishPriority();
+            
+            // ======================================================================== //
+            //                               RESET TASKS                                //
+            // ======================================================================== //
+            
+            for(Chain* chain : chains)
+            {
+                chain->m_tick_count.fetch_add(1);
+                
+                Chain::Schedule* schedule = chain->m_tick_schedule.load();
+                
+                if(schedule == nullptr)
+                    continue;
+                
+                chain->m_sample_clock.tick(time, schedule->m_sample_rate, schedule->m_vector_size);
+                
+                if(schedule->m_tasks.empty())
+                    continue;
+                
+                m_schedules.push_back(schedule);
+                
+                for(Chain::Task& task : schedule->m_tasks)
+                {
+                    task.m_pending.store(task.m_dependencies, std::memory_order_relaxed);
+                }
+                
+                // sequential tasks of a chain are performed after the ones of the previous chains.
+                
+                if(schedule->m_first_sequential != nullptr)
+                {
+                    schedule->m_last_sequential->m_next_sequential = nullptr;
+                    
+                    if(last_sequential != nullptr)
+                    {
+                        last_sequential->m_next_sequential = schedule->m_first_sequential;
+                        schedule->m_first_sequential->m_pending.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    
+                    last_sequential = schedule->m_last_sequential;
+                }
+                
+                number_of_tasks += schedule->m_tasks.size();
+            }
+            
+            // ======================================================================== //
+            //                              PERFORM TASKS                               //
+            // ======================================================================== //
+            
+            if(number_of_tasks > 0)
+            {
+                m_remaining.store(number_of_tasks);
+                
+                m_semaphore->post(m_threads.size());
+                
+                for(Chain::Schedule* schedule : m_schedules)
+                {
+                    for(Chain::Task& task : schedule->m_tasks)
+                    {
+                        if(task.m_pending.load(std::memory_order_relaxed) == 0)
+                        {
+                            push(task, 0);
+                        }
+                    }
+                }
+                
+                performTasks(0);
+            }
+            
+            m_schedules.clear();
+            
+            for(Chain* chain : chains)
+            {
+                chain->m_tick_count.fetch_add(1);
+            }
+        }
+        
+        void ThreadPool::publishPriority() noexcept
+        {
+            const std::thread::id thread = std::this_thread::get_id();
+            
+            if(thread == m_tick_thread)
+                return;
+            
+            m_tick_thread = thread;
+            
+            #if defined(__APPLE__) || defined(__linux__)
+            int policy = 0;
+            sched_param param;
+            
+            if(pthread_getschedparam(pthread_self(), &policy, &param) == 0)
+            {
+                m_policy.store(policy);
+                m_priority.store(param.sched_priority);
+                m_priority_version.fetch_add(1, std::memory_order_release);
+            }
+            #endif
+        }
+        
+        void ThreadPool::applyPriority(size_t& version) noexcept
+        {
+            const size_t current = m_priority_version.load(std::memory_order_acquire);
+            
+            if(current == version)
+                return;
+            
+            version = current;
+            
+            #if defined(__APPLE__) || defined(__linux__)
+            sched_param param;
+            param.sched_priority = m_priority.load();
+            pthread_setschedparam(pthread_self(), m_policy.load(), &param);
+            #endif
+        }
+        
+        void ThreadPool::run(size_t index)
+        {
+            size_t priority_version = 0;
+            
+            // each tick posts one token per worker, a worker only sleeps once its tasks are done.
+            
+            while(m_running.load())
+            {
+                applyPriority(priority_version);
+                
+                performTasks(index);
+                
+                m_semaphore->wait();
+            }
+        }
+        
+        void ThreadPool::performTasks(size_t index) noexcept
+        {
+            const size_t number_of_queues = m_queues.size();
+            
+            while(m_remaining.load(std::memory_order_acquire) > 0)
+            {
+                Chain::Task* task = m_queues[index]->pop();
+                
+                for(size_t i = 1; task == nullptr && i < number_of_queues; ++i)
+                {
+                    task = m_queues[(index + i) % number_of_queues]->steal();
+                }
+                
+                if(task != nullptr)
+                {
+                    performTask(*task, index);
+                }
+            }
+        }
+        
+        void ThreadPool::performTask(Chain::Task& task, size_t index) noexcept
+        {
+            task.m_node->perform();
+            
+            for(Chain::Task* successor : task.m_successors)
+            {
+                if(successor->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    push(*successor, index);
+                }
+            }
+            
+            if(Chain::Task* next = task.m_next_sequential)
+            {
+                if(next->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    push(*next, index);
+                }
+            }
+            
+            // the tasks of the tick must not be accessed once they're all performed.
+            
+            m_remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        
+        void ThreadPool::push(Chain::Task& task, size_t index) noexcept
+        {
+            if(!m_queues[index]->push(&task))
+            {
+                performTask(task, index);
+            }
+        }
+    }
+}
@@ -0,0 +1,159 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <thread>
+
+#include "KiwiDsp_Chain.h"
+
+namespace kiwi
+{
+    namespace dsp
+    {
+        // ==================================================================================== //
+        //                                     THREAD POOL                                      //
+        // ==================================================================================== //
+        
+        //! @brief Performs chains on a fixed set of worker threads.
+        //! @details The nodes of the chains are performed as soon as the nodes they depend on are
+        //! performed. Each worker holds a lock-free queue of ready nodes and steals nodes from the
+        //! queues of the other workers when its own is empty. The thread calling tick takes part in
+        //! the computation. Since a node is always performed after its parents and sequential
+        //! processors one after the other, the result doesn't depend on the threads. The thread
+        //! calling tick never locks a mutex nor allocates memory as long as enough chains have
+        //! been reserved, and the workers never run with a higher priority than this thread.
+        //! @see Chain::setParallel, Processor::setSequential
+        class ThreadPool final
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @details Starts the worker threads. The workers take the scheduling policy and
+            //! the priority of the thread calling tick once it starts ticking.
+            //! @param number_of_threads The number of threads added to the one calling tick.
+            ThreadPool(size_t number_of_threads);
+            
+            //! @brief Destructor.
+            //! @details Stops and joins the worker threads. Shall not be called during tick.
+            ~ThreadPool();
+            
+            //! @brief Returns the number of worker threads.
+            size_t getNumberOfThreads() const noexcept;
+            
+            //! @brief Reserves the memory to tick a number of chains at once.
+            //! @details Shall be called whenever the list of ticked chains grows, but not during
+            //! tick. Ticking more chains allocates memory on the thread calling tick.
+            void reserve(size_t number_of_chains);
+            
+            //! @brief Ticks once all the chains.
+            //! @details Returns when all the nodes of the chains have been performed. Chains can be
+            //! prepared, released and updated concurrently as with Chain::tick. Tick shall only be
+            //! called by one thread at a time and a chain shall not be ticked by other means meanwhile.
+            void tick(std::vector<Chain*> const& chains) noexcept;
+        
+        private: // classes
+            
+            class Queue;
+            class Semaphore;
+        
+        private: // methods
+            
+            //! @brief The function of the worker threads.
+            void run(size_t index);
+            
+            //! @brief Shares the priority of the thread calling tick with the workers.
+            //! @details Only reads the priority when tick is called by another thread.
+            void publishPriority() noexcept;
+            
+            //! @brief Gives the calling worker the priority of the thread calling tick.
+            void applyPriority(size_t& version) noexcept;
+            
+            //! @brief Performs ready tasks until all the tasks of the current tick are performed.
+            void performTasks(size_t index) noexcept;
+            
+            //! @brief Performs a task and schedules the tasks that become ready.
+            void performTask(Chain::Task& task, size_t index) noexcept;
+            
+            //! @brief Adds a ready task to a queue or performs it if the queue is full.
+            void push(Chain::Task& task, size_t index) noexcept;
+        
+        private: // members
+            
+            std::vector<std::unique_ptr<Queue>>     m_queues;
+            std::vector<std::thread>                m_threads;
+            std::vector<Chain::Schedule*>           m_schedules;
+            std::unique_ptr<Semaphore>              m_semaphore;
+            std::atomic<size_t>                     m_remaining;
+            std::atomic<bool>                       m_running;
+            std::thread::id                         m_tick_thread;
+            std::atomic<int>                        m_policy;
+            std::atomic<int>                        m_priority;
+            std::atomic<size_t>                     m_priority_version;
+        
+        private: // deleted methods
+            
+            ThreadPool(ThreadPool const& other) = delete;
+            ThreadPool(ThreadPool && other) = delete;
+            ThreadPool& operator=(ThreadPool const& other) = delete;
+            ThreadPool& operator=(ThreadPool && other) = delete;
+        };
+        
+        // ==================================================================================== //
+        //                                  THREAD POOL::QUEUE                                  //
+        // ==================================================================================== //
+        
+        //! @brief A bounded work-stealing deque of tasks.
+        //! @details The owner pushes and pops tasks at the bottom, the other threads steal tasks
+        //! at the top (Chase-Lev deque).
+        class ThreadPool::Queue final
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @param capacity The maximum number of tasks, must be a power of two.
+            Queue(size_t capacity);
+            
+            //! @brief Destructor.
+            ~Queue() = default;
+            
+            //! @brief Adds a task at the bottom. Called by the owner only.
+            //! @return false if the queue is full.
+            bool push(Chain::Task* task) noexcept;
+            
+            //! @brief Removes the task at the bottom. Called by the owner only.
+            //! @return nullptr if the queue is empty.
+            Chain::Task* pop() noexcept;
+            
+            //! @brief Removes the task at the top. Called by the other threads.
+            //! @return nullptr if the queue is empty or if the task was taken concurrently.
+            Chain::Task* steal() noexcept;
+        
+        private: // members
+            
+            const int64_t                                   m_mask;
+            std::unique_ptr<std::atomic<Chain::Task*>[]>    m_tasks;
+            std::atomic<int64_t>                            m_top;
+            std::atomic<int64_t>                            m_bottom;
+        };
+    }
+}
@@ -19,6 +19,9 @@
  ==============================================================================
  */
 
+#include <algorithm>
+#include <chrono>
+
 #include "KiwiEngine_Console.h"
 
 namespace kiwi
@@ -29,9 +32,87 @@ namespace kiwi
         //                                      CONSOLE                                     //
         // ================================================================================ //
         
-        void Console::post(Message const& mess) const
+        Console::Console(size_t capacity, size_t rate_limit):
+        m_queue(capacity),
+        m_rate_limit(rate_limit),
+        m_suppressed(0),
+        m_batch(),
+        m_listeners()
+        {
+            m_batch.reserve(m_queue.capacity());
+        }
+        
+        void Console::post(Message const& mess, RateLimit* rate_limit) const
+        {
+            if(!acquire(rate_limit) || !m_queue.push(mess))
+            {
+                m_suppressed.fetch_add(1);
+            }
+        }
+        
+        size_t Console::process(size_t max_messages)
+        {
+            m_batch.clear();
+            
+            Message message;
+            
+            while(m_batch.size() < max_messages && m_queue.pop(message))
+            {
+                m_batch.emplace_back(std::move(message));
+            }
+            
+            if(!m_batch.empty())
+            {
+                m_listeners.call(&Listener::newConsoleMessages, m_batch);
+            }
+            
+            return m_batch.size();
+        }
+        
+        void Console::setRateLimit(size_t rate_limit)
+        {
+            m_rate_limit.store(rate_limit);
+        }
+        
+        uint64_t Console::getNumberOfSuppressedMessages() const
+        {
+            return m_suppressed.load();
+        }
+        
+        bool Console::acquire(RateLimit* rate_limit) const
         {
-            m_listeners.call(&Listener::newConsoleMessage, mess);
+            const uint64_t mask = 0xFFFFFFFFull;
+            const uint64_t limit = std::min<uint64_t>(m_rate_limit.load(), mask);
+            
+            if(rate_limit == nullptr || limit == 0)
+            {
+                return true;
+            }
+            
+            const uint64_t second = std::chrono::duration_cast<std::chrono::seconds>
+            (std::chrono::steady_clock::now().time_since_epoch()).count() & mask;
+            
+            uint64_t state = rate_limit->m_state.load();
+            
+            while(true)
+            {
+                uint64_t next = state + 1;
+                
+                if((state >> 32) != second)
+                {
+                    // a new second starts with this message.
+                    next = (second << 32) | 1;
+                }
+                else if((state & mask) >= limit)
+                {
+                    return false;
+                }
+                
+                if(rate_limit->m_state.compare_exchange_weak(state, next))
+                {
+                    return true;
+                }
+            }
         }
         
         void Console::addListener(Listener& listener)
@@ -21,8 +21,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <vector>
+
 #include <KiwiTool/KiwiTool_Atom.h>
 #include <KiwiTool/KiwiTool_Listeners.h>
+#include <KiwiTool/KiwiTool_BoundedQueue.h>
 
 namespace kiwi
 {
@@ -33,12 +37,17 @@ namespace kiwi
         // ================================================================================ //
         
         //! @brief The console is an interface that let you print messages.
+        //! @details The messages are posted from any thread in a bounded queue without blocking,
+        //! they are dispatched to the listeners by batches when the console is processed.
+        //! A message is suppressed if the queue is full or if its source posts too many messages.
         class Console
         {
         public: // methods
             
             //! @brief Constructor
-            Console() = default;
+            //! @param capacity The maximum number of messages waiting to be processed.
+            //! @param rate_limit The maximum number of messages per second of a source.
+            Console(size_t capacity = 4096, size_t rate_limit = 200);
             
             //! @brief Destructor
             ~Console() = default;
@@ -61,8 +70,39 @@ namespace kiwi
                 Type        type;
             };
             
+            //! @brief The number of messages posted by a source during the current second.
+            //! @details Each source holds its own rate limit and passes it to post.
+            class RateLimit
+            {
+            public:
+                
+                RateLimit() = default;
+                ~RateLimit() = default;
+                
+            private:
+                
+                friend class Console;
+                
+                // the second in the high bits and the count in the low bits, updated together.
+                std::atomic<uint64_t> m_state {0};
+            };
+            
             //! @brief Print a post-type message in the console.
-            void post(Message const& mess) const;
+            //! @details Never blocks, the rate limit of the source is used to limit the rate of
+            //! its messages, messages without rate limit are not limited.
+            void post(Message const& mess, RateLimit* rate_limit = nullptr) const;
+            
+            //! @brief Dispatches the messages posted to the listeners.
+            //! @details Shall be called by a single thread, at most max_messages are dispatched.
+            //! @return The number of messages dispatched.
+            size_t process(size_t max_messages);
+            
+            //! @brief Sets the maximum number of messages per second of a source.
+            //! @details Zero disables the limit.
+            void setRateLimit(size_t rate_limit);
+            
+            //! @brief Returns the number of messages suppressed since the console's creation.
+            uint64_t getNumberOfSuppressedMessages() const;
             
             // ================================================================================ //
             //                                 CONSOLE LISTENER                                 //
@@ -74,8 +114,8 @@ namespace kiwi
             public:
                 virtual ~Listener() = default;
                 
-                //! @brief Receive the Console messages.
-                virtual void newConsoleMessage(Console::Message const& message) = 0;
+                //! @brief Receive a batch of Console messages.
+                virtual void newConsoleMessages(std::vector<Console::Message> const& messages) = 0;
             };
             
             //! @brief Adds a Console listener.
@@ -84,9 +124,18 @@ namespace kiwi
             //! @brief Removes a Console listener.
             void removeListener(Listener& listener);
             
+        private: // methods
+            
+            //! @internal Returns true if the source can post a message now.
+            bool acquire(RateLimit* rate_limit) const;
+            
         private: // members
             
-            tool::Listeners<Listener>  m_listeners;
+            mutable tool::BoundedQueue<Message> m_queue;
+            std::atomic<size_t>                 m_rate_limit;
+            mutable std::atomic<uint64_t>       m_suppressed;
+            std::vector<Message>                m_batch;
+            tool::Listeners<Listener>           m_listeners;
         };
     }
 }
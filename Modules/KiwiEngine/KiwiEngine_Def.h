@@ -48,5 +48,7 @@ namespace kiwi
         class Object;
         class Patcher;
         class Instance;
+        class DiskThreadPool;
+        class FaustFactoryCache;
     }
 }
@@ -0,0 +1,72 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <algorithm>
+
+#include "KiwiEngine_DiskThreadPool.h"
+
+namespace kiwi
+{
+    namespace engine
+    {
+        // ================================================================================ //
+        //                                  DISK THREAD POOL                                //
+        // ================================================================================ //
+        
+        DiskThreadPool::DiskThreadPool(size_t number_of_threads) :
+        m_threads(),
+        m_mutex()
+        {
+            for(size_t i = 0; i < std::max<size_t>(number_of_threads, 1); ++i)
+            {
+                m_threads.emplace_back(new juce::TimeSliceThread("Kiwi Disk Thread " + juce::String(i + 1)));
+                m_threads.back()->startThread();
+            }
+        }
+        
+        DiskThreadPool::~DiskThreadPool()
+        {
+            for(auto& thread : m_threads)
+            {
+                thread->stopThread(1000);
+            }
+        }
+        
+        juce::TimeSliceThread& DiskThreadPool::getThread()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            
+            auto it = std::min_element(m_threads.begin(), m_threads.end(),
+                                       [](std::unique_ptr<juce::TimeSliceThread> const& lhs,
+                                          std::unique_ptr<juce::TimeSliceThread> const& rhs)
+            {
+                return lhs->getNumClients() < rhs->getNumClients();
+            });
+            
+            return **it;
+        }
+        
+        size_t DiskThreadPool::getNumberOfThreads() const
+        {
+            return m_threads.size();
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+namespace kiwi
+{
+    namespace engine
+    {
+        // ================================================================================ //
+        //                                  DISK THREAD POOL                                //
+        // ================================================================================ //
+        
+        //! @brief A set of threads shared by the objects that read or write files while playing.
+        //! @details Objects register their juce::TimeSliceClient to one of the threads so that
+        //! disk accesses never happen on the audio thread.
+        class DiskThreadPool
+        {
+        public: // methods
+            
+            //! @brief Constructor, starts the threads.
+            DiskThreadPool(size_t number_of_threads);
+            
+            //! @brief Destructor, stops the threads.
+            //! @details All the clients shall have been removed from the threads.
+            ~DiskThreadPool();
+            
+            //! @brief Returns the thread that currently has the fewest clients.
+            juce::TimeSliceThread& getThread();
+            
+            //! @brief Returns the number of threads.
+            size_t getNumberOfThreads() const;
+            
+        private: // members
+            
+            std::vector<std::unique_ptr<juce::TimeSliceThread>> m_threads;
+            std::mutex                                          m_mutex;
+            
+        private: // deleted methods
+            
+            DiskThreadPool(DiskThreadPool const&) = delete;
+            DiskThreadPool(DiskThreadPool&&) = delete;
+            DiskThreadPool& operator=(DiskThreadPool const&) = delete;
+            DiskThreadPool& operator=(DiskThreadPool&&) = delete;
+        };
+    }
+}
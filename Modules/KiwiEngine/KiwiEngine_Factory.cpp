@@ -32,12 +32,22 @@ namespace kiwi
         //                                      FACTORY                                     //
         // ================================================================================ //
         
-        std::map<std::string, Factory::ctor_fn_t> Factory::m_creators;
+        std::unordered_map<std::string, Factory::ctor_fn_t> Factory::m_creators;
+        std::unordered_map<model::ObjectClass const*, Factory::ctor_fn_t> Factory::m_class_creators;
+        
+        void Factory::index(std::string const& name, ctor_fn_t create_method)
+        {
+            m_class_creators[model::Factory::getClassByName(name, true)] = create_method;
+            m_creators[name] = std::move(create_method);
+        }
         
         std::unique_ptr<Object> Factory::create(Patcher& patcher, model::Object const& model)
         {
-            assert(m_creators.count(model.getName()) != 0 && "The object has not been registered.");
-            return m_creators[model.getName()](model, patcher);
+            // the class is found by type id, the name doesn't need to be hashed.
+            auto creator = m_class_creators.find(&model.getClass());
+            
+            assert(creator != m_class_creators.end() && "The object has not been registered.");
+            return creator->second(model, patcher);
         }
         
         bool Factory::has(std::string const& name)
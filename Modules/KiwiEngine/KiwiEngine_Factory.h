@@ -22,7 +22,7 @@
 #pragma once
 
 #include <functional>
-#include <map>
+#include <unordered_map>
 #include <string>
 #include <memory>
 
@@ -67,7 +67,7 @@ namespace kiwi
                 
                 assert(m_creators.count(name) == 0 && "The object already exists");
                 
-                m_creators[name] = create_method;
+                index(name, std::move(create_method));
             }
             
             //! @brief Creates a new engine Object.
@@ -83,8 +83,12 @@ namespace kiwi
         private: // methods
             
             static bool modelHasObject(std::string const& name);
+            
+            //! @internal Stores the constructor by name and by model class.
+            static void index(std::string const& name, ctor_fn_t create_method);
         
-            static std::map<std::string, ctor_fn_t> m_creators;
+            static std::unordered_map<std::string, ctor_fn_t> m_creators;
+            static std::unordered_map<model::ObjectClass const*, ctor_fn_t> m_class_creators;
             
         private: // deleted methods
             
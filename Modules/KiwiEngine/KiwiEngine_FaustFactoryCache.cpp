@@ -0,0 +1,321 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <algorithm>
+
+#include <faust/dsp/llvm-dsp.h>
+
+#include "KiwiEngine_FaustFactoryCache.h"
+
+namespace kiwi
+{
+    namespace engine
+    {
+        // ================================================================================ //
+        //                                FAUST FACTORY CACHE                               //
+        // ================================================================================ //
+        
+        FaustFactoryCache::FaustFactoryCache(size_t number_of_threads, juce::File const& directory,
+                                             juce::int64 max_directory_size) :
+        m_directory(directory),
+        m_max_directory_size(max_directory_size),
+        m_multi_thread(startMTDSPFactories()),
+        m_directory_mutex(),
+        m_mutex(),
+        m_entries(),
+        m_pool(static_cast<int>(std::max<size_t>(number_of_threads, 1)), compile_stack_size)
+        {
+        }
+        
+        FaustFactoryCache::~FaustFactoryCache()
+        {
+            // a compilation can't be interrupted.
+            m_pool.removeAllJobs(false, -1);
+            
+            if(m_multi_thread)
+            {
+                stopMTDSPFactories();
+            }
+        }
+        
+        void FaustFactoryCache::compile(std::string const& code,
+                                        std::vector<std::string> const& options,
+                                        callback_t callback)
+        {
+            if(!m_multi_thread)
+            {
+                callback({nullptr, "can't start multi-thread access", false});
+                return;
+            }
+            
+            std::string description = getDescription(code, options);
+            std::string key = getKey(description);
+            
+            std::unique_lock<std::mutex> lock(m_mutex);
+            
+            if(m_entries.find(key) == m_entries.end())
+            {
+                prune();
+            }
+            
+            Entry& entry = m_entries[key];
+            
+            if(factory_t factory = entry.factory.lock())
+            {
+                lock.unlock();
+                callback({factory, std::string(), true});
+                return;
+            }
+            
+            entry.callbacks.emplace_back(std::move(callback));
+            
+            if(!entry.compiling)
+            {
+                entry.compiling = true;
+                
+                m_pool.addJob([this, key, description, code, options]()
+                {
+                    run(key, description, code, options);
+                });
+            }
+        }
+        
+        void FaustFactoryCache::run(std::string const& key, std::string const& description,
+                                    std::string const& code, std::vector<std::string> const& options)
+        {
+            std::string errors;
+            bool cached = true;
+            
+            factory_t factory = load(key, description);
+            
+            if(!factory)
+            {
+                cached = false;
+                
+                std::vector<char const*> argv(options.size());
+                for(size_t i = 0; i < options.size(); ++i)
+                {
+                    argv[i] = options[i].c_str();
+                }
+                
+                llvm_dsp_factory* nfactory = createDSPFactoryFromString("kiwi" + key, code,
+                                                                       static_cast<int>(argv.size()), argv.data(),
+                                                                       std::string(), errors);
+                
+                if(nfactory != nullptr && errors.empty())
+                {
+                    factory = factory_t(nfactory, deleteDSPFactory);
+                    save(key, description, factory);
+                }
+                else if(nfactory != nullptr)
+                {
+                    deleteDSPFactory(nfactory);
+                }
+            }
+            
+            std::vector<callback_t> callbacks;
+            
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                
+                Entry& entry = m_entries[key];
+                callbacks.swap(entry.callbacks);
+                
+                if(factory)
+                {
+                    entry.compiling = false;
+                    entry.factory = factory;
+                }
+                else
+                {
+                    // a failed compilation is retried the next time.
+                    m_entries.erase(key);
+                }
+            }
+            
+            const Result result {factory, errors, cached};
+            
+            for(auto& callback : callbacks)
+            {
+                callback(result);
+            }
+        }
+        
+        FaustFactoryCache::factory_t FaustFactoryCache::load(std::string const& key, std::string const& description) const
+        {
+            const juce::File machine_file = m_directory.getChildFile(key + ".fbc");
+            const juce::File description_file = m_directory.getChildFile(key + ".dsp");
+            
+            // the description is compared byte per byte to avoid collisions of the hashes.
+            
+            juce::MemoryBlock saved_description;
+            
+            if(!machine_file.existsAsFile()
+               || !description_file.loadFileAsData(saved_description)
+               || saved_description.getSize() != description.size()
+               || !std::equal(description.begin(), description.end(),
+                              static_cast<char const*>(saved_description.getData())))
+            {
+                return nullptr;
+            }
+            
+            std::string errors;
+            llvm_dsp_factory* factory = readDSPFactoryFromMachineFile(machine_file.getFullPathName().toStdString(),
+                                                                      getDSPMachineTarget(), errors);
+            
+            if(factory == nullptr)
+            {
+                return nullptr;
+            }
+            
+            // the access time orders the eviction of the directory.
+            machine_file.setLastAccessTime(juce::Time::getCurrentTime());
+            
+            return factory_t(factory, deleteDSPFactory);
+        }
+        
+        void FaustFactoryCache::save(std::string const& key, std::string const& description, factory_t const& factory) const
+        {
+            if(!m_directory.createDirectory())
+            {
+                return;
+            }
+            
+            const juce::File machine_file = m_directory.getChildFile(key + ".fbc");
+            const juce::File description_file = m_directory.getChildFile(key + ".dsp");
+            
+            // the description is written last, a factory is only loaded if it matches.
+            description_file.deleteFile();
+            
+            if(writeDSPFactoryToMachineFile(factory.get(), machine_file.getFullPathName().toStdString(),
+                                            getDSPMachineTarget()))
+            {
+                // the bytes are written unchanged so that the line endings of the code match.
+                description_file.replaceWithData(description.data(), description.size());
+                
+                trim(key);
+            }
+        }
+        
+        void FaustFactoryCache::trim(std::string const& key) const
+        {
+            std::lock_guard<std::mutex> lock(m_directory_mutex);
+            
+            struct SavedFactory
+            {
+                juce::File  machine_file;
+                juce::File  description_file;
+                juce::int64 size;
+                juce::Time  access_time;
+            };
+            
+            std::vector<SavedFactory> saved_factories;
+            juce::int64 directory_size = 0;
+            
+            juce::DirectoryIterator iter(m_directory, false, "*.fbc", juce::File::findFiles);
+            
+            while(iter.next())
+            {
+                const juce::File machine_file = iter.getFile();
+                const juce::File description_file = machine_file.withFileExtension("dsp");
+                const juce::int64 size = machine_file.getSize() + description_file.getSize();
+                
+                directory_size += size;
+                
+                if(machine_file.getFileNameWithoutExtension().toStdString() != key)
+                {
+                    saved_factories.push_back({machine_file, description_file, size,
+                                               machine_file.getLastAccessTime()});
+                }
+            }
+            
+            if(directory_size <= m_max_directory_size)
+            {
+                return;
+            }
+            
+            std::sort(saved_factories.begin(), saved_factories.end(),
+                      [](SavedFactory const& lhs, SavedFactory const& rhs)
+            {
+                return lhs.access_time < rhs.access_time;
+            });
+            
+            for(auto const& saved_factory : saved_factories)
+            {
+                if(directory_size <= m_max_directory_size)
+                {
+                    break;
+                }
+                
+                // the description goes first, a machine file without it is never loaded.
+                
+                if(saved_factory.description_file.deleteFile() && saved_factory.machine_file.deleteFile())
+                {
+                    directory_size -= saved_factory.size;
+                }
+            }
+        }
+        
+        void FaustFactoryCache::prune()
+        {
+            for(auto it = m_entries.begin(); it != m_entries.end();)
+            {
+                if(!it->second.compiling && it->second.factory.expired())
+                {
+                    it = m_entries.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        
+        std::string FaustFactoryCache::getDescription(std::string const& code, std::vector<std::string> const& options)
+        {
+            std::string description = std::string(getCLibFaustVersion()) + '\n' + getDSPMachineTarget() + '\n';
+            
+            for(auto const& option : options)
+            {
+                description += option + '\n';
+            }
+            
+            return description + '\n' + code;
+        }
+        
+        std::string FaustFactoryCache::getKey(std::string const& description)
+        {
+            // two 64-bit FNV-1a hashes with different offsets.
+            uint64_t first = 14695981039346656037ull;
+            uint64_t second = 1099511628211ull * 31ull;
+            
+            for(unsigned char c : description)
+            {
+                first = (first ^ c) * 1099511628211ull;
+                second = (second ^ c) * 1099511628211ull;
+            }
+            
+            return juce::String::toHexString(static_cast<juce::int64>(first)).paddedLeft('0', 16).toStdString()
+            + juce::String::toHexString(static_cast<juce::int64>(second)).paddedLeft('0', 16).toStdString();
+        }
+    }
+}
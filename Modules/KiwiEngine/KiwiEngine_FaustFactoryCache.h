@@ -0,0 +1,145 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <juce_core/juce_core.h>
+
+class llvm_dsp_factory;
+
+namespace kiwi
+{
+    namespace engine
+    {
+        // ================================================================================ //
+        //                                FAUST FACTORY CACHE                               //
+        // ================================================================================ //
+        
+        //! @brief Compiles the FAUST factories in the background and shares them between objects.
+        //! @details The factories are identified by a hash of their code, compile options and
+        //! target. A factory still used by an object is shared by the objects with the same code,
+        //! and the objects that ask for a factory being compiled wait for the same compilation.
+        //! Compiled factories are saved as machine code in a directory so that they are loaded
+        //! instead of compiled the next time, the least recently used ones are removed when the
+        //! directory exceeds a maximum size.
+        class FaustFactoryCache
+        {
+        public: // classes
+            
+            using factory_t = std::shared_ptr<llvm_dsp_factory>;
+            
+            //! @brief The result of a compilation.
+            struct Result
+            {
+                factory_t   factory;
+                std::string errors;
+                bool        cached;
+            };
+            
+            using callback_t = std::function<void(Result const&)>;
+            
+        public: // methods
+            
+            //! @brief Constructor, starts the compile threads.
+            //! @param number_of_threads The number of compilations that can run concurrently.
+            //! @param directory The directory where the machine code of the factories is saved.
+            //! @param max_directory_size The size in bytes beyond which saved factories are removed.
+            FaustFactoryCache(size_t number_of_threads, juce::File const& directory,
+                              juce::int64 max_directory_size = default_max_directory_size);
+            
+            //! @brief Destructor, waits for the running compilations.
+            ~FaustFactoryCache();
+            
+            //! @brief Gets the factory of some FAUST code.
+            //! @details If a factory with the same code and options is in memory the callback is
+            //! called immediately, otherwise it's called on a compile thread once the factory has
+            //! been loaded from the directory or compiled.
+            void compile(std::string const& code,
+                         std::vector<std::string> const& options,
+                         callback_t callback);
+            
+        private: // classes
+            
+            //! @internal A factory, compiled or being compiled.
+            struct Entry
+            {
+                std::weak_ptr<llvm_dsp_factory>     factory {};
+                bool                                compiling = false;
+                std::vector<callback_t>             callbacks {};
+            };
+            
+        private: // methods
+            
+            //! @internal Loads or compiles a factory, called on a compile thread.
+            void run(std::string const& key, std::string const& description,
+                     std::string const& code, std::vector<std::string> const& options);
+            
+            //! @internal Loads a factory from the directory.
+            factory_t load(std::string const& key, std::string const& description) const;
+            
+            //! @internal Saves the machine code of a factory in the directory.
+            void save(std::string const& key, std::string const& description, factory_t const& factory) const;
+            
+            //! @internal Removes the least recently used factories until the directory fits its
+            //! maximum size, the factory of a key is kept.
+            void trim(std::string const& key) const;
+            
+            //! @internal Removes the entries whose factory is no longer used, called with the mutex.
+            void prune();
+            
+            //! @internal Returns the text that identifies a factory.
+            static std::string getDescription(std::string const& code, std::vector<std::string> const& options);
+            
+            //! @internal Returns the hash of a description.
+            static std::string getKey(std::string const& description);
+            
+        private: // members
+            
+            //! @internal LLVM needs a larger stack than the default one of secondary threads.
+            static constexpr size_t compile_stack_size = 8 * 1024 * 1024;
+            
+            static constexpr juce::int64 default_max_directory_size = 256 * 1024 * 1024;
+            
+            const juce::File                            m_directory;
+            const juce::int64                           m_max_directory_size;
+            const bool                                  m_multi_thread;
+            mutable std::mutex                          m_directory_mutex;
+            std::mutex                                  m_mutex;
+            std::unordered_map<std::string, Entry>      m_entries;
+            juce::ThreadPool                            m_pool;
+            
+        private: // deleted methods
+            
+            FaustFactoryCache(FaustFactoryCache const&) = delete;
+            FaustFactoryCache(FaustFactoryCache&&) = delete;
+            FaustFactoryCache& operator=(FaustFactoryCache const&) = delete;
+            FaustFactoryCache& operator=(FaustFactoryCache&&) = delete;
+        };
+    }
+}
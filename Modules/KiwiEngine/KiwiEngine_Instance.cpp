@@ -34,6 +34,9 @@ namespace kiwi
         m_audio_controler(std::move(audio_controler)),
         m_scheduler(),
         m_main_scheduler(main_scheduler),
+        m_disk_thread_pool(2),
+        m_faust_factory_cache(2, juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                              .getChildFile("Kiwi").getChildFile("FaustCache")),
         m_quit(false),
         m_engine_thread(std::bind(&Instance::processScheduler, this))
         {
@@ -42,6 +45,7 @@ namespace kiwi
         Instance::~Instance()
         {
             m_quit.store(true);
+            m_scheduler.wakeUp();
             m_engine_thread.join();
         }
         
@@ -49,24 +53,24 @@ namespace kiwi
         //                                      CONSOLE                                     //
         // ================================================================================ //
         
-        void Instance::log(std::string const& text) const
+        void Instance::log(std::string const& text, Console::RateLimit* rate_limit) const
         {
-            m_console.post({text, Console::Message::Type::Log});
+            m_console.post({text, Console::Message::Type::Log}, rate_limit);
         }
         
-        void Instance::post(std::string const& text) const
+        void Instance::post(std::string const& text, Console::RateLimit* rate_limit) const
         {
-            m_console.post({text, Console::Message::Type::Normal});
+            m_console.post({text, Console::Message::Type::Normal}, rate_limit);
         }
         
-        void Instance::warning(std::string const& text) const
+        void Instance::warning(std::string const& text, Console::RateLimit* rate_limit) const
         {
-            m_console.post({text, Console::Message::Type::Warning});
+            m_console.post({text, Console::Message::Type::Warning}, rate_limit);
         }
         
-        void Instance::error(std::string const& text) const
+        void Instance::error(std::string const& text, Console::RateLimit* rate_limit) const
         {
-            m_console.post({text, Console::Message::Type::Error});
+            m_console.post({text, Console::Message::Type::Error}, rate_limit);
         }
 
         void Instance::addConsoleListener(Console::Listener& listener)
@@ -79,6 +83,21 @@ namespace kiwi
             m_console.removeListener(listener);
         }
         
+        size_t Instance::processConsole(size_t max_messages)
+        {
+            return m_console.process(max_messages);
+        }
+        
+        void Instance::setConsoleRateLimit(size_t rate_limit)
+        {
+            m_console.setRateLimit(rate_limit);
+        }
+        
+        uint64_t Instance::getNumberOfSuppressedConsoleMessages() const
+        {
+            return m_console.getNumberOfSuppressedMessages();
+        }
+        
         // ================================================================================ //
         //                              AUDIO CONTROLER                                     //
         // ================================================================================ //
@@ -102,15 +121,31 @@ namespace kiwi
             return m_main_scheduler;
         }
         
+        // ================================================================================ //
+        //                              DISK THREAD POOL                                    //
+        // ================================================================================ //
+        
+        DiskThreadPool& Instance::getDiskThreadPool()
+        {
+            return m_disk_thread_pool;
+        }
+        
+        // ================================================================================ //
+        //                              FAUST FACTORY CACHE                                 //
+        // ================================================================================ //
+        
+        FaustFactoryCache& Instance::getFaustFactoryCache()
+        {
+            return m_faust_factory_cache;
+        }
+        
         void Instance::processScheduler()
         {
             m_scheduler.setThreadAsConsumer();
             
             while(!m_quit.load())
             {
-                m_scheduler.process();
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-
+                m_scheduler.waitAndProcess(std::chrono::seconds(1));
             }
         }
     }
@@ -31,6 +31,8 @@
 #include "KiwiEngine_Console.h"
 #include "KiwiEngine_Patcher.h"
 #include "KiwiEngine_AudioControler.h"
+#include "KiwiEngine_DiskThreadPool.h"
+#include "KiwiEngine_FaustFactoryCache.h"
 
 namespace kiwi
 {
@@ -58,16 +60,16 @@ namespace kiwi
             // ================================================================================ //
             
             //! @brief post a log message in the Console.
-            void log(std::string const& text) const;
+            void log(std::string const& text, Console::RateLimit* rate_limit = nullptr) const;
             
             //! @brief post a message in the Console.
-            void post(std::string const& text) const;
+            void post(std::string const& text, Console::RateLimit* rate_limit = nullptr) const;
             
             //! @brief post a warning message in the Console.
-            void warning(std::string const& text) const;
+            void warning(std::string const& text, Console::RateLimit* rate_limit = nullptr) const;
             
             //! @brief post an error message in the Console.
-            void error(std::string const& text) const;
+            void error(std::string const& text, Console::RateLimit* rate_limit = nullptr) const;
             
             //! @brief Adds a console listener.
             void addConsoleListener(Console::Listener& listener);
@@ -75,6 +77,17 @@ namespace kiwi
             //! @brief Removes a console listener.
             void removeConsoleListener(Console::Listener& listener);
             
+            //! @brief Dispatches a batch of the messages posted to the console listeners.
+            //! @details Shall be called by a single thread, usually at the rate of the user interface.
+            //! @return The number of messages dispatched.
+            size_t processConsole(size_t max_messages);
+            
+            //! @brief Sets the maximum number of console messages per second of an object.
+            void setConsoleRateLimit(size_t rate_limit);
+            
+            //! @brief Returns the number of console messages suppressed by the rate limit or a full queue.
+            uint64_t getNumberOfSuppressedConsoleMessages() const;
+            
             // ================================================================================ //
             //                              AUDIO CONTROLER                                     //
             // ================================================================================ //
@@ -91,6 +104,20 @@ namespace kiwi
             //! @brief Returns the main's scheduler.
             tool::Scheduler<> & getMainScheduler();
             
+            // ================================================================================ //
+            //                              DISK THREAD POOL                                    //
+            // ================================================================================ //
+            
+            //! @brief Returns the threads that read and write files for the objects.
+            DiskThreadPool& getDiskThreadPool();
+            
+            // ================================================================================ //
+            //                              FAUST FACTORY CACHE                                 //
+            // ================================================================================ //
+            
+            //! @brief Returns the cache of the FAUST factories compiled in the background.
+            FaustFactoryCache& getFaustFactoryCache();
+            
         private: // methods
             
             //! @internal Processes the scheduler to check if new messages have been added.
@@ -103,6 +130,8 @@ namespace kiwi
             std::unique_ptr<AudioControler> m_audio_controler;
             tool::Scheduler<>               m_scheduler;
             tool::Scheduler<>&              m_main_scheduler;
+            DiskThreadPool                  m_disk_thread_pool;
+            FaustFactoryCache               m_faust_factory_cache;
             std::atomic<bool>               m_quit;
             std::thread                     m_engine_thread;
             
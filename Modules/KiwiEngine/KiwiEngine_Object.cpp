@@ -31,6 +31,58 @@ namespace kiwi
     namespace engine
     {
         
+        // ================================================================================ //
+        //                                    OBJECT TASK                                   //
+        // ================================================================================ //
+        
+        Object::Task::Task(Object& owner)
+        : tool::Scheduler<>::Task()
+        , m_owner(owner.m_master)
+        {
+        }
+        
+        Object::Task::~Task()
+        {
+        }
+        
+        void Object::Task::execute()
+        {
+            if (!m_owner.expired())
+            {
+                perform();
+            }
+        }
+        
+        // ================================================================================ //
+        //                                  OBJECT CALLBACK                                 //
+        // ================================================================================ //
+        
+        //! @brief The task used to schedule a function.
+        class Object::CallBack final : public Object::Task
+        {
+        public: // methods
+            
+            CallBack(Object& owner, std::function<void()> && call_back)
+            : Object::Task(owner)
+            , m_call_back(std::move(call_back))
+            {
+            }
+            
+            ~CallBack() = default;
+            
+        private: // methods
+            
+            void perform() override
+            {
+                m_call_back();
+            }
+            
+        private: // members
+            
+            std::function<void()> m_call_back;
+        };
+        
+        
         // ================================================================================ //
         //                                      OBJECT                                      //
         // ================================================================================ //
@@ -41,6 +93,7 @@ namespace kiwi
         , m_inlets(model.getNumberOfInlets())
         , m_outlets(model.getNumberOfOutlets())
         , m_master(this, [](engine::Object*){})
+        , m_rate_limit()
         {
             getObjectModel().addListener(*this);
         }
@@ -113,22 +166,22 @@ namespace kiwi
         
         void Object::log(std::string const& text) const
         {
-            m_patcher.log(text);
+            m_patcher.log(text, &m_rate_limit);
         }
         
         void Object::post(std::string const& text) const
         {
-            m_patcher.post(text);
+            m_patcher.post(text, &m_rate_limit);
         }
         
         void Object::warning(std::string const& text) const
         {
-            m_patcher.warning(text);
+            m_patcher.warning(text, &m_rate_limit);
         }
         
         void Object::error(std::string const& text) const
         {
-            m_patcher.error(text);
+            m_patcher.error(text, &m_rate_limit);
         }
         
         // ================================================================================ //
@@ -145,52 +198,42 @@ namespace kiwi
             return m_patcher.getMainScheduler();
         }
         
+        DiskThreadPool& Object::getDiskThreadPool() const
+        {
+            return m_patcher.getDiskThreadPool();
+        }
+        
+        FaustFactoryCache& Object::getFaustFactoryCache() const
+        {
+            return m_patcher.getFaustFactoryCache();
+        }
+        
         void Object::defer(std::function<void()> call_back)
         {
-            std::weak_ptr<engine::Object> object(m_master);
+            tool::Scheduler<>& scheduler = getScheduler();
             
-            getScheduler().defer([object, cb = std::move(call_back)]() {
-                if (!object.expired())
-                {
-                    cb();
-                }
-            });
+            scheduler.defer(scheduler.makeTask<CallBack>(*this, std::move(call_back)));
         }
         
         void Object::deferMain(std::function<void()> call_back)
         {
-            std::weak_ptr<engine::Object> object(m_master);
+            tool::Scheduler<>& scheduler = getMainScheduler();
             
-            getMainScheduler().defer([object, cb = std::move(call_back)]() {
-                if (!object.expired())
-                {
-                    cb();
-                }
-            });
+            scheduler.defer(scheduler.makeTask<CallBack>(*this, std::move(call_back)));
         }
         
         void Object::schedule(std::function<void()> call_back, tool::Scheduler<>::duration_t delay)
         {
-            std::weak_ptr<engine::Object> object(m_master);
+            tool::Scheduler<>& scheduler = getScheduler();
             
-            getScheduler().schedule([object, cb = std::move(call_back)]() {
-                if (!object.expired())
-                {
-                    cb();
-                }
-            }, delay);
+            scheduler.schedule(scheduler.makeTask<CallBack>(*this, std::move(call_back)), delay);
         }
         
         void Object::scheduleMain(std::function<void()> call_back, tool::Scheduler<>::duration_t delay)
         {
-            std::weak_ptr<engine::Object> object(m_master);
+            tool::Scheduler<>& scheduler = getMainScheduler();
             
-            getMainScheduler().schedule([object, cb = std::move(call_back)]() {
-                if (!object.expired())
-                {
-                    cb();
-                }
-            }, delay);
+            scheduler.schedule(scheduler.makeTask<CallBack>(*this, std::move(call_back)), delay);
         }
         
         // ================================================================================ //
@@ -202,7 +245,7 @@ namespace kiwi
             return m_patcher.getBeacon(name);
         }
         
-        void Object::send(const size_t index, std::vector<tool::Atom> const& args)
+        void Object::send(const size_t index, tool::AtomList const& args)
         {
             assert(getScheduler().isThisConsumerThread());
             
@@ -254,8 +297,19 @@ namespace kiwi
         AudioObject::AudioObject(model::Object const& model, Patcher& patcher) noexcept
         : Object(model, patcher)
         , dsp::Processor(model.getNumberOfInlets(), model.getNumberOfOutlets())
+        , m_sample_clock(patcher.getSampleClock())
         {}
         
+        uint64_t AudioObject::getEventPosition() const
+        {
+            return m_sample_clock.getPosition(getScheduler().getEventTime());
+        }
+        
+        uint64_t AudioObject::getBlockPosition() const noexcept
+        {
+            return m_sample_clock.getBlockPosition();
+        }
+        
     }
 }
 
@@ -32,10 +32,12 @@
 
 #include <KiwiTool/KiwiTool_Scheduler.h>
 #include <KiwiTool/KiwiTool_ConcurrentQueue.h>
+#include <KiwiTool/KiwiTool_AtomList.h>
 
 #include <KiwiEngine/KiwiEngine_Patcher.h>
 
 #include <KiwiDsp/KiwiDsp_Processor.h>
+#include <KiwiDsp/KiwiDsp_EventQueue.h>
 
 #include <KiwiModel/KiwiModel_Object.h>
 
@@ -50,6 +52,14 @@ namespace kiwi
         //! @brief The Object reacts and interacts with other ones by sending and receiving messages via its inlets and outlets.
         class Object : public model::Object::Listener
         {
+        public: // classes
+            
+            class Task;
+            
+        private: // classes
+            
+            class CallBack;
+            
         public: // methods
             
             //! @brief Constructor.
@@ -62,7 +72,7 @@ namespace kiwi
             
             //! @brief Receives a set of arguments via an inlet.
             //! @details This method must be overriden by object's subclasses.
-            virtual void receive(size_t index, std::vector<tool::Atom> const& args) = 0;
+            virtual void receive(size_t index, tool::AtomList const& args) = 0;
             
         public: // methods
             
@@ -109,6 +119,12 @@ namespace kiwi
             //! @brief Returns the main scheduler.
             tool::Scheduler<> & getMainScheduler() const;
             
+            //! @brief Returns the threads that read and write files.
+            DiskThreadPool& getDiskThreadPool() const;
+            
+            //! @brief Returns the cache of the FAUST factories.
+            FaustFactoryCache& getFaustFactoryCache() const;
+            
             //! @brief Defers a task on the engine thread.
             //! @details The task is automatically unscheduled when object is destroyed.
             void defer(std::function<void()> call_back);
@@ -125,6 +141,13 @@ namespace kiwi
             //! @details The tasks is automatically unscheduled when object is destroyed.
             void scheduleMain(std::function<void()> call_back, tool::Scheduler<>::duration_t delay);
             
+            //! @brief Schedules a task on the engine thread without allocating.
+            //! @details The task is created by the scheduler's pool with the given arguments and
+            //! recycled once executed. Shall be preferred to schedule for high-rate messages.
+            //! @see Object::Task
+            template<class TaskType, class... Args>
+            void scheduleTask(tool::Scheduler<>::duration_t delay, Args&&... args);
+            
             // ================================================================================ //
             //                                      BEACON                                      //
             // ================================================================================ //
@@ -136,10 +159,10 @@ namespace kiwi
             //                                       SEND                                       //
             // ================================================================================ //
             
-            //! @brief Sends a vector of Atom via an outlet.
+            //! @brief Sends a list of Atom via an outlet.
             //! @todo Improve the stack overflow system.
             //! @todo See if the method must be noexcept.
-            void send(const size_t index, std::vector<tool::Atom> const& args);
+            void send(const size_t index, tool::AtomList const& args);
             
             //! @brief Changes one of the data model's attributes.
             //! @details For thread safety actual model's modification is called on the main thread.
@@ -176,6 +199,7 @@ namespace kiwi
             size_t                          m_inlets;
             std::vector<Outlet>             m_outlets;
             std::shared_ptr<Object>         m_master;
+            mutable Console::RateLimit      m_rate_limit;
             
             static constexpr size_t m_stack_overflow_max = 12;
             
@@ -191,6 +215,44 @@ namespace kiwi
         
         typedef std::shared_ptr<Object> sObject;
         
+        // ================================================================================ //
+        //                                    OBJECT TASK                                   //
+        // ================================================================================ //
+        
+        //! @brief A task that is only performed if its object still exists.
+        //! @details Subclasses hold the data of a delayed message and override perform.
+        //! @see Object::scheduleTask
+        class Object::Task : public tool::Scheduler<>::Task
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            Task(Object& owner);
+            
+            //! @brief Destructor.
+            ~Task();
+            
+        private: // methods
+            
+            //! @brief Called by the scheduler, performs the task if the object exists.
+            void execute() override final;
+            
+            //! @brief Performs the task.
+            virtual void perform() = 0;
+            
+        private: // members
+            
+            std::weak_ptr<Object>   m_owner;
+        };
+        
+        template<class TaskType, class... Args>
+        void Object::scheduleTask(tool::Scheduler<>::duration_t delay, Args&&... args)
+        {
+            tool::Scheduler<>& scheduler = getScheduler();
+            
+            scheduler.schedule(scheduler.makeTask<TaskType>(std::forward<Args>(args)...), delay);
+        }
+        
         // ================================================================================ //
         //                                    AUDIOOBJECT                                   //
         // ================================================================================ //
@@ -206,6 +268,22 @@ namespace kiwi
             
             //! @brief Destructor.
             virtual ~AudioObject() = default;
+            
+        protected: // methods
+            
+            //! @brief Returns the sample position at which a message received now shall be applied.
+            //! @details Called on the engine thread. The position is computed from the time of the
+            //! scheduler's event that sent the message, messages are applied one block after this time.
+            //! @see dsp::EventQueue
+            uint64_t getEventPosition() const;
+            
+            //! @brief Returns the position of the first sample of the block being performed.
+            //! @details Called during perform to read the events of the block.
+            uint64_t getBlockPosition() const noexcept;
+            
+        private: // members
+            
+            dsp::SampleClock const& m_sample_clock;
         };
     }
 }
@@ -69,7 +69,7 @@ namespace kiwi { namespace engine {
         return routes;
     }
     
-    void AudioInterfaceObject::receive(size_t index, std::vector<tool::Atom> const & args)
+    void AudioInterfaceObject::receive(size_t index, tool::AtomList const& args)
     {
         if(!args.empty())
         {
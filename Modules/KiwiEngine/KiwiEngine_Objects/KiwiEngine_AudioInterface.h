@@ -36,7 +36,7 @@ namespace kiwi { namespace engine {
         
         AudioInterfaceObject(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const & args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         std::vector<size_t> parseArgs(std::vector<tool::Atom> const& args) const;
         
@@ -56,11 +56,11 @@ namespace kiwi { namespace engine {
     {
         defer([this]()
         {
-            send(0, {"bang"});
+            send(0, {tool::Symbol::bang()});
         });
     }
     
-    void Bang::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Bang::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0 && !args.empty())
         {
@@ -43,7 +43,7 @@ namespace kiwi { namespace engine {
         
         void signalTriggered();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
     private: // members
         
@@ -56,7 +56,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Clip::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Clip::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty())
         {
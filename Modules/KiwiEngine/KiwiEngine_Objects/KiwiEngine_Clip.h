@@ -41,7 +41,7 @@ namespace kiwi { namespace engine {
         
         Clip(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
     private: // methods
         
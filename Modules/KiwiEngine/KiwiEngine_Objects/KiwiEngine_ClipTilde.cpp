@@ -57,7 +57,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void ClipTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void ClipTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty())
         {
@@ -41,7 +41,7 @@ namespace kiwi { namespace engine {
         
         ClipTilde(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         void prepare(dsp::Processor::PrepareInfo const& infos) override final;
         
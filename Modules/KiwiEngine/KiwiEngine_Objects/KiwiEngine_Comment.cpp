@@ -48,7 +48,7 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void Comment::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Comment::receive(size_t index, tool::AtomList const& args)
     {
     }
     
@@ -37,7 +37,7 @@ namespace kiwi { namespace engine {
         
         ~Comment();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         static void declare();
         
@@ -41,6 +41,7 @@ namespace kiwi { namespace engine {
     DacTilde::DacTilde(model::Object const& model, Patcher& patcher):
     AudioInterfaceObject(model, patcher)
     {
+        setSequential(true);
     }
     
     void DacTilde::perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept
@@ -60,10 +60,10 @@ namespace kiwi
         
         void Delay::bang()
         {
-            send(0, {"bang"});
+            send(0, {tool::Symbol::bang()});
         }
         
-        void Delay::receive(size_t index, std::vector<tool::Atom> const& args)
+        void Delay::receive(size_t index, tool::AtomList const& args)
         {
             if (!args.empty())
             {
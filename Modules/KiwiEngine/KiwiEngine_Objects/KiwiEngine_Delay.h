@@ -41,7 +41,7 @@ namespace kiwi { namespace engine {
         
         ~Delay();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
         void bang();
         
@@ -44,13 +44,15 @@ namespace kiwi { namespace engine {
     DelaySimpleTilde::DelaySimpleTilde(model::Object const& model, Patcher& patcher):
     AudioObject(model, patcher),
     tool::Scheduler<>::Timer(patcher.getScheduler()),
-    m_circular_buffer(),
+    m_delay_line(nullptr),
+    m_performed_blocks(0),
     m_reinject_signal(),
     m_max_delay(60.),
     m_delay(1.),
     m_reinject_level(0.),
     m_sr(0.),
-    m_pool()
+    m_pool(),
+    m_mutex()
     {
         std::vector<tool::Atom> const& args = model.getArguments();
         
@@ -64,9 +66,7 @@ namespace kiwi { namespace engine {
             m_reinject_level = std::max(0., std::min(args[1].getFloat(), 1.));
         }
         
-        std::shared_ptr<CircularBuffer> buffer(new CircularBuffer(0., 0., 0.));
-        m_pool.add(buffer);
-        store(buffer);
+        store(std::make_unique<dsp::DelayLine>(1));
         
         startTimer(std::chrono::milliseconds(1000));
     }
@@ -74,43 +74,41 @@ namespace kiwi { namespace engine {
     DelaySimpleTilde::~DelaySimpleTilde()
     {
         stopTimer();
-        timerCallBack();
+        delete m_delay_line.load();
     }
     
     void DelaySimpleTilde::timerCallBack()
     {
-        m_pool.clear();
+        m_pool.clear(m_performed_blocks.load());
     }
     
-    std::shared_ptr<DelaySimpleTilde::CircularBuffer> DelaySimpleTilde::load()
+    void DelaySimpleTilde::store(std::unique_ptr<dsp::DelayLine> line)
     {
-        std::shared_ptr<CircularBuffer> load_buffer;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        dsp::DelayLine* previous = m_delay_line.exchange(line.release());
         
+        // the audio thread may still be using the previous line until the end of the current block.
+        if (previous != nullptr)
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            load_buffer = m_circular_buffer;
+            m_pool.add(previous, m_performed_blocks.load());
         }
-        
-        return load_buffer;
-    }
-    
-    void DelaySimpleTilde::store(std::shared_ptr<CircularBuffer> new_buffer)
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_circular_buffer = new_buffer;
     }
     
-    void DelaySimpleTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void DelaySimpleTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0 && args[0].isString())
         {
             if (args[0].isString() && args[0].getString() == "clear")
             {
-                std::shared_ptr<CircularBuffer> new_buffer(new CircularBuffer(m_circular_buffer->size(),
-                                                                              m_circular_buffer->size(),
-                                                                              0.));
-                m_pool.add(new_buffer);
-                store(new_buffer);
+                size_t size = 0;
+                
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    size = m_delay_line.load()->size();
+                }
+                
+                store(std::make_unique<dsp::DelayLine>(size));
             }
             else
             {
@@ -141,70 +139,63 @@ namespace kiwi { namespace engine {
         }
     }
     
-    dsp::sample_t DelaySimpleTilde::cubicInterpolate(float const& x,
-                                                     float const& y0,
-                                                     float const& y1,
-                                                     float const& y2,
-                                                     float const& y3)
+    void DelaySimpleTilde::write(dsp::DelayLine& line, dsp::Signal const& input) noexcept
     {
-        return y1 + 0.5 * x * (y2 - y0 + x * (2.0 * y0 - 5.0 * y1 + 4.0 * y2 - y3
-                                              + x * (3.0 * (y1 - y2) + y3 - y0)));
+        dsp::Signal& reinject = *m_reinject_signal;
+        const size_t size = input.size();
+        
+        for (size_t i = 0; i < size; ++i)
+        {
+            reinject[i] += input[i];
+        }
+        
+        line.write(reinject.data(), size);
     }
     
     void DelaySimpleTilde::perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        std::shared_ptr<CircularBuffer> buffer = load();
+        dsp::DelayLine& line = *m_delay_line.load();
         
-        size_t buffer_size = input[0].size();
+        dsp::Signal& reinject = *m_reinject_signal;
+        const size_t buffer_size = input[0].size();
         
-        for (int i = 0; i < buffer_size; ++i)
-        {
-            buffer->push_back(input[0][i] + m_reinject_signal->operator[](i));
-        }
+        write(line, input[0]);
+        
+        const float delay = std::max<float>(1. / m_sr, std::min<float>(m_delay.load(), m_max_delay));
         
-        float delay = std::max<float>(1. / m_sr, std::min<float>(m_delay.load(), m_max_delay));
-        float offset = buffer->size() - (delay * m_sr) - (buffer_size - 1);
-        size_t offset_floor = std::floor(offset);
-        float decimal_part = offset - offset_floor;
+        line.read(output[0].data(), buffer_size, delay * m_sr);
         
-        for(int i = 0; i < buffer_size; ++i)
+        const dsp::sample_t reinject_level = m_reinject_level.load();
+        
+        for(size_t i = 0; i < buffer_size; ++i)
         {
-            output[0][i] = cubicInterpolate(decimal_part,
-                                            m_circular_buffer->operator[](offset_floor - 1),
-                                            m_circular_buffer->operator[](offset_floor),
-                                            m_circular_buffer->operator[](offset_floor + 1),
-                                            m_circular_buffer->operator[](offset_floor + 2));
-            
-            m_reinject_signal->operator[](i) = m_reinject_level.load() * output[0][i];
-            ++offset_floor;
+            reinject[i] = reinject_level * output[0][i];
         }
+        
+        m_performed_blocks.fetch_add(1);
     }
     
     void DelaySimpleTilde::performDelay(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        std::shared_ptr<CircularBuffer> buffer = load();
+        dsp::DelayLine& line = *m_delay_line.load();
         
-        size_t buffer_size = input[0].size();
+        dsp::Signal& reinject = *m_reinject_signal;
+        const size_t buffer_size = input[0].size();
         
-        for (int i = 0; i < buffer_size; ++i)
-        {
-            buffer->push_back(input[0][i] + m_reinject_signal->operator[](i));
-        }
+        write(line, input[0]);
         
-        for(int i = 0; i < buffer_size; ++i)
+        const dsp::sample_t reinject_level = m_reinject_level.load();
+        
+        for(size_t i = 0; i < buffer_size; ++i)
         {
-            float delay = std::max<float>(1. / m_sr, std::min<float>(input[1][i] / 1000., m_max_delay));
-            float offset = buffer->size() - (delay * m_sr) - (buffer_size - 1) + i;
-            size_t offset_floor = std::floor(offset);
+            const float delay = std::max<float>(1. / m_sr, std::min<float>(input[1][i] / 1000., m_max_delay));
             
-            output[0][i] = cubicInterpolate(offset - offset_floor,
-                                            buffer->operator[](offset_floor - 1),
-                                            buffer->operator[](offset_floor),
-                                            buffer->operator[](offset_floor + 1),
-                                            buffer->operator[](offset_floor + 2));
+            output[0][i] = line.read(delay * m_sr + (buffer_size - 1 - i));
             
-            m_reinject_signal->operator[](i) = m_reinject_level.load() * output[0][i];
+            reinject[i] = reinject_level * output[0][i];
         }
+        
+        m_performed_blocks.fetch_add(1);
     }
     
     void DelaySimpleTilde::prepare(dsp::Processor::PrepareInfo const& infos)
@@ -212,11 +203,10 @@ namespace kiwi { namespace engine {
         m_sr = infos.sample_rate;
         size_t vector_size = infos.vector_size;
         
-        size_t buffer_size = std::ceil(m_max_delay * m_sr) + 1 + vector_size;
+        // the interpolation reads two samples before and one after the delayed position.
+        size_t buffer_size = std::ceil(m_max_delay * m_sr) + vector_size + 3;
         
-        std::shared_ptr<CircularBuffer> new_buffer(new CircularBuffer(buffer_size, buffer_size, 0.));
-        m_pool.add(new_buffer);
-        store(new_buffer);
+        store(std::make_unique<dsp::DelayLine>(buffer_size));
         
         m_reinject_signal.reset(new dsp::Signal(vector_size));
         
@@ -244,23 +234,21 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void DelaySimpleTilde::ReleasePool::add(std::shared_ptr<DelaySimpleTilde::CircularBuffer> & buffer)
+    void DelaySimpleTilde::ReleasePool::add(dsp::DelayLine* line, uint64_t performed_blocks)
     {
-        if (buffer != nullptr)
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            
-            m_pool.emplace_back(buffer);
-        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        m_pool.emplace_back(std::unique_ptr<dsp::DelayLine>(line), performed_blocks);
     }
     
-    void DelaySimpleTilde::ReleasePool::clear()
+    void DelaySimpleTilde::ReleasePool::clear(uint64_t performed_blocks)
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         
+        // a block that started before a line was replaced has ended once the count has changed.
         for (auto it = m_pool.begin(); it != m_pool.end();)
         {
-            if (it->use_count() <= 1)
+            if (performed_blocks > it->second)
             {
                 it = m_pool.erase(it);
             }
@@ -22,10 +22,12 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <vector>
 
 #include <KiwiTool/KiwiTool_Scheduler.h>
-#include <KiwiTool/KiwiTool_CircularBuffer.h>
+
+#include <KiwiDsp/KiwiDsp_DelayLine.h>
 
 #include <KiwiEngine/KiwiEngine_Object.h>
 
@@ -39,8 +41,8 @@ namespace kiwi { namespace engine {
     {
     private: //classes
         
-        using CircularBuffer = tool::CircularBuffer<dsp::sample_t>;
-        
+        //! @brief Keeps the replaced delay lines until the audio thread stops using them.
+        //! @details A line is released once a block has been performed after its replacement.
         class ReleasePool
         {
         public: // methods
@@ -49,14 +51,16 @@ namespace kiwi { namespace engine {
             
             ~ReleasePool();
             
-            void add(std::shared_ptr<CircularBuffer> & buffer);
+            //! @brief Adds a line replaced when the given number of blocks were performed.
+            void add(dsp::DelayLine* line, uint64_t performed_blocks);
             
-            void clear();
+            //! @brief Releases the lines replaced before the given number of blocks.
+            void clear(uint64_t performed_blocks);
             
         private: // members
             
-            std::vector<std::shared_ptr<CircularBuffer>>    m_pool;
-            mutable std::mutex                              m_mutex;
+            std::vector<std::pair<std::unique_ptr<dsp::DelayLine>, uint64_t>>   m_pool;
+            mutable std::mutex                                                  m_mutex;
         };
         
     public: // methods
@@ -69,7 +73,7 @@ namespace kiwi { namespace engine {
         
         ~DelaySimpleTilde();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         void perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
@@ -79,21 +83,19 @@ namespace kiwi { namespace engine {
         
         void timerCallBack() override final;
         
-        void store(std::shared_ptr<CircularBuffer> new_buffer);
-        
-        std::shared_ptr<CircularBuffer> load();
-        
     private: // methods
         
-        dsp::sample_t cubicInterpolate(float const& x,
-                                       float const& y0,
-                                       float const& y1,
-                                       float const& y2,
-                                       float const& y3);
+        //! @brief Replaces the delay line used by the audio thread.
+        //! @details The line is exchanged without lock, the previous one is released later.
+        void store(std::unique_ptr<dsp::DelayLine> line);
+        
+        //! @brief Adds the reinjected signal to the input and writes it in the delay line.
+        void write(dsp::DelayLine& line, dsp::Signal const& input) noexcept;
         
     private: // members
         
-        std::shared_ptr<CircularBuffer>     m_circular_buffer;
+        std::atomic<dsp::DelayLine*>        m_delay_line;
+        std::atomic<uint64_t>               m_performed_blocks;
         std::unique_ptr<dsp::Signal>        m_reinject_signal;
         float                               m_max_delay;
         std::atomic<float>                  m_delay;
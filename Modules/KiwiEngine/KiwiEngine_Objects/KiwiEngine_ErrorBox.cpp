@@ -45,7 +45,7 @@ namespace kiwi { namespace engine {
         ;
     }
     
-    void ErrorBox::receive(size_t index, std::vector<tool::Atom> const& args)
+    void ErrorBox::receive(size_t index, tool::AtomList const& args)
     {
         ;
     }
@@ -32,6 +32,42 @@
 
 namespace kiwi { namespace engine {
 
+    // ================================================================================ //
+    //                                FAUST~ COMPILATION                                //
+    // ================================================================================ //
+    
+    //! @brief The task that brings the result of a compilation back to the main thread.
+    //! @details The instance is allocated on the compile thread and released if the object
+    //! has been deleted in the meantime.
+    class FaustTilde::Compilation final : public Object::Task
+    {
+    public: // methods
+        
+        Compilation(FaustTilde& owner, uint64_t compilation)
+        : Object::Task(owner)
+        , m_owner(owner)
+        , m_compilation(compilation)
+        {
+        }
+        
+        ~Compilation() = default;
+        
+        FaustFactoryCache::Result   m_result {nullptr, std::string(), false};
+        std::unique_ptr<llvm_dsp>   m_instance;
+        
+    private: // methods
+        
+        void perform() override
+        {
+            m_owner.dspCodeCompiled(m_compilation, m_result, m_instance.release());
+        }
+        
+    private: // members
+        
+        FaustTilde&     m_owner;
+        const uint64_t  m_compilation;
+    };
+
     // ================================================================================ //
     //                                       FAUST~                                     //
     // ================================================================================ //
@@ -48,7 +84,13 @@ namespace kiwi { namespace engine {
 
     FaustTilde::FaustTilde(model::Object const& model, Patcher& patcher)
     : AudioObject(model, patcher)
-    , m_factory(nullptr, deleteDSPFactory)
+    , tool::Scheduler<>::Timer(patcher.getScheduler())
+    , m_factory(nullptr)
+    , m_instance(nullptr)
+    , m_faded_instance(nullptr)
+    , m_performed_blocks(0)
+    , m_crossfade(1024)
+    , m_pool()
     , m_compile_options({"-I", getFaustLibsPath()})
     , m_ui_glue(std::make_unique<UIGlue>(*this))
     , m_file_selector(std::make_unique<FileSelector>(*this))
@@ -63,10 +105,25 @@ namespace kiwi { namespace engine {
         {
             attributeChanged("lockstate", {tool::Parameter::Type::Int, {fmodel->getLockState()}});
         }
+        
+        startTimer(std::chrono::milliseconds(1000));
     }
 
     FaustTilde::~FaustTilde()
-    {}
+    {
+        stopTimer();
+        delete m_instance.load();
+    }
+    
+    void FaustTilde::timerCallBack()
+    {
+        // the count must be read before the faded instance, an instance faded by a block
+        // performed after the count was read is then younger than its threshold.
+        const uint64_t performed_blocks = m_performed_blocks.load();
+        llvm_dsp const* faded_instance = m_faded_instance.load();
+        
+        m_pool.clear(performed_blocks, faded_instance);
+    }
 
     // ================================================================================ //
     bool FaustTilde::grabLock(bool state)
@@ -213,86 +270,101 @@ namespace kiwi { namespace engine {
     
     void FaustTilde::compileDspCode()
     {
+        // the result of a previous compilation is ignored.
+        const uint64_t compilation = ++m_compilation;
+        
         if(m_dsp_code.empty())
         {
             m_ui_glue->prepareChanges();
-            {
-                // Safetly release the instance
-                std::lock_guard<std::mutex> guard(m_mutex);
-                m_instance.reset();
-            }
-            
-            m_factory.reset();
+            store(nullptr, nullptr);
             return;
         }
         
-        std::string errors;
-        uptr_faust_factory nfactory(nullptr, deleteDSPFactory);
-        if(startMTDSPFactories())
+        auto task = std::make_shared<Compilation>(*this, compilation);
+        tool::Scheduler<>& main_scheduler = getMainScheduler();
+        
+        getFaustFactoryCache().compile(m_dsp_code, m_compile_options,
+                                       [task, &main_scheduler](FaustFactoryCache::Result const& result)
         {
-            const auto options = m_compile_options;
-            const auto name = "kiwi" + juce::Uuid().toString().toStdString();
-            std::vector<char const*> argv(options.size());
-            for(size_t i = 0; i < options.size(); ++i)
+            task->m_result = result;
+            
+            if(result.factory)
             {
-                argv[i] = options[i].c_str();
+                task->m_instance.reset(result.factory->createDSPInstance());
             }
             
-            nfactory = std::unique_ptr<llvm_dsp_factory, decltype(&deleteDSPFactory)>(createDSPFactoryFromString(name, m_dsp_code, options.size(), argv.data(), std::string(), errors), deleteDSPFactory);
-            stopMTDSPFactories();
-        }
-        else
+            main_scheduler.defer(task);
+        });
+    }
+    
+    void FaustTilde::dspCodeCompiled(uint64_t compilation, FaustFactoryCache::Result const& result, llvm_dsp* instance)
+    {
+        std::unique_ptr<llvm_dsp> ninstance(instance);
+        
+        if(compilation != m_compilation)
         {
-            warning("faust~: can't start multi-thread access");
+            return;
         }
-
-        if(!errors.empty())
+        
+        if(!result.errors.empty())
         {
-            warning("faust~: compilation failed - " + errors);
+            warning("faust~: compilation failed - " + result.errors);
         }
-        else if(nfactory)
+        else if(result.factory)
         {
-            log("faust~: compilation succeed - " + nfactory->getName());
-            auto ninstance = std::unique_ptr<llvm_dsp, nop>(nfactory->createDSPInstance());
+            log((result.cached ? "faust~: compilation loaded from cache - " : "faust~: compilation succeed - ")
+                + result.factory->getName());
 
-            if(ninstance)
+            if(!ninstance)
             {
                 m_ui_glue->prepareChanges();
-                // Safetly swap the factory
-                {
-                    std::lock_guard<std::mutex> guard(m_mutex);
-                    m_instance = std::move(ninstance);
-                }
-                m_instance->buildUserInterface(m_ui_glue.get());
-                m_ui_glue->finishChanges();
-                log("faust~: DSP allocation succeed");
-                log("faust~: number of inputs " + std::to_string(m_instance->getNumInputs()));
-                log("faust~: number of outputs " + std::to_string(m_instance->getNumOutputs()));
-                m_ui_glue->log();
-                prepareDsp(m_sample_rate, m_block_size);
+                warning("faust~: DSP allocation failed");
+                store(nullptr, nullptr);
+                return;
             }
-            else
+            
+            log("faust~: DSP allocation succeed");
+            log("faust~: number of inputs " + std::to_string(ninstance->getNumInputs()));
+            log("faust~: number of outputs " + std::to_string(ninstance->getNumOutputs()));
+            
+            if(static_cast<size_t>(ninstance->getNumInputs()) > getNumberOfInputs() ||
+               static_cast<size_t>(ninstance->getNumOutputs()) > getNumberOfOutputs() - 1)
             {
                 m_ui_glue->prepareChanges();
-                warning("faust~: DSP allocation failed");
-                {
-                    // Safetly release the instance
-                    std::lock_guard<std::mutex> guard(m_mutex);
-                    m_instance.reset();
-                }
+                warning("faust~: DSP instance has invalid number of inputs and outputs, expected at least " + std::to_string(ninstance->getNumInputs()) + " inputs but has " + std::to_string(getNumberOfInputs()) + " and " + std::to_string(ninstance->getNumOutputs()) + " outputs but has " + std::to_string(getNumberOfOutputs() - 1));
+                store(nullptr, nullptr);
+                return;
             }
             
-            m_factory = std::move(nfactory);
+            // the instance is initialized before the parameters so the values of the
+            // matching parameters of the previous instance are recalled.
+            ninstance->init(static_cast<int>(m_sample_rate));
+            
+            m_ui_glue->prepareChanges();
+            ninstance->buildUserInterface(m_ui_glue.get());
+            m_ui_glue->finishChanges();
+            m_ui_glue->log();
+            
+            store(std::move(ninstance), result.factory);
             return;
         }
         
         m_ui_glue->prepareChanges();
+        store(nullptr, nullptr);
+    }
+    
+    void FaustTilde::store(std::unique_ptr<llvm_dsp> instance, FaustFactoryCache::factory_t factory)
+    {
+        llvm_dsp* previous = m_instance.exchange(instance.release());
+        
+        // the audio thread may still be using the previous instance until the end of the
+        // current block, then it fades it out.
+        if(previous != nullptr)
         {
-            // Safetly release the instance
-            std::lock_guard<std::mutex> guard(m_mutex);
-            m_instance.reset();
+            m_pool.add(previous, std::move(m_factory), m_performed_blocks.load() + 1);
         }
-        m_factory.reset();
+        
+        m_factory = std::move(factory);
     }
 
     // ================================================================================ //
@@ -344,7 +416,7 @@ namespace kiwi { namespace engine {
     // The Kiwi Object interface
     // ================================================================================ //
 
-    void FaustTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void FaustTilde::receive(size_t index, tool::AtomList const& args)
     {
         if(!args.empty() && args[0].isString())
         {
@@ -405,7 +477,20 @@ namespace kiwi { namespace engine {
                 return;
             }
 
-            if(!m_factory || !m_instance)
+            if(name == "crossfade")
+            {
+                if(args.size() > 1 && args[1].isNumber() && args[1].getInt() >= 0)
+                {
+                    m_crossfade.store(static_cast<size_t>(args[1].getInt()));
+                }
+                else
+                {
+                    warning(std::string("faust~: crossfade method expects a positive number of samples"));
+                }
+                return;
+            }
+
+            if(m_instance.load() == nullptr)
             {
                 return;
             }
@@ -439,75 +524,156 @@ namespace kiwi { namespace engine {
         warning(std::string("faust~: receive bad arguments"));
     }
 
+    void FaustTilde::compute(llvm_dsp* instance, size_t nsamples, dsp::sample_t** outputs) noexcept
+    {
+        const size_t noutputs = m_outputs.size();
+        const size_t ncomputed = (instance != nullptr) ? static_cast<size_t>(instance->getNumOutputs()) : 0ul;
+        
+        if(instance != nullptr)
+        {
+            instance->compute(static_cast<int>(nsamples), const_cast<FAUSTFLOAT**>(m_inputs.data()), outputs);
+        }
+        
+        for(size_t i = ncomputed; i < noutputs; ++i)
+        {
+            std::fill_n(outputs[i], nsamples, 0.f);
+        }
+    }
+
     void FaustTilde::perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
         const size_t nsamples = input.getVectorSize();
         const size_t ninputs  = m_inputs.size();
         const size_t noutputs = m_outputs.size();
-        if(m_mutex.try_lock())
+        
+        llvm_dsp* instance = m_instance.load();
+        
+        if(instance != m_performed_instance)
         {
-            if(m_instance)
-            {
-                for(size_t i = 0; i < ninputs; ++i)
-                {
-                    m_inputs[i] = const_cast<dsp::sample_t*>(input[i].data());
-                }
-                for(size_t i = 0; i < noutputs; ++i)
-                {
-                    m_outputs[i] = output[i].data();
-                }
-                m_instance->compute(nsamples, const_cast<FAUSTFLOAT**>(m_inputs.data()), m_outputs.data());
-            }
-            else
+            // the instance that fades out is published before the end of the block so it
+            // won't be released, a fade that is not over is interrupted.
+            m_faded_instance.store(m_performed_instance);
+            m_performed_instance = instance;
+            m_crossfade_length = m_crossfade.load();
+            m_crossfade_position = 0;
+        }
+        
+        for(size_t i = 0; i < ninputs; ++i)
+        {
+            m_inputs[i] = const_cast<dsp::sample_t*>(input[i].data());
+        }
+        for(size_t i = 0; i < noutputs; ++i)
+        {
+            m_outputs[i] = output[i].data();
+        }
+        
+        const size_t nfaded = std::min(nsamples, m_crossfade_length - m_crossfade_position);
+        
+        if(nfaded > 0)
+        {
+            // the previous instance is computed first as the outputs may share the inputs.
+            compute(m_faded_instance.load(), nsamples, m_crossfade_outputs.data());
+            compute(instance, nsamples, m_outputs.data());
+            
+            const dsp::sample_t length = static_cast<dsp::sample_t>(m_crossfade_length);
+            
+            for(size_t i = 0; i < noutputs; ++i)
             {
-                for(size_t i = ninputs; i < noutputs; ++i)
+                dsp::sample_t* out = m_outputs[i];
+                dsp::sample_t const* faded = m_crossfade_outputs[i];
+                
+                for(size_t j = 0; j < nfaded; ++j)
                 {
-                    std::fill_n(output[i].data(), nsamples, 0.f);
+                    const dsp::sample_t gain = static_cast<dsp::sample_t>(m_crossfade_position + j) / length;
+                    out[j] = faded[j] + gain * (out[j] - faded[j]);
                 }
             }
-            m_mutex.unlock();
+            
+            m_crossfade_position += nfaded;
         }
         else
         {
-            for(size_t i = ninputs; i < noutputs; ++i)
-            {
-                std::fill_n(output[i].data(), nsamples, 0.f);
-            }
+            compute(instance, nsamples, m_outputs.data());
         }
+        
+        if(m_crossfade_position >= m_crossfade_length && m_faded_instance.load() != nullptr)
+        {
+            m_faded_instance.store(nullptr);
+        }
+        
+        m_performed_blocks.fetch_add(1);
     }
 
-    bool FaustTilde::prepareDsp(size_t sampleRate, size_t blockSize) noexcept
+    void FaustTilde::prepareDsp(size_t sampleRate, size_t blockSize)
     {
         m_sample_rate   = sampleRate;
         m_block_size    = blockSize;
-
-        if(static_cast<size_t>(m_instance->getNumInputs()) <= getNumberOfInputs() &&
-           static_cast<size_t>(m_instance->getNumOutputs()) <= getNumberOfOutputs() - 1)
+        
+        const size_t noutputs = getNumberOfOutputs() - 1;
+        
+        m_inputs.resize(getNumberOfInputs());
+        m_outputs.resize(noutputs);
+        m_crossfade_buffer.assign(noutputs * blockSize, 0.f);
+        m_crossfade_outputs.resize(noutputs);
+        for(size_t i = 0; i < noutputs; ++i)
+        {
+            m_crossfade_outputs[i] = m_crossfade_buffer.data() + i * blockSize;
+        }
+        
+        m_performed_instance = m_instance.load();
+        m_faded_instance.store(nullptr);
+        m_crossfade_length = 0;
+        m_crossfade_position = 0;
+        
+        if(m_performed_instance != nullptr)
         {
             m_ui_glue->saveStates();
-            const int sampling_rate = static_cast<int>(m_sample_rate);
-            m_instance->init(sampling_rate);
-            m_instance->instanceInit(sampling_rate);
-            m_instance->instanceConstants(sampling_rate);
+            m_performed_instance->init(static_cast<int>(m_sample_rate));
             m_ui_glue->recallStates();
-            m_inputs.resize(m_instance->getNumInputs());
-            m_outputs.resize(m_instance->getNumOutputs());
-            return true;
         }
-        return false;
     }
 
     void FaustTilde::prepare(PrepareInfo const& infos)
     {
-        if(m_instance)
+        prepareDsp(infos.sample_rate, infos.vector_size);
+        setPerformCallBack(this, &FaustTilde::perform);
+    }
+    
+    // ================================================================================ //
+    //                               FAUST~ RELEASE POOL                                //
+    // ================================================================================ //
+    
+    FaustTilde::ReleasePool::ReleasePool()
+    : m_pool()
+    , m_mutex()
+    {
+    }
+    
+    FaustTilde::ReleasePool::~ReleasePool()
+    {
+    }
+    
+    void FaustTilde::ReleasePool::add(llvm_dsp* instance, FaustFactoryCache::factory_t factory, uint64_t performed_blocks)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        m_pool.push_back(Entry{std::move(factory), std::unique_ptr<llvm_dsp>(instance), performed_blocks});
+    }
+    
+    void FaustTilde::ReleasePool::clear(uint64_t performed_blocks, llvm_dsp const* faded_instance)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        // once the count has changed the audio thread has published the instance it fades out.
+        for(auto it = m_pool.begin(); it != m_pool.end();)
         {
-            if(prepareDsp(infos.sample_rate, infos.vector_size))
+            if(performed_blocks > it->performed_blocks && it->instance.get() != faded_instance)
             {
-                setPerformCallBack(this, &FaustTilde::perform);
+                it = m_pool.erase(it);
             }
             else
             {
-                warning("faust~: DSP instance has invalid number of inputs and outputs, expected at least " + std::to_string(m_instance->getNumInputs()) + " inputs but has " + std::to_string(getNumberOfInputs()) + " and " + std::to_string(m_instance->getNumOutputs()) + " inputs but has " + std::to_string(getNumberOfOutputs() - 1));
+                ++it;
             }
         }
     }
@@ -21,7 +21,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <list>
+#include <vector>
+
 #include <KiwiEngine/KiwiEngine_Object.h>
+#include <KiwiEngine/KiwiEngine_FaustFactoryCache.h>
 
 class llvm_dsp_factory;
 class llvm_dsp;
@@ -32,8 +37,45 @@ namespace kiwi { namespace engine {
     //                                       FAUST~                                     //
     // ================================================================================ //
     
-    class FaustTilde : public engine::AudioObject
+    class FaustTilde : public engine::AudioObject, public tool::Scheduler<>::Timer
     {
+    private: // classes
+        
+        //! @brief Keeps the replaced instances until the audio thread stops using them.
+        //! @details An instance is released once a block has been performed after its
+        //! replacement and once it is not faded out anymore. The factory is kept alive with
+        //! its instance because the code of the instance belongs to the factory.
+        class ReleasePool
+        {
+        public: // methods
+            
+            ReleasePool();
+            
+            ~ReleasePool();
+            
+            //! @brief Adds an instance replaced when the given number of blocks were performed.
+            void add(llvm_dsp* instance, FaustFactoryCache::factory_t factory, uint64_t performed_blocks);
+            
+            //! @brief Releases the instances replaced before the given number of blocks.
+            //! @details The instance that is faded out by the audio thread is kept.
+            void clear(uint64_t performed_blocks, llvm_dsp const* faded_instance);
+            
+        private: // classes
+            
+            //! @brief The instance is destroyed before its factory.
+            struct Entry
+            {
+                FaustFactoryCache::factory_t    factory;
+                std::unique_ptr<llvm_dsp>       instance;
+                uint64_t                        performed_blocks;
+            };
+            
+        private: // members
+            
+            std::list<Entry>    m_pool;
+            mutable std::mutex  m_mutex;
+        };
+        
     public: // methods
         
         static void declare();
@@ -44,12 +86,14 @@ namespace kiwi { namespace engine {
         
         ~FaustTilde();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
         void prepare(dsp::Processor::PrepareInfo const& infos) override;
 
         void attributeChanged(std::string const& name, tool::Parameter const& param) override;
         
+        void timerCallBack() override final;
+        
     private:
         
         //! @brief Returns the faust libraries path
@@ -92,31 +136,49 @@ namespace kiwi { namespace engine {
         void openFile(const std::string& file);
         
         //! @brief Compile the current DSP code.
+        //! @details The code is compiled by the FAUST factory cache out of the main thread.
         void compileDspCode();
         
+        class Compilation;
+        
+        //! @brief Swaps the instance of a compiled DSP code in, called on the main thread.
+        //! @details The instance is initialized and receives the values of the matching
+        //! parameters before being published to the audio thread.
+        void dspCodeCompiled(uint64_t compilation, FaustFactoryCache::Result const& result, llvm_dsp* instance);
+        
+        //! @brief Replaces the instance used by the audio thread.
+        //! @details The instance is exchanged without lock, the audio thread crossfades the
+        //! previous one with the new one and the previous one is released later.
+        void store(std::unique_ptr<llvm_dsp> instance, FaustFactoryCache::factory_t factory);
+        
         //! @brief Get the time of a block size in ms.
         double getBlockSizeInMS() { return static_cast<double>(m_block_size) / static_cast<double>(m_sample_rate); }
         
-        //! @brief Get the time of a block size in ms.
-        bool prepareDsp(size_t sampleRate, size_t blockSize) noexcept;
+        //! @brief Initializes the instance and the buffers for a sample rate and a block size.
+        void prepareDsp(size_t sampleRate, size_t blockSize);
         
         void perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
-        struct nop
-        {
-            template <typename T>
-            void operator() (T const &) const noexcept { }
-        };
+        //! @brief Computes an instance or fills the outputs with zeros if the instance is null.
+        void compute(llvm_dsp* instance, size_t nsamples, dsp::sample_t** outputs) noexcept;
         
         class UIGlue;
         class FileSelector;
         class CodeEditor;
-        typedef std::unique_ptr<llvm_dsp_factory, bool(*)(llvm_dsp_factory*)> uptr_faust_factory;
-        typedef std::unique_ptr<llvm_dsp, nop> uptr_faust_instance;
         
-        uptr_faust_factory              m_factory;
-        uptr_faust_instance             m_instance;
-        std::mutex                      m_mutex;
+        FaustFactoryCache::factory_t    m_factory;
+        std::atomic<llvm_dsp*>          m_instance;
+        std::atomic<llvm_dsp*>          m_faded_instance;
+        std::atomic<uint64_t>           m_performed_blocks;
+        std::atomic<size_t>             m_crossfade;
+        ReleasePool                     m_pool;
+        
+        // audio thread
+        llvm_dsp*                       m_performed_instance = nullptr;
+        size_t                          m_crossfade_length   = 0;
+        size_t                          m_crossfade_position = 0;
+        std::vector<dsp::sample_t>      m_crossfade_buffer;
+        std::vector<dsp::sample_t*>     m_crossfade_outputs;
         std::vector<dsp::sample_t*>     m_inputs;
         std::vector<dsp::sample_t*>     m_outputs;
         
@@ -130,6 +192,7 @@ namespace kiwi { namespace engine {
         const int64_t                   m_user_id = 0;
         size_t                          m_sample_rate   = 44100;
         size_t                          m_block_size    = 64;
+        uint64_t                        m_compilation   = 0;
     };
 
 }}
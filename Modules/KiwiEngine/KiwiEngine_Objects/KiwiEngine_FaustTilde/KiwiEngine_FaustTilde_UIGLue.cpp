@@ -235,7 +235,7 @@ namespace kiwi { namespace engine {
             std::lock_guard<std::mutex> guard(m_mutex_glue);
             for(auto& param : m_params_short)
             {
-                if(param.second.type != Parameter::Type::Button)
+                if(param.second.type != Parameter::Type::Button && !param.second.dirty)
                 {
                     param.second.saved = *param.second.zone;
                 }
@@ -247,18 +247,25 @@ namespace kiwi { namespace engine {
             std::lock_guard<std::mutex> guard(m_mutex_glue);
             for(auto& param : m_params_short)
             {
-                if(param.second.type != Parameter::Type::Button)
+                if(param.second.type != Parameter::Type::Button && !param.second.dirty)
                 {
                     *param.second.zone = param.second.saved;
                 }
             }
         }
         
+        //! @brief Marks the parameters as dirty before the instance is replaced.
+        //! @details The values are saved while the zones are still valid, they are recalled
+        //! by the parameters of the next instance that match.
         void prepareChanges()
         {
             std::lock_guard<std::mutex> guard(m_mutex_glue);
             for(auto& param : m_params_short)
             {
+                if(param.second.type != Parameter::Type::Button && !param.second.dirty)
+                {
+                    param.second.saved = *param.second.zone;
+                }
                 param.second.dirty = true;
             }
             m_params_path.clear();
@@ -338,7 +345,6 @@ namespace kiwi { namespace engine {
                 }
                 else
                 {
-                    it->second.saved = *it->second.zone;
                     it->second.zone = zone;
                     it->second.dirty = false;
                     m_params_long[getLongName(name)] = it->second;
@@ -347,7 +353,7 @@ namespace kiwi { namespace engine {
             }
             else
             {
-                m_params_short[name] = Parameter({type, zone, min, max, step, init, init, false});
+                it = m_params_short.emplace(name, Parameter({type, zone, min, max, step, init, init, false})).first;
                 m_params_long[getLongName(name)] = it->second;
                 *zone = init;
             }
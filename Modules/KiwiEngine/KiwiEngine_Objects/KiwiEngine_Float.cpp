@@ -51,7 +51,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Float::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Float::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty())
         {
@@ -56,7 +56,7 @@ namespace kiwi { namespace engine {
         m_opened_output = std::max(0, std::min(output, static_cast<int>(m_num_outputs)));
     }
     
-    void Gate::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Gate::receive(size_t index, tool::AtomList const& args)
     {
         if (args.size() > 0)
         {
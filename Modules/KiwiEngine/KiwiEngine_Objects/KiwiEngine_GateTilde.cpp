@@ -41,6 +41,7 @@ namespace kiwi { namespace engine {
     
     GateTilde::GateTilde(model::Object const& model, Patcher& patcher) :
     AudioObject(model, patcher),
+    m_events(256),
     m_opened_output(),
     m_num_outputs(model.getArguments()[0].getInt())
     {
@@ -48,16 +49,16 @@ namespace kiwi { namespace engine {
         
         if (args.size() > 1)
         {
-            openOutput(args[1].getInt());
+            m_opened_output = clipOutput(args[1].getInt());
         }
     }
     
-    void GateTilde::openOutput(int output)
+    size_t GateTilde::clipOutput(int output) const
     {
-        m_opened_output = std::max(0, std::min(output, static_cast<int>(m_num_outputs)));
+        return std::max(0, std::min(output, static_cast<int>(m_num_outputs)));
     }
     
-    void GateTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void GateTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (args.size() > 0)
         {
@@ -65,7 +66,7 @@ namespace kiwi { namespace engine {
             {
                 if (args[0].isNumber())
                 {
-                    openOutput(args[0].getInt());
+                    m_events.push(getEventPosition(), clipOutput(args[0].getInt()));
                 }
                 else
                 {
@@ -87,19 +88,50 @@ namespace kiwi { namespace engine {
         }
     }
     
+    template<class Segment>
+    void GateTilde::performControls(size_t size, Segment&& segment) noexcept
+    {
+        uint64_t const block_position = getBlockPosition();
+        
+        size_t start = 0;
+        size_t offset = 0;
+        size_t opened_output = 0;
+        
+        while(m_events.pop(block_position, size, offset, opened_output))
+        {
+            if(offset > start)
+            {
+                segment(start, offset - start);
+                start = offset;
+            }
+            
+            m_opened_output = opened_output;
+        }
+        
+        if(size > start)
+        {
+            segment(start, size - start);
+        }
+    }
+    
     void GateTilde::performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
         size_t output_number = output.getNumberOfChannels();
+        dsp::sample_t const * input_signal = input[1].data();
         
         for(size_t outlet = 0; outlet < output_number; ++outlet)
         {
             output[outlet].fill(0);
         }
         
-        if (m_opened_output != 0)
+        performControls(input[1].size(), [this, &output, input_signal](size_t start, size_t count)
         {
-            output[m_opened_output - 1].copy(input[1]);
-        }
+            if (m_opened_output != 0)
+            {
+                std::copy(input_signal + start, input_signal + start + count,
+                          output[m_opened_output - 1].data() + start);
+            }
+        });
     }
     
     void GateTilde::performSig(dsp::Buffer const& input, dsp::Buffer& output) noexcept
@@ -110,6 +142,9 @@ namespace kiwi { namespace engine {
         size_t output_number = output.getNumberOfChannels();
         size_t opened_output = 0;
         
+        // the opened output is kept for when the signal is disconnected.
+        performControls(sample_index, [](size_t, size_t) {});
+        
         for(size_t outlet = 0; outlet < output_number; ++outlet)
         {
             output[outlet].fill(0);
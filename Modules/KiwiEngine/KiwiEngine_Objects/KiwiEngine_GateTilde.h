@@ -41,7 +41,7 @@ namespace kiwi { namespace engine {
         
         GateTilde(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         void prepare(PrepareInfo const& infos) override final;
         
@@ -51,10 +51,16 @@ namespace kiwi { namespace engine {
         
     private:
         
-        void openOutput(int output);
+        size_t clipOutput(int output) const;
+        
+        //! @brief Opens the outputs received during the block.
+        //! @details The function receives the start and the size of each segment.
+        template<class Segment>
+        void performControls(size_t size, Segment&& segment) noexcept;
         
     private:
         
+        dsp::EventQueue<size_t> m_events;
         size_t m_opened_output;
         size_t m_num_outputs;
     };
@@ -58,7 +58,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Hub::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Hub::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0 && !args.empty())
         {
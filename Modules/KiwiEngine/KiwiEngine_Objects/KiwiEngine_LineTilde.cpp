@@ -28,10 +28,11 @@ namespace kiwi{ namespace engine {
     //                                      RAMP                                        //
     // ================================================================================ //
     
-    Ramp::Ramp(dsp::sample_t start) noexcept
+    Ramp::Ramp(dsp::sample_t start)
     : m_current_value(start)
     , m_destination_value(start)
     {
+        m_value_time_pairs.reserve(max_pairs);
     }
     
     void Ramp::setSampleRate(double sample_rate) noexcept
@@ -47,25 +48,29 @@ namespace kiwi{ namespace engine {
     
     void Ramp::setValueDirect(dsp::sample_t new_value) noexcept
     {
-        auto lock = std::unique_lock<std::mutex>(m_lock);
         reset();
         m_current_value = m_destination_value = new_value;
         m_countdown = m_steps_to_destination = 0;
         m_step = 0.;
     }
     
-    void Ramp::setValueTimePairs(std::vector<ValueTimePair> value_time_pairs)
+    void Ramp::startValueTimePairs(ValueTimePair const& value_time_pair) noexcept
     {
-        auto lock = std::unique_lock<std::mutex>(m_lock);
         reset();
-        m_value_time_pairs.swap(value_time_pairs);
-        m_valuetime_pairs_countdown = m_value_time_pairs.size();
+        appendValueTimePair(value_time_pair);
+    }
+    
+    void Ramp::appendValueTimePair(ValueTimePair const& value_time_pair) noexcept
+    {
+        if(m_value_time_pairs.size() < max_pairs)
+        {
+            m_value_time_pairs.push_back(value_time_pair);
+            ++m_valuetime_pairs_countdown;
+        }
     }
     
     dsp::sample_t Ramp::getNextValue() noexcept
     {
-        auto lock = std::unique_lock<std::mutex>(m_lock);
-        
         if (m_countdown <= 0)
         {
             const auto value = m_destination_value;
@@ -136,7 +141,7 @@ namespace kiwi{ namespace engine {
         
         BangTask(LineTilde& owner) : m_owner(owner) {}
         ~BangTask() = default;
-        void execute() override { m_owner.send(1ul, {"bang"}); }
+        void execute() override { m_owner.send(1ul, {tool::Symbol::bang()}); }
         
     private: // members
         LineTilde& m_owner;
@@ -159,6 +164,7 @@ namespace kiwi{ namespace engine {
     LineTilde::LineTilde(model::Object const& model, Patcher& patcher)
     : AudioObject(model, patcher)
     , m_bang_task(std::make_shared<BangTask>(*this))
+    , m_events(256)
     , m_ramp(0.)
     {
         std::vector<tool::Atom> const& args = model.getArguments();
@@ -179,7 +185,7 @@ namespace kiwi{ namespace engine {
     }
     
     std::vector<Ramp::ValueTimePair>
-    LineTilde::parseAtomsAsValueTimePairs(std::vector<tool::Atom> const& atoms) const
+    LineTilde::parseAtomsAsValueTimePairs(tool::AtomList const& atoms) const
     {
         std::vector<Ramp::ValueTimePair> value_time_pairs;
         
@@ -209,7 +215,42 @@ namespace kiwi{ namespace engine {
         return value_time_pairs;
     }
     
-    void LineTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void LineTilde::pushValueTimePairs(std::vector<Ramp::ValueTimePair> const& value_time_pairs)
+    {
+        const uint64_t position = getEventPosition();
+        
+        Control::Type type = Control::Type::Start;
+        
+        for(auto const& pair : value_time_pairs)
+        {
+            m_events.push(position, {type, pair.value, pair.time_ms});
+            type = Control::Type::Append;
+        }
+    }
+    
+    void LineTilde::applyControl(Control const& control) noexcept
+    {
+        switch(control.type)
+        {
+            case Control::Type::Direct:
+            {
+                m_ramp.setValueDirect(control.value);
+                break;
+            }
+            case Control::Type::Start:
+            {
+                m_ramp.startValueTimePairs({control.value, control.time_ms});
+                break;
+            }
+            case Control::Type::Append:
+            {
+                m_ramp.appendValueTimePair({control.value, control.time_ms});
+                break;
+            }
+        }
+    }
+    
+    void LineTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty())
         {
@@ -221,26 +262,22 @@ namespace kiwi{ namespace engine {
                     {
                         auto value_time_pairs = parseAtomsAsValueTimePairs(args);
                         
-                        if(!value_time_pairs.empty())
-                        {
-                            m_ramp.setValueTimePairs(value_time_pairs);
-                        }
+                        pushValueTimePairs(value_time_pairs);
                     }
                     else
                     {
                         if(!m_next_ramp_time_consumed)
                         {
-                            Ramp::ValueTimePair pair {
+                            pushValueTimePairs({{
                                 (dsp::sample_t) args[0].getFloat(),
                                 (dsp::sample_t) m_next_ramp_time_ms
-                            };
+                            }});
                             
-                            m_ramp.setValueTimePairs({std::move(pair)});
                             m_next_ramp_time_consumed = true;
                         }
                         else
                         {
-                            m_ramp.setValueDirect(args[0].getFloat());
+                            m_events.push(getEventPosition(), {Control::Type::Direct, (dsp::sample_t) args[0].getFloat()});
                         }
                     }
                 }
@@ -286,12 +323,29 @@ namespace kiwi{ namespace engine {
     
     void LineTilde::perform(dsp::Buffer const&, dsp::Buffer& output) noexcept
     {
-        size_t sampleframes = output[0ul].size();
+        size_t const size = output[0ul].size();
         dsp::sample_t* out = output[0ul].data();
+        uint64_t const block_position = getBlockPosition();
+        
+        size_t start = 0;
+        size_t offset = 0;
+        Control control;
+        
+        // the ramp runs up to each event and restarts from its offset.
+        
+        while(m_events.pop(block_position, size, offset, control))
+        {
+            for(; start < offset; ++start)
+            {
+                out[start] = m_ramp.getNextValue();
+            }
+            
+            applyControl(control);
+        }
         
-        while(sampleframes--)
+        for(; start < size; ++start)
         {
-            *out++ = m_ramp.getNextValue();
+            out[start] = m_ramp.getNextValue();
         }
     }
     
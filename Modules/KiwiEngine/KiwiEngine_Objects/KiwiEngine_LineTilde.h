@@ -48,7 +48,7 @@ namespace kiwi { namespace engine {
     public: // methods
         
         //! @brief Constructor
-        Ramp(dsp::sample_t start = 0) noexcept;
+        Ramp(dsp::sample_t start = 0);
         
         //! @brief Set sample rate.
         //! @details The sample rate is used to compute the step value of the ramp.
@@ -64,9 +64,15 @@ namespace kiwi { namespace engine {
         //! @param new_value New value
         void setValueDirect(dsp::sample_t new_value) noexcept;
         
-        //! @brief Resets the value-time pairs of the ramp.
-        //! @param value_time_pairs A vector of ValueTimePair.
-        void setValueTimePairs(std::vector<ValueTimePair> value_time_pairs);
+        //! @brief Resets the value-time pairs of the ramp with a first pair.
+        //! @param value_time_pair The first ValueTimePair.
+        void startValueTimePairs(ValueTimePair const& value_time_pair) noexcept;
+        
+        //! @brief Appends a value-time pair to the ramp.
+        //! @details The pairs beyond the maximum number of pairs are ignored so that the ramp
+        //! never allocates while it performs.
+        //! @param value_time_pair The ValueTimePair to append.
+        void appendValueTimePair(ValueTimePair const& value_time_pair) noexcept;
         
         //! @brief Compute and returns the next value.
         //! @details The sampling rate must be set before calling this method.
@@ -83,7 +89,8 @@ namespace kiwi { namespace engine {
         
     private: // variables
         
-        std::mutex m_lock;
+        static constexpr size_t max_pairs = 64;
+        
         double m_sr = 0.;
         dsp::sample_t m_current_value = 0, m_destination_value = 0, m_step = 0;
         int m_countdown = 0, m_steps_to_destination = 0;
@@ -111,15 +118,31 @@ namespace kiwi { namespace engine {
         
         ~LineTilde();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
         void prepare(dsp::Processor::PrepareInfo const& infos) override;
         
         void perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
+    private: // classes
+        
+        //! @brief A value or a value-time pair sent to the audio thread.
+        struct Control
+        {
+            enum class Type { Direct, Start, Append };
+            
+            Type            type = Type::Direct;
+            dsp::sample_t   value = 0.f;
+            dsp::sample_t   time_ms = 0.f;
+        };
+        
     private: // methods
         
-        std::vector<Ramp::ValueTimePair> parseAtomsAsValueTimePairs(std::vector<tool::Atom> const& atoms) const;
+        std::vector<Ramp::ValueTimePair> parseAtomsAsValueTimePairs(tool::AtomList const& atoms) const;
+        
+        void pushValueTimePairs(std::vector<Ramp::ValueTimePair> const& value_time_pairs);
+        
+        void applyControl(Control const& control) noexcept;
         
     private: // variables
         
@@ -129,6 +152,7 @@ namespace kiwi { namespace engine {
         double m_next_ramp_time_ms;
         bool m_next_ramp_time_consumed;
         
+        dsp::EventQueue<Control> m_events;
         Ramp m_ramp;
     };
     
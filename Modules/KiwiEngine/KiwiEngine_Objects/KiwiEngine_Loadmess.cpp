@@ -44,7 +44,7 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void Loadmess::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Loadmess::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty() && args[0].isBang())
         {
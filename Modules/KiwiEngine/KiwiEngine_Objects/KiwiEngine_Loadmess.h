@@ -41,13 +41,13 @@ namespace kiwi { namespace engine {
         
         ~Loadmess() = default;
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
         void loadbang() override;
         
     private:
         
-        const std::vector<tool::Atom> m_args;
+        const tool::AtomList m_args;
     };
     
 }}
@@ -75,7 +75,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Message::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Message::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0 && !args.empty())
         {
@@ -105,7 +105,7 @@ namespace kiwi { namespace engine {
         m_messages.clear();
         if(!atoms.empty())
         {
-            std::vector<tool::Atom> atom_sequence;
+            tool::AtomList atom_sequence;
             bool dollar_flag = false;
             
             for(auto&& atom : atoms)
@@ -145,7 +145,7 @@ namespace kiwi { namespace engine {
         {
             if(message.has_dollar)
             {
-                std::vector<tool::Atom> atoms = message.atoms;
+                tool::AtomList atoms = message.atoms;
                 
                 for(auto& atom : atoms)
                 {
@@ -41,7 +41,7 @@ namespace kiwi { namespace engine {
         
         void attributeChanged(std::string const& name, tool::Parameter const& param) override final;
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         void outputMessage();
         
@@ -59,13 +59,13 @@ namespace kiwi { namespace engine {
         
         struct Sequence
         {
-            Sequence(std::vector<tool::Atom>&& _atoms, bool _has_dollar)
-            : atoms(_atoms), has_dollar(_has_dollar)
+            Sequence(tool::AtomList&& _atoms, bool _has_dollar)
+            : atoms(std::move(_atoms)), has_dollar(_has_dollar)
             {}
             
             ~Sequence() = default;
             
-            const std::vector<tool::Atom> atoms {};
+            const tool::AtomList atoms {};
             const bool has_dollar = false;
         };
         
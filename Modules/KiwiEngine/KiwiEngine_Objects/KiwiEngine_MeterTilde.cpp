@@ -53,7 +53,7 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void MeterTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void MeterTilde::receive(size_t index, tool::AtomList const& args)
     {
     }
     
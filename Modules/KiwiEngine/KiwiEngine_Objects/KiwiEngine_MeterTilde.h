@@ -48,7 +48,7 @@ namespace kiwi { namespace engine {
         
         MeterTilde(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         void perform(dsp::Buffer const& intput, dsp::Buffer& output);
         
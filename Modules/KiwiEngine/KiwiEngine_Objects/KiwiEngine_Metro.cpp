@@ -38,25 +38,34 @@ namespace kiwi { namespace engine {
         return std::make_unique<Metro>(model, patcher);
     }
     
+    //! @brief Converts a period in milliseconds, fractional periods are kept.
+    //! @details The period is clamped to a millisecond so that a null or tiny period can't make
+    //! the engine thread spin.
+    static tool::Scheduler<>::duration_t toPeriod(tool::Atom const& atom)
+    {
+        const std::chrono::duration<double, std::milli> period(std::max(atom.getFloat(), 1.));
+        
+        return std::chrono::duration_cast<tool::Scheduler<>::duration_t>(period);
+    }
+    
     Metro::Metro(model::Object const& model, Patcher& patcher):
     engine::Object(model, patcher),
-    m_period(std::chrono::milliseconds(1000)),
-    m_task(new tool::Scheduler<>::CallBack(std::bind(&Metro::timerCallBack, this)))
+    tool::Scheduler<>::Timer(patcher.getScheduler()),
+    m_period(std::chrono::milliseconds(1000))
     {
         std::vector<tool::Atom> const& args = model.getArguments();
         
         if(!args.empty())
         {
-            m_period = std::chrono::milliseconds(args[0].getInt());
+            m_period = toPeriod(args[0]);
         }
     }
     
     Metro::~Metro()
     {
-        getScheduler().unschedule(m_task);
     }
     
-    void Metro::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Metro::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty())
         {
@@ -66,12 +75,13 @@ namespace kiwi { namespace engine {
                 {
                     if (static_cast<bool>(args[0].getFloat()))
                     {
-                        getScheduler().unschedule(m_task);
+                        // the timer is started first so that the bang can stop it.
+                        startTimer(m_period);
                         timerCallBack();
                     }
                     else
                     {
-                        getScheduler().unschedule(m_task);
+                        stopTimer();
                     }
                 }
                 else
@@ -83,7 +93,8 @@ namespace kiwi { namespace engine {
             {
                 if (args[0].isNumber())
                 {
-                    m_period = std::chrono::milliseconds(args[0].getInt());
+                    m_period = toPeriod(args[0]);
+                    setTimerPeriod(m_period);
                 }
                 else
                 {
@@ -95,7 +106,6 @@ namespace kiwi { namespace engine {
     
     void Metro::timerCallBack()
     {
-        send(0, {"bang"});
-        getScheduler().schedule(m_task, m_period);
+        send(0, {tool::Symbol::bang()});
     }
 }}
@@ -29,7 +29,10 @@ namespace kiwi { namespace engine {
     //                                  OBJECT METRO                                    //
     // ================================================================================ //
     
-    class Metro final : public engine::Object
+    //! @brief Outputs a bang at a regular interval.
+    //! @details The period is given in milliseconds and can be fractional. The bangs are
+    //! scheduled on absolute deadlines so that they don't drift over time.
+    class Metro final : public engine::Object, public tool::Scheduler<>::Timer
     {
     public: // methods
         
@@ -41,14 +44,13 @@ namespace kiwi { namespace engine {
         
         ~Metro();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
-        void timerCallBack();
+        void timerCallBack() override;
         
     private: // members
         
-        tool::Scheduler<>::duration_t                   m_period;
-        std::shared_ptr<tool::Scheduler<>::CallBack>    m_task;
+        tool::Scheduler<>::duration_t   m_period;
     };
     
 }}
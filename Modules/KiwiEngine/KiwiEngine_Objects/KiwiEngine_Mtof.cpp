@@ -45,7 +45,7 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void Mtof::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Mtof::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0 && !args.empty())
         {
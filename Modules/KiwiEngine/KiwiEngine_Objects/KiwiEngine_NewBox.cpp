@@ -45,7 +45,7 @@ namespace kiwi { namespace engine {
         ;
     }
     
-    void NewBox::receive(size_t index, std::vector<tool::Atom> const& args)
+    void NewBox::receive(size_t index, tool::AtomList const& args)
     {
         ;
     }  
@@ -50,7 +50,7 @@ namespace kiwi { namespace engine {
         ;
     }
     
-    void NoiseTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void NoiseTilde::receive(size_t index, tool::AtomList const& args)
     {
         ;
     }
@@ -65,7 +65,7 @@ namespace kiwi { namespace engine {
         });
     }
     
-    void Number::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Number::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0 && !args.empty())
         {
@@ -37,7 +37,7 @@ namespace kiwi { namespace engine {
         
         void parameterChanged(std::string const& name, tool::Parameter const& param) override final;
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         static void declare();
         
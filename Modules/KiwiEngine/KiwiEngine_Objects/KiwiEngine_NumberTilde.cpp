@@ -77,7 +77,7 @@ namespace kiwi { namespace engine {
         send(0,{current_value});
     }
     
-    void NumberTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void NumberTilde::receive(size_t index, tool::AtomList const& args)
     {
     }
 }}
@@ -51,7 +51,7 @@ namespace kiwi { namespace engine {
         
         void timerCallBack() override final;
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
 
     private: // members
 
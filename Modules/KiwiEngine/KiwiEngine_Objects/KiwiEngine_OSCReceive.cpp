@@ -49,7 +49,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void OSCReceive::receive(size_t index, std::vector<tool::Atom> const& args)
+    void OSCReceive::receive(size_t index, tool::AtomList const& args)
     {
         if(index == 0 && args.size() >= 2 && args[0].getString() == "port" && args[1].isInt())
         {
@@ -82,7 +82,7 @@ namespace kiwi { namespace engine {
     
     void OSCReceive::oscMessageReceived(juce::OSCMessage const& msg)
     {
-        std::vector<tool::Atom> msg_out {msg.getAddressPattern().toString().toStdString()};
+        tool::AtomList msg_out {msg.getAddressPattern().toString().toStdString()};
         
         for(auto const& arg : msg)
         {
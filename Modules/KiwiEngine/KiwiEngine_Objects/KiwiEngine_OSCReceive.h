@@ -40,7 +40,7 @@ namespace kiwi { namespace engine {
         
         OSCReceive(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
         static void declare();
         
@@ -59,7 +59,7 @@ namespace kiwi { namespace engine {
         connectToHostAndPort(m_host, m_port);
     }
     
-    void OSCSend::receive(size_t index, std::vector<tool::Atom> const& args)
+    void OSCSend::receive(size_t index, tool::AtomList const& args)
     {
         if(args.size() >= 1 && args[0].isString() && args[0].getString() == "connect")
         {
@@ -43,7 +43,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Operator::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Operator::receive(size_t index, tool::AtomList const& args)
     {
         if(!args.empty())
         {
@@ -35,7 +35,7 @@ namespace kiwi { namespace engine {
             
             Operator(model::Object const& model, Patcher& patcher);
             
-            void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+            void receive(size_t index, tool::AtomList const& args) override final;
             
             void bang();
             
@@ -31,6 +31,8 @@ namespace kiwi { namespace engine {
     AudioObject(model, patcher),
     m_rhs()
     {
+        setInplace(true);
+        
         std::vector<tool::Atom> const& args = model.getArguments();
         
         if (!args.empty() && args[0].isNumber())
@@ -39,7 +41,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void OperatorTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void OperatorTilde::receive(size_t index, tool::AtomList const& args)
     {
         if(!args.empty())
         {
@@ -37,7 +37,7 @@ namespace kiwi { namespace engine {
         
         void prepare(dsp::Processor::PrepareInfo const& infos) override final;
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         void performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
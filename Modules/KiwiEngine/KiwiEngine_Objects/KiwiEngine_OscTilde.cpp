@@ -21,6 +21,7 @@
 
 #include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_OscTilde.h>
 #include <KiwiEngine/KiwiEngine_Factory.h>
+#include <KiwiDsp/KiwiDsp_Oscillator.h>
 
 namespace kiwi { namespace engine {
     
@@ -45,32 +46,33 @@ namespace kiwi { namespace engine {
         
         if (!args.empty() && args[0].isNumber())
         {
-            setFrequency(args[0].getFloat());
+            m_freq = args[0].getFloat();
         }
     }
     
-    void OscTilde::setFrequency(dsp::sample_t const& freq) noexcept
-    {
-        m_freq = freq;
-    }
-    
     void OscTilde::setSampleRate(dsp::sample_t const& sample_rate)
     {
         m_sr = sample_rate;
     }
     
-    void OscTilde::setOffset(dsp::sample_t const& offset) noexcept
-    {
-        m_offset = fmodf(offset, 1.f);
-    }
-    
-    void OscTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void OscTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0)
         {
             if (args[0].isNumber())
             {
-                setFrequency(args[0].getFloat());
+                m_events.push(getEventPosition(), {Control::Type::Frequency, args[0].getFloat()});
+            }
+            else if (args[0].getString() == "quality")
+            {
+                if (args.size() == 2 && (args[1].getString() == "fast" || args[1].getString() == "exact"))
+                {
+                    m_fast.store(args[1].getString() == "fast");
+                }
+                else
+                {
+                    warning("osc~ quality must be followed by fast or exact");
+                }
             }
             else
             {
@@ -81,7 +83,7 @@ namespace kiwi { namespace engine {
         {
             if (args[0].isNumber())
             {
-                setOffset(args[0].getFloat());
+                m_events.push(getEventPosition(), {Control::Type::Offset, fmodf(args[0].getFloat(), 1.f)});
             }
             else
             {
@@ -112,68 +114,120 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void OscTilde::performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    void OscTilde::performCosine(dsp::sample_t* phases, size_t size) noexcept
+    {
+        if(m_fast.load())
+        {
+            dsp::oscillator::fastCosine(phases, phases, size);
+        }
+        else
+        {
+            dsp::oscillator::cosine(phases, phases, size);
+        }
+    }
+    
+    template<class Segment>
+    void OscTilde::performControls(size_t size, Segment&& segment) noexcept
     {
-        dsp::sample_t *sig_data = output[0ul].data();
-        size_t sample_index = output[0ul].size();
-        dsp::sample_t const time_inc = m_freq/m_sr;
-        dsp::sample_t const offset = m_offset;
+        uint64_t const block_position = getBlockPosition();
         
-        while(sample_index--)
+        size_t start = 0;
+        size_t offset = 0;
+        Control control;
+        
+        while(m_events.pop(block_position, size, offset, control))
         {
-            *sig_data++ = std::cos(2.f * dsp::pi * (m_time + offset));
-            m_time += time_inc;
+            if(offset > start)
+            {
+                segment(start, offset - start);
+                start = offset;
+            }
+            
+            if(control.type == Control::Type::Frequency)
+            {
+                m_freq = control.value;
+            }
+            else
+            {
+                m_offset = control.value;
+            }
         }
         
-        m_time = fmodf(m_time, 1.f);
+        if(size > start)
+        {
+            segment(start, size - start);
+        }
+    }
+    
+    void OscTilde::performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
+    {
+        dsp::sample_t* output_sig = output[0ul].data();
+        size_t const size = output[0ul].size();
+        
+        performControls(size, [this, output_sig](size_t start, size_t count)
+        {
+            dsp::sample_t const offset = m_offset;
+            
+            m_time = dsp::oscillator::phase(output_sig + start, count, m_time + offset, m_freq / m_sr) - offset;
+        });
+        
+        performCosine(output_sig, size);
     }
     
     void OscTilde::performFreq(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t sample_index = output[0ul].size();
         dsp::sample_t* output_sig = output[0ul].data();
+        size_t const size = output[0ul].size();
         dsp::sample_t const* freq = input[0ul].data();
-        dsp::sample_t const offset = m_offset;
         
-        while(sample_index--)
+        performControls(size, [this, output_sig, freq](size_t start, size_t count)
         {
-            *output_sig++ = std::cos(2.f *dsp::pi * (m_time + offset));
-            m_time += (*freq++ / m_sr);
-        }
+            dsp::sample_t const offset = m_offset;
+            
+            m_time = dsp::oscillator::phase(output_sig + start, count, m_time + offset, freq + start, 1.f / m_sr) - offset;
+        });
         
-        m_time = fmodf(m_time, 1.f);
+        performCosine(output_sig, size);
     }
     
     void OscTilde::performPhase(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
         dsp::sample_t* output_sig = output[0ul].data();
-        size_t sample_index = output[0ul].size();
+        size_t const size = output[0ul].size();
         dsp::sample_t const* phase = input[1ul].data();
-        dsp::sample_t const time_inc = m_freq/m_sr;
         
-        while(sample_index--)
+        performControls(size, [this, output_sig](size_t start, size_t count)
+        {
+            m_time = dsp::oscillator::phase(output_sig + start, count, m_time, m_freq / m_sr);
+        });
+        
+        // the cosine is periodic, the phases don't need to be wrapped.
+        for(size_t i = 0; i < size; ++i)
         {
-            *output_sig++  = std::cos(2.f * dsp::pi * (m_time + fmodf(*phase++, 1.f)));
-            m_time += time_inc;
+            output_sig[i] += phase[i];
         }
         
-        m_time = fmodf(m_time, 1.f);
+        performCosine(output_sig, size);
     }
     
     void OscTilde::performPhaseAndFreq(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t sample_index = output[0].size();
-        dsp::sample_t* output_sig = output[0].data();
-        dsp::sample_t const* freq = input[0].data();
-        dsp::sample_t const* phase = input[1].data();
+        dsp::sample_t* output_sig = output[0ul].data();
+        size_t const size = output[0ul].size();
+        dsp::sample_t const* phase = input[1ul].data();
+        dsp::sample_t const* freq = input[0ul].data();
+        
+        performControls(size, [this, output_sig, freq](size_t start, size_t count)
+        {
+            m_time = dsp::oscillator::phase(output_sig + start, count, m_time, freq + start, 1.f / m_sr);
+        });
         
-        while(sample_index--)
+        for(size_t i = 0; i < size; ++i)
         {
-            *output_sig++  = std::cos(2.f * dsp::pi * (m_time + fmodf(*phase++, 1.f)));
-            m_time += (*freq++ / m_sr);
+            output_sig[i] += phase[i];
         }
         
-        m_time = fmodf(m_time, 1.f);
+        performCosine(output_sig, size);
     }
     
 }}
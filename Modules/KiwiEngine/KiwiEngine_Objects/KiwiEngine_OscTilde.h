@@ -39,7 +39,7 @@ namespace kiwi { namespace engine {
         
         OscTilde(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
         void performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
@@ -51,20 +51,37 @@ namespace kiwi { namespace engine {
         
         void prepare(dsp::Processor::PrepareInfo const& infos) override final;
         
-    private: // methods
+    private: // classes
         
-        void setFrequency(dsp::sample_t const& freq) noexcept;
+        //! @brief A frequency or an offset sent to the audio thread.
+        struct Control
+        {
+            enum class Type { Frequency, Offset };
+            
+            Type            type = Type::Frequency;
+            dsp::sample_t   value = 0.f;
+        };
         
-        void setOffset(dsp::sample_t const& offset) noexcept;
+    private: // methods
         
         void setSampleRate(dsp::sample_t const& sample_rate);
         
+        //! @brief Calls a segment function between the controls of the block and applies them.
+        //! @details The function receives the start and the size of each segment.
+        template<class Segment>
+        void performControls(size_t size, Segment&& segment) noexcept;
+        
+        //! @brief Replaces the phases by their cosine with the chosen quality.
+        void performCosine(dsp::sample_t* phases, size_t size) noexcept;
+        
     private: // members
         
+        dsp::EventQueue<Control> m_events {256};
         dsp::sample_t m_sr = 0.f;
         dsp::sample_t m_time = 0.f;
-        std::atomic<dsp::sample_t> m_freq{0.f};
-        std::atomic<dsp::sample_t> m_offset{0.f};
+        dsp::sample_t m_freq = 0.f;
+        dsp::sample_t m_offset = 0.f;
+        std::atomic<bool> m_fast{true};
     };
     
 }}
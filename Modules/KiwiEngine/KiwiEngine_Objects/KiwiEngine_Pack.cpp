@@ -65,7 +65,7 @@ namespace kiwi { namespace engine {
             }
             case tool::Atom::Type::String:
             {
-                m_list[index] = atom.getString();
+                m_list[index] = atom.getSymbol();
                 break;
             }
             default: break;
@@ -73,7 +73,7 @@ namespace kiwi { namespace engine {
 
     }
     
-    void Pack::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Pack::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty())
         {
@@ -83,8 +83,7 @@ namespace kiwi { namespace engine {
                 {
                     output_list();
                 }
-                else if (args[0].isString()
-                         && args[0].getString() == "set"
+                else if (args[0].getSymbol() == tool::Symbol::set()
                          && args.size() > 1)
                 {
                     setElement(index, args[1]);
@@ -97,8 +96,7 @@ namespace kiwi { namespace engine {
             }
             else
             {
-                if (args[0].isString()
-                    && args[0].getString() == "set"
+                if (args[0].getSymbol() == tool::Symbol::set()
                     && args.size() > 1)
                 {
                     setElement(index, args[1]);
@@ -43,7 +43,7 @@ namespace kiwi { namespace engine {
         
         void setElement(size_t index, tool::Atom const& atom);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
     private:
         
@@ -51,7 +51,7 @@ namespace kiwi { namespace engine {
         
     private:
         
-        std::vector<tool::Atom> m_list;
+        tool::AtomList m_list;
     };
     
 }}
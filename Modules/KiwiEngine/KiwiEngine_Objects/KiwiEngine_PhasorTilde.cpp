@@ -21,6 +21,7 @@
 
 #include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_PhasorTilde.h>
 #include <KiwiEngine/KiwiEngine_Factory.h>
+#include <KiwiDsp/KiwiDsp_Oscillator.h>
 
 namespace kiwi{ namespace engine {
     
@@ -69,7 +70,7 @@ namespace kiwi{ namespace engine {
         m_phase.store(new_phase);
     }
     
-    void PhasorTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void PhasorTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0)
         {
@@ -104,41 +105,32 @@ namespace kiwi{ namespace engine {
                                   : &PhasorTilde::performValue));
     }
     
-    dsp::sample_t PhasorTilde::getAndIncrementPhase(const dsp::sample_t inc)
-    {
-        dsp::sample_t old_phase = m_phase.load();
-        dsp::sample_t phase = old_phase;
-        
-        if(phase > 1.f) { phase -= 1.f; }
-        else if(phase < 0.f) { phase += 1.f; }
-
-        m_phase.compare_exchange_strong(old_phase, phase += inc);
-        return phase;
-    }
-    
     void PhasorTilde::performSignal(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t sampleframes = output[0ul].size();
-        dsp::sample_t const* in = input[0ul].data();
+        size_t const size = output[0ul].size();
         dsp::sample_t* out = output[0ul].data();
-        dsp::sample_t freq = 0.f;
+        dsp::sample_t phase = m_phase.load();
         
-        while(sampleframes--)
-        {
-            freq = *in++;
-            *out++ = getAndIncrementPhase(freq / m_sr);
-        }
+        const dsp::sample_t next = dsp::oscillator::phase(out, size, phase, input[0ul].data(), 1.f / m_sr);
+        
+        // each sample is the phase after its increment.
+        std::copy(out + 1, out + size, out);
+        out[size - 1] = next;
+        
+        // a phase set meanwhile is kept.
+        m_phase.compare_exchange_strong(phase, next);
     }
     
     void PhasorTilde::performValue(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t sampleframes = output[0ul].size();
-        dsp::sample_t *out = output[0ul].data();
+        size_t const size = output[0ul].size();
+        dsp::sample_t* out = output[0ul].data();
+        dsp::sample_t const inc = m_phase_inc.load();
+        dsp::sample_t phase = m_phase.load();
         
-        while(sampleframes--)
-        {
-            *out++ = getAndIncrementPhase(m_phase_inc.load());
-        }
+        dsp::oscillator::phase(out, size, phase + inc, inc);
+        
+        m_phase.compare_exchange_strong(phase, out[size - 1]);
     }
     
 }}
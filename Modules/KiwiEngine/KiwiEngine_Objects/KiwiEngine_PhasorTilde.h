@@ -39,7 +39,7 @@ namespace kiwi { namespace engine {
         
         PhasorTilde(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         void prepare(dsp::Processor::PrepareInfo const& infos) override final;
         
@@ -55,8 +55,6 @@ namespace kiwi { namespace engine {
         
         void setSampleRate(dsp::sample_t const& sample_rate);
         
-        dsp::sample_t getAndIncrementPhase(const dsp::sample_t inc);
-        
     private: // members
         
         dsp::sample_t               m_sr {0.f};
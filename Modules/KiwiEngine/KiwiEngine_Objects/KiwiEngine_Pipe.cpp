@@ -24,6 +24,37 @@
 
 namespace kiwi { namespace engine {
     
+    // ================================================================================ //
+    //                                  PIPE MESSAGE                                    //
+    // ================================================================================ //
+    
+    //! @brief A message delayed by the pipe, recycled by the scheduler once sent.
+    class Pipe::Message final : public Object::Task
+    {
+    public: // methods
+        
+        Message(Pipe& pipe, tool::AtomList const& args):
+        Object::Task(pipe),
+        m_pipe(pipe),
+        m_args(args)
+        {
+        }
+        
+        ~Message() = default;
+        
+    private: // methods
+        
+        void perform() override
+        {
+            m_pipe.send(0, m_args);
+        }
+        
+    private: // members
+        
+        Pipe&           m_pipe;
+        tool::AtomList  m_args;
+    };
+    
     // ================================================================================ //
     //                                  OBJECT PIPE                                     //
     // ================================================================================ //
@@ -54,13 +85,13 @@ namespace kiwi { namespace engine {
     {
     }
     
-    void Pipe::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Pipe::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty())
         {
             if (index == 0)
             {
-                schedule([this, args](){send(0, args);}, m_delay);
+                scheduleTask<Message>(m_delay, *this, args);
             }
             else if(index == 1)
             {
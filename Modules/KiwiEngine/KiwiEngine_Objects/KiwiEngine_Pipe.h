@@ -41,7 +41,11 @@ namespace kiwi { namespace engine {
         
         ~Pipe();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
+        
+    private: // classes
+        
+        class Message;
         
     private: // members
         
@@ -67,7 +67,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Print::receive(size_t, std::vector<tool::Atom> const& args)
+    void Print::receive(size_t, tool::AtomList const& args)
     {
         if(!args.empty())
         {
@@ -35,7 +35,7 @@ namespace kiwi { namespace engine {
         
         Print(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t, std::vector<tool::Atom> const& args) override;
+        void receive(size_t, tool::AtomList const& args) override;
         
         static void declare();
         
@@ -50,7 +50,7 @@ namespace kiwi { namespace engine {
         setSeed((args.size() > 1 && args[1].isNumber()) ? args[1].getInt() : 0ll);
     }
     
-    void Random::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Random::receive(size_t index, tool::AtomList const& args)
     {
         if(args.empty())
             return; // abort
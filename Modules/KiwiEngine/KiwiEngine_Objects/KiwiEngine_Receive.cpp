@@ -65,12 +65,12 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Receive::receive(size_t, std::vector<tool::Atom> const& args)
+    void Receive::receive(size_t, tool::AtomList const& args)
     {
         
     }
     
-    void Receive::receive(std::vector<tool::Atom> const& args)
+    void Receive::receive(tool::AtomList const& args)
     {
         defer([this, args]()
         {
@@ -44,10 +44,10 @@ namespace kiwi { namespace engine {
         ~Receive();
         
         //! @brief inlets receive.
-        void receive(size_t, std::vector<tool::Atom> const& args) override;
+        void receive(size_t, tool::AtomList const& args) override;
         
         //! @brief beacon receive.
-        void receive(std::vector<tool::Atom> const& args) override;
+        void receive(tool::AtomList const& args) override;
         
     private: // members
         
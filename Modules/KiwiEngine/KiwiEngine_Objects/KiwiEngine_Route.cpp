@@ -50,7 +50,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Route::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Route::receive(size_t index, tool::AtomList const& args)
     {
         // handle custom selector special case
         if(index == 1 && !args.empty())
@@ -64,7 +64,10 @@ namespace kiwi { namespace engine {
             const auto& first_arg = args.front();
             const bool is_list = args.size() > 1;
             
-            const std::vector<tool::Atom> bang_msg = {"bang"};
+            static const tool::AtomList bang_msg = {tool::Symbol::bang()};
+            static const tool::Symbol int_sym("int");
+            static const tool::Symbol float_sym("float");
+            static const tool::Symbol list_sym("list");
             
             auto send_if = [&](const size_t out, bool remove_first_elem = true) {
                 
@@ -74,7 +77,7 @@ namespace kiwi { namespace engine {
                 }
                 else if (is_list)
                 {
-                    send(out, {args.begin()+1, args.end()});
+                    send(out, tool::AtomList(args.begin() + 1, args.end()));
                 }
                 else
                 {
@@ -90,18 +93,18 @@ namespace kiwi { namespace engine {
                 
                 if(arg.isString())
                 {
-                    const auto& str = arg.getString();
+                    const tool::Symbol sym = arg.getSymbol();
                     
-                    if(first_arg.isString() && (first_arg.getString() == str))
+                    if(first_arg.isString() && (first_arg.getSymbol() == sym))
                     {
                         send_if(i);
                         input_matched = true;
                         continue;
                     }
                     
-                    if ((!is_list && str == "int" && first_arg.isInt())
-                        || (!is_list && str == "float" && first_arg.isFloat())
-                        || (is_list && str == "list"))
+                    if ((!is_list && sym == int_sym && first_arg.isInt())
+                        || (!is_list && sym == float_sym && first_arg.isFloat())
+                        || (is_list && sym == list_sym))
                     {
                         send_if(i, false);
                         input_matched = true;
@@ -35,7 +35,7 @@ namespace kiwi { namespace engine {
         
         Route(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
         static void declare();
         
@@ -43,7 +43,7 @@ namespace kiwi { namespace engine {
         
     private: // members
         
-        std::vector<tool::Atom> m_args {};
+        tool::AtomList m_args {};
     };
     
 }}
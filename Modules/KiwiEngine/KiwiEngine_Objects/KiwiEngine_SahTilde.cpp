@@ -54,7 +54,7 @@ namespace kiwi{ namespace engine {
         m_threshold.store(value);
     }
     
-    void SahTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void SahTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 1 && !args.empty())
         {
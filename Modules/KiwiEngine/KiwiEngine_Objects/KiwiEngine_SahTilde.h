@@ -39,7 +39,7 @@ namespace kiwi { namespace engine {
         
         SahTilde(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
         void prepare(dsp::Processor::PrepareInfo const& infos) override final;
         
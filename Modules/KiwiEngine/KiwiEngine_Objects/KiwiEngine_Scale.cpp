@@ -64,7 +64,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Scale::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Scale::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0)
         {
@@ -39,7 +39,7 @@ namespace kiwi { namespace engine {
         
         Scale(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
     private:
         
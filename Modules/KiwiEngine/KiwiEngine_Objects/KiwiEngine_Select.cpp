@@ -43,12 +43,12 @@ namespace kiwi { namespace engine {
     , m_list(model.getArguments())
     {}
     
-    void Select::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Select::receive(size_t index, tool::AtomList const& args)
     {
         if(args.empty())
             return; // abort
         
-        static const std::vector<tool::Atom> bang_msg = {"bang"};
+        static const tool::AtomList bang_msg = {tool::Symbol::bang()};
         
         tool::Atom const& input = args[0];
         
@@ -61,7 +61,7 @@ namespace kiwi { namespace engine {
                 if ((input.isNumber()
                      && (input.getFloat() == selector.getFloat()))
                     || (input.isString()
-                        && (input.getString() == selector.getString())))
+                        && (input.getSymbol() == selector.getSymbol())))
                 {
                     send(i, bang_msg);
                     return;
@@ -43,11 +43,11 @@ namespace kiwi { namespace engine {
         
         ~Select() = default;
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
     private:
         
-        std::vector<tool::Atom> m_list;
+        tool::AtomList m_list;
     };
     
 }}
@@ -42,7 +42,7 @@ namespace kiwi { namespace engine {
         
         Send() = default;
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
     private:
         
@@ -19,11 +19,92 @@
  ==============================================================================
  */
 
+#include <atomic>
+
 #include <KiwiEngine/KiwiEngine_Objects/KiwiEngine_SfPlayTilde.h>
 #include <KiwiEngine/KiwiEngine_Factory.h>
 
 namespace kiwi { namespace engine {
     
+    // ================================================================================ //
+    //                          SOUNDFILE PLAYER PAGE LOADER                             //
+    // ================================================================================ //
+    
+    //! @brief Loads the pages of a memory-mapped file on a disk thread.
+    //! @details A bounded number of pages is touched per time slice so that the other
+    //! clients of the thread keep being served.
+    class SoundFilePlayer::PageLoader : public juce::TimeSliceClient
+    {
+    public: // methods
+        
+        PageLoader(std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader,
+                   double start_ms,
+                   double end_ms,
+                   pagesLoadedCallback loaded_callback)
+        : m_reader(std::move(reader))
+        , m_start_ms(start_ms)
+        , m_end_ms(end_ms)
+        , m_loaded_callback(std::move(loaded_callback))
+        {
+            const int64_t frame_size = std::max<int64_t>(m_reader->numChannels * m_reader->bitsPerSample / 8, 1);
+            m_frames_per_page = std::max<int64_t>(page_size / frame_size, 1);
+        }
+        
+        ~PageLoader() = default;
+        
+        int useTimeSlice() override
+        {
+            const int64_t length = m_reader->lengthInSamples;
+            const int64_t end = std::min<int64_t>(m_next_frame + m_frames_per_page * pages_per_slice, length);
+            
+            for(; m_next_frame < end; m_next_frame += m_frames_per_page)
+            {
+                m_reader->touchSample(m_next_frame);
+            }
+            
+            if(m_next_frame < length)
+            {
+                return 0;
+            }
+            
+            m_loaded.store(true);
+            
+            if(m_loaded_callback)
+            {
+                m_loaded_callback();
+            }
+            
+            // the loader leaves the thread.
+            return -1;
+        }
+        
+        bool isLoaded() const
+        {
+            return m_loaded.load();
+        }
+        
+        std::unique_ptr<juce::AudioFormatReader> releaseReader()
+        {
+            return std::move(m_reader);
+        }
+        
+        double getStart() const { return m_start_ms; }
+        double getEnd() const { return m_end_ms; }
+        
+    private: // members
+        
+        static const int64_t page_size = 4096;
+        static const int64_t pages_per_slice = 256;
+        
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> m_reader;
+        const double m_start_ms;
+        const double m_end_ms;
+        const pagesLoadedCallback m_loaded_callback;
+        int64_t m_frames_per_page {1};
+        int64_t m_next_frame {0};
+        std::atomic<bool> m_loaded {false};
+    };
+    
     // ================================================================================ //
     //                                SOUNDFILE PLAYER                                  //
     // ================================================================================ //
@@ -31,8 +112,11 @@ namespace kiwi { namespace engine {
     //! @note the SoundFilePlayer class is based on the juce tutorial :
     // https://docs.juce.com/master/tutorial_playing_sound_files.html
     
-    SoundFilePlayer::SoundFilePlayer()
-    : m_buffer()
+    SoundFilePlayer::SoundFilePlayer(DiskThreadPool& disk_thread_pool)
+    : m_disk_thread_pool(disk_thread_pool)
+    , m_channels(0)
+    , m_read_ahead(32768)
+    , m_buffer()
     , m_audio_source_channel_info(m_buffer)
     {
         m_format_manager.registerBasicFormats();
@@ -48,8 +132,59 @@ namespace kiwi { namespace engine {
     {
         stop();
         
-        std::unique_ptr<juce::AudioFormatReader> reader (m_format_manager.createReaderFor(file));
+        std::unique_ptr<juce::AudioFormatReader> reader (createReader(file));
+        
+        auto* mapped_reader = dynamic_cast<juce::MemoryMappedAudioFormatReader*>(reader.get());
+        
+        if (mapped_reader != nullptr && m_read_ahead == 0)
+        {
+            // the audio thread reads the mapping, its pages are loaded first on a disk thread.
+            
+            reader.release();
+            
+            m_page_loader.reset(new PageLoader(std::unique_ptr<juce::MemoryMappedAudioFormatReader>(mapped_reader),
+                                               start_ms, end_ms, m_pages_loaded_callback));
+            
+            m_page_loader_thread = &m_disk_thread_pool.getThread();
+            m_page_loader_thread->addTimeSliceClient(m_page_loader.get());
+            
+            return true;
+        }
         
+        return play(std::move(reader), start_ms, end_ms);
+    }
+    
+    void SoundFilePlayer::startLoaded()
+    {
+        if (m_page_loader != nullptr && m_page_loader->isLoaded())
+        {
+            // waits until the loader has returned from its last time slice.
+            
+            m_page_loader_thread->removeTimeSliceClient(m_page_loader.get());
+            
+            const double start_ms = m_page_loader->getStart();
+            const double end_ms = m_page_loader->getEnd();
+            std::unique_ptr<juce::AudioFormatReader> reader = m_page_loader->releaseReader();
+            
+            m_page_loader.reset();
+            m_page_loader_thread = nullptr;
+            
+            play(std::move(reader), start_ms, end_ms);
+        }
+    }
+    
+    void SoundFilePlayer::cancelLoading()
+    {
+        if (m_page_loader != nullptr)
+        {
+            m_page_loader_thread->removeTimeSliceClient(m_page_loader.get());
+            m_page_loader.reset();
+            m_page_loader_thread = nullptr;
+        }
+    }
+    
+    bool SoundFilePlayer::play(std::unique_ptr<juce::AudioFormatReader> reader, double start_ms, double end_ms)
+    {
         if (reader)
         {
             const auto sf_frames = reader->lengthInSamples;
@@ -71,16 +206,21 @@ namespace kiwi { namespace engine {
                 
                 auto new_source = std::make_unique<juce::AudioFormatReaderSource>(subsection_reader,
                                                                                   true);
-                int read_ahead = 0;
+                // the transport buffers the source and fills the buffer on a disk thread
+                // so the audio thread only copies samples from memory.
+                
+                const int read_ahead = static_cast<int>(m_read_ahead);
+                
                 m_transport_source.setSource(new_source.get(),
                                              read_ahead,
-                                             nullptr,
+                                             read_ahead > 0 ? &m_disk_thread_pool.getThread() : nullptr,
                                              subsection_reader->sampleRate,
                                              getNumberOfChannels());
                 
                 m_reader_source.reset(new_source.release());
                 setLoop(is_looping);
                 changeState(Starting);
+                return true;
             }
         }
         
@@ -89,6 +229,7 @@ namespace kiwi { namespace engine {
     
     void SoundFilePlayer::stop()
     {
+        cancelLoading();
         changeState(Stopping);
     }
     
@@ -116,6 +257,46 @@ namespace kiwi { namespace engine {
         return m_channels;
     }
     
+    void SoundFilePlayer::setReadAhead(size_t frames)
+    {
+        m_read_ahead = frames;
+    }
+    
+    size_t SoundFilePlayer::getReadAhead() const
+    {
+        return m_read_ahead;
+    }
+    
+    void SoundFilePlayer::setMemoryMapping(bool should_map)
+    {
+        m_memory_mapping = should_map;
+    }
+    
+    bool SoundFilePlayer::isMemoryMapping() const
+    {
+        return m_memory_mapping;
+    }
+    
+    std::unique_ptr<juce::AudioFormatReader> SoundFilePlayer::createReader(juce::File const& file)
+    {
+        if(m_memory_mapping)
+        {
+            // only uncompressed formats provide memory-mapped readers.
+            
+            if(auto* format = m_format_manager.findFormatForFileExtension(file.getFileExtension()))
+            {
+                std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader (format->createMemoryMappedReader(file));
+                
+                if(reader && reader->mapEntireFile())
+                {
+                    return std::move(reader);
+                }
+            }
+        }
+        
+        return std::unique_ptr<juce::AudioFormatReader>(m_format_manager.createReaderFor(file));
+    }
+    
     juce::String SoundFilePlayer::getSupportedFormats() const
     {
         return m_format_manager.getWildcardForAllFormats();
@@ -155,6 +336,11 @@ namespace kiwi { namespace engine {
         m_playing_stopped_callback = std::move(fn);
     }
     
+    void SoundFilePlayer::setPagesLoadedCallback(pagesLoadedCallback && fn)
+    {
+        m_pages_loaded_callback = std::move(fn);
+    }
+    
     void SoundFilePlayer::prepare(double sample_rate, size_t vector_size)
     {
         m_buffer.setSize(getNumberOfChannels(), vector_size);
@@ -243,6 +429,42 @@ namespace kiwi { namespace engine {
         }
     }
     
+    // ================================================================================ //
+    //                                   SFPLAY~ TASKS                                  //
+    // ================================================================================ //
+    
+    class SfPlayTilde::BangTask : public tool::Scheduler<>::Task
+    {
+    public: // methods
+        
+        BangTask(SfPlayTilde& owner) : m_owner(owner) {}
+        ~BangTask() = default;
+        
+        void execute() override
+        {
+            m_owner.send(m_owner.getNumberOfOutputs() - 1, {tool::Symbol::bang()});
+        }
+        
+    private: // members
+        SfPlayTilde& m_owner;
+    };
+    
+    class SfPlayTilde::StartTask : public tool::Scheduler<>::Task
+    {
+    public: // methods
+        
+        StartTask(SfPlayTilde& owner) : m_owner(owner) {}
+        ~StartTask() = default;
+        
+        void execute() override
+        {
+            m_owner.m_player.startLoaded();
+        }
+        
+    private: // members
+        SfPlayTilde& m_owner;
+    };
+    
     // ================================================================================ //
     //                                       SFPLAY~                                    //
     // ================================================================================ //
@@ -259,24 +481,37 @@ namespace kiwi { namespace engine {
     
     SfPlayTilde::SfPlayTilde(model::Object const& model, Patcher& patcher)
     : AudioObject(model, patcher)
+    , m_bang_task(std::make_shared<BangTask>(*this))
+    , m_start_task(std::make_shared<StartTask>(*this))
+    , m_player(getDiskThreadPool())
     {
         const auto& args = model.getArguments();
         const auto channels = !args.empty() && args[0].getInt() > 0 ? args[0].getInt() : 2;
         m_player.setNumberOfChannels(channels);
         
+        // the callback can be called by the audio thread, the task is preallocated.
+        
         m_player.setPlayingStoppedCallback([this](){
-            defer([this](){
-                send(getNumberOfOutputs() - 1, {"bang"});
-            });
+            getScheduler().defer(m_bang_task);
+        });
+        
+        // the playback of a memory-mapped file waits for its pages on the engine thread.
+        
+        m_player.setPagesLoadedCallback([this](){
+            getScheduler().defer(m_start_task);
         });
     }
     
     SfPlayTilde::~SfPlayTilde()
     {
+        m_player.setPlayingStoppedCallback(nullptr);
+        m_player.stop();
+        getScheduler().unschedule(m_start_task);
+        getScheduler().unschedule(m_bang_task);
         closeFileDialog();
     }
     
-    void SfPlayTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void SfPlayTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty() && index == 0)
         {
@@ -331,6 +566,28 @@ namespace kiwi { namespace engine {
                     warning("sf.play~: loop message must be followed by 0 or 1");
                 }
             }
+            else if (args[0].getString() == "readahead")
+            {
+                if(args.size() == 2 && args[1].isNumber() && args[1].getInt() >= 0)
+                {
+                    m_player.setReadAhead(args[1].getInt());
+                }
+                else
+                {
+                    warning("sf.play~: readahead message must be followed by a number of samples, 0 to read on the audio thread");
+                }
+            }
+            else if (args[0].getString() == "mmap")
+            {
+                if(args.size() == 2 && args[1].isNumber())
+                {
+                    m_player.setMemoryMapping(args[1].getInt());
+                }
+                else
+                {
+                    warning("sf.play~: mmap message must be followed by 0 or 1");
+                }
+            }
             else if (args[0].getString() == "print")
             {
                 post("*sfplay~ infos*");
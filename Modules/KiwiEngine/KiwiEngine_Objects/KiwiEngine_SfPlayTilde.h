@@ -22,6 +22,7 @@
 #pragma once
 
 #include <KiwiEngine/KiwiEngine_Object.h>
+#include <KiwiEngine/KiwiEngine_DiskThreadPool.h>
 #include <juce_core/juce_core.h>
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_audio_devices/juce_audio_devices.h>
@@ -38,14 +39,24 @@ namespace kiwi { namespace engine {
     {
     public: // methods
         
-        SoundFilePlayer();
+        //! @brief Constructor.
+        //! @param disk_thread_pool The threads used to read the files ahead.
+        SoundFilePlayer(DiskThreadPool& disk_thread_pool);
+        
         ~SoundFilePlayer();
         
         //! @brief Starts reading file from start pos to end pos.
         //! @details if end time is greater than starting time,
-        //! file will be played from the start position to the end of the file
+        //! file will be played from the start position to the end of the file.
+        //! A memory-mapped file without read-ahead is played once its pages are loaded.
+        //! @see startLoaded
         bool start(const juce::File& file, double start_ms = 0., double end_ms = -1.);
         
+        //! @brief Starts the file whose pages were loaded on a disk thread.
+        //! @details Shall be called on the thread that called start once the pages loaded
+        //! callback was called, does nothing if the loading was stopped meanwhile.
+        void startLoaded();
+        
         void stop();
         
         bool isPlaying() const;
@@ -56,6 +67,21 @@ namespace kiwi { namespace engine {
         
         size_t getNumberOfChannels() const;
         
+        //! @brief Sets the number of frames read ahead on a disk thread.
+        //! @details Zero reads the file directly on the audio thread.
+        //! Applies to the next call to start.
+        void setReadAhead(size_t frames);
+        
+        size_t getReadAhead() const;
+        
+        //! @brief Maps uncompressed files (WAV, AIFF) in memory instead of streaming them.
+        //! @details Applies to the next call to start. Without read-ahead the audio thread reads
+        //! the mapping directly, so its pages are first loaded on a disk thread and the playback
+        //! only starts when they're all loaded.
+        void setMemoryMapping(bool should_map);
+        
+        bool isMemoryMapping() const;
+        
         juce::String getSupportedFormats() const;
         
         void prepare(double sample_rate, size_t vector_size);
@@ -67,6 +93,11 @@ namespace kiwi { namespace engine {
         using playingStoppedCallback = std::function<void(void)>;
         void setPlayingStoppedCallback(playingStoppedCallback && fn);
         
+        //! @brief Sets the function called on a disk thread when the pages of a file are loaded.
+        //! @details The function shall make the owner's thread call startLoaded.
+        using pagesLoadedCallback = std::function<void(void)>;
+        void setPagesLoadedCallback(pagesLoadedCallback && fn);
+        
         //! @brief Print file infos.
         void printInfos(juce::File file,
                         std::function<void(juce::String const&)> printer);
@@ -85,9 +116,28 @@ namespace kiwi { namespace engine {
         
         void changeState(TransportState new_state);
         
+        //! @brief Creates a memory-mapped reader if required and possible or a stream reader.
+        std::unique_ptr<juce::AudioFormatReader> createReader(juce::File const& file);
+        
+        //! @brief Plays a reader from start pos to end pos.
+        bool play(std::unique_ptr<juce::AudioFormatReader> reader, double start_ms, double end_ms);
+        
+        //! @brief Stops loading the pages of a file, waits if a disk thread is loading them.
+        void cancelLoading();
+        
     private:
         
+        class PageLoader;
+        
+        DiskThreadPool& m_disk_thread_pool;
+        
+        std::unique_ptr<PageLoader> m_page_loader {nullptr};
+        juce::TimeSliceThread* m_page_loader_thread {nullptr};
+        pagesLoadedCallback m_pages_loaded_callback {nullptr};
+        
         size_t m_channels;
+        size_t m_read_ahead;
+        bool m_memory_mapping {false};
         
         playingStoppedCallback m_playing_stopped_callback {nullptr};
         
@@ -114,7 +164,7 @@ namespace kiwi { namespace engine {
         SfPlayTilde(model::Object const& model, Patcher& patcher);
         ~SfPlayTilde();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
     private:
         
@@ -137,6 +187,12 @@ namespace kiwi { namespace engine {
         juce::File m_file_to_read;
         std::unique_ptr<juce::FileChooser> m_file_chooser;
         
+        class BangTask;
+        std::shared_ptr<BangTask> m_bang_task;
+        
+        class StartTask;
+        std::shared_ptr<StartTask> m_start_task;
+        
         SoundFilePlayer m_player;
     };
     
@@ -28,9 +28,25 @@ namespace kiwi { namespace engine {
     //                               SOUNDFILE RECORDER                                 //
     // ================================================================================ //
     
+    //! @brief The duration of audio the ring buffer can hold in seconds.
+    static const double buffer_duration = 4.;
+    
+    //! @brief The maximum number of frames written into the file at once.
+    static const size_t drain_frames = 4096;
+    
+    SoundFileRecorder::Stream::Stream(size_t channels,
+                                      size_t capacity,
+                                      std::unique_ptr<juce::AudioFormatWriter> writer)
+    : m_channels(channels)
+    , m_ring(capacity)
+    , m_writer(std::move(writer))
+    {
+    }
+    
     //! @note the SoundFileRecorder class is based on the juce Demo App
     SoundFileRecorder::SoundFileRecorder()
-    : m_background_thread("SoundFile Recorder Thread")
+    : m_channels(1)
+    , m_background_thread("SoundFile Recorder Thread")
     {
         m_background_thread.startThread();
     }
@@ -55,9 +71,9 @@ namespace kiwi { namespace engine {
             return false; // abort
         
         // Now create a WAV writer object that writes to our output stream...
+        // (32 bits are written as floating point samples)
         juce::WavAudioFormat wav_format;
         
-        const int bit_per_sample = 16;
         const int quality_option = 0;
         const juce::StringPairArray metadata {};
         const int nchan = getNumberOfChannels();
@@ -69,12 +85,12 @@ namespace kiwi { namespace engine {
             return false;
         }
         
-        auto* writer = wav_format.createWriterFor(file_stream.get(),
-                                                  m_sample_rate,
-                                                  channel_set,
-                                                  bit_per_sample,
-                                                  metadata,
-                                                  quality_option);
+        std::unique_ptr<juce::AudioFormatWriter> writer (wav_format.createWriterFor(file_stream.get(),
+                                                                                    m_sample_rate,
+                                                                                    channel_set,
+                                                                                    m_bits_per_sample,
+                                                                                    metadata,
+                                                                                    quality_option));
         
         if (writer == nullptr)
             return false; // abort
@@ -82,42 +98,58 @@ namespace kiwi { namespace engine {
         // (passes responsibility for deleting the stream to the writer object that is now using it)
         file_stream.release();
         
-        // Now we'll create one of these helper objects which will act as a FIFO buffer, and will
-        // write the data to disk on our background thread.
-        m_threaded_writer.reset(new juce::AudioFormatWriter::ThreadedWriter(writer,
-                                                                            m_background_thread,
-                                                                            32768));
+        const size_t capacity = static_cast<size_t>(m_sample_rate * buffer_duration) * nchan;
+        m_stream.reset(new Stream(nchan, capacity, std::move(writer)));
+        
+        m_drain_interleaved.resize(drain_frames * nchan);
+        m_drain_channels.assign(nchan, std::vector<float>(drain_frames));
+        m_drain_channels_ref.resize(nchan);
         
-        // And now, swap over our active writer pointer so that the audio callback will start using it..
-        const std::lock_guard<std::mutex> lock (m_writer_lock);
-        m_active_writer = m_threaded_writer.get();
+        for(size_t channel = 0; channel < nchan; ++channel)
+        {
+            m_drain_channels_ref[channel] = m_drain_channels[channel].data();
+        }
+        
+        m_dropped_frames.store(0);
+        m_high_water_mark.store(0);
+        
+        m_background_thread.addTimeSliceClient(this);
+        
+        // And now, swap over our active stream pointer so that the audio callback will start using it..
+        m_active_stream.store(m_stream.get());
         
         return true;
     }
     
     void SoundFileRecorder::stop()
     {
-        // First, clear this pointer to stop the audio callback from using our writer object..
+        // First, clear this pointer and wait for the audio callback to stop using the stream..
+        m_active_stream.store(nullptr);
+        
+        while(m_writing.load())
         {
-            const std::lock_guard<std::mutex> lock (m_writer_lock);
-            m_active_writer = nullptr;
+            std::this_thread::yield();
         }
         
-        // Now we can delete the writer object. It's done in this order because the deletion could
-        // take a little time while remaining data gets flushed to disk, so it's best to avoid blocking
-        // the audio callback while this happens.
-        m_threaded_writer.reset();
+        // Then the remaining frames are written and the file is closed on this thread.
+        m_background_thread.removeTimeSliceClient(this);
+        
+        if(m_stream)
+        {
+            while(drain() > 0) {}
+            
+            m_stream.reset();
+        }
     }
     
     bool SoundFileRecorder::isRecording() const
     {
-        return m_active_writer != nullptr;
+        return m_active_stream.load() != nullptr;
     }
     
     void SoundFileRecorder::setNumberOfChannels(size_t channels)
     {
         m_channels = channels > 0 ? channels : m_channels;
-        m_buffer_ref.resize(m_channels);
     }
     
     size_t SoundFileRecorder::getNumberOfChannels() const
@@ -125,30 +157,156 @@ namespace kiwi { namespace engine {
         return m_channels;
     }
     
+    bool SoundFileRecorder::setBitsPerSample(int bits_per_sample)
+    {
+        if(bits_per_sample == 16 || bits_per_sample == 24 || bits_per_sample == 32)
+        {
+            m_bits_per_sample = bits_per_sample;
+            return true;
+        }
+        
+        return false;
+    }
+    
+    int SoundFileRecorder::getBitsPerSample() const
+    {
+        return m_bits_per_sample;
+    }
+    
+    size_t SoundFileRecorder::getDroppedFrames() const
+    {
+        return m_dropped_frames.load();
+    }
+    
+    size_t SoundFileRecorder::getHighWaterMark() const
+    {
+        return m_high_water_mark.load();
+    }
+    
+    size_t SoundFileRecorder::getBufferCapacity() const
+    {
+        return m_stream ? m_stream->m_ring.capacity() / m_stream->m_channels : 0;
+    }
+    
     void SoundFileRecorder::prepare(double sample_rate, size_t vector_size)
     {
         m_sample_rate = sample_rate;
         m_vector_size = vector_size;
+        m_interleaved.resize(m_channels * vector_size);
     }
     
     bool SoundFileRecorder::write(dsp::Buffer const& input)
     {
-        const std::lock_guard<std::mutex> lock (m_writer_lock);
+        // the flag is raised before the stream is loaded so stop can wait for it to be lowered.
+        
+        m_writing.store(true);
         
-        if (m_active_writer != nullptr)
+        Stream* stream = m_active_stream.load();
+        bool written = false;
+        
+        if (stream != nullptr && m_interleaved.size() == stream->m_channels * m_vector_size)
         {
-            const auto channels = input.getNumberOfChannels();
-            for(auto channel = 0; channel < channels; ++channel)
+            const size_t channels = stream->m_channels;
+            const size_t input_channels = std::min(channels, input.getNumberOfChannels());
+            
+            for(size_t channel = 0; channel < channels; ++channel)
             {
-                m_buffer_ref[channel] = input[channel].data();
+                float* interleaved = m_interleaved.data() + channel;
+                
+                if(channel < input_channels)
+                {
+                    dsp::sample_t const* samples = input[channel].data();
+                    
+                    for(size_t i = 0; i < m_vector_size; ++i, interleaved += channels)
+                    {
+                        *interleaved = static_cast<float>(samples[i]);
+                    }
+                }
+                else
+                {
+                    for(size_t i = 0; i < m_vector_size; ++i, interleaved += channels)
+                    {
+                        *interleaved = 0.f;
+                    }
+                }
             }
             
-            return m_active_writer->write(m_buffer_ref.data(), m_vector_size);
+            if(stream->m_ring.write(m_interleaved.data(), m_interleaved.size()))
+            {
+                const size_t pending_frames = stream->m_ring.size() / channels;
+                
+                if(pending_frames > m_high_water_mark.load(std::memory_order_relaxed))
+                {
+                    m_high_water_mark.store(pending_frames, std::memory_order_relaxed);
+                }
+                
+                written = true;
+            }
+            else
+            {
+                m_dropped_frames.fetch_add(m_vector_size, std::memory_order_relaxed);
+            }
         }
         
-        return false;
+        m_writing.store(false);
+        
+        return written;
+    }
+    
+    int SoundFileRecorder::useTimeSlice()
+    {
+        return drain() > 0 ? 0 : 10;
+    }
+    
+    size_t SoundFileRecorder::drain()
+    {
+        Stream& stream = *m_stream;
+        
+        const size_t channels = stream.m_channels;
+        const size_t frames = stream.m_ring.read(m_drain_interleaved.data(), m_drain_interleaved.size()) / channels;
+        
+        for(size_t channel = 0; channel < channels; ++channel)
+        {
+            float const* interleaved = m_drain_interleaved.data() + channel;
+            float* samples = m_drain_channels[channel].data();
+            
+            for(size_t i = 0; i < frames; ++i, interleaved += channels)
+            {
+                samples[i] = *interleaved;
+            }
+        }
+        
+        if(frames > 0)
+        {
+            stream.m_writer->writeFromFloatArrays(m_drain_channels_ref.data(),
+                                                  static_cast<int>(channels),
+                                                  static_cast<int>(frames));
+        }
+        
+        return frames;
     }
     
+    // ================================================================================ //
+    //                                  SFRECORD~ TASK                                  //
+    // ================================================================================ //
+    
+    class SfRecordTilde::StopTask : public tool::Scheduler<>::Task
+    {
+    public: // methods
+        
+        StopTask(SfRecordTilde& owner) : m_owner(owner) {}
+        ~StopTask() = default;
+        
+        void execute() override
+        {
+            m_owner.m_writer_count = 0;
+            m_owner.m_recorder.stop();
+        }
+        
+    private: // members
+        SfRecordTilde& m_owner;
+    };
+    
     // ================================================================================ //
     //                                     SFRECORD~                                    //
     // ================================================================================ //
@@ -165,16 +323,18 @@ namespace kiwi { namespace engine {
     
     SfRecordTilde::SfRecordTilde(model::Object const& model, Patcher& patcher)
     : AudioObject(model, patcher)
+    , m_stop_task(std::make_shared<StopTask>(*this))
     {
         m_recorder.setNumberOfChannels(getNumberOfInputs());
     }
     
     SfRecordTilde::~SfRecordTilde()
     {
+        getScheduler().unschedule(m_stop_task);
         closeFileDialog();
     }
     
-    void SfRecordTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void SfRecordTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty() && index == 0)
         {
@@ -217,6 +377,22 @@ namespace kiwi { namespace engine {
                 
                 record(duration_ms);
             }
+            else if (args[0].getString() == "bits")
+            {
+                if(!(args.size() == 2 && args[1].isNumber() && m_recorder.setBitsPerSample(args[1].getInt())))
+                {
+                    warning("sf.record~: bits message must be followed by 16, 24 or 32 (floating point)");
+                }
+            }
+            else if (args[0].getString() == "print")
+            {
+                post("*sf.record~ infos*");
+                post("- bits per sample: " + std::to_string(m_recorder.getBitsPerSample()));
+                post("- recording: " + std::string(m_recorder.isRecording() ? "yes" : "no"));
+                post("- buffer capacity: " + std::to_string(m_recorder.getBufferCapacity()) + " samples");
+                post("- buffer high water mark: " + std::to_string(m_recorder.getHighWaterMark()) + " samples");
+                post("- dropped samples: " + std::to_string(m_recorder.getDroppedFrames()));
+            }
         }
     }
     
@@ -314,10 +490,9 @@ namespace kiwi { namespace engine {
     
     void SfRecordTilde::stop()
     {
-        defer([this]{
-            m_writer_count = 0;
-            m_recorder.stop();
-        });
+        // the task is preallocated because the stop can be requested by the audio thread.
+        
+        getScheduler().defer(m_stop_task);
     }
     
     void SfRecordTilde::record(double duration_ms)
@@ -21,7 +21,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <thread>
+
 #include <KiwiEngine/KiwiEngine_Object.h>
+#include <KiwiTool/KiwiTool_RingBuffer.h>
 #include <juce_core/juce_core.h>
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_gui_basics/juce_gui_basics.h>
@@ -32,7 +36,12 @@ namespace kiwi { namespace engine {
     //                               SOUNDFILE RECORDER                                 //
     // ================================================================================ //
     
+    //! @brief Writes the samples of the audio thread into a file.
+    //! @details The audio thread interleaves its samples into a wait-free ring buffer
+    //! that a dedicated thread drains into the file. The ring holds a few seconds of audio,
+    //! the frames that don't fit are dropped and counted.
     class SoundFileRecorder
+    : public juce::TimeSliceClient
     {
     public: // methods
         
@@ -46,28 +55,70 @@ namespace kiwi { namespace engine {
         
         bool isRecording() const;
         
+        //! @brief Pushes a block of samples, called by the audio thread.
+        //! @return false if not recording or if the block was dropped.
         bool write(dsp::Buffer const& input);
         
         void setNumberOfChannels(size_t channels);
         
         size_t getNumberOfChannels() const;
         
+        //! @brief Sets the bit depth of the next files (16, 24 or 32 for floating point).
+        bool setBitsPerSample(int bits_per_sample);
+        
+        int getBitsPerSample() const;
+        
+        //! @brief Returns the number of frames dropped since the recording started.
+        size_t getDroppedFrames() const;
+        
+        //! @brief Returns the maximum number of frames the buffer held since the recording started.
+        size_t getHighWaterMark() const;
+        
+        //! @brief Returns the number of frames the buffer can hold.
+        size_t getBufferCapacity() const;
+        
         void prepare(double sample_rate, size_t vector_size);
         
-    private:
+    private: // methods
         
-        size_t m_channels;
+        //! @brief Writes the pending frames into the file, called by the writer thread.
+        int useTimeSlice() override;
         
-        std::vector<float const*> m_buffer_ref;
+        //! @brief Moves the pending frames of the ring buffer into the file.
+        //! @return The number of frames written.
+        size_t drain();
         
-        juce::TimeSliceThread m_background_thread;
-        std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> m_threaded_writer = nullptr;
+    private: // classes
+        
+        struct Stream
+        {
+            Stream(size_t channels, size_t capacity, std::unique_ptr<juce::AudioFormatWriter> writer);
+            
+            const size_t                                m_channels;
+            tool::RingBuffer<float>                     m_ring;
+            std::unique_ptr<juce::AudioFormatWriter>    m_writer;
+        };
+        
+    private: // members
+        
+        size_t m_channels;
+        int m_bits_per_sample {16};
         
         double m_sample_rate = 0.;
         size_t m_vector_size = 0;
         
-        std::mutex m_writer_lock;
-        juce::AudioFormatWriter::ThreadedWriter* m_active_writer {nullptr};
+        juce::TimeSliceThread m_background_thread;
+        std::unique_ptr<Stream> m_stream;
+        
+        std::vector<float> m_interleaved;
+        std::vector<float> m_drain_interleaved;
+        std::vector<std::vector<float>> m_drain_channels;
+        std::vector<float*> m_drain_channels_ref;
+        
+        std::atomic<Stream*> m_active_stream {nullptr};
+        std::atomic<bool> m_writing {false};
+        std::atomic<size_t> m_dropped_frames {0};
+        std::atomic<size_t> m_high_water_mark {0};
     };
     
     // ================================================================================ //
@@ -87,7 +138,7 @@ namespace kiwi { namespace engine {
         
         ~SfRecordTilde();
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
     private:
         
@@ -109,7 +160,11 @@ namespace kiwi { namespace engine {
         juce::File m_file_to_write;
         std::unique_ptr<juce::FileChooser> m_file_chooser;
         
+        class StopTask;
+        std::shared_ptr<StopTask> m_stop_task;
+        
         SoundFileRecorder m_recorder;
+        
         double m_sample_rate = 0.;
         long m_writer_count {0};
         double m_time_to_stop_ms {-1};
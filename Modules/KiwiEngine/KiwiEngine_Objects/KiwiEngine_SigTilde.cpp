@@ -39,7 +39,9 @@ namespace kiwi { namespace engine {
     }
     
     SigTilde::SigTilde(model::Object const& model, Patcher& patcher):
-    AudioObject(model, patcher)
+    AudioObject(model, patcher),
+    m_events(256),
+    m_value(0.f)
     {
         std::vector<tool::Atom> const& args = model.getArguments();
         
@@ -49,13 +51,13 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void SigTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void SigTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0)
         {
             if (args[0].isNumber())
             {
-                m_value = args[0].getFloat();
+                m_events.push(getEventPosition(), args[0].getFloat());
             }
             else
             {
@@ -66,14 +68,24 @@ namespace kiwi { namespace engine {
     
     void SigTilde::perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept
     {
-        size_t sample_index = output[0].size();
         dsp::sample_t* output_sig = output[0].data();
-        dsp::sample_t const value = m_value;
+        size_t const size = output[0].size();
+        uint64_t const block_position = getBlockPosition();
         
-        while(sample_index--)
+        size_t start = 0;
+        size_t offset = 0;
+        dsp::sample_t value = 0.f;
+        
+        // the block is filled up to each event with the previous value.
+        
+        while(m_events.pop(block_position, size, offset, value))
         {
-            *output_sig++  = value;
+            std::fill(output_sig + start, output_sig + offset, m_value);
+            m_value = value;
+            start = offset;
         }
+        
+        std::fill(output_sig + start, output_sig + size, m_value);
     }
     
     void SigTilde::prepare(dsp::Processor::PrepareInfo const& infos)
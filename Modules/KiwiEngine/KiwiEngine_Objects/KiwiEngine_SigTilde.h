@@ -39,7 +39,7 @@ namespace kiwi { namespace engine {
         
         SigTilde(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         void perform(dsp::Buffer const& input, dsp::Buffer& output) noexcept;
         
@@ -47,7 +47,8 @@ namespace kiwi { namespace engine {
         
     private: // members
         
-        std::atomic<float>   m_value{0.f};
+        dsp::EventQueue<dsp::sample_t>  m_events;
+        dsp::sample_t                   m_value;
     };
     
 }}
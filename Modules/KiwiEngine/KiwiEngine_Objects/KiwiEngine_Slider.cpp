@@ -72,7 +72,7 @@ namespace kiwi { namespace engine {
         });
     }
     
-    void Slider::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Slider::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0 && !args.empty())
         {
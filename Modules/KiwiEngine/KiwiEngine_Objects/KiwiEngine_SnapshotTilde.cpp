@@ -44,7 +44,7 @@ namespace kiwi { namespace engine {
         ;
     }
     
-    void SnapshotTilde::receive(size_t index, std::vector<tool::Atom> const& args)
+    void SnapshotTilde::receive(size_t index, tool::AtomList const& args)
     {
         if (index == 0 && !args.empty())
         {
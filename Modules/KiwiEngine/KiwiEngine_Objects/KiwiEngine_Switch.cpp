@@ -57,7 +57,7 @@ namespace kiwi { namespace engine {
         m_opened_input = std::max(0, std::min(input, static_cast<int>(m_num_inputs)));
     }
     
-    void Switch::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Switch::receive(size_t index, tool::AtomList const& args)
     {
         if (args.size() > 0)
         {
@@ -41,7 +41,7 @@ namespace kiwi { namespace engine {
         
         SwitchTilde(model::Object const& model, Patcher& patcher);
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override final;
+        void receive(size_t index, tool::AtomList const& args) override final;
         
         void prepare(PrepareInfo const& infos) override final;
         
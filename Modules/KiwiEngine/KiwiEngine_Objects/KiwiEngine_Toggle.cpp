@@ -68,7 +68,7 @@ namespace kiwi { namespace engine {
         });
     }
     
-    void Toggle::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Toggle::receive(size_t index, tool::AtomList const& args)
     {
         if (!args.empty())
         {
@@ -53,8 +53,8 @@ namespace kiwi { namespace engine {
             {
                 const auto value = atom.isInt() ? atom.getInt() : atom.getFloat();
                 
-                return [value](std::vector<tool::Atom> const&){
-                    return std::vector<tool::Atom>{{value}};
+                return [value](tool::AtomList const&){
+                    return tool::AtomList{value};
                 };
             }
             
@@ -62,36 +62,38 @@ namespace kiwi { namespace engine {
             
             if(str == "b")
             {
-                return [](std::vector<tool::Atom> const&) { return std::vector<tool::Atom>{{"bang"}}; };
+                return [](tool::AtomList const&) { return tool::AtomList{tool::Symbol::bang()}; };
             }
             
             if(str == "i")
             {
-                return [](std::vector<tool::Atom> const& args) {
-                    return std::vector<tool::Atom> {{args[0].getInt()}};
+                return [](tool::AtomList const& args) {
+                    return tool::AtomList{args[0].getInt()};
                 };
             }
             
             if(str == "f")
             {
-                return [](std::vector<tool::Atom> const& args) {
-                    return std::vector<tool::Atom> {{args[0].getFloat()}};
+                return [](tool::AtomList const& args) {
+                    return tool::AtomList{args[0].getFloat()};
                 };
             }
             
             if(str == "s")
             {
-                return [](std::vector<tool::Atom> const& args) {
-                    return std::vector<tool::Atom> {{args[0].getString()}};
+                return [](tool::AtomList const& args) {
+                    return tool::AtomList{args[0].getSymbol()};
                 };
             }
             
             if(str == "l")
             {
-                return [](std::vector<tool::Atom> const& args) { return args; };
+                return [](tool::AtomList const& args) { return args; };
             }
             
-            return [str](std::vector<tool::Atom> const&) { return std::vector<tool::Atom>{{str}}; };
+            const tool::Symbol sym(str);
+            
+            return [sym](tool::AtomList const&) { return tool::AtomList{sym}; };
         };
         
         std::vector<trigger_fn_t> triggers;
@@ -105,7 +107,7 @@ namespace kiwi { namespace engine {
         return triggers;
     }
     
-    void Trigger::receive(size_t, std::vector<tool::Atom> const& args)
+    void Trigger::receive(size_t, tool::AtomList const& args)
     {
         if(m_triggers.empty())
             return;
@@ -41,11 +41,11 @@ namespace kiwi { namespace engine {
         
         ~Trigger() = default;
         
-        void receive(size_t, std::vector<tool::Atom> const& args) override;
+        void receive(size_t, tool::AtomList const& args) override;
         
     private:
         
-        using trigger_fn_t = std::function<std::vector<tool::Atom>(std::vector<tool::Atom> const&)>;
+        using trigger_fn_t = std::function<tool::AtomList(tool::AtomList const&)>;
         static std::vector<trigger_fn_t> initializeTriggers(std::vector<tool::Atom> const&);
         const std::vector<trigger_fn_t> m_triggers;
     };
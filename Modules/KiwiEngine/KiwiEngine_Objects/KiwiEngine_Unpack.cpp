@@ -52,7 +52,7 @@ namespace kiwi { namespace engine {
         }
     }
     
-    void Unpack::receive(size_t index, std::vector<tool::Atom> const& args)
+    void Unpack::receive(size_t index, tool::AtomList const& args)
     {
         if (args[0].isBang())
         {
@@ -82,7 +82,7 @@ namespace kiwi { namespace engine {
                         {
                             if (args[i].isString())
                             {
-                                m_list[i] = args[i].getString();
+                                m_list[i] = args[i].getSymbol();
                                 send(i, {m_list[i]});
                             }
                             break;
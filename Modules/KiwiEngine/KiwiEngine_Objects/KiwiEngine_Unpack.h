@@ -41,13 +41,13 @@ namespace kiwi { namespace engine {
         
         ~Unpack() = default;
         
-        void receive(size_t index, std::vector<tool::Atom> const& args) override;
+        void receive(size_t index, tool::AtomList const& args) override;
         
         void output_list();
         
     private:
         
-        std::vector<tool::Atom> m_list;
+        tool::AtomList m_list;
     };
     
 }}
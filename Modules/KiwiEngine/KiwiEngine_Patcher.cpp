@@ -43,6 +43,7 @@ namespace kiwi { namespace engine {
         onStackOverflowCleared();
     }))
     {
+        m_chain.setUpdateMode(dsp::Chain::UpdateMode::Incremental);
         m_instance.getAudioControler().add(m_chain);
     }
     
@@ -74,6 +75,11 @@ namespace kiwi { namespace engine {
         return m_instance.getAudioControler();
     }
     
+    dsp::SampleClock const& Patcher::getSampleClock() const
+    {
+        return m_chain.getSampleClock();
+    }
+    
     void Patcher::signalStackOverflow(flip::Ref ref)
     {
         m_instance.getMainScheduler().defer([this, ref = std::move(ref)](){
@@ -116,24 +122,24 @@ namespace kiwi { namespace engine {
     //                                      CONSOLE                                     //
     // ================================================================================ //
     
-    void Patcher::log(std::string const& text) const
+    void Patcher::log(std::string const& text, Console::RateLimit* rate_limit) const
     {
-        m_instance.log(text);
+        m_instance.log(text, rate_limit);
     }
     
-    void Patcher::post(std::string const& text) const
+    void Patcher::post(std::string const& text, Console::RateLimit* rate_limit) const
     {
-        m_instance.post(text);
+        m_instance.post(text, rate_limit);
     }
     
-    void Patcher::warning(std::string const& text) const
+    void Patcher::warning(std::string const& text, Console::RateLimit* rate_limit) const
     {
-        m_instance.warning(text);
+        m_instance.warning(text, rate_limit);
     }
     
-    void Patcher::error(std::string const& text) const
+    void Patcher::error(std::string const& text, Console::RateLimit* rate_limit) const
     {
-        m_instance.error(text);
+        m_instance.error(text, rate_limit);
     }
     
     // ================================================================================ //
@@ -150,6 +156,16 @@ namespace kiwi { namespace engine {
         return m_instance.getMainScheduler();
     }
     
+    DiskThreadPool& Patcher::getDiskThreadPool() const
+    {
+        return m_instance.getDiskThreadPool();
+    }
+    
+    FaustFactoryCache& Patcher::getFaustFactoryCache() const
+    {
+        return m_instance.getFaustFactoryCache();
+    }
+    
     // ================================================================================ //
     //                                      BEACON                                      //
     // ================================================================================ //
@@ -27,6 +27,7 @@
 #include <KiwiTool/KiwiTool_Beacon.h>
 
 #include "KiwiEngine_Def.h"
+#include "KiwiEngine_Console.h"
 #include "KiwiEngine_AudioControler.h"
 
 #include <KiwiDsp/KiwiDsp_Chain.h>
@@ -70,6 +71,9 @@ namespace kiwi { namespace engine {
         //! @brief Returns the audio controler held by the patcher's instance.
         AudioControler& getAudioControler() const;
         
+        //! @brief Returns the clock ticked by the patcher's dsp chain.
+        dsp::SampleClock const& getSampleClock() const;
+        
         //! @internal Call the loadbang method of all objects.
         void sendLoadbang();
         
@@ -81,16 +85,16 @@ namespace kiwi { namespace engine {
         // ================================================================================ //
         
         //! @brief post a log message in the Console.
-        void log(std::string const& text) const;
+        void log(std::string const& text, Console::RateLimit* rate_limit = nullptr) const;
         
         //! @brief post a message in the Console.
-        void post(std::string const& text) const;
+        void post(std::string const& text, Console::RateLimit* rate_limit = nullptr) const;
         
         //! @brief post a warning message in the Console.
-        void warning(std::string const& text) const;
+        void warning(std::string const& text, Console::RateLimit* rate_limit = nullptr) const;
         
         //! @brief post an error message in the Console.
-        void error(std::string const& text) const;
+        void error(std::string const& text, Console::RateLimit* rate_limit = nullptr) const;
         
         // ================================================================================ //
         //                                      SCHEDULER                                   //
@@ -102,6 +106,12 @@ namespace kiwi { namespace engine {
         //! @brief Returns the main scheduler
         tool::Scheduler<> & getMainScheduler() const;
         
+        //! @brief Returns the threads that read and write files.
+        DiskThreadPool& getDiskThreadPool() const;
+        
+        //! @brief Returns the cache of the FAUST factories.
+        FaustFactoryCache& getFaustFactoryCache() const;
+        
         // ================================================================================ //
         //                                      BEACON                                      //
         // ================================================================================ //
@@ -174,7 +174,6 @@ namespace kiwi { namespace model {
     
     DocumentManager::Session::Session(flip::DocumentBase& document)
     : m_document(document)
-    , m_history(document)
     {}
     
     DocumentManager::Session::~Session()
@@ -190,37 +189,21 @@ namespace kiwi { namespace model {
     
     void DocumentManager::Session::commit()
     {
-        bool first_flag = m_tx.empty();
         auto tx = m_document.commit();
         
-        m_document.execute_backward(tx);
-        m_document.execute_backward(m_tx);
-        
-        flip::Transaction tx_abs;
-        m_document.root<model::Patcher>().make(tx_abs);
-        tx_abs.invert_direction();
+        if(tx.empty())
+            return;
         
-        m_tx = tx_abs;
+        const bool has_label = tx.has_metadata(flip::Transaction::key_label);
+        const std::string label = has_label ? tx.label() : std::string();
         
-        if(tx.has_metadata(flip::Transaction::key_label))
-        {
-            m_tx.impl_use_metadata_map()[flip::Transaction::key_label] = tx.label();
-        }
+        // the step only holds the fields changed since the previous one.
+        m_tx.push(std::move(tx));
         
-        if(first_flag)
+        if(has_label)
         {
-            m_history.add_undo_step(m_tx);
+            m_tx.impl_use_metadata_map()[flip::Transaction::key_label] = label;
         }
-        else if(m_tx.empty())
-        {
-            m_history.erase(m_history.last_undo());
-        }
-        else
-        {
-            *m_history.last_undo() = m_tx;
-        }
-        
-        m_document.revert();
     }
     
     void DocumentManager::Session::commit(std::string label)
@@ -237,14 +220,15 @@ namespace kiwi { namespace model {
     {
         if(m_tx.empty()) return;
         
-        if(master_history != nullptr)
+        squash();
+        
+        if(master_history != nullptr && !m_tx.empty())
         {
             // copy session transaction into the master history.
             master_history->add_undo_step(m_tx);
         }
         
         m_tx.clear();
-        m_history.clear();
     }
     
     void DocumentManager::Session::revert()
@@ -255,7 +239,23 @@ namespace kiwi { namespace model {
         m_tx.clear();
         
         m_document.commit();
+    }
+    
+    void DocumentManager::Session::squash()
+    {
+        m_document.execute_backward(m_tx);
+        
+        flip::Transaction tx_abs;
+        m_document.root<model::Patcher>().make(tx_abs);
+        tx_abs.invert_direction();
+        
+        if(m_tx.has_metadata(flip::Transaction::key_label))
+        {
+            tx_abs.impl_use_metadata_map()[flip::Transaction::key_label] = m_tx.label();
+        }
+        
+        m_document.revert();
         
-        m_history.erase(m_history.last_undo());
+        m_tx = std::move(tx_abs);
     }
 }}
@@ -141,8 +141,9 @@ namespace kiwi { namespace model {
     
     //! @brief The Session is used internally by the DocumentManager to
     //! handle the gesture commits.
-    //! @details A session manages its own transaction stack,
-    //! and squash each new transaction into a single one.
+    //! @details A session appends the changes of each commit to a single transaction,
+    //! so a commit only costs the fields that changed, whatever the size of the document.
+    //! The transaction is squashed once when the gesture ends.
     //! @see DocumentManager::startCommitGesture, DocumentManager::commitGesture, DocumentManager::endCommitGesture, DocumentManager::isInCommitGesture
     class DocumentManager::Session
     {
@@ -165,10 +166,15 @@ namespace kiwi { namespace model {
         //! @brief Reverts all changes
         void revert();
         
+    private:
+        
+        //! @brief Replaces the steps of the transaction by the changes between
+        //! the document before and after the gesture.
+        void squash();
+        
     private:
         
         flip::DocumentBase& m_document;
-        flip::History<flip::HistoryStoreMemory> m_history;
         flip::Transaction m_tx;
     };
 }}
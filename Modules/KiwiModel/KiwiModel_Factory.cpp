@@ -34,6 +34,9 @@ namespace kiwi
         // ================================================================================ //
         
         std::vector<std::unique_ptr<ObjectClass>> Factory::m_object_classes;
+        Factory::index_t Factory::m_names;
+        Factory::index_t Factory::m_aliases;
+        std::unordered_map<size_t, ObjectClass const*> Factory::m_type_ids;
         
         std::unique_ptr<model::Object> Factory::create(std::vector<tool::Atom> const& atoms)
         {
@@ -97,24 +100,41 @@ namespace kiwi
             }
         }
         
-        bool Factory::has(std::string const& name)
+        void Factory::index(ObjectClass const& object_class)
         {
-            for(const auto& object_class : m_object_classes)
+            m_names.emplace(object_class.getName(), &object_class);
+            
+            for(std::string const& alias : object_class.getAliases())
             {
-                if(object_class->getName() == name || object_class->hasAlias(name))
-                    return true;
+                m_aliases.emplace(alias, &object_class);
             }
             
-            return false;
+            m_type_ids.emplace(object_class.m_type_id, &object_class);
+        }
+        
+        bool Factory::has(std::string const& name)
+        {
+            return m_names.count(name) != 0 || m_aliases.count(name) != 0;
         }
         
         ObjectClass const* Factory::getClassByName(std::string const& name,
                                              const bool ignore_aliases)
         {
-            for(const auto& object_class : m_object_classes)
+            auto found_name = m_names.find(name);
+            
+            if(found_name != m_names.end())
+            {
+                return found_name->second;
+            }
+            
+            if(!ignore_aliases)
             {
-                if(object_class->getName() == name || (!ignore_aliases && object_class->hasAlias(name)))
-                    return object_class.get();
+                auto found_alias = m_aliases.find(name);
+                
+                if(found_alias != m_aliases.end())
+                {
+                    return found_alias->second;
+                }
             }
             
             return nullptr;
@@ -122,14 +142,9 @@ namespace kiwi
         
         ObjectClass const* Factory::getClassByTypeId(size_t type_id)
         {
-            auto found_class = std::find_if(m_object_classes.begin(),
-                                            m_object_classes.end(),
-                                            [type_id](std::unique_ptr<ObjectClass> const& object_class)
-            {
-                return object_class->m_type_id == type_id;
-            });
+            auto found_class = m_type_ids.find(type_id);
             
-            return found_class != m_object_classes.end() ? found_class->get() : nullptr;
+            return found_class != m_type_ids.end() ? found_class->second : nullptr;
         }
         
         std::vector<std::string> Factory::getNames(const bool ignore_aliases, const bool ignore_internals)
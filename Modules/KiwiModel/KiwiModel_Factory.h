@@ -25,6 +25,7 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <unordered_map>
 
 #include <KiwiModel/KiwiModel_ObjectClass.h>
 #include <KiwiModel/KiwiModel_Object.h>
@@ -115,6 +116,8 @@ namespace kiwi
                 object_class->setMoldCaster(mold_caster);
                 
                 object_class->setTypeId(typeid(TModel).hash_code());
+                
+                index(*object_class);
 
                 m_object_classes.emplace_back(std::move(object_class));
             }
@@ -172,9 +175,19 @@ namespace kiwi
             //! can be used in the datamodel, we define a bijection between name and model name.
             static std::string toKiwiName(std::string const& name);
             
+        private: // methods
+            
+            //! @internal Adds the name, the aliases and the type id of a class to the indexes.
+            static void index(ObjectClass const& object_class);
+            
         private: // members
             
+            using index_t = std::unordered_map<std::string, ObjectClass const*>;
+            
             static std::vector<std::unique_ptr<ObjectClass>> m_object_classes;
+            static index_t m_names;
+            static index_t m_aliases;
+            static std::unordered_map<size_t, ObjectClass const*> m_type_ids;
             
         private: // deleted methods
             
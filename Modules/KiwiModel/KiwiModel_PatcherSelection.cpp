@@ -0,0 +1,289 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include "KiwiModel_PatcherSelection.h"
+
+namespace kiwi
+{
+    namespace model
+    {
+        // ================================================================================ //
+        //                                 PATCHER SELECTION                                //
+        // ================================================================================ //
+        
+        bool PatcherSelection::State::operator!=(State const& other) const
+        {
+            return local != other.local || users != other.users;
+        }
+        
+        PatcherSelection::PatcherSelection(uint64_t local_user, Patcher::View const& local_view)
+        : m_local_user(local_user)
+        , m_local_view(local_view)
+        {
+        }
+        
+        bool PatcherSelection::isActive(uint64_t user) const
+        {
+            return user == m_local_user || m_connected_users.count(user) != 0;
+        }
+        
+        void PatcherSelection::update(Patcher& patcher, std::unordered_set<uint64_t> const& connected_users)
+        {
+            m_changed_objects.clear();
+            m_changed_links.clear();
+            
+            // removed objects and links are forgotten by the views while they still exist.
+            
+            if(patcher.objectsChanged())
+            {
+                collectRemoved<model::Object>(&ViewSelection::objects, m_object_states, m_object_candidates);
+            }
+            
+            if(patcher.linksChanged())
+            {
+                collectRemoved<model::Link>(&ViewSelection::links, m_link_states, m_link_candidates);
+            }
+            
+            std::unordered_set<uint64_t> previous_users(connected_users);
+            std::swap(previous_users, m_connected_users);
+            
+            for(auto& user : patcher.getUsers())
+            {
+                const uint64_t user_id = user.getId();
+                
+                const bool user_changed = user.added() || user.removed()
+                || (previous_users.count(user_id) != m_connected_users.count(user_id));
+                
+                const bool active = !user.removed() && isActive(user_id);
+                
+                for(auto& view : user.getViews())
+                {
+                    if(user_changed || view.added() || view.removed() || view.selectionChanged()
+                       || (active && m_views.count(&view) == 0))
+                    {
+                        readView(view, active && !view.removed());
+                    }
+                }
+            }
+            
+            updateStates<model::Object>(patcher, m_object_candidates, m_object_states, m_changed_objects);
+            updateStates<model::Link>(patcher, m_link_candidates, m_link_states, m_changed_links);
+            
+            m_object_candidates.clear();
+            m_link_candidates.clear();
+        }
+        
+        void PatcherSelection::readView(Patcher::View& view, bool active)
+        {
+            auto it = m_views.find(&view);
+            
+            if(!active)
+            {
+                if(it != m_views.end())
+                {
+                    m_object_candidates.insert(it->second.objects.begin(), it->second.objects.end());
+                    m_link_candidates.insert(it->second.links.begin(), it->second.links.end());
+                    m_views.erase(it);
+                }
+                
+                return;
+            }
+            
+            ViewSelection selection;
+            
+            for(model::Object* object : view.getSelectedObjects())
+            {
+                if(object != nullptr && !object->removed() && view.isSelected(*object))
+                {
+                    selection.objects.insert(object);
+                }
+            }
+            
+            for(model::Link* link : view.getSelectedLinks())
+            {
+                if(link != nullptr && !link->removed() && view.isSelected(*link))
+                {
+                    selection.links.insert(link);
+                }
+            }
+            
+            ViewSelection& previous = m_views[&view];
+            
+            // only the objects and links selected or unselected since the last update are candidates.
+            
+            for(auto const* object : selection.objects)
+            {
+                if(previous.objects.count(object) == 0) m_object_candidates.insert(object);
+            }
+            
+            for(auto const* object : previous.objects)
+            {
+                if(selection.objects.count(object) == 0) m_object_candidates.insert(object);
+            }
+            
+            for(auto const* link : selection.links)
+            {
+                if(previous.links.count(link) == 0) m_link_candidates.insert(link);
+            }
+            
+            for(auto const* link : previous.links)
+            {
+                if(selection.links.count(link) == 0) m_link_candidates.insert(link);
+            }
+            
+            previous = std::move(selection);
+        }
+        
+        template<class Model>
+        void PatcherSelection::collectRemoved(std::unordered_set<Model const*> ViewSelection::*selection,
+                                              std::unordered_map<Model const*, State> const& states,
+                                              std::unordered_set<Model const*>& candidates)
+        {
+            // only the selected models are visited, the others have no state to update.
+            
+            for(auto& view : m_views)
+            {
+                auto& models = view.second.*selection;
+                
+                for(auto it = models.begin(); it != models.end();)
+                {
+                    if((*it)->removed())
+                    {
+                        candidates.insert(*it);
+                        it = models.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+            
+            for(auto const& state : states)
+            {
+                if(state.first->removed())
+                {
+                    candidates.insert(state.first);
+                }
+            }
+        }
+        
+        template<class Model>
+        void PatcherSelection::updateStates(Patcher const& patcher,
+                                            std::unordered_set<Model const*> const& candidates,
+                                            std::unordered_map<Model const*, State>& states,
+                                            std::vector<Model const*>& changed)
+        {
+            for(Model const* model : candidates)
+            {
+                State state;
+                
+                if(!model->removed())
+                {
+                    for(auto const& user : patcher.getUsers())
+                    {
+                        const uint64_t user_id = user.getId();
+                        
+                        if(user.removed() || !isActive(user_id))
+                        {
+                            continue;
+                        }
+                        
+                        for(auto const& view : user.getViews())
+                        {
+                            if(view.removed() || !view.isSelected(*model))
+                            {
+                                continue;
+                            }
+                            
+                            if(user_id != m_local_user)
+                            {
+                                // a model is selected by a user when it's selected in one of its views.
+                                state.users.insert(user_id);
+                                break;
+                            }
+                            else if(&view == &m_local_view)
+                            {
+                                state.local = true;
+                            }
+                            else
+                            {
+                                state.users.insert(user_id);
+                            }
+                        }
+                    }
+                }
+                
+                const auto it = states.find(model);
+                const bool was_selected = (it != states.end());
+                
+                if(was_selected ? (state != it->second) : (state.local || !state.users.empty()))
+                {
+                    changed.push_back(model);
+                    
+                    if(state.local || !state.users.empty())
+                    {
+                        states[model] = std::move(state);
+                    }
+                    else
+                    {
+                        states.erase(it);
+                    }
+                }
+            }
+        }
+        
+        std::vector<model::Object const*> const& PatcherSelection::getChangedObjects() const noexcept
+        {
+            return m_changed_objects;
+        }
+        
+        std::vector<model::Link const*> const& PatcherSelection::getChangedLinks() const noexcept
+        {
+            return m_changed_links;
+        }
+        
+        bool PatcherSelection::isSelectedLocally(model::Object const& object) const
+        {
+            const auto it = m_object_states.find(&object);
+            return it != m_object_states.end() && it->second.local;
+        }
+        
+        bool PatcherSelection::isSelectedLocally(model::Link const& link) const
+        {
+            const auto it = m_link_states.find(&link);
+            return it != m_link_states.end() && it->second.local;
+        }
+        
+        std::set<uint64_t> PatcherSelection::getUsers(model::Object const& object) const
+        {
+            const auto it = m_object_states.find(&object);
+            return it != m_object_states.end() ? it->second.users : std::set<uint64_t>();
+        }
+        
+        std::set<uint64_t> PatcherSelection::getUsers(model::Link const& link) const
+        {
+            const auto it = m_link_states.find(&link);
+            return it != m_link_states.end() ? it->second.users : std::set<uint64_t>();
+        }
+    }
+}
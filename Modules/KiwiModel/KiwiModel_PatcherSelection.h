@@ -0,0 +1,152 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <set>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "KiwiModel_PatcherUser.h"
+
+namespace kiwi
+{
+    namespace model
+    {
+        // ================================================================================ //
+        //                                 PATCHER SELECTION                                //
+        // ================================================================================ //
+        
+        //! @brief Tracks the selection of the objects and links of a patcher by all its users.
+        //! @details The selection is seen from a local view: an object is selected locally if it
+        //! is selected in this view and selected by a user if it is selected in one of the views
+        //! of a connected user, the local user included for its other views.
+        //! Each update only reads the views whose selection changed and returns the objects and
+        //! links whose selection state changed, so that its cost doesn't depend on the size of
+        //! the patcher.
+        class PatcherSelection
+        {
+        public: // methods
+            
+            //! @brief Constructor.
+            //! @param local_user The id of the local user.
+            //! @param local_view The view of the local user from which the selection is seen.
+            PatcherSelection(uint64_t local_user, Patcher::View const& local_view);
+            
+            //! @brief Destructor.
+            ~PatcherSelection() = default;
+            
+            //! @brief Updates the selection.
+            //! @details Shall be called while observing the patcher and when the connected users
+            //! change.
+            //! @param patcher The observed patcher.
+            //! @param connected_users The ids of the distant users that are connected.
+            void update(Patcher& patcher, std::unordered_set<uint64_t> const& connected_users);
+            
+            //! @brief Returns the objects whose selection changed during the last update.
+            //! @details Removed objects are included, they are not selected anymore.
+            std::vector<model::Object const*> const& getChangedObjects() const noexcept;
+            
+            //! @brief Returns the links whose selection changed during the last update.
+            //! @details Removed links are included, they are not selected anymore.
+            std::vector<model::Link const*> const& getChangedLinks() const noexcept;
+            
+            //! @brief Returns true if an object is selected in the local view.
+            bool isSelectedLocally(model::Object const& object) const;
+            
+            //! @brief Returns true if a link is selected in the local view.
+            bool isSelectedLocally(model::Link const& link) const;
+            
+            //! @brief Returns the ids of the users that select an object in their views.
+            std::set<uint64_t> getUsers(model::Object const& object) const;
+            
+            //! @brief Returns the ids of the users that select a link in their views.
+            std::set<uint64_t> getUsers(model::Link const& link) const;
+            
+        private: // classes
+            
+            //! @internal The selection state of an object or a link.
+            struct State
+            {
+                bool operator!=(State const& other) const;
+                
+                bool                local = false;
+                std::set<uint64_t>  users {};
+            };
+            
+            //! @internal The objects and links selected in a view at the last update.
+            struct ViewSelection
+            {
+                std::unordered_set<model::Object const*>    objects {};
+                std::unordered_set<model::Link const*>      links {};
+            };
+            
+        private: // methods
+            
+            //! @internal Reads the selection of a view and adds the objects and links whose
+            //! selection changed in the view to the candidates.
+            void readView(Patcher::View& view, bool active);
+            
+            //! @internal Adds the selected models that are removed to the candidates and forgets
+            //! them in the selection of the views.
+            template<class Model>
+            void collectRemoved(std::unordered_set<Model const*> ViewSelection::*selection,
+                                std::unordered_map<Model const*, State> const& states,
+                                std::unordered_set<Model const*>& candidates);
+            
+            //! @internal Computes the state of the candidates and keeps the ones that changed.
+            template<class Model>
+            void updateStates(Patcher const& patcher,
+                              std::unordered_set<Model const*> const& candidates,
+                              std::unordered_map<Model const*, State>& states,
+                              std::vector<Model const*>& changed);
+            
+            //! @internal Returns true if a user is connected or is the local user.
+            bool isActive(uint64_t user) const;
+            
+        private: // members
+            
+            const uint64_t                                              m_local_user;
+            Patcher::View const&                                        m_local_view;
+            
+            std::unordered_set<uint64_t>                                m_connected_users;
+            std::unordered_map<Patcher::View const*, ViewSelection>     m_views;
+            
+            std::unordered_set<model::Object const*>                    m_object_candidates;
+            std::unordered_set<model::Link const*>                      m_link_candidates;
+            
+            std::unordered_map<model::Object const*, State>             m_object_states;
+            std::unordered_map<model::Link const*, State>               m_link_states;
+            
+            std::vector<model::Object const*>                           m_changed_objects;
+            std::vector<model::Link const*>                             m_changed_links;
+            
+        private: // deleted methods
+            
+            PatcherSelection(PatcherSelection const& other) = delete;
+            PatcherSelection(PatcherSelection && other) = delete;
+            PatcherSelection& operator=(PatcherSelection const& other) = delete;
+            PatcherSelection& operator=(PatcherSelection && other) = delete;
+        };
+    }
+}
@@ -35,13 +35,20 @@ namespace kiwi
             {
                 if (patcher.objectsChanged())
                 {
+                    std::unordered_set<Object const*> removed_objects;
+                    
                     for(Object const& object : patcher.getObjects())
                     {
                         if(object.removed())
                         {
-                            objectRemoved(object, patcher);
+                            removed_objects.insert(&object);
                         }
                     }
+                    
+                    if(!removed_objects.empty())
+                    {
+                        objectsRemoved(removed_objects, patcher);
+                    }
                 }
                 
                 if (patcher.linksChanged())
@@ -57,12 +64,13 @@ namespace kiwi
             }
         }
         
-        void PatcherValidator::objectRemoved(Object const& object, Patcher const& patcher) const
+        void PatcherValidator::objectsRemoved(std::unordered_set<Object const*> const& objects,
+                                              Patcher const& patcher) const
         {
             for(Link const& link : patcher.getLinks())
             {
-                if((link.getSenderObject().ref() == object.ref() || link.getReceiverObject().ref() == object.ref())
-                   && !link.removed())
+                if(!link.removed()
+                   && (objects.count(&link.getSenderObject()) != 0 || objects.count(&link.getReceiverObject()) != 0))
                 {
                     flip_VALIDATION_FAILED ("Removing object without removing its links");
                 }
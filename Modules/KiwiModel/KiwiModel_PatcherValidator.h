@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "flip/DocumentValidator.h"
 
 #include "KiwiModel_PatcherUser.h"
@@ -45,8 +47,9 @@ namespace kiwi
             
         private: // methods
             
-            //! @brief Carry out checks once a object is removed.
-            void objectRemoved(Object const& object, Patcher const& patcher) const;
+            //! @brief Carry out checks once objects are removed.
+            //! @details The links are scanned once whatever the number of removed objects.
+            void objectsRemoved(std::unordered_set<Object const*> const& objects, Patcher const& patcher) const;
             
             //! @brief Carry out checks once a link is created.
             void linkAdded(Link const& link) const;
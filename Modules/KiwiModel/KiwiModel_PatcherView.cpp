@@ -19,6 +19,8 @@
  ==============================================================================
  */
 
+#include <atomic>
+
 #include "KiwiModel_DataModel.h"
 #include "KiwiModel_PatcherView.h"
 
@@ -77,8 +79,7 @@ namespace kiwi
         
         Patcher::View::~View()
         {
-            m_selected_links.clear();
-            m_selected_objects.clear();
+            unselectAll();
         }
         
         Patcher& Patcher::View::getPatcher()
@@ -140,34 +141,88 @@ namespace kiwi
             return links;
         }
         
-        bool Patcher::View::isSelected(model::Object const& object) const
+        //! @brief Counts the references constructed by the transactions of the documents.
+        //! @details They can't be linked to their view before it reads them.
+        static std::atomic<uint64_t> transaction_references(1);
+        
+        template<class Ref, class Index>
+        bool Patcher::View::findSelection(Index const& index, typename Ref::model_t const* model)
         {
-            for(auto& ref : m_selected_objects)
+            const auto range = index.equal_range(model);
+            
+            for(auto it = range.first; it != range.second; ++it)
             {
-                if(!ref.removed())
+                Ref const& ref = *it->second;
+                
+                // references removed by the current transaction are kept until it is committed,
+                // the ref of a dead model doesn't resolve to a new model allocated at its address.
+                if(!ref.removed() && ref.get() == model)
                 {
-                    auto* sel_object = ref.get();
-                    
-                    if(sel_object != nullptr && sel_object == &object) return true;
+                    return true;
                 }
             }
             
             return false;
         }
         
-        bool Patcher::View::isSelected(model::Link const& link) const
+        template<class Ref, class Index>
+        void Patcher::View::rebuildSelection(flip::Collection<Ref>& refs, Index& index) const
         {
-            for(auto& ref : m_selected_links)
+            index.clear();
+            
+            for(auto it = refs.begin(); it != refs.end(); ++it)
             {
-                if(!ref.removed())
+                const bool indexed = !it->removed() && it->get() != nullptr;
+                
+                it->m_view = indexed ? this : nullptr;
+                
+                if(indexed)
                 {
-                    auto* sel_link = ref.get();
-                    
-                    if(sel_link != nullptr && sel_link == &link) return true;
+                    index.emplace(it->get(), it);
                 }
             }
+        }
+        
+        template<class Ref, class Index>
+        void Patcher::View::forgetSelection(Index& index)
+        {
+            for(auto& entry : index)
+            {
+                entry.second->m_view = nullptr;
+            }
             
-            return false;
+            index.clear();
+        }
+        
+        void Patcher::View::updateSelection() const
+        {
+            const uint64_t generation = transaction_references.load();
+            
+            if(m_index_valid && m_index_generation == generation)
+            {
+                return;
+            }
+            
+            // the references are only modified to be linked to this view.
+            auto& self = const_cast<View&>(*this);
+            
+            rebuildSelection(self.m_selected_objects, m_objects_index);
+            rebuildSelection(self.m_selected_links, m_links_index);
+            
+            m_index_generation = generation;
+            m_index_valid = true;
+        }
+        
+        bool Patcher::View::isSelected(model::Object const& object) const
+        {
+            updateSelection();
+            return findSelection<View::Object>(m_objects_index, &object);
+        }
+        
+        bool Patcher::View::isSelected(model::Link const& link) const
+        {
+            updateSelection();
+            return findSelection<View::Link>(m_links_index, &link);
         }
         
         bool Patcher::View::selectionChanged() const
@@ -179,7 +234,9 @@ namespace kiwi
         {
             if(!isSelected(object))
             {
-                m_selected_objects.emplace(object);
+                const auto it = m_selected_objects.emplace(object);
+                it->m_view = this;
+                m_objects_index.emplace(&object, it);
             }
         }
         
@@ -187,56 +244,51 @@ namespace kiwi
         {
             if(!isSelected(link))
             {
-                m_selected_links.emplace(link);
+                const auto it = m_selected_links.emplace(link);
+                it->m_view = this;
+                m_links_index.emplace(&link, it);
             }
         }
         
-        void Patcher::View::unselectObject(model::Object& object)
+        template<class Ref, class Index>
+        void Patcher::View::unselect(flip::Collection<Ref>& refs, Index& index,
+                                     typename Ref::model_t const* model)
         {
-            const auto find_object = [&object] (View::Object& ref)
+            const auto range = index.equal_range(model);
+            
+            for(auto it = range.first; it != range.second; ++it)
             {
-                if(!ref.removed())
+                const auto ref = it->second;
+                
+                if(!ref->removed() && ref->get() == model)
                 {
-                    auto* sel_object = ref.get();
-                    
-                    if(sel_object != nullptr && sel_object == &object) return true;
+                    ref->m_view = nullptr;
+                    index.erase(it);
+                    refs.erase(ref);
+                    return;
                 }
-                
-                return false;
-            };
-            
-            auto it = std::find_if(m_selected_objects.begin(), m_selected_objects.end(), find_object);
-            
-            if(it != m_selected_objects.end())
-            {
-                m_selected_objects.erase(it);
             }
         }
         
+        void Patcher::View::unselectObject(model::Object& object)
+        {
+            updateSelection();
+            unselect(m_selected_objects, m_objects_index, &object);
+        }
+        
         void Patcher::View::unselectLink(model::Link& link)
         {
-            const auto find_link = [&link] (View::Link& ref)
-            {
-                if(!ref.removed())
-                {
-                    auto* sel_link = ref.get();
-                    
-                    if(sel_link != nullptr && sel_link == &link) return true;
-                }
-                
-                return false;
-            };
-            
-            auto it = std::find_if(m_selected_links.begin(), m_selected_links.end(), find_link);
-            
-            if(it != m_selected_links.end())
-            {
-                m_selected_links.erase(it);
-            }
+            updateSelection();
+            unselect(m_selected_links, m_links_index, &link);
         }
         
         void Patcher::View::unselectAll()
         {
+            updateSelection();
+            
+            forgetSelection<View::Link>(m_links_index);
+            forgetSelection<View::Object>(m_objects_index);
+            
             m_selected_links.clear();
             m_selected_objects.clear();
         }
@@ -251,7 +303,9 @@ namespace kiwi
             {
                 if(!object.removed())
                 {
-                    m_selected_objects.emplace(object);
+                    const auto it = m_selected_objects.emplace(object);
+                    it->m_view = this;
+                    m_objects_index.emplace(&object, it);
                 }
             }
             
@@ -259,7 +313,9 @@ namespace kiwi
             {
                 if(!link.removed())
                 {
-                    m_selected_links.emplace(link);
+                    const auto it = m_selected_links.emplace(link);
+                    it->m_view = this;
+                    m_links_index.emplace(&link, it);
                 }
             }
         }
@@ -289,11 +345,24 @@ namespace kiwi
         //                                PATCHER VIEW OBJECT                               //
         // ================================================================================ //
         
-        Patcher::View::Object::Object(model::Object& object) : m_ref(&object)
+        Patcher::View::Object::Object() : m_ref(), m_view(nullptr)
+        {
+            transaction_references.fetch_add(1);
+        }
+        
+        Patcher::View::Object::Object(model::Object& object) : m_ref(&object), m_view(nullptr)
         {
             ;
         }
         
+        Patcher::View::Object::~Object()
+        {
+            if(m_view != nullptr)
+            {
+                m_view->m_index_valid = false;
+            }
+        }
+        
         model::Object* Patcher::View::Object::get() const
         {
             return m_ref.value();
@@ -303,11 +372,24 @@ namespace kiwi
         //                                 PATCHER VIEW LINK                                //
         // ================================================================================ //
         
-        Patcher::View::Link::Link(model::Link& link) : m_ref(&link)
+        Patcher::View::Link::Link() : m_ref(), m_view(nullptr)
+        {
+            transaction_references.fetch_add(1);
+        }
+        
+        Patcher::View::Link::Link(model::Link& link) : m_ref(&link), m_view(nullptr)
         {
             ;
         }
         
+        Patcher::View::Link::~Link()
+        {
+            if(m_view != nullptr)
+            {
+                m_view->m_index_valid = false;
+            }
+        }
+        
         model::Link* Patcher::View::Link::get() const
         {
             return m_ref.value();
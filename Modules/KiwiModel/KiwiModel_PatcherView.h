@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "KiwiModel_PatcherUser.h"
 
 #include "KiwiModel_Point.h"
@@ -134,8 +136,10 @@ namespace kiwi
             {
             public: // methods
                 
-                Object() = default;
-                ~Object() = default;
+                using model_t = model::Object;
+                
+                Object();
+                ~Object();
                 Object(model::Object& object);
                 model::Object* get() const;
                 
@@ -146,7 +150,12 @@ namespace kiwi
                 
             private: // members
                 
+                friend View;
+                
                 flip::ObjectRef<model::Object> m_ref;
+                
+                // the view whose selection index holds the reference, invalidated on destruction.
+                View const* m_view;
             };
             
             // ================================================================================ //
@@ -158,8 +167,10 @@ namespace kiwi
             {
             public: // methods
                 
-                Link() = default;
-                ~Link() = default;
+                using model_t = model::Link;
+                
+                Link();
+                ~Link();
                 Link(model::Link& link);
                 model::Link* get() const;
                 
@@ -170,9 +181,37 @@ namespace kiwi
                 
             private: // members
                 
+                friend View;
+                
                 flip::ObjectRef<model::Link> m_ref;
+                
+                // the view whose selection index holds the reference, invalidated on destruction.
+                View const* m_view;
             };
 
+        private: // methods
+            
+            //! @internal Rebuilds the selection index if one of its references was destroyed or
+            //! if references were added by a transaction, an undo or another document.
+            void updateSelection() const;
+            
+            //! @internal Returns true if a model has a valid reference in the index.
+            template<class Ref, class Index>
+            static bool findSelection(Index const& index, typename Ref::model_t const* model);
+            
+            //! @internal Indexes the references and links them to this view.
+            template<class Ref, class Index>
+            void rebuildSelection(flip::Collection<Ref>& refs, Index& index) const;
+            
+            //! @internal Unlinks the indexed references from this view and clears the index.
+            template<class Ref, class Index>
+            static void forgetSelection(Index& index);
+            
+            //! @internal Removes the reference of a model from the index and the selection.
+            template<class Ref, class Index>
+            static void unselect(flip::Collection<Ref>& refs, Index& index,
+                                 typename Ref::model_t const* model);
+            
         private: // members
             
             flip::Collection<View::Object>  m_selected_objects;
@@ -182,6 +221,18 @@ namespace kiwi
             flip::Float                     m_zoom_factor;
             Bounds                          m_screen_bounds;
             Point                           m_view_position;
+            
+            using ObjectsIndex = std::unordered_multimap<model::Object const*,
+                                                         flip::Collection<View::Object>::iterator>;
+            
+            using LinksIndex = std::unordered_multimap<model::Link const*,
+                                                       flip::Collection<View::Link>::iterator>;
+            
+            // references of each selected object and link.
+            mutable ObjectsIndex            m_objects_index;
+            mutable LinksIndex              m_links_index;
+            mutable uint64_t                m_index_generation = 0;
+            mutable bool                    m_index_valid = false;
         };
     }
 }
@@ -22,25 +22,16 @@
 #pragma once
 
 #include <memory>
-#include <chrono>
 #include <functional>
-#include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <iostream>
 
-#include <boost/asio.hpp>
-#include <boost/asio/steady_timer.hpp>
-
-#include <boost/beast/core.hpp>
-#include <boost/beast/http.hpp>
-
-namespace beast = boost::beast;
+#include "KiwiHttp_Client.h"
 
 namespace kiwi { namespace network { namespace http {
     
-    using Timeout = std::chrono::milliseconds;
-    using Error = beast::error_code;
-    
     // ================================================================================ //
     //                                      RESPONSE                                    //
     // ================================================================================ //
@@ -59,6 +50,8 @@ namespace kiwi { namespace network { namespace http {
     //                                       QUERY                                      //
     // ================================================================================ //
     
+    //! @brief A request sent by a Client.
+    //! @details Queries share the threads and the connections of their client.
     template<class ReqType, class ResType>
     class Query
     {
@@ -66,22 +59,27 @@ namespace kiwi { namespace network { namespace http {
         
         using Callback = std::function<void(Response<ResType> const&)>;
         
+        class Operation;
+        
     public: // methods
         
         //! @brief Constructor.
         Query(std::unique_ptr<Request<ReqType>> request,
-              std::string port);
+              std::string port,
+              Client& client = Client::use());
         
         //! @brief Destructor.
         //! @details Wait for asynchronous operation to terminate.
+        //! Must not be called by the callback of the query.
         ~Query();
         
         //! @brief Call request on the network.
         //! @details If query is already executed query will not be sent again.
-        //! Previous reponse will be returned.
+        //! Previous reponse will be returned. Waits for the response, so it must not
+        //! be called by the threads of the client.
         Response<ResType> writeQuery(Timeout timeout = Timeout(0));
         
-        //! @brief Calls the request on a specific thread.
+        //! @brief Calls the request on the threads of the client.
         //! @details If an asnchronous read is currently running, it will not be updated or relaunched.
         void writeQueryAsync(std::function<void(Response<ResType> const& res)> && callback, Timeout timeout = Timeout(0));
         
@@ -95,48 +93,85 @@ namespace kiwi { namespace network { namespace http {
         
     private: // methods
         
-        using tcp = boost::asio::ip::tcp;
+        //! @internal Sends the operation to the client once.
+        void init(Callback && callback, Timeout timeout);
         
-        //! @internal
-        void init(Timeout timeout);
+    private: // members
         
-        //! @internal
-        void handleTimeout(beast::error_code const& error);
+        Client&                             m_client;
+        std::shared_ptr<Operation>          m_operation;
+        std::atomic<bool>                   m_launched;
+        
+    private: // deleted methods
+        
+        Query() = delete;
+        Query(Query const& other) = delete;
+        Query(Query && other) = delete;
+        Query& operator=(Query const& other) = delete;
+        Query& operator=(Query && other) = delete;
+    };
+    
+    // ================================================================================ //
+    //                                  QUERY OPERATION                                 //
+    // ================================================================================ //
+    
+    //! @brief The request and the response of a Query.
+    //! @details The operation is shared with the client so that it outlives a cancelled query.
+    template<class ReqType, class ResType>
+    class Query<ReqType, ResType>::Operation : public Client::Operation
+    {
+    public: // methods
+        
+        //! @brief Constructor.
+        Operation(std::unique_ptr<Request<ReqType>> request, std::string const& port);
+        
+        //! @brief Destructor.
+        ~Operation() = default;
+        
+        //! @brief Sets the callback and prepares the request.
+        void init(Callback && callback);
+        
+        //! @brief Returns true once the callback has been called.
+        bool executed() const;
+        
+        //! @brief Waits until the operation is executed.
+        void wait();
+        
+        //! @brief Returns the response.
+        //! @details Only valid once the operation is executed.
+        Response<ResType> const& getResponse() const;
+        
+    private: // methods
+        
+        using tcp = Client::tcp;
+        using Parser = beast::http::response_parser<ResType>;
         
         //! @internal
-        void connect(tcp::resolver::results_type results);
+        static bool isIdempotent(beast::http::verb method);
         
         //! @internal
-        void write();
+        void write(tcp::socket& socket,
+                   Client::Strand& strand,
+                   std::function<void(Error const&)> handler) override final;
         
         //! @internal
-        void read();
+        void read(tcp::socket& socket,
+                  beast::flat_buffer& buffer,
+                  Client::Strand& strand,
+                  std::function<void(Error const&, bool)> handler) override final;
         
         //! @internal
-        void shutdown(beast::error_code const& error);
+        void finish(Error const& error) override final;
         
     private: // members
         
         std::unique_ptr<Request<ReqType>>   m_request;
+        std::unique_ptr<Parser>             m_parser;
         Response<ResType>                   m_response;
-        
-        std::string                         m_port;
-        boost::asio::io_context             m_io_context;
-        tcp::socket                         m_socket;
-        boost::asio::steady_timer           m_timer;
-        tcp::resolver                       m_resolver;
-        beast::flat_buffer                  m_buffer;
-        std::thread                         m_thread;
-        std::atomic<bool>                   m_executed;
         Callback                            m_callback;
-        
-    private: // deleted methods
-        
-        Query() = delete;
-        Query(Query const& other) = delete;
-        Query(Query && other) = delete;
-        Query& operator=(Query const& other) = delete;
-        Query& operator=(Query && other) = delete;
+        std::mutex                          m_mutex;
+        std::condition_variable             m_condition;
+        std::atomic<bool>                   m_executed;
     };
     
 }}} // namespace kiwi::network::http
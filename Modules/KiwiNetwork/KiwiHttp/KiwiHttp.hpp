@@ -19,6 +19,7 @@
  ==============================================================================
  */
 
+
 #pragma once
 
 namespace kiwi { namespace network { namespace http {
@@ -29,195 +30,181 @@ namespace kiwi { namespace network { namespace http {
     
     template<class ReqType, class ResType>
     Query<ReqType, ResType>::Query(std::unique_ptr<beast::http::request<ReqType>> request,
-                                   std::string port)
-    : m_request(std::move(request))
-    , m_response()
-    , m_port(port)
-    , m_io_context()
-    , m_socket(m_io_context)
-    , m_timer(m_io_context)
-    , m_resolver(m_io_context)
-    , m_buffer()
-    , m_thread()
-    , m_executed(false)
-    , m_callback()
+                                   std::string port,
+                                   Client& client)
+    : m_client(client)
+    , m_operation(std::make_shared<Operation>(std::move(request), port))
+    , m_launched(false)
     {
     }
     
     template<class ReqType, class ResType>
     Query<ReqType, ResType>::~Query()
     {
-        if (m_thread.joinable())
+        if (m_launched)
         {
-            m_thread.join();
+            m_operation->wait();
         }
     }
     
     template<class ReqType, class ResType>
     Response<ResType> Query<ReqType, ResType>::writeQuery(Timeout timeout)
     {
-        if (m_thread.joinable())
-        {
-            m_thread.join();
-        }
+        init(Callback(), timeout);
         
-        if (!executed())
-        {
-            init(timeout);
-            
-            while(!executed())
-            {
-                m_socket.get_io_context().poll_one();
-            }
-        }
+        m_operation->wait();
         
-        return m_response;
+        return m_operation->getResponse();
     }
     
     template<class ReqType, class ResType>
     void Query<ReqType, ResType>::writeQueryAsync(std::function<void(Response<ResType> const& res)> && callback, Timeout timeout)
     {
-        if (!executed() && !m_thread.joinable())
-        {
-            init(timeout);
-            
-            m_callback = std::move(callback);
-            
-            m_thread = std::thread([this]()
-            {
-                while(!executed())
-                {
-                    m_socket.get_io_context().poll_one();
-                }
-            });
-        }
+        init(std::move(callback), timeout);
     }
     
     template<class ReqType, class ResType>
     void Query<ReqType, ResType>::cancel()
     {
-        if (m_timer.cancel() != 0)
+        if (m_launched)
         {
-            if (m_thread.joinable())
-            {
-                m_thread.join();
-            }
+            m_client.cancel(m_operation, boost::asio::error::basic_errors::timed_out);
         }
-        
-        if (!m_executed)
+        else
         {
-            shutdown(boost::asio::error::basic_errors::timed_out);
+            m_operation->complete(boost::asio::error::basic_errors::timed_out);
         }
     }
     
     template<class ReqType, class ResType>
     bool Query<ReqType, ResType>::executed()
     {
-        return m_executed.load();
+        return m_operation->executed();
     }
     
     template<class ReqType, class ResType>
-    void Query<ReqType, ResType>::init(Timeout timeout)
+    void Query<ReqType, ResType>::init(Callback && callback, Timeout timeout)
     {
-        if (timeout > Timeout(0))
+        if (!m_operation->completed() && !m_launched.exchange(true))
         {
-            m_timer.expires_from_now(timeout);
-            
-            m_timer.async_wait([this](Error const& error)
-            {
-                handleTimeout(error);
-            });
+            m_operation->init(std::move(callback));
+            m_client.submit(m_operation, timeout);
         }
-        
+    }
+    
+    // ================================================================================ //
+    //                                  QUERY OPERATION                                 //
+    // ================================================================================ //
+    
+    template<class ReqType, class ResType>
+    Query<ReqType, ResType>::Operation::Operation(std::unique_ptr<Request<ReqType>> request,
+                                                  std::string const& port)
+    : Client::Operation((*request)[beast::http::field::host].to_string(),
+                        port,
+                        isIdempotent(request->method()))
+    , m_request(std::move(request))
+    , m_parser()
+    , m_response()
+    , m_callback()
+    , m_mutex()
+    , m_condition()
+    , m_executed(false)
+    {
+    }
+    
+    template<class ReqType, class ResType>
+    void Query<ReqType, ResType>::Operation::init(Callback && callback)
+    {
+        m_callback = std::move(callback);
         m_request->prepare_payload();
+    }
+    
+    template<class ReqType, class ResType>
+    bool Query<ReqType, ResType>::Operation::executed() const
+    {
+        return m_executed.load();
+    }
+    
+    template<class ReqType, class ResType>
+    void Query<ReqType, ResType>::Operation::wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
         
-        const std::string host = m_request->at(beast::http::field::host).to_string();
-        
-        m_resolver.async_resolve(host, m_port, [this](beast::error_code ec,
-                                                      tcp::resolver::results_type results)
+        m_condition.wait(lock, [this]()
         {
-            if (ec)
-            {
-                shutdown(ec);
-            }
-            else
-            {
-                connect(results);
-            }
+            return m_executed.load();
         });
     }
     
     template<class ReqType, class ResType>
-    void Query<ReqType, ResType>::handleTimeout(Error const& error)
+    Response<ResType> const& Query<ReqType, ResType>::Operation::getResponse() const
     {
-        shutdown(boost::asio::error::basic_errors::timed_out);
+        return m_response;
     }
     
     template<class ReqType, class ResType>
-    void Query<ReqType, ResType>::connect(tcp::resolver::results_type results)
+    bool Query<ReqType, ResType>::Operation::isIdempotent(beast::http::verb method)
     {
-        boost::asio::async_connect(m_socket, results, [this](beast::error_code ec, tcp::endpoint const& endpoint){
-            
-            boost::ignore_unused(endpoint);
-            
-            if (ec)
-            {
-                shutdown(ec);
-            }
-            else
-            {
-                write();
-            }
-        });
+        return (method == beast::http::verb::get
+                || method == beast::http::verb::head
+                || method == beast::http::verb::put
+                || method == beast::http::verb::delete_
+                || method == beast::http::verb::options);
     }
     
     template<class ReqType, class ResType>
-    void Query<ReqType, ResType>::write()
+    void Query<ReqType, ResType>::Operation::write(tcp::socket& socket,
+                                                   Client::Strand& strand,
+                                                   std::function<void(Error const&)> handler)
     {
-        beast::http::async_write(m_socket, *m_request, [this](beast::error_code ec,
-                                                              std::size_t bytes_transferred)
+        beast::http::async_write(socket, *m_request, boost::asio::bind_executor(strand, [handler](Error ec,
+                                                                                                std::size_t bytes_transferred)
         {
             boost::ignore_unused(bytes_transferred);
-            
-            if (ec)
-            {
-                shutdown(ec);
-            }
-            else
-            {
-                read();
-            }
-        });
+            handler(ec);
+        }));
     }
     
     template<class ReqType, class ResType>
-    void Query<ReqType, ResType>::read()
+    void Query<ReqType, ResType>::Operation::read(tcp::socket& socket,
+                                                  beast::flat_buffer& buffer,
+                                                  Client::Strand& strand,
+                                                  std::function<void(Error const&, bool)> handler)
     {
-        beast::http::async_read(m_socket, m_buffer, m_response, [this](beast::error_code ec,
-                                                                       std::size_t bytes_transferred)
+        m_parser.reset(new Parser());
+        m_parser->skip(m_request->method() == beast::http::verb::head);
+        
+        beast::http::async_read(socket, buffer, *m_parser, boost::asio::bind_executor(strand, [this, handler](Error ec,
+                                                                                                            std::size_t bytes_transferred)
         {
             boost::ignore_unused(bytes_transferred);
-            shutdown(ec);
-        });
+            handler(ec, !ec && m_parser->keep_alive());
+        }));
     }
     
     template<class ReqType, class ResType>
-    void Query<ReqType, ResType>::shutdown(Error const& error)
+    void Query<ReqType, ResType>::Operation::finish(Error const& error)
     {
         if (error)
         {
             m_response.error = error;
         }
-        
-        boost::system::error_code ec;
-        m_socket.shutdown(tcp::socket::shutdown_both, ec);
+        else if (m_parser)
+        {
+            static_cast<beast::http::response<ResType>&>(m_response) = m_parser->release();
+        }
         
         if (m_callback)
         {
             m_callback(m_response);
         }
         
-        m_executed.store(true);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_executed.store(true);
+        }
+        
+        m_condition.notify_all();
     }
     
 }}} // namespace kiwi::network::http
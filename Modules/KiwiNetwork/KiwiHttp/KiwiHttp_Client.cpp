@@ -0,0 +1,812 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <algorithm>
+#include <deque>
+
+#include "KiwiHttp_Client.h"
+
+namespace kiwi { namespace network { namespace http {
+    
+    // ================================================================================ //
+    //                                    CLIENT HOST                                   //
+    // ================================================================================ //
+    
+    //! @brief The operations and the connections of a host.
+    //! @details All the methods are called on the strand of the host.
+    class Client::Host
+    {
+    public: // methods
+        
+        Host(Client& client, std::string const& name, std::string const& port);
+        
+        ~Host() = default;
+        
+        Client& getClient();
+        
+        Strand& getStrand();
+        
+        std::string const& getName() const;
+        
+        std::string const& getPort() const;
+        
+        //! @brief Queues an operation and arms its timeout.
+        void submit(std::shared_ptr<Operation> operation, Timeout timeout);
+        
+        //! @brief Withdraws an operation and completes it.
+        void cancel(std::shared_ptr<Operation> const& operation, Error const& error);
+        
+        //! @brief Completes an operation and disarms its timeout.
+        void complete(std::shared_ptr<Operation> const& operation, Error const& error);
+        
+        //! @brief Queues operations again in front of the others.
+        void requeue(std::deque<std::shared_ptr<Operation>> operations);
+        
+        //! @brief Forgets a closed connection.
+        void remove(Connection const& connection);
+        
+        //! @brief Assigns the queued operations to the connections.
+        //! @details Idle connections are used first, then new connections are opened
+        //! and finally the operations are pipelined on the least busy connection.
+        void dispatch();
+        
+        //! @brief Closes the connections and aborts the operations.
+        void shutdown();
+        
+    private: // members
+        
+        Client&                                     m_client;
+        Strand                                      m_strand;
+        const std::string                           m_name;
+        const std::string                           m_port;
+        std::deque<std::shared_ptr<Operation>>      m_queue;
+        std::vector<std::shared_ptr<Connection>>    m_connections;
+        bool                                        m_shutdown;
+    };
+    
+    // ================================================================================ //
+    //                                 CLIENT CONNECTION                                //
+    // ================================================================================ //
+    
+    //! @brief A persistent connection to a host.
+    //! @details Requests are written in order while the responses of the previous ones
+    //! are read. All the methods are called on the strand of the host.
+    class Client::Connection : public std::enable_shared_from_this<Connection>
+    {
+    public: // methods
+        
+        Connection(Host& host);
+        
+        ~Connection() = default;
+        
+        //! @brief Resolves the host and connects to it.
+        void start();
+        
+        //! @brief Returns true if no operation is pending.
+        bool isIdle() const;
+        
+        //! @brief Returns the number of pending operations.
+        size_t getNumberOfOperations() const;
+        
+        //! @brief Returns true if an operation can be sent behind the pending ones.
+        //! @details Only idempotent requests are pipelined, on connections that were kept alive.
+        bool canPipeline(Operation const& operation) const;
+        
+        //! @brief Sends an operation.
+        void push(std::shared_ptr<Operation> operation);
+        
+        //! @brief Withdraws a cancelled operation.
+        //! @details The connection is closed if the request has been written.
+        //! Returns false if the operation is not pending on this connection.
+        bool abort(Operation const& operation);
+        
+        //! @brief Closes the connection and completes the pending operations with an error.
+        //! @details Requests that have not been written are queued again, as well as the idempotent
+        //! ones written on a reused connection that the server may have closed in the meantime.
+        void fail(Error const& error);
+        
+        //! @brief Closes the connection and queues the pending operations again.
+        void recycle();
+        
+    private: // methods
+        
+        void connect(tcp::resolver::results_type const& results);
+        
+        void write();
+        
+        void read();
+        
+        void wait();
+        
+        void close();
+        
+        bool written(size_t index) const;
+        
+    private: // members
+        
+        Host&                                       m_host;
+        tcp::resolver                               m_resolver;
+        tcp::socket                                 m_socket;
+        boost::asio::steady_timer                   m_idle_timer;
+        beast::flat_buffer                          m_buffer;
+        std::deque<std::shared_ptr<Operation>>      m_operations;
+        size_t                                      m_written;
+        size_t                                      m_exchanges;
+        bool                                        m_connected;
+        bool                                        m_writing;
+        bool                                        m_reading;
+        bool                                        m_reused;
+        bool                                        m_closed;
+    };
+    
+    // ================================================================================ //
+    //                                 CLIENT OPERATION                                 //
+    // ================================================================================ //
+    
+    Client::Operation::Operation(std::string const& host, std::string const& port, bool idempotent)
+    : m_host(host)
+    , m_port(port)
+    , m_idempotent(idempotent)
+    , m_completed(false)
+    , m_retries(0)
+    , m_timer()
+    {
+    }
+    
+    Client::Operation::~Operation()
+    {
+    }
+    
+    std::string const& Client::Operation::getHost() const
+    {
+        return m_host;
+    }
+    
+    std::string const& Client::Operation::getPort() const
+    {
+        return m_port;
+    }
+    
+    bool Client::Operation::isIdempotent() const
+    {
+        return m_idempotent;
+    }
+    
+    bool Client::Operation::complete(Error const& error)
+    {
+        if (m_completed.exchange(true))
+        {
+            return false;
+        }
+        
+        finish(error);
+        
+        return true;
+    }
+    
+    bool Client::Operation::completed() const
+    {
+        return m_completed.load();
+    }
+    
+    // ================================================================================ //
+    //                                      CLIENT                                      //
+    // ================================================================================ //
+    
+    Client& Client::use()
+    {
+        static Client client;
+        return client;
+    }
+    
+    Client::Client(size_t threads, size_t connections, size_t pipeline, Timeout keep_alive)
+    : m_io_context(static_cast<int>(std::max<size_t>(threads, 1)))
+    , m_work(boost::asio::make_work_guard(m_io_context))
+    , m_mutex()
+    , m_hosts()
+    , m_opened_connections(0)
+    , m_max_connections(std::max<size_t>(connections, 1))
+    , m_pipeline(std::max<size_t>(pipeline, 1))
+    , m_keep_alive(keep_alive)
+    , m_threads()
+    {
+        for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i)
+        {
+            m_threads.emplace_back([this]()
+            {
+                m_io_context.run();
+            });
+        }
+    }
+    
+    Client::~Client()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            
+            for (auto& host : m_hosts)
+            {
+                Host* host_ptr = host.second.get();
+                
+                boost::asio::post(host_ptr->getStrand(), [host_ptr]()
+                {
+                    host_ptr->shutdown();
+                });
+            }
+        }
+        
+        m_work.reset();
+        
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+    
+    void Client::submit(std::shared_ptr<Operation> operation, Timeout timeout)
+    {
+        Host& host = getHost(operation->getHost(), operation->getPort());
+        
+        boost::asio::post(host.getStrand(), [&host, operation, timeout]()
+        {
+            host.submit(operation, timeout);
+        });
+    }
+    
+    void Client::cancel(std::shared_ptr<Operation> operation, Error const& error)
+    {
+        operation->complete(error);
+        
+        Host& host = getHost(operation->getHost(), operation->getPort());
+        
+        boost::asio::post(host.getStrand(), [&host, operation, error]()
+        {
+            host.cancel(operation, error);
+        });
+    }
+    
+    size_t Client::getNumberOfConnections() const
+    {
+        return m_opened_connections.load();
+    }
+    
+    Client::Host& Client::getHost(std::string const& name, std::string const& port)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        std::unique_ptr<Host>& host = m_hosts[name + ":" + port];
+        
+        if (!host)
+        {
+            host.reset(new Host(*this, name, port));
+        }
+        
+        return *host;
+    }
+    
+    // ================================================================================ //
+    //                                    CLIENT HOST                                   //
+    // ================================================================================ //
+    
+    Client::Host::Host(Client& client, std::string const& name, std::string const& port)
+    : m_client(client)
+    , m_strand(client.m_io_context)
+    , m_name(name)
+    , m_port(port)
+    , m_queue()
+    , m_connections()
+    , m_shutdown(false)
+    {
+    }
+    
+    Client& Client::Host::getClient()
+    {
+        return m_client;
+    }
+    
+    Client::Strand& Client::Host::getStrand()
+    {
+        return m_strand;
+    }
+    
+    std::string const& Client::Host::getName() const
+    {
+        return m_name;
+    }
+    
+    std::string const& Client::Host::getPort() const
+    {
+        return m_port;
+    }
+    
+    void Client::Host::submit(std::shared_ptr<Operation> operation, Timeout timeout)
+    {
+        if (operation->completed())
+        {
+            return;
+        }
+        
+        if (m_shutdown)
+        {
+            complete(operation, boost::asio::error::operation_aborted);
+            return;
+        }
+        
+        if (timeout > Timeout(0))
+        {
+            operation->m_timer.reset(new boost::asio::steady_timer(m_client.m_io_context));
+            operation->m_timer->expires_after(timeout);
+            
+            std::weak_ptr<Operation> weak_operation(operation);
+            
+            operation->m_timer->async_wait(boost::asio::bind_executor(m_strand, [this, weak_operation](Error const& error)
+            {
+                std::shared_ptr<Operation> operation = weak_operation.lock();
+                
+                if (!error && operation)
+                {
+                    cancel(operation, boost::asio::error::timed_out);
+                }
+            }));
+        }
+        
+        m_queue.emplace_back(std::move(operation));
+        
+        dispatch();
+    }
+    
+    void Client::Host::cancel(std::shared_ptr<Operation> const& operation, Error const& error)
+    {
+        auto it = std::find(m_queue.begin(), m_queue.end(), operation);
+        
+        if (it != m_queue.end())
+        {
+            m_queue.erase(it);
+        }
+        else
+        {
+            for (size_t i = 0; i < m_connections.size(); ++i)
+            {
+                if (m_connections[i]->abort(*operation))
+                {
+                    break;
+                }
+            }
+        }
+        
+        complete(operation, error);
+    }
+    
+    void Client::Host::complete(std::shared_ptr<Operation> const& operation, Error const& error)
+    {
+        if (operation->m_timer)
+        {
+            operation->m_timer->cancel();
+        }
+        
+        operation->complete(error);
+    }
+    
+    void Client::Host::requeue(std::deque<std::shared_ptr<Operation>> operations)
+    {
+        if (m_shutdown)
+        {
+            for (auto& operation : operations)
+            {
+                complete(operation, boost::asio::error::operation_aborted);
+            }
+            
+            return;
+        }
+        
+        m_queue.insert(m_queue.begin(), operations.begin(), operations.end());
+        
+        dispatch();
+    }
+    
+    void Client::Host::remove(Connection const& connection)
+    {
+        m_connections.erase(std::remove_if(m_connections.begin(),
+                                           m_connections.end(),
+                                           [&connection](std::shared_ptr<Connection> const& other)
+        {
+            return other.get() == &connection;
+        }), m_connections.end());
+    }
+    
+    void Client::Host::dispatch()
+    {
+        while (!m_queue.empty() && !m_shutdown)
+        {
+            std::shared_ptr<Operation> operation = m_queue.front();
+            
+            if (operation->completed())
+            {
+                m_queue.pop_front();
+                continue;
+            }
+            
+            Connection* connection = nullptr;
+            
+            for (auto& other : m_connections)
+            {
+                if (other->isIdle())
+                {
+                    connection = other.get();
+                    break;
+                }
+            }
+            
+            if (connection == nullptr && m_connections.size() < m_client.m_max_connections)
+            {
+                m_connections.emplace_back(std::make_shared<Connection>(*this));
+                connection = m_connections.back().get();
+                connection->start();
+            }
+            
+            if (connection == nullptr)
+            {
+                for (auto& other : m_connections)
+                {
+                    if (other->canPipeline(*operation)
+                        && (connection == nullptr
+                            || other->getNumberOfOperations() < connection->getNumberOfOperations()))
+                    {
+                        connection = other.get();
+                    }
+                }
+            }
+            
+            if (connection == nullptr)
+            {
+                break;
+            }
+            
+            m_queue.pop_front();
+            connection->push(std::move(operation));
+        }
+    }
+    
+    void Client::Host::shutdown()
+    {
+        m_shutdown = true;
+        
+        while (!m_connections.empty())
+        {
+            m_connections.back()->fail(boost::asio::error::operation_aborted);
+        }
+        
+        for (auto& operation : m_queue)
+        {
+            complete(operation, boost::asio::error::operation_aborted);
+        }
+        
+        m_queue.clear();
+    }
+    
+    // ================================================================================ //
+    //                                 CLIENT CONNECTION                                //
+    // ================================================================================ //
+    
+    Client::Connection::Connection(Host& host)
+    : m_host(host)
+    , m_resolver(host.getClient().m_io_context)
+    , m_socket(host.getClient().m_io_context)
+    , m_idle_timer(host.getClient().m_io_context)
+    , m_buffer()
+    , m_operations()
+    , m_written(0)
+    , m_exchanges(0)
+    , m_connected(false)
+    , m_writing(false)
+    , m_reading(false)
+    , m_reused(false)
+    , m_closed(false)
+    {
+        ++host.getClient().m_opened_connections;
+    }
+    
+    void Client::Connection::start()
+    {
+        auto self = shared_from_this();
+        
+        m_resolver.async_resolve(m_host.getName(),
+                                 m_host.getPort(),
+                                 boost::asio::bind_executor(m_host.getStrand(),
+                                                            [self](Error const& error,
+                                                                   tcp::resolver::results_type results)
+        {
+            if (self->m_closed)
+            {
+                return;
+            }
+            
+            if (error)
+            {
+                self->fail(error);
+            }
+            else
+            {
+                self->connect(results);
+            }
+        }));
+    }
+    
+    bool Client::Connection::isIdle() const
+    {
+        return m_operations.empty();
+    }
+    
+    size_t Client::Connection::getNumberOfOperations() const
+    {
+        return m_operations.size();
+    }
+    
+    bool Client::Connection::canPipeline(Operation const& operation) const
+    {
+        if (!m_reused
+            || !operation.isIdempotent()
+            || m_operations.size() >= m_host.getClient().m_pipeline)
+        {
+            return false;
+        }
+        
+        return std::all_of(m_operations.begin(),
+                           m_operations.end(),
+                           [](std::shared_ptr<Operation> const& other)
+        {
+            return other->isIdempotent();
+        });
+    }
+    
+    void Client::Connection::push(std::shared_ptr<Operation> operation)
+    {
+        m_operations.emplace_back(std::move(operation));
+        
+        ++m_exchanges;
+        
+        write();
+    }
+    
+    bool Client::Connection::abort(Operation const& operation)
+    {
+        auto it = std::find_if(m_operations.begin(),
+                               m_operations.end(),
+                               [&operation](std::shared_ptr<Operation> const& other)
+        {
+            return other.get() == &operation;
+        });
+        
+        if (it == m_operations.end())
+        {
+            return false;
+        }
+        
+        if (!written(it - m_operations.begin()))
+        {
+            m_operations.erase(it);
+        }
+        else
+        {
+            // the responses would be read out of order, the others are sent again.
+            
+            m_operations.erase(it);
+            recycle();
+        }
+        
+        return true;
+    }
+    
+    void Client::Connection::fail(Error const& error)
+    {
+        auto self = shared_from_this();
+        
+        std::deque<std::shared_ptr<Operation>> operations;
+        
+        for (size_t i = 0; i < m_operations.size(); ++i)
+        {
+            std::shared_ptr<Operation>& operation = m_operations[i];
+            
+            if (m_connected && !written(i))
+            {
+                operations.emplace_back(std::move(operation));
+            }
+            else if (m_reused && operation->isIdempotent() && operation->m_retries++ == 0)
+            {
+                operations.emplace_back(std::move(operation));
+            }
+            else
+            {
+                m_host.complete(operation, error);
+            }
+        }
+        
+        close();
+        
+        m_host.remove(*this);
+        m_host.requeue(std::move(operations));
+    }
+    
+    void Client::Connection::recycle()
+    {
+        auto self = shared_from_this();
+        
+        std::deque<std::shared_ptr<Operation>> operations;
+        operations.swap(m_operations);
+        
+        close();
+        
+        m_host.remove(*this);
+        m_host.requeue(std::move(operations));
+    }
+    
+    void Client::Connection::connect(tcp::resolver::results_type const& results)
+    {
+        auto self = shared_from_this();
+        
+        boost::asio::async_connect(m_socket,
+                                   results,
+                                   boost::asio::bind_executor(m_host.getStrand(),
+                                                              [self](Error const& error,
+                                                                     tcp::endpoint const& endpoint)
+        {
+            boost::ignore_unused(endpoint);
+            
+            if (self->m_closed)
+            {
+                return;
+            }
+            
+            if (error)
+            {
+                self->fail(error);
+            }
+            else
+            {
+                self->m_connected = true;
+                self->write();
+            }
+        }));
+    }
+    
+    void Client::Connection::write()
+    {
+        if (m_closed || !m_connected || m_writing || m_written == m_operations.size())
+        {
+            return;
+        }
+        
+        auto self = shared_from_this();
+        
+        m_writing = true;
+        
+        m_operations[m_written]->write(m_socket, m_host.getStrand(), [self](Error const& error)
+        {
+            if (self->m_closed)
+            {
+                return;
+            }
+            
+            if (error)
+            {
+                self->fail(error);
+                return;
+            }
+            
+            self->m_writing = false;
+            ++self->m_written;
+            
+            self->read();
+            self->write();
+        });
+    }
+    
+    void Client::Connection::read()
+    {
+        if (m_closed || m_reading || m_written == 0)
+        {
+            return;
+        }
+        
+        auto self = shared_from_this();
+        
+        std::shared_ptr<Operation> operation = m_operations.front();
+        
+        m_reading = true;
+        
+        operation->read(m_socket, m_buffer, m_host.getStrand(), [self, operation](Error const& error,
+                                                                                 bool keep_alive)
+        {
+            if (self->m_closed)
+            {
+                return;
+            }
+            
+            if (error)
+            {
+                self->fail(error);
+                return;
+            }
+            
+            self->m_reading = false;
+            self->m_operations.pop_front();
+            --self->m_written;
+            
+            self->m_host.complete(operation, Error());
+            
+            if (!keep_alive)
+            {
+                self->recycle();
+                return;
+            }
+            
+            self->m_reused = true;
+            
+            self->read();
+            self->write();
+            self->wait();
+            
+            self->m_host.dispatch();
+        });
+    }
+    
+    void Client::Connection::wait()
+    {
+        if (!m_operations.empty())
+        {
+            return;
+        }
+        
+        auto self = shared_from_this();
+        
+        const size_t exchanges = m_exchanges;
+        
+        m_idle_timer.expires_after(m_host.getClient().m_keep_alive);
+        
+        m_idle_timer.async_wait(boost::asio::bind_executor(m_host.getStrand(), [self, exchanges](Error const& error)
+        {
+            if (!error && !self->m_closed && self->isIdle() && self->m_exchanges == exchanges)
+            {
+                self->recycle();
+            }
+        }));
+    }
+    
+    void Client::Connection::close()
+    {
+        m_closed = true;
+        m_operations.clear();
+        
+        m_resolver.cancel();
+        m_idle_timer.cancel();
+        
+        Error error;
+        m_socket.shutdown(tcp::socket::shutdown_both, error);
+        m_socket.close(error);
+    }
+    
+    bool Client::Connection::written(size_t index) const
+    {
+        return index < m_written || (index == m_written && m_writing);
+    }
+    
+}}} // namespace kiwi::network::http
@@ -0,0 +1,203 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+namespace beast = boost::beast;
+
+namespace kiwi { namespace network { namespace http {
+    
+    using Timeout = std::chrono::milliseconds;
+    using Error = beast::error_code;
+    
+    // ================================================================================ //
+    //                                      CLIENT                                      //
+    // ================================================================================ //
+    
+    //! @brief Sends the http operations of the process on a fixed pool of threads.
+    //! @details The client keeps the connections of each host alive and reuses them.
+    //! When all the connections of a host are busy, idempotent requests are pipelined
+    //! on the connections that have already answered. The operations of a host are
+    //! handled on its own strand, cancelling an operation never blocks nor spawns a thread.
+    class Client
+    {
+    public: // classes
+        
+        class Operation;
+        
+        using tcp = boost::asio::ip::tcp;
+        using Strand = boost::asio::io_context::strand;
+        
+    public: // methods
+        
+        //! @brief Returns the client shared by the process.
+        static Client& use();
+        
+        //! @brief Constructor.
+        //! @param threads The number of threads that perform the network operations.
+        //! @param connections The maximum number of connections opened to a host.
+        //! @param pipeline The maximum number of requests sent on a connection without waiting for their response.
+        //! @param keep_alive The time after which an idle connection is closed.
+        Client(size_t threads = 2,
+               size_t connections = 4,
+               size_t pipeline = 4,
+               Timeout keep_alive = Timeout(4000));
+        
+        //! @brief Destructor.
+        //! @details Pending operations are completed with an operation_aborted error.
+        ~Client();
+        
+        //! @brief Sends an operation to its host.
+        //! @details The operation is completed with a timed_out error if its response
+        //! is not received before the timeout. A null timeout never expires.
+        void submit(std::shared_ptr<Operation> operation, Timeout timeout = Timeout(0));
+        
+        //! @brief Completes an operation with an error and withdraws it from its host.
+        //! @details The operation is completed before the method returns, the connection
+        //! on which it has been sent is closed later by the threads of the client.
+        void cancel(std::shared_ptr<Operation> operation, Error const& error);
+        
+        //! @brief Returns the number of connections opened since the client was created.
+        size_t getNumberOfConnections() const;
+        
+    private: // classes
+        
+        class Host;
+        class Connection;
+        
+    private: // methods
+        
+        //! @internal Returns the host of a name and a port, creates it if needed.
+        Host& getHost(std::string const& name, std::string const& port);
+        
+    private: // members
+        
+        using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+        
+        boost::asio::io_context                         m_io_context;
+        WorkGuard                                       m_work;
+        std::mutex                                      m_mutex;
+        std::map<std::string, std::unique_ptr<Host>>    m_hosts;
+        std::atomic<size_t>                             m_opened_connections;
+        const size_t                                    m_max_connections;
+        const size_t                                    m_pipeline;
+        const Timeout                                   m_keep_alive;
+        std::vector<std::thread>                        m_threads;
+        
+    private: // deleted methods
+        
+        Client(Client const& other) = delete;
+        Client(Client && other) = delete;
+        Client& operator=(Client const& other) = delete;
+        Client& operator=(Client && other) = delete;
+    };
+    
+    // ================================================================================ //
+    //                                 CLIENT OPERATION                                 //
+    // ================================================================================ //
+    
+    //! @brief An exchange of a request and a response sent by the Client.
+    //! @details Subclasses write the request and read the response on the connection
+    //! given by the client. An operation is completed once, either by its response,
+    //! an error or a cancellation.
+    class Client::Operation
+    {
+    public: // methods
+        
+        //! @brief Constructor.
+        //! @param idempotent Idempotent requests can be pipelined and sent again.
+        Operation(std::string const& host, std::string const& port, bool idempotent);
+        
+        //! @brief Destructor.
+        virtual ~Operation();
+        
+        //! @brief Returns the name of the host.
+        std::string const& getHost() const;
+        
+        //! @brief Returns the port of the host.
+        std::string const& getPort() const;
+        
+        //! @brief Returns true if the request can be pipelined and sent again.
+        bool isIdempotent() const;
+        
+        //! @brief Completes the operation.
+        //! @details Returns false if the operation was already completed.
+        bool complete(Error const& error);
+        
+        //! @brief Returns true if the operation was completed.
+        bool completed() const;
+        
+    private: // methods
+        
+        //! @brief Writes the request.
+        //! @details The handler must be called on the strand.
+        virtual void write(tcp::socket& socket,
+                           Strand& strand,
+                           std::function<void(Error const&)> handler) = 0;
+        
+        //! @brief Reads the response.
+        //! @details The handler must be called on the strand with the keep-alive status of the response.
+        virtual void read(tcp::socket& socket,
+                          beast::flat_buffer& buffer,
+                          Strand& strand,
+                          std::function<void(Error const&, bool)> handler) = 0;
+        
+        //! @brief Called once when the operation is completed.
+        //! @details The read response is only valid if there is no error.
+        virtual void finish(Error const& error) = 0;
+        
+    private: // members
+        
+        const std::string                           m_host;
+        const std::string                           m_port;
+        const bool                                  m_idempotent;
+        std::atomic<bool>                           m_completed;
+        size_t                                      m_retries;
+        std::unique_ptr<boost::asio::steady_timer>  m_timer;
+        
+        friend class Client;
+        
+    private: // deleted methods
+        
+        Operation() = delete;
+        Operation(Operation const& other) = delete;
+        Operation(Operation && other) = delete;
+        Operation& operator=(Operation const& other) = delete;
+        Operation& operator=(Operation && other) = delete;
+    };
+    
+}}} // namespace kiwi::network::http
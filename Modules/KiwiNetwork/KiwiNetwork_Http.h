@@ -21,5 +21,6 @@
 
 #pragma once
 
+#include "KiwiHttp/KiwiHttp_Client.h"
 #include "KiwiHttp/KiwiHttp.h"
 #include "KiwiHttp/KiwiHttp_Session.h"
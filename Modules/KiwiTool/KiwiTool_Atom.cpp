@@ -78,21 +78,28 @@ namespace kiwi { namespace tool {
     
     Atom::Atom(string_t const& sym)
     : m_type(Type::String)
-    , m_value(sym)
+    , m_value(Symbol(sym))
     {
         ;
     }
     
     Atom::Atom(string_t&& sym)
     : m_type(Type::String)
-    , m_value(std::move(sym))
+    , m_value(Symbol(std::move(sym)))
     {
         ;
     }
     
     Atom::Atom(char const* sym)
     : m_type(Type::String)
-    , m_value(std::move(sym))
+    , m_value(Symbol(sym))
+    {
+        ;
+    }
+    
+    Atom::Atom(Symbol const& sym) noexcept
+    : m_type(Type::String)
+    , m_value(sym)
     {
         ;
     }
@@ -113,38 +120,14 @@ namespace kiwi { namespace tool {
         return (index > 0 && index <= 9) ? atom : Atom();
     }
     
-    Atom::Atom(Atom const& other)
+    Atom::Atom(Atom const& other) noexcept
     : m_type(other.m_type)
+    , m_value(other.m_value)
     {
-        switch(m_type)
-        {
-            case Type::Int:
-            case Type::Dollar:
-            {
-                m_value = other.m_value.int_v;
-                break;
-            }
-            case Type::Float:
-            {
-                m_value = other.m_value.float_v;
-                break;
-            }
-            case Type::String:
-            {
-                assert(other.m_value.string_v != nullptr);
-                m_value = *other.m_value.string_v;
-                break;
-            }
-            case Type::Comma:
-            {
-                break;
-            }
-                
-            default: break;
-        }
+        // strings are shared by the symbol table.
     }
     
-    Atom::Atom(Atom&& other)
+    Atom::Atom(Atom&& other) noexcept
     : m_type(std::move(other.m_type))
     , m_value(std::move(other.m_value))
     {
@@ -153,42 +136,10 @@ namespace kiwi { namespace tool {
         other.m_value = {};
     }
     
-    Atom::~Atom()
+    Atom& Atom::operator=(Atom const& other) noexcept
     {
-        if(isString())
-        {
-            std::allocator<string_t> alloc;
-            alloc.destroy(m_value.string_v);
-            alloc.deallocate(m_value.string_v, 1);
-        }
-    }
-    
-    Atom& Atom::operator=(Atom const& other)
-    {
-        if(!other.isString())
-        {
-            if(isString())
-            {
-                std::allocator<string_t> alloc;
-                alloc.destroy(m_value.string_v);
-                alloc.deallocate(m_value.string_v, 1);
-            }
-            
-            m_value = other.m_value;
-        }
-        else
-        {
-            if(isString())
-            {
-                *m_value.string_v = *other.m_value.string_v;
-            }
-            else
-            {
-                m_value.string_v = create_string_pointer(*other.m_value.string_v);
-            }
-        }
-        
         m_type = other.m_type;
+        m_value = other.m_value;
         
         return *this;
     }
@@ -235,8 +186,7 @@ namespace kiwi { namespace tool {
     
     bool Atom::isBang() const
     {
-        static const auto bang_str = "bang";
-        return isString() && getString() == bang_str;
+        return isString() && m_value.string_v == Symbol::bang().m_name;
     }
     
     bool Atom::isComma() const noexcept
@@ -292,6 +242,11 @@ namespace kiwi { namespace tool {
         return empty_string;
     }
     
+    Symbol Atom::getSymbol() const
+    {
+        return isString() ? Symbol(m_value.string_v, Symbol::Interned()) : Symbol();
+    }
+    
     //! @brief Retrieves the Dollar index value if the Atom is a dollar type.
     //! @return The Dollar index if the Atom is a dollar, 0 otherwise.
     //! @see getType(), isDollar(), isDollarTyped()
@@ -300,29 +255,6 @@ namespace kiwi { namespace tool {
         return isDollar() ? m_value.int_v : 0;
     }
     
-    // ================================================================================ //
-    //                                      VALUE                                       //
-    // ================================================================================ //
-    
-    //! @internal Exception-safe object creation helper
-    Atom::string_t* Atom::create_string_pointer(string_t const& v)
-    {
-        std::allocator<string_t> alloc;
-        auto deleter = [&alloc](string_t * object) { alloc.deallocate(object, 1); };
-        std::unique_ptr<string_t, decltype(deleter)> object(alloc.allocate(1), deleter);
-        alloc.construct(object.get(), v);
-        return object.release();
-    }
-    
-    Atom::string_t* Atom::create_string_pointer(string_t&& v)
-    {
-        std::allocator<string_t> alloc;
-        auto deleter = [&alloc](string_t * object) { alloc.deallocate(object, 1); };
-        std::unique_ptr<string_t, decltype(deleter)> object(alloc.allocate(1), deleter);
-        alloc.construct(object.get(), std::move(v));
-        return object.release();
-    }
-    
     // ================================================================================ //
     //                                    ATOM HELPER                                   //
     // ================================================================================ //
@@ -618,15 +550,20 @@ namespace kiwi { namespace tool {
     }
     
     std::string AtomHelper::toString(std::vector<Atom> const& atoms, const bool add_quotes)
+    {
+        return toString(atoms.data(), atoms.size(), add_quotes);
+    }
+    
+    std::string AtomHelper::toString(Atom const* atoms, size_t size, const bool add_quotes)
     {
         static const auto delimiter = ' ';
         std::ostringstream output;
-        if(!atoms.empty())
+        if(size > 0)
         {
-            for(std::vector<Atom>::size_type i = 0; i < atoms.size();)
+            for(size_t i = 0; i < size;)
             {
                 output << toString(atoms[i], add_quotes);
-                if(++i != atoms.size() && !atoms[i].isComma())
+                if(++i != size && !atoms[i].isComma())
                 {
                     output << delimiter;
                 }
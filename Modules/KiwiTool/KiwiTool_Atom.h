@@ -28,14 +28,19 @@
 #include <memory>
 #include <vector>
 
+#include <KiwiTool/KiwiTool_Symbol.h>
+
 namespace kiwi { namespace tool {
     
+    class AtomList;
+    
     // ================================================================================ //
     //                                      ATOM                                        //
     // ================================================================================ //
     
     //! @brief The Atom can dynamically hold different types of value
     //! @details The Atom can hold an integer, a float or a string.
+    //! Strings are interned as Symbol so copying and comparing string atoms is cheap.
     class Atom
     {
     public: // methods
@@ -115,6 +120,15 @@ namespace kiwi { namespace tool {
         //! @param sym The value.
         Atom(char const* sym);
         
+        //! @brief Constructs a string_t Atom from a Symbol.
+        //! @details Doesn't look up the symbol table.
+        //! @param sym The value.
+        Atom(Symbol const& sym) noexcept;
+        
+        //! @brief Deleted pointer constructor.
+        //! @details Prevents the other pointers from being converted to a bool Atom.
+        Atom(void const*) = delete;
+        
         //! @brief Constructs a Comma Atom.
         static Atom Comma();
         
@@ -126,21 +140,21 @@ namespace kiwi { namespace tool {
         //! @brief Copy constructor.
         //! @details Constructs an Atom by copying the contents of an other Atom.
         //! @param other The other Atom.
-        Atom(Atom const& other);
+        Atom(Atom const& other) noexcept;
         
         //! @brief Move constructor.
         //! @details Constructs an Atom value by stealing the contents of an other Atom
         //! using move semantics, leaving the other as a Null value Atom.
         //! @param other The other Atom value.
-        Atom(Atom&& other);
+        Atom(Atom&& other) noexcept;
         
         //! @brief Destructor.
-        ~Atom();
+        ~Atom() = default;
         
         //! @brief Copy assigment operator.
         //! @details Copies an Atom value.
         //! @param other The Atom object to copy.
-        Atom& operator=(Atom const& other);
+        Atom& operator=(Atom const& other) noexcept;
         
         //! @brief Copy assigment operator.
         //! @details Copies an Atom value with the "copy and swap" method.
@@ -215,6 +229,11 @@ namespace kiwi { namespace tool {
         //! @see getType(), isString(), getInt(), getFloat()
         string_t const& getString() const;
         
+        //! @brief Retrieves the Atom value as a Symbol.
+        //! @return The current string atom value if it is a string otherwise the empty symbol.
+        //! @see getType(), isString(), getString()
+        Symbol getSymbol() const;
+        
         //! @brief Retrieves the Dollar index value if the Atom is a dollar type.
         //! @return The Dollar index if the Atom is a dollar, 0 otherwise.
         //! @see getType(), isDollar(), isDollarTyped()
@@ -226,11 +245,6 @@ namespace kiwi { namespace tool {
         //                                      VALUE                                       //
         // ================================================================================ //
         
-        //! @internal Exception-safe object creation helper
-        static string_t* create_string_pointer(string_t const& v);
-        
-        static string_t* create_string_pointer(string_t&& v);
-        
         //! @internal The actual storage union for an Atom value.
         union atom_value
         {
@@ -240,8 +254,8 @@ namespace kiwi { namespace tool {
             //! @brief number (floating-point).
             float_t float_v;
             
-            //! @brief string.
-            string_t*   string_v;
+            //! @brief string interned in the symbol table.
+            string_t const* string_v;
             
             //! @brief default constructor (for null values).
             atom_value() = default;
@@ -253,10 +267,7 @@ namespace kiwi { namespace tool {
             atom_value(const float_t v) noexcept : float_v(v) {}
             
             //! @brief constructor for strings
-            atom_value(string_t const& v) : string_v(create_string_pointer(v)) {}
-            
-            //! @brief constructor for strings
-            atom_value(string_t&& v) : string_v(create_string_pointer(std::move(v))) {}
+            atom_value(Symbol const& v) noexcept : string_v(v.m_name) {}
         };
         
     private: // methods
@@ -303,7 +314,15 @@ namespace kiwi { namespace tool {
         //! (except for the special Atom::Type::Comma that is stuck to the previous Atom).
         static std::string toString(std::vector<Atom> const& atoms, const bool add_quotes = true);
         
+        //! @brief Convert a list of Atom into a string.
+        //! @see toString(std::vector<Atom> const&, const bool)
+        static std::string toString(AtomList const& atoms, const bool add_quotes = true);
+        
+        //! @brief Convert a range of Atom into a string.
+        //! @see toString(std::vector<Atom> const&, const bool)
+        static std::string toString(Atom const* atoms, size_t size, const bool add_quotes = true);
+        
         static std::string trimDecimal(std::string const& text);
     };
     
-}}
+}}
@@ -0,0 +1,318 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <array>
+#include <new>
+
+#include <KiwiTool/KiwiTool_AtomList.h>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                  ATOM LIST ARENA                                 //
+    // ================================================================================ //
+    
+    //! @brief Caches the storage of the long lists freed by a thread.
+    //! @details The capacities are powers of two. The largest blocks aren't cached.
+    class AtomListArena
+    {
+    public: // methods
+        
+        //! @brief Returns the arena of the current thread or nullptr if it's destroyed.
+        static AtomListArena* use() noexcept
+        {
+            thread_local bool destroyed = false;
+            thread_local AtomListArena arena(destroyed);
+            
+            return destroyed ? nullptr : &arena;
+        }
+        
+        //! @brief Allocates the storage of a number of atoms, rounded to a power of two.
+        static Atom* allocate(size_t& capacity)
+        {
+            size_t size_class = 0;
+            
+            while((min_capacity << size_class) < capacity)
+            {
+                ++size_class;
+            }
+            
+            capacity = min_capacity << size_class;
+            
+            AtomListArena* arena = use();
+            
+            if(arena != nullptr && size_class < number_of_classes && arena->m_blocks[size_class] != nullptr)
+            {
+                Block* block = arena->m_blocks[size_class];
+                arena->m_blocks[size_class] = block->m_next;
+                --arena->m_counts[size_class];
+                
+                return reinterpret_cast<Atom*>(block);
+            }
+            
+            return static_cast<Atom*>(::operator new(capacity * sizeof(Atom)));
+        }
+        
+        //! @brief Gives back the storage of atoms.
+        static void deallocate(Atom* data, size_t capacity) noexcept
+        {
+            size_t size_class = 0;
+            
+            while((min_capacity << size_class) < capacity)
+            {
+                ++size_class;
+            }
+            
+            AtomListArena* arena = use();
+            
+            if(arena != nullptr && size_class < number_of_classes
+               && arena->m_counts[size_class] < max_blocks_per_class)
+            {
+                Block* block = reinterpret_cast<Block*>(data);
+                block->m_next = arena->m_blocks[size_class];
+                arena->m_blocks[size_class] = block;
+                ++arena->m_counts[size_class];
+            }
+            else
+            {
+                ::operator delete(data);
+            }
+        }
+        
+    private: // classes
+        
+        struct Block
+        {
+            Block* m_next;
+        };
+        
+    private: // methods
+        
+        AtomListArena(bool& destroyed) noexcept :
+        m_blocks(),
+        m_counts(),
+        m_destroyed(destroyed)
+        {
+            m_blocks.fill(nullptr);
+            m_counts.fill(0);
+        }
+        
+        ~AtomListArena()
+        {
+            m_destroyed = true;
+            
+            for(Block* block : m_blocks)
+            {
+                while(block != nullptr)
+                {
+                    Block* next = block->m_next;
+                    ::operator delete(block);
+                    block = next;
+                }
+            }
+        }
+        
+    private: // members
+        
+        static constexpr size_t min_capacity = AtomList::inline_capacity * 2;
+        static constexpr size_t number_of_classes = 8;
+        static constexpr size_t max_blocks_per_class = 32;
+        
+        std::array<Block*, number_of_classes>   m_blocks;
+        std::array<size_t, number_of_classes>   m_counts;
+        bool&                                   m_destroyed;
+    };
+    
+    // ================================================================================ //
+    //                                     ATOM LIST                                    //
+    // ================================================================================ //
+    
+    constexpr size_t AtomList::inline_capacity;
+    
+    AtomList::AtomList() noexcept :
+    m_data(inlineData()),
+    m_size(0),
+    m_capacity(inline_capacity)
+    {
+    }
+    
+    AtomList::AtomList(std::initializer_list<Atom> atoms) : AtomList()
+    {
+        reserve(atoms.size());
+        assign(atoms.begin(), atoms.end());
+    }
+    
+    AtomList::AtomList(std::vector<Atom> const& atoms) : AtomList()
+    {
+        reserve(atoms.size());
+        assign(atoms.begin(), atoms.end());
+    }
+    
+    AtomList::AtomList(AtomList const& other) : AtomList()
+    {
+        reserve(other.size());
+        assign(other.begin(), other.end());
+    }
+    
+    AtomList::AtomList(AtomList&& other) noexcept : AtomList()
+    {
+        *this = std::move(other);
+    }
+    
+    AtomList::~AtomList()
+    {
+        clear();
+        release();
+    }
+    
+    AtomList& AtomList::operator=(AtomList const& other)
+    {
+        if(this != &other)
+        {
+            clear();
+            reserve(other.size());
+            assign(other.begin(), other.end());
+        }
+        
+        return *this;
+    }
+    
+    AtomList& AtomList::operator=(AtomList&& other) noexcept
+    {
+        if(this == &other)
+        {
+            return *this;
+        }
+        
+        clear();
+        
+        if(other.isInline())
+        {
+            for(Atom& atom : other)
+            {
+                new (m_data + m_size) Atom(std::move(atom));
+                ++m_size;
+            }
+            
+            other.clear();
+        }
+        else
+        {
+            release();
+            
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_capacity = other.m_capacity;
+            
+            other.m_data = other.inlineData();
+            other.m_size = 0;
+            other.m_capacity = inline_capacity;
+        }
+        
+        return *this;
+    }
+    
+    void AtomList::reserve(size_t capacity)
+    {
+        if(capacity <= m_capacity)
+        {
+            return;
+        }
+        
+        Atom* data = AtomListArena::allocate(capacity);
+        
+        for(size_t i = 0; i < m_size; ++i)
+        {
+            new (data + i) Atom(std::move(m_data[i]));
+            m_data[i].~Atom();
+        }
+        
+        release();
+        
+        m_data = data;
+        m_capacity = capacity;
+    }
+    
+    void AtomList::resize(size_t size)
+    {
+        while(m_size > size)
+        {
+            pop_back();
+        }
+        
+        reserve(size);
+        
+        while(m_size < size)
+        {
+            emplace_back();
+        }
+    }
+    
+    void AtomList::clear() noexcept
+    {
+        while(m_size > 0)
+        {
+            pop_back();
+        }
+    }
+    
+    void AtomList::push_back(Atom const& atom)
+    {
+        emplace_back(atom);
+    }
+    
+    void AtomList::push_back(Atom&& atom)
+    {
+        emplace_back(std::move(atom));
+    }
+    
+    void AtomList::pop_back() noexcept
+    {
+        m_data[--m_size].~Atom();
+    }
+    
+    std::vector<Atom> AtomList::toVector() const
+    {
+        return std::vector<Atom>(begin(), end());
+    }
+    
+    void AtomList::release() noexcept
+    {
+        if(!isInline())
+        {
+            AtomListArena::deallocate(m_data, m_capacity);
+            
+            m_data = inlineData();
+            m_capacity = inline_capacity;
+        }
+    }
+    
+    // ================================================================================ //
+    //                                    ATOM HELPER                                   //
+    // ================================================================================ //
+    
+    std::string AtomHelper::toString(AtomList const& atoms, const bool add_quotes)
+    {
+        return toString(atoms.data(), atoms.size(), add_quotes);
+    }
+    
+}}
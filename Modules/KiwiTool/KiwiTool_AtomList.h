@@ -0,0 +1,192 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+
+#include <KiwiTool/KiwiTool_Atom.h>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                     ATOM LIST                                    //
+    // ================================================================================ //
+    
+    //! @brief A list of atoms used to pass messages.
+    //! @details Lists of up to inline_capacity atoms are stored inside the object so building,
+    //! copying and destroying short messages doesn't allocate. Longer lists take their storage
+    //! from blocks cached by each thread and given back to the cache of the thread that frees
+    //! them, so a thread that keeps sending long messages reuses the same blocks.
+    class AtomList
+    {
+    public: // types
+        
+        using value_type        = Atom;
+        using size_type         = size_t;
+        using reference         = Atom&;
+        using const_reference   = Atom const&;
+        using iterator          = Atom*;
+        using const_iterator    = Atom const*;
+        
+        //! @brief The number of atoms stored without allocation.
+        static constexpr size_t inline_capacity = 8;
+        
+    public: // methods
+        
+        //! @brief Constructs an empty list.
+        AtomList() noexcept;
+        
+        //! @brief Constructs a list from atoms.
+        AtomList(std::initializer_list<Atom> atoms);
+        
+        //! @brief Constructs a list from a range of atoms.
+        template<class InputIt,
+                 class = typename std::iterator_traits<InputIt>::iterator_category>
+        AtomList(InputIt first, InputIt last) : AtomList()
+        {
+            assign(first, last);
+        }
+        
+        //! @brief Constructs a list from a vector of atoms.
+        AtomList(std::vector<Atom> const& atoms);
+        
+        //! @brief Copy constructor.
+        AtomList(AtomList const& other);
+        
+        //! @brief Move constructor.
+        //! @details Steals the storage of a long list, copies the atoms of a short one.
+        AtomList(AtomList&& other) noexcept;
+        
+        //! @brief Destructor.
+        ~AtomList();
+        
+        //! @brief Copy assignment operator.
+        AtomList& operator=(AtomList const& other);
+        
+        //! @brief Move assignment operator.
+        AtomList& operator=(AtomList&& other) noexcept;
+        
+        //! @brief Replaces the atoms by a range of atoms.
+        template<class InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            
+            for(; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+        
+        //! @brief Returns the number of atoms.
+        size_t size() const noexcept { return m_size; }
+        
+        //! @brief Returns true if the list has no atom.
+        bool empty() const noexcept { return m_size == 0; }
+        
+        //! @brief Returns the number of atoms the list can hold without reallocating.
+        size_t capacity() const noexcept { return m_capacity; }
+        
+        //! @brief Returns true if the atoms are stored inside the list.
+        bool isInline() const noexcept { return m_data == inlineData(); }
+        
+        Atom* data() noexcept { return m_data; }
+        Atom const* data() const noexcept { return m_data; }
+        
+        Atom& operator[](size_t index) noexcept { return m_data[index]; }
+        Atom const& operator[](size_t index) const noexcept { return m_data[index]; }
+        
+        Atom& front() noexcept { return m_data[0]; }
+        Atom const& front() const noexcept { return m_data[0]; }
+        
+        Atom& back() noexcept { return m_data[m_size - 1]; }
+        Atom const& back() const noexcept { return m_data[m_size - 1]; }
+        
+        iterator begin() noexcept { return m_data; }
+        iterator end() noexcept { return m_data + m_size; }
+        const_iterator begin() const noexcept { return m_data; }
+        const_iterator end() const noexcept { return m_data + m_size; }
+        const_iterator cbegin() const noexcept { return m_data; }
+        const_iterator cend() const noexcept { return m_data + m_size; }
+        
+        //! @brief Makes room for a number of atoms.
+        void reserve(size_t capacity);
+        
+        //! @brief Resizes the list, new atoms are Null.
+        void resize(size_t size);
+        
+        //! @brief Removes all the atoms and keeps the storage.
+        void clear() noexcept;
+        
+        //! @brief Appends an atom.
+        void push_back(Atom const& atom);
+        
+        //! @brief Appends an atom.
+        void push_back(Atom&& atom);
+        
+        //! @brief Appends an atom constructed in place.
+        template<class... Args>
+        Atom& emplace_back(Args&&... args)
+        {
+            if(m_size < m_capacity)
+            {
+                Atom* atom = new (m_data + m_size) Atom(std::forward<Args>(args)...);
+                ++m_size;
+                return *atom;
+            }
+            
+            // the arguments may refer to an atom of the list.
+            Atom atom(std::forward<Args>(args)...);
+            reserve(m_capacity * 2);
+            
+            Atom* result = new (m_data + m_size) Atom(std::move(atom));
+            ++m_size;
+            return *result;
+        }
+        
+        //! @brief Removes the last atom.
+        void pop_back() noexcept;
+        
+        //! @brief Returns a vector with the atoms.
+        std::vector<Atom> toVector() const;
+        
+    private: // methods
+        
+        Atom* inlineData() noexcept { return reinterpret_cast<Atom*>(&m_inline); }
+        Atom const* inlineData() const noexcept { return reinterpret_cast<Atom const*>(&m_inline); }
+        
+        //! @internal Gives back the storage of a long list.
+        void release() noexcept;
+        
+    private: // members
+        
+        Atom*   m_data;
+        size_t  m_size;
+        size_t  m_capacity;
+        
+        typename std::aligned_storage<sizeof(Atom) * inline_capacity, alignof(Atom)>::type m_inline;
+    };
+    
+}}
@@ -42,7 +42,7 @@ namespace kiwi { namespace tool {
         m_castaways.erase(&castaway);
     }
     
-    void Beacon::dispatch(std::vector<Atom> const& args)
+    void Beacon::dispatch(AtomList const& args)
     {
         for(auto* castaway : m_castaways)
         {
@@ -25,7 +25,7 @@
 #include <map>
 #include <set>
 
-#include <KiwiTool/KiwiTool_Atom.h>
+#include <KiwiTool/KiwiTool_AtomList.h>
 
 namespace kiwi { namespace tool {
 
@@ -61,7 +61,7 @@ namespace kiwi { namespace tool {
         void unbind(Castaway& castaway);
         
         //! @brief Dispatch message to beacon castaways.
-        void dispatch(std::vector<Atom> const& args);
+        void dispatch(AtomList const& args);
         
     public: // nested classes
         
@@ -74,7 +74,7 @@ namespace kiwi { namespace tool {
         {
         public:
             virtual ~Castaway() {}
-            virtual void receive(std::vector<Atom> const& args) = 0;
+            virtual void receive(AtomList const& args) = 0;
         };
         
         // ================================================================================ //
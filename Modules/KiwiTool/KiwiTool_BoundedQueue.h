@@ -0,0 +1,192 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                   BOUNDED QUEUE                                  //
+    // ================================================================================ //
+    
+    //! @brief A lock-free multiple producers, multiple consumers FIFO of fixed capacity.
+    //! @details The capacity is fixed at construction, a push never blocks nor allocates
+    //! memory for the queue, it fails if the queue is full. Each slot has a sequence number
+    //! that tells the producers and the consumers if it can be written or read.
+    template<class T>
+    class BoundedQueue final
+    {
+    public: // methods
+        
+        //! @brief Constructor.
+        //! @details The capacity is rounded up to the next power of two.
+        BoundedQueue(size_t capacity):
+        m_capacity(roundCapacity(capacity)),
+        m_mask(m_capacity - 1),
+        m_cells(new Cell[m_capacity]),
+        m_push(0),
+        m_pop(0)
+        {
+            for(size_t i = 0; i < m_capacity; ++i)
+            {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        
+        //! @brief Destructor.
+        ~BoundedQueue() = default;
+        
+        //! @brief Returns the maximum number of values the queue can hold.
+        size_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+        
+        //! @brief Returns an approximative number of values in the queue.
+        size_t size() const noexcept
+        {
+            const size_t pop = m_pop.load(std::memory_order_acquire);
+            const size_t push = m_push.load(std::memory_order_acquire);
+            
+            return push > pop ? push - pop : 0;
+        }
+        
+        //! @brief Pushes a value at the end of the queue.
+        //! @return false if the queue is full, in which case the value is left untouched.
+        template<class U>
+        bool push(U&& value)
+        {
+            size_t position = m_push.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            
+            for(;;)
+            {
+                cell = &m_cells[position & m_mask];
+                
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - position);
+                
+                if(diff == 0)
+                {
+                    if(m_push.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if(diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_push.load(std::memory_order_relaxed);
+                }
+            }
+            
+            cell->value = std::forward<U>(value);
+            cell->sequence.store(position + 1, std::memory_order_release);
+            
+            return true;
+        }
+        
+        //! @brief Pops the first value of the queue.
+        //! @return false if the queue is empty.
+        bool pop(T& value)
+        {
+            size_t position = m_pop.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            
+            for(;;)
+            {
+                cell = &m_cells[position & m_mask];
+                
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+                
+                if(diff == 0)
+                {
+                    if(m_pop.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if(diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_pop.load(std::memory_order_relaxed);
+                }
+            }
+            
+            value = std::move(cell->value);
+            cell->sequence.store(position + m_capacity, std::memory_order_release);
+            
+            return true;
+        }
+        
+    private: // classes
+        
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T                   value;
+        };
+        
+    private: // methods
+        
+        static size_t roundCapacity(size_t capacity) noexcept
+        {
+            size_t result = 1;
+            
+            while(result < capacity)
+            {
+                result <<= 1;
+            }
+            
+            return result;
+        }
+        
+    private: // members
+        
+        const size_t                    m_capacity;
+        const size_t                    m_mask;
+        std::unique_ptr<Cell[]>         m_cells;
+        alignas(64) std::atomic<size_t> m_push;
+        alignas(64) std::atomic<size_t> m_pop;
+        
+    private: // deleted methods
+        
+        BoundedQueue() = delete;
+        BoundedQueue(BoundedQueue const& other) = delete;
+        BoundedQueue(BoundedQueue && other) = delete;
+        BoundedQueue& operator=(BoundedQueue const& other) = delete;
+        BoundedQueue& operator=(BoundedQueue && other) = delete;
+    };
+    
+}}
@@ -0,0 +1,195 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                 ORDER STATISTICS                                 //
+    // ================================================================================ //
+    
+    //! @brief Counts the elements of a sequence that are still present after removals.
+    //! @details The positions of the sequence are stable, removing an element only marks its
+    //! position. The rank of a position and the position of a rank are found in logarithmic
+    //! time with a Fenwick tree, so a list view can skip the removed elements without moving
+    //! the others.
+    class OrderStatistics final
+    {
+    public: // methods
+        
+        //! @brief Constructor.
+        OrderStatistics() = default;
+        
+        //! @brief Constructor, all the elements are present.
+        OrderStatistics(size_t size):
+        m_present(size, true),
+        m_tree(size + 1, 0),
+        m_count(size)
+        {
+            for(size_t i = 1; i <= size; ++i)
+            {
+                m_tree[i] += 1;
+                
+                const size_t parent = i + lowBit(i);
+                
+                if(parent <= size)
+                {
+                    m_tree[parent] += m_tree[i];
+                }
+            }
+        }
+        
+        //! @brief Destructor.
+        ~OrderStatistics() = default;
+        
+        //! @brief Returns the number of positions, including the removed elements.
+        size_t size() const noexcept
+        {
+            return m_present.size();
+        }
+        
+        //! @brief Returns the number of elements still present.
+        size_t count() const noexcept
+        {
+            return m_count;
+        }
+        
+        //! @brief Returns true if the element at a position is present.
+        bool contains(size_t position) const noexcept
+        {
+            return position < m_present.size() && m_present[position];
+        }
+        
+        //! @brief Appends a present element at the end of the sequence.
+        void push_back()
+        {
+            const size_t index = m_present.size() + 1;
+            
+            // the node covers the elements between index - lowBit(index) and index.
+            size_t value = 1;
+            
+            for(size_t child = index - 1; child > index - lowBit(index); child -= lowBit(child))
+            {
+                value += m_tree[child];
+            }
+            
+            if(m_tree.empty())
+            {
+                m_tree.push_back(0);
+            }
+            
+            m_tree.push_back(value);
+            m_present.push_back(true);
+            ++m_count;
+        }
+        
+        //! @brief Removes the element at a position.
+        //! @return false if the element was already removed.
+        bool erase(size_t position)
+        {
+            if(!contains(position))
+            {
+                return false;
+            }
+            
+            m_present[position] = false;
+            --m_count;
+            
+            for(size_t i = position + 1; i < m_tree.size(); i += lowBit(i))
+            {
+                --m_tree[i];
+            }
+            
+            return true;
+        }
+        
+        //! @brief Returns the number of elements present before a position.
+        size_t rank(size_t position) const noexcept
+        {
+            size_t result = 0;
+            
+            for(size_t i = std::min(position, size()); i > 0; i -= lowBit(i))
+            {
+                result += m_tree[i];
+            }
+            
+            return result;
+        }
+        
+        //! @brief Returns the position of the element present with a given rank.
+        //! @details The rank shall be lower than the count.
+        size_t select(size_t rank) const noexcept
+        {
+            assert(rank < m_count);
+            
+            const size_t size = m_present.size();
+            
+            size_t position = 0;
+            size_t step = 1;
+            
+            while((step << 1) <= size)
+            {
+                step <<= 1;
+            }
+            
+            // descends the tree, the position ends before the element.
+            for(; step > 0; step >>= 1)
+            {
+                if(position + step <= size && m_tree[position + step] <= rank)
+                {
+                    position += step;
+                    rank -= m_tree[position];
+                }
+            }
+            
+            return position;
+        }
+        
+        //! @brief Removes all the elements and positions.
+        void clear()
+        {
+            m_present.clear();
+            m_tree.clear();
+            m_count = 0;
+        }
+        
+    private: // methods
+        
+        static size_t lowBit(size_t index) noexcept
+        {
+            return index & (~index + 1);
+        }
+        
+    private: // members
+        
+        std::vector<bool>   m_present {};
+        std::vector<size_t> m_tree {};
+        size_t              m_count = 0;
+    };
+    
+}}
@@ -0,0 +1,146 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                    RING BUFFER                                   //
+    // ================================================================================ //
+    
+    //! @brief A wait-free single producer, single consumer FIFO of values.
+    //! @details The capacity is fixed at construction, values are written and read by blocks.
+    //! A write never blocks nor allocates, it fails if the block doesn't fit.
+    //! One thread shall write and another one shall read.
+    template<class T>
+    class RingBuffer final
+    {
+    public: // methods
+        
+        //! @brief Constructor.
+        //! @details The capacity is rounded up to the next power of two.
+        RingBuffer(size_t capacity):
+        m_capacity(roundCapacity(capacity)),
+        m_mask(m_capacity - 1),
+        m_buffer(new T[m_capacity]()),
+        m_read(0),
+        m_write(0)
+        {
+        }
+        
+        //! @brief Destructor.
+        ~RingBuffer() = default;
+        
+        //! @brief Returns the maximum number of values the buffer can hold.
+        size_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+        
+        //! @brief Returns the number of values that can be read.
+        //! @details Exact for the reader, at most the actual number for the writer.
+        size_t size() const noexcept
+        {
+            return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
+        }
+        
+        //! @brief Writes a block of values. Called by the writer only.
+        //! @return false if the values don't fit, in which case nothing is written.
+        bool write(T const* values, size_t count) noexcept
+        {
+            const size_t write = m_write.load(std::memory_order_relaxed);
+            const size_t read = m_read.load(std::memory_order_acquire);
+            
+            if(m_capacity - (write - read) < count)
+            {
+                return false;
+            }
+            
+            const size_t start = write & m_mask;
+            const size_t first = std::min(count, m_capacity - start);
+            
+            std::copy(values, values + first, m_buffer.get() + start);
+            std::copy(values + first, values + count, m_buffer.get());
+            
+            m_write.store(write + count, std::memory_order_release);
+            
+            return true;
+        }
+        
+        //! @brief Reads at most count values. Called by the reader only.
+        //! @return The number of values read.
+        size_t read(T* values, size_t count) noexcept
+        {
+            const size_t read = m_read.load(std::memory_order_relaxed);
+            const size_t write = m_write.load(std::memory_order_acquire);
+            
+            count = std::min(count, write - read);
+            
+            const size_t start = read & m_mask;
+            const size_t first = std::min(count, m_capacity - start);
+            
+            std::copy(m_buffer.get() + start, m_buffer.get() + start + first, values);
+            std::copy(m_buffer.get(), m_buffer.get() + (count - first), values + first);
+            
+            m_read.store(read + count, std::memory_order_release);
+            
+            return count;
+        }
+        
+    private: // methods
+        
+        static size_t roundCapacity(size_t capacity) noexcept
+        {
+            size_t result = 1;
+            
+            while(result < capacity)
+            {
+                result <<= 1;
+            }
+            
+            return result;
+        }
+        
+    private: // members
+        
+        const size_t                    m_capacity;
+        const size_t                    m_mask;
+        std::unique_ptr<T[]>            m_buffer;
+        alignas(64) std::atomic<size_t> m_read;
+        alignas(64) std::atomic<size_t> m_write;
+        
+    private: // deleted methods
+        
+        RingBuffer() = delete;
+        RingBuffer(RingBuffer const& other) = delete;
+        RingBuffer(RingBuffer && other) = delete;
+        RingBuffer& operator=(RingBuffer const& other) = delete;
+        RingBuffer& operator=(RingBuffer && other) = delete;
+    };
+    
+}}
@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <array>
+#include <cassert>
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <list>
 #include <chrono>
@@ -31,8 +34,11 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
+#include <functional>
 
 #include <KiwiTool/KiwiTool_ConcurrentQueue.h>
+#include <KiwiTool/KiwiTool_Semaphore.h>
 
 namespace kiwi { namespace tool {
     
@@ -67,6 +73,11 @@ namespace kiwi { namespace tool {
         
         class Event;
         
+        class Pool;
+        
+        template<class T>
+        class Allocator;
+        
     public: // methods
         
         //! @brief Constructor
@@ -100,6 +111,22 @@ namespace kiwi { namespace tool {
         //! @details Internally create a callback that will be executed and destroyed by the scheduler.
         void schedule(std::function<void(void)> && func, duration_t delay = std::chrono::milliseconds(0));
         
+        //! @brief Schedules the execution of a task at a certain time. Shared ownership.
+        //! @details Unlike schedule the execution time doesn't depend on the time of the call, periodic
+        //! tasks can compute their next deadline from the previous one without accumulating latencies.
+        void scheduleAt(std::shared_ptr<Task> const& task, time_point_t time);
+        
+        //! @brief Schedules the execution of a task at a certain time. Transfer ownership.
+        void scheduleAt(std::shared_ptr<Task> && task, time_point_t time);
+        
+        //! @brief Creates a task whose memory is recycled by the scheduler.
+        //! @details The task and its reference count are stored in a single block that returns to
+        //! the scheduler's pool when the last reference is released, so that creating tasks at a
+        //! steady rate doesn't allocate once the pool holds as many blocks as the pending tasks.
+        //! The task can be created and released on any thread and can outlive the scheduler.
+        template<class TaskType, class... Args>
+        std::shared_ptr<TaskType> makeTask(Args&&... args);
+        
         //! @brief Conditionally schedule a task in the consumer thread.
         //! @details The task is scheduled only if the calling thread is not the consumer thread. Otherwise
         //! it is executed right away.
@@ -120,17 +147,38 @@ namespace kiwi { namespace tool {
         //! wait for the execution to finish but only guarantee that further execution  will no occur.
         void unschedule(std::shared_ptr<Task> const& task);
         
+        //! @brief Returns the time of the event being executed.
+        //! @details Called by the consumer. While an event is executed, returns the time it was
+        //! scheduled at, so that the messages it sends can be stamped with their intended time
+        //! rather than the time they're processed. Returns the current time otherwise.
+        time_point_t getEventTime() const;
+        
         //! @brief Processes events of the consumer that have reached exeuction time.
         void process();
         
+        //! @brief Blocks until the next event reaches its execution time then processes events.
+        //! @details The consumer is woken up as soon as a task is scheduled or unscheduled or wakeUp
+        //! is called. Calling this method in a loop instead of process lets the consumer thread
+        //! execute events on time without polling. The wait never exceeds max_wait.
+        //! @see wakeUp
+        void waitAndProcess(duration_t max_wait);
+        
+        //! @brief Wakes up the consumer if it's waiting in waitAndProcess.
+        //! @details Can be used to make the consumer check an exit condition. Never locks, so
+        //! that tasks can be scheduled from a real-time thread.
+        void wakeUp();
+        
         //! @brief Lock the process until the returned lock is out of scope.
         std::unique_lock<std::mutex> lock() const;
         
     private: // members
         
-        Queue               m_queue;
-        mutable std::mutex  m_mutex;
-        std::thread::id     m_consumer_id;
+        std::shared_ptr<Pool>   m_pool;
+        Queue                   m_queue;
+        mutable std::mutex      m_mutex;
+        std::thread::id         m_consumer_id;
+        std::atomic<uint64_t>   m_wakeups;
+        Semaphore               m_wakeup_semaphore;
         
     private: // deleted methods
         
@@ -145,8 +193,10 @@ namespace kiwi { namespace tool {
     // ==================================================================================== //
     
     //! @brief A class that holds a list of scheduled events.
-    //! @details Implementation countains a list of events sorted by execution time that is updated
-    //! before processing using commands. A queue is created for each consumer.
+    //! @details Implementation countains a binary heap of events ordered by execution time that is
+    //! updated before processing using commands. Each scheduled task knows its position in the heap
+    //! so that rescheduling or cancelling it takes a logarithmic time. Events with the same execution
+    //! time are executed in the order they were scheduled. A queue is created for each consumer.
     template <class Clock>
     class Scheduler<Clock>::Queue final
     {
@@ -172,12 +222,25 @@ namespace kiwi { namespace tool {
         //! @brief Delays the execution of a task. Transfer ownership.
         void schedule(std::shared_ptr<Task> && task, duration_t delay);
         
+        //! @brief Schedules the execution of a task at a certain time. Shared ownership.
+        void scheduleAt(std::shared_ptr<Task> const& task, time_point_t time);
+        
+        //! @brief Schedules the execution of a task at a certain time. Transfer ownership.
+        void scheduleAt(std::shared_ptr<Task> && task, time_point_t time);
+        
         //! @brief Cancels the execution of a task.
         void unschedule(std::shared_ptr<Task> const& task);
         
         //! @brief Processes all events that have reached execution time.
         void process(time_point_t process_time);
         
+        //! @brief Applies the pending commands without executing events.
+        void update();
+        
+        //! @brief Gets the execution time of the next event.
+        //! @details Returns false if no event is scheduled. Called by the consumer.
+        bool getNextTime(time_point_t& time) const;
+        
     private: // methods
         
         //! @internal
@@ -186,10 +249,28 @@ namespace kiwi { namespace tool {
         //! @internal
         void remove(Event const& event);
         
+        //! @internal Returns the position of the task in the heap or npos if it's not scheduled.
+        size_t find(Task const& task) const;
+        
+        //! @internal Removes the event at a certain position in the heap.
+        Event extract(size_t position);
+        
+        //! @internal Moves an event at a certain position and updates its task's position.
+        void place(Event && event, size_t position);
+        
+        //! @internal Moves an event toward the top of the heap until the heap is ordered.
+        void siftUp(size_t position);
+        
+        //! @internal Moves an event toward the bottom of the heap until the heap is ordered.
+        void siftDown(size_t position);
+        
     private: // members
         
         std::vector<Event>          m_events;
+        uint64_t                    m_sequence;
         ConcurrentQueue<Command>    m_commands;
+        time_point_t                m_event_time;
+        bool                        m_executing;
         
     private: // friend classes
         
@@ -203,6 +284,128 @@ namespace kiwi { namespace tool {
         Queue& operator=(Queue && other) = delete;
     };
     
+    // ==================================================================================== //
+    //                                       POOL                                           //
+    // ==================================================================================== //
+    
+    //! @brief The memory of the tasks created by the scheduler.
+    //! @details Released blocks are kept in free lists of a same size and reused by the next
+    //! allocations of this size. Each type of task needs a single size, the pool holds a fixed number
+    //! of sizes and the other ones are allocated by the system. Blocks are only freed with the pool.
+    //! The free lists are lock-free stacks whose head is tagged with a counter against ABA, so that
+    //! tasks can be made and released from a real-time thread.
+    template <class Clock>
+    class Scheduler<Clock>::Pool final
+    {
+    public: // methods
+        
+        //! @brief Constructor.
+        Pool();
+        
+        //! @brief Destructor. Frees the released blocks.
+        ~Pool();
+        
+        //! @brief Returns a block of a certain size, reusing a released one if possible.
+        void* allocate(size_t size);
+        
+        //! @brief Releases a block previously returned by allocate with the same size.
+        void deallocate(void* block, size_t size) noexcept;
+        
+    private: // classes
+        
+        struct Block
+        {
+            std::atomic<Block*> m_next;
+        };
+        
+        struct List
+        {
+            std::atomic<size_t>     m_size;
+            std::atomic<uint64_t>   m_head;
+        };
+        
+    private: // methods
+        
+        //! @internal Returns the list of a certain size, nullptr if the pool doesn't hold this size.
+        List* find(size_t size, bool create) noexcept;
+        
+        //! @internal Packs a block and a tag in a list head.
+        static uint64_t pack(Block* block, uint64_t tag) noexcept;
+        
+        //! @internal Returns the block of a list head.
+        static Block* unpack(uint64_t head) noexcept;
+        
+        //! @internal Returns the tag of the head replacing a list head.
+        static uint64_t nextTag(uint64_t head) noexcept;
+        
+    private: // members
+        
+        static const size_t max_lists = 8;
+        
+        std::array<List, max_lists> m_lists;
+        
+    private: // deleted methods
+        
+        Pool(Pool const& other) = delete;
+        Pool(Pool && other) = delete;
+        Pool& operator=(Pool const& other) = delete;
+        Pool& operator=(Pool && other) = delete;
+    };
+    
+    // ==================================================================================== //
+    //                                      ALLOCATOR                                       //
+    // ==================================================================================== //
+    
+    //! @brief The standard allocator that takes the memory of the tasks from the pool.
+    //! @details The allocator shares the ownership of the pool so that a task released after the
+    //! scheduler's destruction still returns its block to a valid pool.
+    template <class Clock>
+    template <class T>
+    class Scheduler<Clock>::Allocator final
+    {
+    public: // classes
+        
+        using value_type = T;
+        
+        template<class U>
+        struct rebind
+        {
+            using other = Allocator<U>;
+        };
+        
+    public: // methods
+        
+        //! @brief Constructor.
+        Allocator(std::shared_ptr<Pool> const& pool) noexcept;
+        
+        //! @brief Conversion constructor used by rebind.
+        template<class U>
+        Allocator(Allocator<U> const& other) noexcept;
+        
+        //! @brief Allocates memory for n elements.
+        T* allocate(size_t n);
+        
+        //! @brief Releases the memory of n elements.
+        void deallocate(T* pointer, size_t n) noexcept;
+        
+        //! @brief Returns true if the allocators share the same pool.
+        template<class U>
+        bool operator==(Allocator<U> const& other) const noexcept;
+        
+        //! @brief Returns true if the allocators don't share the same pool.
+        template<class U>
+        bool operator!=(Allocator<U> const& other) const noexcept;
+        
+    private: // members
+        
+        std::shared_ptr<Pool>   m_pool;
+        
+    private: // friends
+        
+        template<class U>
+        friend class Allocator;
+    };
+    
     // ==================================================================================== //
     //                                       TASK                                           //
     // ==================================================================================== //
@@ -230,6 +433,10 @@ namespace kiwi { namespace tool {
         //! is reached.
         virtual void execute() = 0;
         
+    private: // members
+        
+        size_t  m_position;
+        
     private: // friends
         
         friend class Scheduler;
@@ -282,6 +489,9 @@ namespace kiwi { namespace tool {
     
     //! @brief An abstract class designed to repetedly call a method at a specified intervall of time.
     //! Overriding timerCallBack and calling startTimer will start repetdly calling method.
+    //! @details Each deadline is computed from the previous one and not from the time of the call, so
+    //! the latency of the callbacks doesn't accumulate. If the timer is late by more than a period, the
+    //! missed deadlines are skipped and the next ones stay on the same grid.
     template<class Clock>
     class Scheduler<Clock>::Timer
     {
@@ -304,6 +514,10 @@ namespace kiwi { namespace tool {
         //! @details Will cause timerCallBack to be called at a specified rate by the right consumer.
         void startTimer(duration_t period);
         
+        //! @brief Changes the period of the timer.
+        //! @details If the timer is running, the new period applies from the next deadline on.
+        void setTimerPeriod(duration_t period);
+        
         //! @brief Stops the timer.
         //! @details If called when timerCallBack is being processed, stopTimer will not wait for the execution
         //! to finish but will only guarantee that further execution will not occur.
@@ -322,6 +536,7 @@ namespace kiwi { namespace tool {
         Scheduler &             m_scheduler;
         std::shared_ptr<Task>   m_task;
         duration_t              m_period;
+        time_point_t            m_next_time;
         
     private: // deleted methods
         
@@ -357,6 +572,9 @@ namespace kiwi { namespace tool {
         //! @brief Called by the scheduler to execute a the task.
         void execute();
         
+        //! @brief Returns true if the event shall be executed before the other.
+        bool isBefore(Event const& other) const;
+        
     private: // friends
         
         friend class Scheduler;
@@ -365,6 +583,7 @@ namespace kiwi { namespace tool {
         
         std::shared_ptr<Task>       m_task;
         time_point_t                m_time;
+        uint64_t                    m_sequence;
         
     private: // deleted methods
         
@@ -22,6 +22,8 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <new>
 
 namespace kiwi { namespace tool {
     
@@ -31,9 +33,12 @@ namespace kiwi { namespace tool {
     
     template<class Clock>
     Scheduler<Clock>::Scheduler():
+    m_pool(std::make_shared<Pool>()),
     m_queue(),
     m_mutex(),
-    m_consumer_id(std::this_thread::get_id())
+    m_consumer_id(std::this_thread::get_id()),
+    m_wakeups(0),
+    m_wakeup_semaphore(1)
     {
     }
     
@@ -59,6 +64,7 @@ namespace kiwi { namespace tool {
     {
         assert(task);
         m_queue.schedule(task, delay);
+        wakeUp();
     }
     
     template<class Clock>
@@ -66,12 +72,36 @@ namespace kiwi { namespace tool {
     {
         assert(task);
         m_queue.schedule(std::move(task), delay);
+        wakeUp();
     }
     
     template<class Clock>
     void Scheduler<Clock>::schedule(std::function<void(void)> && func, duration_t delay)
     {
-        schedule(std::make_shared<CallBack>(func), delay);
+        schedule(makeTask<CallBack>(std::move(func)), delay);
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::scheduleAt(std::shared_ptr<Task> const& task, time_point_t time)
+    {
+        assert(task);
+        m_queue.scheduleAt(task, time);
+        wakeUp();
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::scheduleAt(std::shared_ptr<Task> && task, time_point_t time)
+    {
+        assert(task);
+        m_queue.scheduleAt(std::move(task), time);
+        wakeUp();
+    }
+    
+    template<class Clock>
+    template<class TaskType, class... Args>
+    std::shared_ptr<TaskType> Scheduler<Clock>::makeTask(Args&&... args)
+    {
+        return std::allocate_shared<TaskType>(Allocator<TaskType>(m_pool), std::forward<Args>(args)...);
     }
     
     template<class Clock>
@@ -123,6 +153,15 @@ namespace kiwi { namespace tool {
     {
         assert(task);
         m_queue.unschedule(task);
+        wakeUp();
+    }
+    
+    template<class Clock>
+    typename Scheduler<Clock>::time_point_t Scheduler<Clock>::getEventTime() const
+    {
+        assert(std::this_thread::get_id() == m_consumer_id);
+        
+        return m_queue.m_executing ? m_queue.m_event_time : clock_t::now();
     }
     
     template<class Clock>
@@ -137,6 +176,67 @@ namespace kiwi { namespace tool {
         m_queue.process(process_time);
     }
     
+    template<class Clock>
+    void Scheduler<Clock>::waitAndProcess(duration_t max_wait)
+    {
+        assert(std::this_thread::get_id() == m_consumer_id);
+        
+        // the system may wake up a thread late, the end of the wait before an event is done actively.
+        
+        const std::chrono::microseconds spin_duration(200);
+        
+        const uint64_t wakeups = m_wakeups.load();
+        
+        time_point_t wakeup_time = clock_t::now() + max_wait;
+        
+        bool wait_event = false;
+        
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            
+            m_queue.update();
+            
+            time_point_t next_time;
+            
+            if (m_queue.getNextTime(next_time) && next_time < wakeup_time)
+            {
+                wakeup_time = next_time;
+                wait_event = true;
+            }
+        }
+        
+        // commands pushed after the update changed the wakeup count, a post left by a wakeup
+        // preceding the update only ends one wait early.
+        
+        const time_point_t wait_time = wait_event ? wakeup_time - spin_duration : wakeup_time;
+        
+        time_point_t now = clock_t::now();
+        
+        while(m_wakeups.load() == wakeups && now < wait_time)
+        {
+            m_wakeup_semaphore.waitFor(std::chrono::duration_cast<std::chrono::nanoseconds>(wait_time - now));
+            
+            now = clock_t::now();
+        }
+        
+        while(wait_event && m_wakeups.load() == wakeups && clock_t::now() < wakeup_time)
+        {
+            std::this_thread::yield();
+        }
+        
+        process();
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::wakeUp()
+    {
+        m_wakeups.fetch_add(1);
+        
+        // the post is lock-free and only calls the system when the consumer is waiting.
+        
+        m_wakeup_semaphore.post();
+    }
+    
     template<class Clock>
     std::unique_lock<std::mutex> Scheduler<Clock>::lock() const
     {
@@ -152,7 +252,10 @@ namespace kiwi { namespace tool {
     template<class Clock>
     Scheduler<Clock>::Queue::Queue():
     m_events(),
-    m_commands(1024)
+    m_sequence(0),
+    m_commands(1024),
+    m_event_time(),
+    m_executing(false)
     {
     }
     
@@ -175,6 +278,21 @@ namespace kiwi { namespace tool {
         m_commands.push({std::move(task), clock_t::now() + delay});
     }
     
+    template<class Clock>
+    void Scheduler<Clock>::Queue::scheduleAt(std::shared_ptr<Task> const& task, time_point_t time)
+    {
+        // the maximum time is reserved to the unschedule commands.
+        assert(task && time != clock_t::time_point::max());
+        m_commands.push({task, time});
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::Queue::scheduleAt(std::shared_ptr<Task> && task, time_point_t time)
+    {
+        assert(task && time != clock_t::time_point::max());
+        m_commands.push({std::move(task), time});
+    }
+    
     template<class Clock>
     void Scheduler<Clock>::Queue::unschedule(std::shared_ptr<Task> const& task)
     {
@@ -182,41 +300,148 @@ namespace kiwi { namespace tool {
     }
     
     template<class Clock>
-    void Scheduler<Clock>::Queue::remove(Event const& event)
+    size_t Scheduler<Clock>::Queue::find(Task const& task) const
     {
-        m_events.erase(std::remove_if(m_events.begin(), m_events.end(), [&event](Event const& e) {
+        const size_t position = task.m_position;
+        
+        if (position < m_events.size() && m_events[position].m_task.get() == &task)
+        {
+            return position;
+        }
+        
+        return std::numeric_limits<size_t>::max();
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::Queue::place(Event && event, size_t position)
+    {
+        event.m_task->m_position = position;
+        m_events[position] = std::move(event);
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::Queue::siftUp(size_t position)
+    {
+        Event event(std::move(m_events[position]));
+        
+        while (position > 0)
+        {
+            const size_t parent = (position - 1) / 2;
             
-            return e.m_task == event.m_task;
+            if (!event.isBefore(m_events[parent]))
+            {
+                break;
+            }
             
-        }), m_events.end());
+            place(std::move(m_events[parent]), position);
+            position = parent;
+        }
+        
+        place(std::move(event), position);
     }
     
     template<class Clock>
-    void Scheduler<Clock>::Queue::emplace(Event && event)
+    void Scheduler<Clock>::Queue::siftDown(size_t position)
     {
-        remove(event);
+        const size_t size = m_events.size();
         
-        auto event_it = m_events.begin();
+        Event event(std::move(m_events[position]));
         
-        while(event_it != m_events.end())
+        while (2 * position + 1 < size)
         {
-            if (event.m_time < event_it->m_time)
+            size_t child = 2 * position + 1;
+            
+            if (child + 1 < size && m_events[child + 1].isBefore(m_events[child]))
+            {
+                ++child;
+            }
+            
+            if (!m_events[child].isBefore(event))
             {
-                m_events.insert(event_it, std::move(event));
                 break;
             }
             
-            ++event_it;
+            place(std::move(m_events[child]), position);
+            position = child;
+        }
+        
+        place(std::move(event), position);
+    }
+    
+    template<class Clock>
+    typename Scheduler<Clock>::Event Scheduler<Clock>::Queue::extract(size_t position)
+    {
+        Event event(std::move(m_events[position]));
+        
+        event.m_task->m_position = std::numeric_limits<size_t>::max();
+        
+        Event last(std::move(m_events.back()));
+        
+        m_events.pop_back();
+        
+        if (position < m_events.size())
+        {
+            const bool is_before = last.isBefore(event);
+            
+            place(std::move(last), position);
+            
+            if (is_before)
+            {
+                siftUp(position);
+            }
+            else
+            {
+                siftDown(position);
+            }
         }
         
-        if (event_it == m_events.end())
+        return event;
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::Queue::remove(Event const& event)
+    {
+        const size_t position = find(*event.m_task);
+        
+        if (position < m_events.size())
+        {
+            extract(position);
+        }
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::Queue::emplace(Event && event)
+    {
+        event.m_sequence = m_sequence++;
+        
+        const size_t position = find(*event.m_task);
+        
+        if (position < m_events.size())
+        {
+            // rescheduling a task updates its event.
+            
+            const bool is_before = event.isBefore(m_events[position]);
+            
+            place(std::move(event), position);
+            
+            if (is_before)
+            {
+                siftUp(position);
+            }
+            else
+            {
+                siftDown(position);
+            }
+        }
+        else
         {
             m_events.emplace_back(std::move(event));
+            siftUp(m_events.size() - 1);
         }
     }
     
     template<class Clock>
-    void Scheduler<Clock>::Queue::process(time_point_t process_time)
+    void Scheduler<Clock>::Queue::update()
     {
         size_t command_size = m_commands.load_size();
         
@@ -238,18 +463,230 @@ namespace kiwi { namespace tool {
                 }
             }
         }
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::Queue::process(time_point_t process_time)
+    {
+        update();
+        
+        // tasks scheduled during execution are only added to the heap by the next process.
         
-        m_events.erase(std::remove_if(m_events.begin(), m_events.end(), [&process_time](auto& event) {
+        m_executing = true;
+        
+        while (!m_events.empty() && m_events.front().m_time <= process_time)
+        {
+            Event event = extract(0);
+            
+            m_event_time = event.m_time;
+            
+            event.execute();
+        }
+        
+        m_executing = false;
+    }
+    
+    template<class Clock>
+    bool Scheduler<Clock>::Queue::getNextTime(time_point_t& time) const
+    {
+        if (m_events.empty())
+        {
+            return false;
+        }
+        
+        time = m_events.front().m_time;
+        
+        return true;
+    }
+    
+    // ==================================================================================== //
+    //                                       POOL                                           //
+    // ==================================================================================== //
+    
+    template<class Clock>
+    Scheduler<Clock>::Pool::Pool():
+    m_lists()
+    {
+        for (List& list : m_lists)
+        {
+            list.m_size.store(0);
+            list.m_head.store(pack(nullptr, 0));
+        }
+    }
+    
+    template<class Clock>
+    Scheduler<Clock>::Pool::~Pool()
+    {
+        for (List& list : m_lists)
+        {
+            Block* block = unpack(list.m_head.load());
+            
+            while (block != nullptr)
+            {
+                Block* next = block->m_next.load();
+                ::operator delete(block);
+                block = next;
+            }
+        }
+    }
+    
+    template<class Clock>
+    uint64_t Scheduler<Clock>::Pool::pack(Block* block, uint64_t tag) noexcept
+    {
+        // user space addresses fit in 48 bits on 64-bit platforms, the tag takes the other bits.
+        
+        const uint64_t address = reinterpret_cast<uintptr_t>(block);
+        
+        return sizeof(Block*) == 8 ? (address << 16) | (tag & 0xffff) : (tag << 32) | address;
+    }
+    
+    template<class Clock>
+    typename Scheduler<Clock>::Pool::Block* Scheduler<Clock>::Pool::unpack(uint64_t head) noexcept
+    {
+        const uint64_t address = sizeof(Block*) == 8 ? head >> 16 : head & 0xffffffff;
+        
+        return reinterpret_cast<Block*>(static_cast<uintptr_t>(address));
+    }
+    
+    template<class Clock>
+    uint64_t Scheduler<Clock>::Pool::nextTag(uint64_t head) noexcept
+    {
+        return (sizeof(Block*) == 8 ? head : head >> 32) + 1;
+    }
+    
+    template<class Clock>
+    typename Scheduler<Clock>::Pool::List* Scheduler<Clock>::Pool::find(size_t size, bool create) noexcept
+    {
+        // lists are taken in order and never given back, a list of size zero ends the search.
+        
+        for (List& list : m_lists)
+        {
+            size_t list_size = list.m_size.load(std::memory_order_acquire);
             
-            if (event.m_time <= process_time)
+            if (list_size == 0)
             {
-                event.execute();
-                return true;
+                if (!create)
+                {
+                    return nullptr;
+                }
+                
+                if (list.m_size.compare_exchange_strong(list_size, size, std::memory_order_acq_rel))
+                {
+                    return &list;
+                }
             }
             
-            return false;
+            if (list_size == size)
+            {
+                return &list;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    template<class Clock>
+    void* Scheduler<Clock>::Pool::allocate(size_t size)
+    {
+        size = std::max(size, sizeof(Block));
+        
+        if (List* list = find(size, true))
+        {
+            uint64_t head = list->m_head.load(std::memory_order_acquire);
+            
+            // blocks are never freed before the pool, reading the next block of a block popped
+            // meanwhile is safe and the tag makes the exchange fail.
+            
+            while (Block* block = unpack(head))
+            {
+                const uint64_t next = pack(block->m_next.load(std::memory_order_relaxed), nextTag(head));
+                
+                if (list->m_head.compare_exchange_weak(head, next,
+                                                       std::memory_order_acquire,
+                                                       std::memory_order_acquire))
+                {
+                    return block;
+                }
+            }
+        }
+        
+        return ::operator new(size);
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::Pool::deallocate(void* block, size_t size) noexcept
+    {
+        size = std::max(size, sizeof(Block));
+        
+        if (List* list = find(size, false))
+        {
+            Block* released = new (block) Block();
             
-        }), m_events.end());
+            uint64_t head = list->m_head.load(std::memory_order_relaxed);
+            
+            do
+            {
+                released->m_next.store(unpack(head), std::memory_order_relaxed);
+            }
+            while (!list->m_head.compare_exchange_weak(head, pack(released, nextTag(head)),
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed));
+            
+            return;
+        }
+        
+        ::operator delete(block);
+    }
+    
+    // ==================================================================================== //
+    //                                      ALLOCATOR                                       //
+    // ==================================================================================== //
+    
+    template<class Clock>
+    template<class T>
+    Scheduler<Clock>::Allocator<T>::Allocator(std::shared_ptr<Pool> const& pool) noexcept:
+    m_pool(pool)
+    {
+    }
+    
+    template<class Clock>
+    template<class T>
+    template<class U>
+    Scheduler<Clock>::Allocator<T>::Allocator(Allocator<U> const& other) noexcept:
+    m_pool(other.m_pool)
+    {
+    }
+    
+    template<class Clock>
+    template<class T>
+    T* Scheduler<Clock>::Allocator<T>::allocate(size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned tasks are not supported");
+        
+        return static_cast<T*>(m_pool->allocate(n * sizeof(T)));
+    }
+    
+    template<class Clock>
+    template<class T>
+    void Scheduler<Clock>::Allocator<T>::deallocate(T* pointer, size_t n) noexcept
+    {
+        m_pool->deallocate(pointer, n * sizeof(T));
+    }
+    
+    template<class Clock>
+    template<class T>
+    template<class U>
+    bool Scheduler<Clock>::Allocator<T>::operator==(Allocator<U> const& other) const noexcept
+    {
+        return m_pool == other.m_pool;
+    }
+    
+    template<class Clock>
+    template<class T>
+    template<class U>
+    bool Scheduler<Clock>::Allocator<T>::operator!=(Allocator<U> const& other) const noexcept
+    {
+        return m_pool != other.m_pool;
     }
     
     // ==================================================================================== //
@@ -257,7 +694,8 @@ namespace kiwi { namespace tool {
     // ==================================================================================== //
     
     template<class Clock>
-    Scheduler<Clock>::Task::Task()
+    Scheduler<Clock>::Task::Task():
+    m_position(std::numeric_limits<size_t>::max())
     {
     }
     
@@ -273,7 +711,7 @@ namespace kiwi { namespace tool {
     template<class Clock>
     Scheduler<Clock>::CallBack::CallBack(std::function<void(void)> func):
     Task(),
-    m_func(func)
+    m_func(std::move(func))
     {
     }
     
@@ -321,7 +759,8 @@ namespace kiwi { namespace tool {
     Scheduler<Clock>::Timer::Timer(Scheduler & scheduler):
     m_scheduler(scheduler),
     m_task(new Task(*this)),
-    m_period()
+    m_period(),
+    m_next_time()
     {
     }
     
@@ -337,16 +776,35 @@ namespace kiwi { namespace tool {
         stopTimer();
         
         m_period = period;
+        m_next_time = clock_t::now() + m_period;
         
-        m_scheduler.schedule(m_task, m_period);
+        m_scheduler.scheduleAt(m_task, m_next_time);
+    }
+    
+    template<class Clock>
+    void Scheduler<Clock>::Timer::setTimerPeriod(duration_t period)
+    {
+        m_period = period;
     }
     
     template<class Clock>
     void Scheduler<Clock>::Timer::callBackInternal()
     {
-        timerCallBack();
+        const time_point_t now = clock_t::now();
+        
+        m_next_time += m_period;
         
-        m_scheduler.schedule(m_task, m_period);
+        if (m_next_time < now && m_period > duration_t::zero())
+        {
+            // skips the deadlines missed while the consumer was late.
+            m_next_time += ((now - m_next_time) / m_period + 1) * m_period;
+        }
+        
+        // rescheduling first lets the callback stop or restart the timer.
+        
+        m_scheduler.scheduleAt(m_task, m_next_time);
+        
+        timerCallBack();
     }
     
     template<class Clock>
@@ -362,14 +820,16 @@ namespace kiwi { namespace tool {
     template<class Clock>
     Scheduler<Clock>::Event::Event(std::shared_ptr<Task> && task, time_point_t time):
     m_task(std::move(task)),
-    m_time(time)
+    m_time(time),
+    m_sequence(0)
     {
     }
     
     template<class Clock>
     Scheduler<Clock>::Event::Event(Event && other):
     m_task(std::move(other.m_task)),
-    m_time(std::move(other.m_time))
+    m_time(std::move(other.m_time)),
+    m_sequence(other.m_sequence)
     {
     }
     
@@ -378,6 +838,7 @@ namespace kiwi { namespace tool {
     {
         m_task = std::move(other.m_task);
         m_time = std::move(other.m_time);
+        m_sequence = other.m_sequence;
         
         return *this;
     }
@@ -393,4 +854,10 @@ namespace kiwi { namespace tool {
     {
         if (m_task){m_task->execute();}
     }
+    
+    template<class Clock>
+    bool Scheduler<Clock>::Event::isBefore(Event const& other) const
+    {
+        return m_time < other.m_time || (m_time == other.m_time && m_sequence < other.m_sequence);
+    }
 }}
@@ -0,0 +1,208 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include "KiwiTool_Semaphore.h"
+
+#if defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#elif defined(_WIN32)
+#include <climits>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdint>
+#include <ctime>
+#include <semaphore.h>
+#endif
+
+namespace kiwi { namespace tool {
+    
+    // ==================================================================================== //
+    //                                      SEMAPHORE                                       //
+    // ==================================================================================== //
+    
+    Semaphore::Semaphore(int max_count):
+    m_count(0),
+    m_max_count(max_count),
+    m_semaphore(nullptr)
+    {
+        #if defined(__APPLE__)
+        m_semaphore = dispatch_semaphore_create(0);
+        #elif defined(_WIN32)
+        m_semaphore = CreateSemaphore(nullptr, 0, LONG_MAX, nullptr);
+        #else
+        sem_t* semaphore = new sem_t;
+        sem_init(semaphore, 0, 0);
+        m_semaphore = semaphore;
+        #endif
+    }
+    
+    Semaphore::~Semaphore()
+    {
+        #if defined(__APPLE__)
+        dispatch_release(static_cast<dispatch_semaphore_t>(m_semaphore));
+        #elif defined(_WIN32)
+        CloseHandle(static_cast<HANDLE>(m_semaphore));
+        #else
+        sem_destroy(static_cast<sem_t*>(m_semaphore));
+        delete static_cast<sem_t*>(m_semaphore);
+        #endif
+    }
+    
+    void Semaphore::post() noexcept
+    {
+        int count = m_count.load(std::memory_order_relaxed);
+        
+        do
+        {
+            if(count >= m_max_count)
+            {
+                return;
+            }
+        }
+        while(!m_count.compare_exchange_weak(count, count + 1,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+        
+        if(count < 0)
+        {
+            postSystem();
+        }
+    }
+    
+    void Semaphore::wait() noexcept
+    {
+        if(!tryWait() && m_count.fetch_sub(1, std::memory_order_acquire) <= 0)
+        {
+            waitSystem(std::chrono::nanoseconds(-1));
+        }
+    }
+    
+    bool Semaphore::waitFor(std::chrono::nanoseconds timeout) noexcept
+    {
+        if(tryWait())
+        {
+            return true;
+        }
+        
+        if(m_count.fetch_sub(1, std::memory_order_acquire) > 0)
+        {
+            return true;
+        }
+        
+        if(timeout.count() > 0 && waitSystem(timeout))
+        {
+            return true;
+        }
+        
+        // gives the decrement back unless a post already woke up this thread.
+        
+        int count = m_count.load(std::memory_order_relaxed);
+        
+        while(count < 0)
+        {
+            if(m_count.compare_exchange_weak(count, count + 1,
+                                             std::memory_order_relaxed,
+                                             std::memory_order_relaxed))
+            {
+                return false;
+            }
+        }
+        
+        waitSystem(std::chrono::nanoseconds(-1));
+        
+        return true;
+    }
+    
+    bool Semaphore::tryWait() noexcept
+    {
+        int count = m_count.load(std::memory_order_relaxed);
+        
+        while(count > 0)
+        {
+            if(m_count.compare_exchange_weak(count, count - 1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    bool Semaphore::waitSystem(std::chrono::nanoseconds timeout) noexcept
+    {
+        #if defined(__APPLE__)
+        
+        auto* semaphore = static_cast<dispatch_semaphore_t>(m_semaphore);
+        
+        const dispatch_time_t time = timeout.count() < 0
+        ? DISPATCH_TIME_FOREVER : dispatch_time(DISPATCH_TIME_NOW, timeout.count());
+        
+        return dispatch_semaphore_wait(semaphore, time) == 0;
+        
+        #elif defined(_WIN32)
+        
+        const DWORD milliseconds = timeout.count() < 0
+        ? INFINITE : static_cast<DWORD>((timeout.count() + 999999) / 1000000);
+        
+        return WaitForSingleObject(static_cast<HANDLE>(m_semaphore), milliseconds) == WAIT_OBJECT_0;
+        
+        #else
+        
+        sem_t* semaphore = static_cast<sem_t*>(m_semaphore);
+        
+        if(timeout.count() < 0)
+        {
+            while(sem_wait(semaphore) != 0) {}
+            return true;
+        }
+        
+        const int64_t nanoseconds_per_second = 1000000000;
+        
+        timespec time;
+        clock_gettime(CLOCK_REALTIME, &time);
+        
+        const int64_t nanoseconds = time.tv_nsec + timeout.count();
+        time.tv_sec += static_cast<time_t>(nanoseconds / nanoseconds_per_second);
+        time.tv_nsec = static_cast<long>(nanoseconds % nanoseconds_per_second);
+        
+        int result = 0;
+        
+        while((result = sem_timedwait(semaphore, &time)) != 0 && errno == EINTR) {}
+        
+        return result == 0;
+        
+        #endif
+    }
+    
+    void Semaphore::postSystem() noexcept
+    {
+        #if defined(__APPLE__)
+        dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(m_semaphore));
+        #elif defined(_WIN32)
+        ReleaseSemaphore(static_cast<HANDLE>(m_semaphore), 1, nullptr);
+        #else
+        sem_post(static_cast<sem_t*>(m_semaphore));
+        #endif
+    }
+}}
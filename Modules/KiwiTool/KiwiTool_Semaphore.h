@@ -0,0 +1,86 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+namespace kiwi { namespace tool {
+    
+    // ==================================================================================== //
+    //                                      SEMAPHORE                                       //
+    // ==================================================================================== //
+    
+    //! @brief A counting semaphore whose post never locks.
+    //! @details The count is an atomic integer, negative when threads wait, so that the
+    //! system semaphore is only used to put waiting threads to sleep and to wake them up.
+    //! Posting is lock-free and only calls the system when a thread sleeps, so it can be done
+    //! from a real-time thread. The count never exceeds a maximum, a semaphore whose maximum
+    //! is one can wake up a thread without accumulating posts.
+    class Semaphore final
+    {
+    public: // methods
+        
+        //! @brief Constructor.
+        //! @param max_count The maximum count, posts beyond it are ignored.
+        Semaphore(int max_count = (std::numeric_limits<int>::max)());
+        
+        //! @brief Destructor.
+        //! @details Shall not be called while a thread waits.
+        ~Semaphore();
+        
+        //! @brief Increments the count, wakes up a waiting thread if there is one.
+        void post() noexcept;
+        
+        //! @brief Decrements the count, waits until it's positive.
+        void wait() noexcept;
+        
+        //! @brief Decrements the count, waits until it's positive or until a timeout.
+        //! @return false if the timeout expired, the count is then unchanged.
+        bool waitFor(std::chrono::nanoseconds timeout) noexcept;
+        
+    private: // methods
+        
+        //! @internal Decrements the count if it's positive.
+        bool tryWait() noexcept;
+        
+        //! @internal Waits for the system semaphore, forever if the timeout is negative.
+        bool waitSystem(std::chrono::nanoseconds timeout) noexcept;
+        
+        //! @internal Wakes up a thread waiting for the system semaphore.
+        void postSystem() noexcept;
+        
+    private: // members
+        
+        std::atomic<int>    m_count;
+        const int           m_max_count;
+        void*               m_semaphore;
+        
+    private: // deleted methods
+        
+        Semaphore(Semaphore const& other) = delete;
+        Semaphore(Semaphore && other) = delete;
+        Semaphore& operator=(Semaphore const& other) = delete;
+        Semaphore& operator=(Semaphore && other) = delete;
+    };
+}}
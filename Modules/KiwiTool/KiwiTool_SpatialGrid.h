@@ -0,0 +1,403 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                   SPATIAL GRID                                   //
+    // ================================================================================ //
+    
+    //! @brief A spatial index of the bounds of items stacked on top of each other.
+    //! @details The plane is divided into square cells, each item is referenced by the cells
+    //! that its bounds overlap so that finding the items under a point only reads one cell and
+    //! finding the items in an area only reads the cells of this area.
+    //! Items found are returned from the bottom to the top of the stack.
+    //! The bounds are only used to select the candidates of a hit test, they are inclusive.
+    template<class Item>
+    class SpatialGrid final
+    {
+    public: // classes
+        
+        //! @brief The bounds of an item.
+        struct Bounds
+        {
+            int x;
+            int y;
+            int width;
+            int height;
+        };
+        
+    public: // methods
+        
+        //! @brief Constructor.
+        //! @param cell_size The size of the cells, shall be close to the size of the items.
+        SpatialGrid(int cell_size = 64) :
+        m_cell_size(std::max(cell_size, 1))
+        {
+        }
+        
+        //! @brief Destructor.
+        ~SpatialGrid() = default;
+        
+        //! @brief Adds an item on top of the others.
+        void insert(Item const& item, Bounds const& bounds)
+        {
+            const uint64_t order = m_order.empty() ? order_step : m_order.rbegin()->first + order_step;
+            
+            insert(item, bounds, order);
+        }
+        
+        //! @brief Adds an item just below another one.
+        //! @details If the upper item is not in the grid, the item is added on top.
+        void insertBelow(Item const& item, Bounds const& bounds, Item const& upper)
+        {
+            const auto upper_it = m_items.find(upper);
+            
+            if(upper_it == m_items.end() || upper_it->first == item)
+            {
+                insert(item, bounds);
+                return;
+            }
+            
+            uint64_t upper_order = upper_it->second.order;
+            auto it = m_order.find(upper_order);
+            uint64_t lower_order = (it == m_order.begin()) ? 0 : std::prev(it)->first;
+            
+            if(upper_order - lower_order < 2)
+            {
+                renumber();
+                upper_order = upper_it->second.order;
+                it = m_order.find(upper_order);
+                lower_order = (it == m_order.begin()) ? 0 : std::prev(it)->first;
+            }
+            
+            insert(item, bounds, lower_order + (upper_order - lower_order) / 2);
+        }
+        
+        //! @brief Changes the bounds of an item.
+        //! @details Does nothing if the item is not in the grid.
+        void setBounds(Item const& item, Bounds const& bounds)
+        {
+            const auto it = m_items.find(item);
+            
+            if(it != m_items.end())
+            {
+                Entry& entry = it->second;
+                
+                const Cells cells = getCells(bounds);
+                
+                if(cells != entry.cells)
+                {
+                    removeFromCells(entry);
+                    entry.cells = cells;
+                    addToCells(entry);
+                }
+                
+                entry.bounds = bounds;
+            }
+        }
+        
+        //! @brief Removes an item.
+        void remove(Item const& item)
+        {
+            const auto it = m_items.find(item);
+            
+            if(it != m_items.end())
+            {
+                removeFromCells(it->second);
+                m_order.erase(it->second.order);
+                m_items.erase(it);
+            }
+        }
+        
+        //! @brief Removes all the items.
+        void clear()
+        {
+            m_cells.clear();
+            m_order.clear();
+            m_items.clear();
+        }
+        
+        //! @brief Returns the number of items.
+        size_t size() const noexcept
+        {
+            return m_items.size();
+        }
+        
+        //! @brief Returns true if the item is in the grid.
+        bool contains(Item const& item) const
+        {
+            return m_items.count(item) != 0;
+        }
+        
+        //! @brief Finds the items whose bounds contain a point.
+        //! @param items Filled with the items found, from the bottom to the top.
+        void find(int x, int y, std::vector<Item>& items) const
+        {
+            items.clear();
+            m_found.clear();
+            
+            const auto cell = m_cells.find(getKey(getCell(x), getCell(y)));
+            
+            if(cell != m_cells.end())
+            {
+                for(Entry const* entry : cell->second)
+                {
+                    Bounds const& bounds = entry->bounds;
+                    
+                    if(x >= bounds.x && x <= bounds.x + bounds.width
+                       && y >= bounds.y && y <= bounds.y + bounds.height)
+                    {
+                        m_found.push_back(entry);
+                    }
+                }
+            }
+            
+            sortFound(items);
+        }
+        
+        //! @brief Finds the items whose bounds overlap an area.
+        //! @param items Filled with the items found, from the bottom to the top.
+        void find(Bounds const& area, std::vector<Item>& items) const
+        {
+            items.clear();
+            m_found.clear();
+            
+            const Cells cells = getCells(area);
+            
+            const uint64_t nb_cells = (static_cast<uint64_t>(cells.right - cells.left) + 1)
+                                    * (static_cast<uint64_t>(cells.bottom - cells.top) + 1);
+            
+            ++m_stamp;
+            
+            if(nb_cells <= m_cells.size())
+            {
+                for(int cx = cells.left; cx <= cells.right; ++cx)
+                {
+                    for(int cy = cells.top; cy <= cells.bottom; ++cy)
+                    {
+                        const auto cell = m_cells.find(getKey(cx, cy));
+                        
+                        if(cell != m_cells.end())
+                        {
+                            collect(cell->second, area);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                // the area is larger than the occupied cells.
+                for(auto const& cell : m_cells)
+                {
+                    const int cx = static_cast<int32_t>(cell.first >> 32);
+                    const int cy = static_cast<int32_t>(cell.first & 0xffffffff);
+                    
+                    if(cx >= cells.left && cx <= cells.right && cy >= cells.top && cy <= cells.bottom)
+                    {
+                        collect(cell.second, area);
+                    }
+                }
+            }
+            
+            sortFound(items);
+        }
+        
+    private: // classes
+        
+        //! @internal The range of cells overlapped by bounds.
+        struct Cells
+        {
+            bool operator!=(Cells const& other) const
+            {
+                return left != other.left || top != other.top
+                || right != other.right || bottom != other.bottom;
+            }
+            
+            int left;
+            int top;
+            int right;
+            int bottom;
+        };
+        
+        //! @internal An item of the grid.
+        struct Entry
+        {
+            Item                item;
+            Bounds              bounds;
+            Cells               cells;
+            uint64_t            order;
+            mutable uint64_t    stamp;
+        };
+        
+    private: // methods
+        
+        void insert(Item const& item, Bounds const& bounds, uint64_t order)
+        {
+            remove(item);
+            
+            Entry& entry = m_items[item];
+            entry.item = item;
+            entry.bounds = bounds;
+            entry.cells = getCells(bounds);
+            entry.order = order;
+            entry.stamp = 0;
+            
+            m_order[order] = &entry;
+            addToCells(entry);
+        }
+        
+        //! @internal Spreads the orders of the items to make room for insertions.
+        void renumber()
+        {
+            std::map<uint64_t, Entry*> order;
+            
+            uint64_t next = 0;
+            
+            for(auto const& it : m_order)
+            {
+                next += order_step;
+                it.second->order = next;
+                order.emplace_hint(order.end(), next, it.second);
+            }
+            
+            std::swap(order, m_order);
+        }
+        
+        int getCell(int coord) const noexcept
+        {
+            return (coord >= 0) ? (coord / m_cell_size) : -((-coord - 1) / m_cell_size) - 1;
+        }
+        
+        Cells getCells(Bounds const& bounds) const noexcept
+        {
+            return Cells {
+                getCell(bounds.x), getCell(bounds.y),
+                getCell(bounds.x + std::max(bounds.width, 0)),
+                getCell(bounds.y + std::max(bounds.height, 0))
+            };
+        }
+        
+        static uint64_t getKey(int cx, int cy) noexcept
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+        }
+        
+        void addToCells(Entry& entry)
+        {
+            for(int cx = entry.cells.left; cx <= entry.cells.right; ++cx)
+            {
+                for(int cy = entry.cells.top; cy <= entry.cells.bottom; ++cy)
+                {
+                    m_cells[getKey(cx, cy)].push_back(&entry);
+                }
+            }
+        }
+        
+        void removeFromCells(Entry& entry)
+        {
+            for(int cx = entry.cells.left; cx <= entry.cells.right; ++cx)
+            {
+                for(int cy = entry.cells.top; cy <= entry.cells.bottom; ++cy)
+                {
+                    const auto cell = m_cells.find(getKey(cx, cy));
+                    
+                    assert(cell != m_cells.end());
+                    
+                    auto& entries = cell->second;
+                    const auto it = std::find(entries.begin(), entries.end(), &entry);
+                    
+                    assert(it != entries.end());
+                    
+                    *it = entries.back();
+                    entries.pop_back();
+                    
+                    if(entries.empty())
+                    {
+                        m_cells.erase(cell);
+                    }
+                }
+            }
+        }
+        
+        //! @internal Collects the entries of a cell that overlap an area, once.
+        void collect(std::vector<Entry*> const& entries, Bounds const& area) const
+        {
+            for(Entry const* entry : entries)
+            {
+                Bounds const& bounds = entry->bounds;
+                
+                if(entry->stamp != m_stamp
+                   && bounds.x <= area.x + area.width && area.x <= bounds.x + bounds.width
+                   && bounds.y <= area.y + area.height && area.y <= bounds.y + bounds.height)
+                {
+                    entry->stamp = m_stamp;
+                    m_found.push_back(entry);
+                }
+            }
+        }
+        
+        void sortFound(std::vector<Item>& items) const
+        {
+            std::sort(m_found.begin(), m_found.end(), [](Entry const* lhs, Entry const* rhs)
+            {
+                return lhs->order < rhs->order;
+            });
+            
+            for(Entry const* entry : m_found)
+            {
+                items.push_back(entry->item);
+            }
+        }
+        
+    private: // members
+        
+        static constexpr uint64_t order_step = 1ull << 20;
+        
+        const int                                           m_cell_size;
+        std::unordered_map<Item, Entry>                     m_items;
+        std::unordered_map<uint64_t, std::vector<Entry*>>   m_cells;
+        std::map<uint64_t, Entry*>                          m_order;
+        mutable std::vector<Entry const*>                   m_found;
+        mutable uint64_t                                    m_stamp = 0;
+        
+    private: // deleted methods
+        
+        SpatialGrid(SpatialGrid const& other) = delete;
+        SpatialGrid(SpatialGrid && other) = delete;
+        SpatialGrid& operator=(SpatialGrid const& other) = delete;
+        SpatialGrid& operator=(SpatialGrid && other) = delete;
+    };
+    
+    template<class Item>
+    constexpr uint64_t SpatialGrid<Item>::order_step;
+}}
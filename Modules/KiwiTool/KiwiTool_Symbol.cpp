@@ -0,0 +1,115 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <mutex>
+#include <unordered_set>
+
+#include <KiwiTool/KiwiTool_Symbol.h>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                   SYMBOL TABLE                                   //
+    // ================================================================================ //
+    
+    //! @brief The table of the interned strings.
+    //! @details The strings are stored in nodes so their addresses never change.
+    class SymbolTable
+    {
+    public: // methods
+        
+        static SymbolTable& use()
+        {
+            static SymbolTable table;
+            return table;
+        }
+        
+        template<class String>
+        std::string const* intern(String&& name)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return &*m_strings.emplace(std::forward<String>(name)).first;
+        }
+        
+    private: // members
+        
+        std::unordered_set<std::string> m_strings;
+        std::mutex                      m_mutex;
+    };
+    
+    // ================================================================================ //
+    //                                      SYMBOL                                      //
+    // ================================================================================ //
+    
+    Symbol::Symbol() :
+    m_name(nullptr)
+    {
+        static std::string const* const empty = SymbolTable::use().intern(std::string());
+        m_name = empty;
+    }
+    
+    Symbol::Symbol(std::string const& name) :
+    m_name(SymbolTable::use().intern(name))
+    {
+    }
+    
+    Symbol::Symbol(std::string&& name) :
+    m_name(SymbolTable::use().intern(std::move(name)))
+    {
+    }
+    
+    Symbol::Symbol(char const* name) :
+    m_name(SymbolTable::use().intern(std::string(name)))
+    {
+    }
+    
+    Symbol const& Symbol::bang()
+    {
+        static const Symbol symbol("bang");
+        return symbol;
+    }
+    
+    Symbol const& Symbol::set()
+    {
+        static const Symbol symbol("set");
+        return symbol;
+    }
+    
+    Symbol const& Symbol::clear()
+    {
+        static const Symbol symbol("clear");
+        return symbol;
+    }
+    
+    Symbol const& Symbol::stop()
+    {
+        static const Symbol symbol("stop");
+        return symbol;
+    }
+    
+    Symbol const& Symbol::print()
+    {
+        static const Symbol symbol("print");
+        return symbol;
+    }
+    
+}}
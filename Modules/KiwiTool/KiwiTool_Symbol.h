@@ -0,0 +1,129 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace kiwi { namespace tool {
+    
+    // ================================================================================ //
+    //                                      SYMBOL                                      //
+    // ================================================================================ //
+    
+    //! @brief An interned string.
+    //! @details Symbols with the same name share the same string stored in a global table,
+    //! so a Symbol is a pointer that is copied and compared in constant time. The strings of
+    //! the table are never released. Creating a Symbol from a string locks and looks up the
+    //! table, the pre-interned symbols returned by the static methods are only looked up once.
+    class Symbol
+    {
+    public: // methods
+        
+        //! @brief Constructs the empty symbol.
+        Symbol();
+        
+        //! @brief Constructs the symbol of a name.
+        explicit Symbol(std::string const& name);
+        
+        //! @brief Constructs the symbol of a name.
+        explicit Symbol(std::string&& name);
+        
+        //! @brief Constructs the symbol of a name.
+        explicit Symbol(char const* name);
+        
+        //! @brief Copy constructor.
+        Symbol(Symbol const& other) noexcept = default;
+        
+        //! @brief Copy assignment operator.
+        Symbol& operator=(Symbol const& other) noexcept = default;
+        
+        //! @brief Destructor.
+        ~Symbol() = default;
+        
+        //! @brief Returns the name of the symbol.
+        //! @details The reference remains valid until the end of the program.
+        std::string const& getName() const noexcept
+        {
+            return *m_name;
+        }
+        
+        //! @brief Returns true if the symbols have the same name.
+        bool operator==(Symbol const& other) const noexcept
+        {
+            return m_name == other.m_name;
+        }
+        
+        //! @brief Returns true if the symbols have different names.
+        bool operator!=(Symbol const& other) const noexcept
+        {
+            return m_name != other.m_name;
+        }
+        
+        // ================================================================================ //
+        //                                PRE-INTERNED SYMBOLS                              //
+        // ================================================================================ //
+        
+        //! @brief Returns the "bang" symbol.
+        static Symbol const& bang();
+        
+        //! @brief Returns the "set" symbol.
+        static Symbol const& set();
+        
+        //! @brief Returns the "clear" symbol.
+        static Symbol const& clear();
+        
+        //! @brief Returns the "stop" symbol.
+        static Symbol const& stop();
+        
+        //! @brief Returns the "print" symbol.
+        static Symbol const& print();
+        
+    private: // methods
+        
+        //! @internal Constructs a symbol from a string of the table.
+        struct Interned {};
+        Symbol(std::string const* name, Interned) noexcept : m_name(name) {}
+        
+    private: // members
+        
+        std::string const* m_name;
+        
+        friend class Atom;
+        friend struct std::hash<Symbol>;
+    };
+    
+}}
+
+namespace std
+{
+    //! @brief Hashes a Symbol in constant time.
+    template<>
+    struct hash<kiwi::tool::Symbol>
+    {
+        size_t operator()(kiwi::tool::Symbol const& symbol) const noexcept
+        {
+            return std::hash<std::string const*>()(symbol.m_name);
+        }
+    };
+}
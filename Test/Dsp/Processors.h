@@ -60,7 +60,10 @@ private:
 class PlusScalar : public Processor
 {
 public:
-    PlusScalar(sample_t value) noexcept : Processor(1ul, 1ul), m_value(value) {}
+    PlusScalar(sample_t value, bool inplace = false) noexcept : Processor(1ul, 1ul), m_value(value)
+    {
+        setInplace(inplace);
+    }
     ~PlusScalar() = default;
 private:
     
@@ -102,6 +105,64 @@ private:
     }
 };
 
+// ==================================================================================== //
+//                                     PREPARE COUNTER                                  //
+// ==================================================================================== //
+
+class PrepareCounter : public Processor
+{
+public:
+    PrepareCounter(size_t& prepare_count) noexcept : Processor(1ul, 1ul), m_prepare_count(prepare_count) {}
+    ~PrepareCounter() = default;
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        ++m_prepare_count;
+        setPerformCallBack(this, &PrepareCounter::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer& output) noexcept
+    {
+        output[0ul].copy(input[0ul]);
+    }
+    
+    size_t& m_prepare_count;
+};
+
+// ==================================================================================== //
+//                                       ACCUMULATE                                     //
+// ==================================================================================== //
+
+class Accumulate : public Processor
+{
+public:
+    Accumulate(sample_t& sum, std::vector<size_t>& order, size_t id) noexcept :
+    Processor(1ul, 0ul), m_sum(sum), m_order(order), m_id(id)
+    {
+        setSequential(true);
+    }
+    
+    ~Accumulate() = default;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        setPerformCallBack(this, &Accumulate::perform);
+    }
+    
+    void perform(Buffer const& input, Buffer&) noexcept
+    {
+        m_sum += input[0ul][0ul];
+        m_order.push_back(m_id);
+    }
+    
+    sample_t&               m_sum;
+    std::vector<size_t>&    m_order;
+    const size_t            m_id;
+};
+
 // ==================================================================================== //
 //                                       COPY THROW                                     //
 // ==================================================================================== //
@@ -20,6 +20,7 @@
  */
 
 #include <memory>
+#include <thread>
 
 #include "../catch.hpp"
 
@@ -479,3 +480,442 @@ TEST_CASE("Dsp - Chain", "[Dsp, Chain]")
         chain.release();
     }
 }
+
+TEST_CASE("Dsp - Chain incremental update", "[Dsp, Chain]")
+{
+    const size_t samplerate = 44100ul;
+    
+    SECTION("Updating after first prepare")
+    {
+        Chain chain;
+        chain.setUpdateMode(Chain::UpdateMode::Incremental);
+        
+        std::shared_ptr<Processor> sig_1(new Sig(1.));
+        std::shared_ptr<Processor> sig_2(new Sig(2.));
+        std::shared_ptr<Processor> plus_signal(new PlusSignal());
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig_1);
+        chain.addProcessor(plus_signal);
+        chain.addProcessor(print);
+        
+        chain.connect(*sig_1, 0, *plus_signal, 0);
+        chain.connect(*plus_signal, 0, *print, 0);
+        
+        chain.prepare(samplerate, 4ul);
+        
+        chain.tick();
+        
+        CHECK(result == "[1.000000, 1.000000, 1.000000, 1.000000]");
+        
+        chain.addProcessor(sig_2);
+        chain.connect(*sig_2, 0, *plus_signal, 1);
+        chain.update();
+        chain.tick();
+        
+        CHECK(result == "[3.000000, 3.000000, 3.000000, 3.000000]");
+        
+        chain.disconnect(*sig_1, 0, *plus_signal, 0);
+        chain.update();
+        chain.tick();
+        
+        CHECK(result == "[2.000000, 2.000000, 2.000000, 2.000000]");
+        
+        chain.removeProcessor(*plus_signal);
+        chain.update();
+        chain.tick();
+        
+        CHECK(result == "[0.000000, 0.000000, 0.000000, 0.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Untouched processors are not prepared again")
+    {
+        Chain chain;
+        chain.setUpdateMode(Chain::UpdateMode::Incremental);
+        
+        size_t prepare_count = 0;
+        
+        std::shared_ptr<Processor> sig_1(new Sig(1.));
+        std::shared_ptr<Processor> counter(new PrepareCounter(prepare_count));
+        std::shared_ptr<Processor> sig_2(new Sig(2.));
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig_1);
+        chain.addProcessor(counter);
+        chain.addProcessor(print);
+        
+        chain.connect(*sig_1, 0, *counter, 0);
+        chain.connect(*counter, 0, *print, 0);
+        
+        chain.prepare(samplerate, 4ul);
+        chain.tick();
+        
+        CHECK(result == "[1.000000, 1.000000, 1.000000, 1.000000]");
+        CHECK(prepare_count == 1);
+        
+        chain.addProcessor(sig_2);
+        chain.connect(*sig_2, 0, *print, 0);
+        chain.update();
+        chain.tick();
+        
+        CHECK(result == "[3.000000, 3.000000, 3.000000, 3.000000]");
+        CHECK(prepare_count == 1);
+        
+        chain.removeProcessor(*sig_2);
+        chain.update();
+        chain.tick();
+        
+        CHECK(result == "[1.000000, 1.000000, 1.000000, 1.000000]");
+        CHECK(prepare_count == 1);
+        
+        // full update prepares every processors again.
+        
+        chain.setUpdateMode(Chain::UpdateMode::Full);
+        chain.addProcessor(sig_2);
+        chain.update();
+        chain.tick();
+        
+        CHECK(result == "[1.000000, 1.000000, 1.000000, 1.000000]");
+        CHECK(prepare_count == 2);
+        
+        chain.release();
+    }
+    
+    SECTION("Connection breaking the current order")
+    {
+        Chain chain;
+        chain.setUpdateMode(Chain::UpdateMode::Incremental);
+        
+        std::shared_ptr<Processor> sig_1(new Sig(1.));
+        std::shared_ptr<Processor> plus_1(new PlusScalar(1.));
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig_1);
+        chain.addProcessor(plus_1);
+        chain.addProcessor(print);
+        
+        chain.connect(*sig_1, 0, *plus_1, 0);
+        chain.connect(*plus_1, 0, *print, 0);
+        
+        chain.prepare(samplerate, 4ul);
+        chain.tick();
+        
+        CHECK(result == "[2.000000, 2.000000, 2.000000, 2.000000]");
+        
+        std::shared_ptr<Processor> sig_2(new Sig(2.));
+        std::shared_ptr<Processor> plus_2(new PlusScalar(10.));
+        
+        chain.addProcessor(plus_2);
+        chain.addProcessor(sig_2);
+        chain.connect(*plus_2, 0, *plus_1, 0);
+        chain.connect(*sig_2, 0, *plus_2, 0);
+        chain.update();
+        chain.tick();
+        
+        CHECK(result == "[14.000000, 14.000000, 14.000000, 14.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Loop Detected")
+    {
+        Chain chain;
+        chain.setUpdateMode(Chain::UpdateMode::Incremental);
+        
+        std::shared_ptr<Processor> sig_1(new Sig(1.));
+        std::shared_ptr<Processor> plus_scalar(new PlusScalar(1.));
+        std::shared_ptr<Processor> plus_signal(new PlusSignal());
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig_1);
+        chain.addProcessor(plus_scalar);
+        chain.addProcessor(plus_signal);
+        chain.addProcessor(print);
+        
+        chain.connect(*sig_1, 0, *plus_scalar, 0);
+        chain.connect(*plus_scalar, 0, *plus_signal, 0);
+        chain.connect(*plus_signal, 0, *print, 0);
+        
+        chain.prepare(samplerate, 4ul);
+        chain.tick();
+        
+        CHECK(result == "[2.000000, 2.000000, 2.000000, 2.000000]");
+        
+        chain.connect(*plus_signal, 0, *plus_scalar, 0);
+        
+        REQUIRE_THROWS_AS(chain.update(), LoopError);
+        
+        result.clear();
+        chain.tick();
+        
+        CHECK(result.empty());
+        
+        chain.disconnect(*plus_signal, 0, *plus_scalar, 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        chain.tick();
+        
+        CHECK(result == "[2.000000, 2.000000, 2.000000, 2.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Chain processor without perform")
+    {
+        Chain chain;
+        chain.setUpdateMode(Chain::UpdateMode::Incremental);
+        
+        std::shared_ptr<Processor> sig1(new Sig(1));
+        std::shared_ptr<Processor> sig2(new Sig(2));
+        std::shared_ptr<Processor> plus_remove(new PlusScalarRemover());
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig1);
+        chain.addProcessor(sig2);
+        chain.addProcessor(plus_remove);
+        chain.addProcessor(print);
+        
+        chain.connect(*sig1, 0, *plus_remove, 0);
+        chain.connect(*sig2, 0, *plus_remove, 1);
+        chain.connect(*plus_remove, 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        chain.tick();
+        
+        CHECK(result == "[3.000000, 3.000000, 3.000000, 3.000000]");
+        
+        chain.disconnect(*sig1, 0, *plus_remove, 0);
+        chain.update();
+        chain.tick();
+        
+        CHECK(result == "[0.000000, 0.000000, 0.000000, 0.000000]");
+        
+        chain.connect(*sig1, 0, *plus_remove, 0);
+        chain.update();
+        chain.tick();
+        
+        CHECK(result == "[3.000000, 3.000000, 3.000000, 3.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Updating while ticking")
+    {
+        Chain chain;
+        chain.setUpdateMode(Chain::UpdateMode::Incremental);
+        
+        std::shared_ptr<Processor> count(new Count());
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::shared_ptr<Processor> plus(new PlusSignal());
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(count);
+        chain.addProcessor(plus);
+        chain.addProcessor(print);
+        
+        chain.connect(*count, 0, *plus, 0);
+        chain.connect(*plus, 0, *print, 0);
+        
+        chain.prepare(samplerate, 4ul);
+        
+        std::atomic<bool> running(true);
+        std::atomic<size_t> ticks(0);
+        
+        std::thread audio_thread([&chain, &running, &ticks]()
+        {
+            while(running.load())
+            {
+                chain.tick();
+                ++ticks;
+            }
+        });
+        
+        while(ticks.load() == 0)
+        {
+            std::this_thread::yield();
+        }
+        
+        for(int i = 0; i < 100; ++i)
+        {
+            chain.addProcessor(sig);
+            chain.connect(*sig, 0, *plus, 1);
+            chain.update();
+            
+            chain.removeProcessor(*sig);
+            chain.update();
+        }
+        
+        running.store(false);
+        audio_thread.join();
+        
+        CHECK(ticks.load() > 0);
+        
+        chain.tick();
+        
+        CHECK(result.size() > 0);
+        
+        chain.release();
+    }
+}
+
+TEST_CASE("Dsp - Chain signals reuse", "[Dsp, Chain]")
+{
+    const size_t samplerate = 44100ul;
+    
+    SECTION("Serial processors reuse two signals")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        std::vector<std::shared_ptr<Processor>> plus;
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(print);
+        
+        for(size_t i = 0; i < 8; ++i)
+        {
+            plus.emplace_back(new PlusScalar(1.));
+            chain.addProcessor(plus.back());
+            chain.connect(i == 0 ? *sig : *plus[i - 1], 0, *plus.back(), 0);
+        }
+        
+        chain.connect(*plus.back(), 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        CHECK(chain.getNumberOfSignals() == 2);
+        
+        chain.tick();
+        
+        CHECK(result == "[9.000000, 9.000000, 9.000000, 9.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Inplace processors share their input signal")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        std::vector<std::shared_ptr<Processor>> plus;
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(print);
+        
+        for(size_t i = 0; i < 8; ++i)
+        {
+            plus.emplace_back(new PlusScalar(1., true));
+            chain.addProcessor(plus.back());
+            chain.connect(i == 0 ? *sig : *plus[i - 1], 0, *plus.back(), 0);
+        }
+        
+        chain.connect(*plus.back(), 0, *print, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        CHECK(chain.getNumberOfSignals() == 1);
+        
+        chain.tick();
+        
+        CHECK(result == "[9.000000, 9.000000, 9.000000, 9.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Fanning outlet keeps its signal until its last child")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::shared_ptr<Processor> plus_1(new PlusScalar(1., true));
+        std::shared_ptr<Processor> plus_2(new PlusScalar(2.));
+        std::string result_1;
+        std::shared_ptr<Processor> print_1(new Print(result_1));
+        std::string result_2;
+        std::shared_ptr<Processor> print_2(new Print(result_2));
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(plus_1);
+        chain.addProcessor(plus_2);
+        chain.addProcessor(print_1);
+        chain.addProcessor(print_2);
+        
+        chain.connect(*sig, 0, *plus_1, 0);
+        chain.connect(*sig, 0, *print_1, 0);
+        chain.connect(*plus_1, 0, *plus_2, 0);
+        chain.connect(*plus_2, 0, *print_2, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        CHECK(chain.getNumberOfSignals() == 3);
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[1.000000, 1.000000, 1.000000, 1.000000]");
+        CHECK(result_2 == "[4.000000, 4.000000, 4.000000, 4.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Incremental update stops sharing overlapping signals")
+    {
+        Chain chain;
+        chain.setUpdateMode(Chain::UpdateMode::Incremental);
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::string result_1;
+        std::shared_ptr<Processor> print_1(new Print(result_1));
+        std::vector<std::shared_ptr<Processor>> plus;
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(print_1);
+        
+        for(size_t i = 0; i < 3; ++i)
+        {
+            plus.emplace_back(new PlusScalar(1.));
+            chain.addProcessor(plus.back());
+            chain.connect(i == 0 ? *sig : *plus[i - 1], 0, *plus.back(), 0);
+        }
+        
+        chain.connect(*plus.back(), 0, *print_1, 0);
+        
+        REQUIRE_NOTHROW(chain.prepare(samplerate, 4ul));
+        
+        CHECK(chain.getNumberOfSignals() == 2);
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[4.000000, 4.000000, 4.000000, 4.000000]");
+        
+        std::string result_2;
+        std::shared_ptr<Processor> print_2(new Print(result_2));
+        
+        chain.addProcessor(print_2);
+        chain.connect(*plus[0], 0, *print_2, 0);
+        
+        REQUIRE_NOTHROW(chain.update());
+        
+        CHECK(chain.getNumberOfSignals() == 3);
+        
+        chain.tick();
+        
+        CHECK(result_1 == "[4.000000, 4.000000, 4.000000, 4.000000]");
+        CHECK(result_2 == "[2.000000, 2.000000, 2.000000, 2.000000]");
+        
+        chain.release();
+    }
+}
@@ -0,0 +1,216 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_DelayLine.h>
+
+using namespace kiwi;
+using namespace dsp;
+
+// ================================================================================ //
+//                                     DELAY LINE                                   //
+// ================================================================================ //
+
+TEST_CASE("Dsp - DelayLine", "[Dsp, DelayLine]")
+{
+    SECTION("The size is rounded up to a power of two")
+    {
+        CHECK(DelayLine(1).size() == 1);
+        CHECK(DelayLine(64).size() == 64);
+        CHECK(DelayLine(65).size() == 128);
+        CHECK(DelayLine(44101).size() == 65536);
+    }
+    
+    SECTION("Integer delays read the written samples")
+    {
+        DelayLine line(16);
+        
+        std::vector<sample_t> ramp(10);
+        
+        for(size_t i = 0; i < ramp.size(); ++i)
+        {
+            ramp[i] = static_cast<sample_t>(i + 1);
+        }
+        
+        line.write(ramp.data(), ramp.size());
+        
+        for(size_t delay = 1; delay <= 10; ++delay)
+        {
+            CHECK(line.read(static_cast<sample_t>(delay)) == static_cast<sample_t>(11 - delay));
+        }
+        
+        // samples that haven't been written are zeros.
+        CHECK(line.read(12.) == 0.);
+    }
+    
+    SECTION("Writes and reads wrap around the buffer")
+    {
+        DelayLine line(16);
+        
+        std::vector<sample_t> block(5);
+        sample_t value = 0.;
+        
+        for(size_t i = 0; i < 11; ++i)
+        {
+            for(sample_t& sample : block)
+            {
+                sample = ++value;
+            }
+            
+            line.write(block.data(), block.size());
+            
+            for(size_t delay = 1; delay < 12 && delay <= value; ++delay)
+            {
+                CHECK(line.read(static_cast<sample_t>(delay)) == value + 1 - delay);
+            }
+        }
+        
+        // a block larger than the buffer keeps its last samples.
+        std::vector<sample_t> large(37);
+        
+        for(size_t i = 0; i < large.size(); ++i)
+        {
+            large[i] = static_cast<sample_t>(i);
+        }
+        
+        line.write(large.data(), large.size());
+        
+        CHECK(line.read(1.) == 36.);
+        CHECK(line.read(13.) == 24.);
+    }
+    
+    SECTION("Fractional delays are interpolated")
+    {
+        DelayLine line(64);
+        
+        std::vector<sample_t> ramp(40);
+        
+        for(size_t i = 0; i < ramp.size(); ++i)
+        {
+            ramp[i] = static_cast<sample_t>(i);
+        }
+        
+        line.write(ramp.data(), ramp.size());
+        
+        // the cubic interpolation is exact on a ramp.
+        for(sample_t delay = 2.; delay < 30.; delay += 0.25)
+        {
+            CHECK(std::abs(line.read(delay) - (40. - delay)) < 1e-4);
+        }
+    }
+    
+    SECTION("Block reads are reads at the delay from each sample")
+    {
+        DelayLine line(128);
+        
+        std::vector<sample_t> input(64);
+        std::vector<sample_t> output(64);
+        
+        for(size_t block = 0; block < 5; ++block)
+        {
+            for(size_t i = 0; i < input.size(); ++i)
+            {
+                input[i] = static_cast<sample_t>(std::sin(0.1 * (block * input.size() + i)));
+            }
+            
+            line.write(input.data(), input.size());
+            
+            for(sample_t delay : {1., 1.5, 17.25, 60.})
+            {
+                line.read(output.data(), output.size(), delay);
+                
+                for(size_t i = 0; i < output.size(); ++i)
+                {
+                    CHECK(output[i] == line.read(delay + static_cast<sample_t>(output.size() - 1 - i)));
+                }
+            }
+        }
+    }
+    
+    SECTION("Clear")
+    {
+        DelayLine line(8);
+        
+        const sample_t samples[] = {1., 2., 3., 4.};
+        line.write(samples, 4);
+        line.clear();
+        
+        for(size_t delay = 1; delay <= 8; ++delay)
+        {
+            CHECK(line.read(static_cast<sample_t>(delay)) == 0.);
+        }
+    }
+}
+
+TEST_CASE("Dsp - DelayLine - Benchmark", "[Dsp, DelayLine]")
+{
+    const double samplerate = 44100.;
+    const size_t vector_size = 64;
+    const size_t number_of_lines = 200;
+    const size_t number_of_blocks = static_cast<size_t>(samplerate) / vector_size;
+    
+    // one second long feedback delays.
+    std::vector<std::unique_ptr<DelayLine>> lines;
+    
+    for(size_t i = 0; i < number_of_lines; ++i)
+    {
+        lines.emplace_back(new DelayLine(static_cast<size_t>(samplerate) + vector_size + 4));
+    }
+    
+    std::vector<sample_t> input(vector_size, 0.5);
+    std::vector<sample_t> output(vector_size, 0.);
+    std::vector<sample_t> reinject(vector_size, 0.);
+    
+    const auto start = std::chrono::steady_clock::now();
+    
+    for(size_t block = 0; block < number_of_blocks; ++block)
+    {
+        for(size_t i = 0; i < number_of_lines; ++i)
+        {
+            for(size_t j = 0; j < vector_size; ++j)
+            {
+                reinject[j] += input[j];
+            }
+            
+            lines[i]->write(reinject.data(), vector_size);
+            lines[i]->read(output.data(), vector_size, static_cast<sample_t>(1000.5 + i));
+            
+            for(size_t j = 0; j < vector_size; ++j)
+            {
+                reinject[j] = sample_t(0.5) * output[j];
+            }
+        }
+    }
+    
+    const double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << "DelayLine - " << number_of_lines << " lines : "
+    << (duration * 100.) << "% of one second of audio" << '\n';
+    
+    CHECK(output[0] == output[0]);
+}
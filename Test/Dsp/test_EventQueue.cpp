@@ -0,0 +1,264 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Chain.h>
+#include <KiwiDsp/KiwiDsp_EventQueue.h>
+
+using namespace kiwi;
+using namespace dsp;
+
+// ================================================================================ //
+//                                       STEP                                       //
+// ================================================================================ //
+
+//! @brief Records a constant signal whose value changes at the offsets of its events.
+class Step : public Processor
+{
+public:
+    
+    Step(SampleClock const& clock, std::vector<sample_t>& output) :
+    Processor(0ul, 0ul), m_events(16), m_clock(clock), m_output(output), m_value(0.) {}
+    
+    ~Step() = default;
+    
+    EventQueue<sample_t> m_events;
+    
+private:
+    
+    void prepare(PrepareInfo const& infos) override final
+    {
+        m_size = infos.vector_size;
+        setPerformCallBack(this, &Step::perform);
+    }
+    
+    void perform(Buffer const&, Buffer&) noexcept
+    {
+        const uint64_t block_position = m_clock.getBlockPosition();
+        
+        m_output.assign(m_size, m_value);
+        
+        size_t offset = 0;
+        sample_t value = 0.;
+        
+        while(m_events.pop(block_position, m_size, offset, value))
+        {
+            m_value = value;
+            std::fill(m_output.begin() + offset, m_output.end(), m_value);
+        }
+    }
+    
+    SampleClock const&      m_clock;
+    std::vector<sample_t>&  m_output;
+    sample_t                m_value;
+    size_t                  m_size = 0;
+};
+
+// ================================================================================ //
+//                                    EVENT QUEUE                                   //
+// ================================================================================ //
+
+TEST_CASE("Dsp - EventQueue", "[Dsp, EventQueue]")
+{
+    SECTION("Events are popped with their offset in the block")
+    {
+        EventQueue<int> queue(8);
+        
+        CHECK(queue.push(70, 1));
+        CHECK(queue.push(100, 2));
+        CHECK(queue.push(130, 3));
+        
+        size_t offset = 0;
+        int value = 0;
+        
+        CHECK_FALSE(queue.pop(0, 64, offset, value));
+        
+        REQUIRE(queue.pop(64, 64, offset, value));
+        CHECK(offset == 6);
+        CHECK(value == 1);
+        
+        REQUIRE(queue.pop(64, 64, offset, value));
+        CHECK(offset == 36);
+        CHECK(value == 2);
+        
+        CHECK_FALSE(queue.pop(64, 64, offset, value));
+        
+        REQUIRE(queue.pop(128, 64, offset, value));
+        CHECK(offset == 2);
+        CHECK(value == 3);
+        
+        CHECK_FALSE(queue.pop(192, 64, offset, value));
+    }
+    
+    SECTION("Late events are applied at the beginning of the block")
+    {
+        EventQueue<int> queue(8);
+        
+        queue.push(10, 1);
+        queue.push(20, 2);
+        
+        size_t offset = 0;
+        int value = 0;
+        
+        REQUIRE(queue.pop(128, 64, offset, value));
+        CHECK(offset == 0);
+        CHECK(value == 1);
+        
+        REQUIRE(queue.pop(128, 64, offset, value));
+        CHECK(offset == 0);
+        CHECK(value == 2);
+    }
+    
+    SECTION("Offsets never decrease")
+    {
+        EventQueue<int> queue(8);
+        
+        queue.push(100, 1);
+        queue.push(90, 2);
+        
+        size_t offset = 0;
+        int value = 0;
+        
+        REQUIRE(queue.pop(64, 64, offset, value));
+        CHECK(offset == 36);
+        
+        REQUIRE(queue.pop(64, 64, offset, value));
+        CHECK(offset == 36);
+        CHECK(value == 2);
+    }
+    
+    SECTION("A full queue discards its oldest events")
+    {
+        EventQueue<int> queue(3);
+        
+        for(int i = 0; i < 4; ++i)
+        {
+            CHECK(queue.push(0, i));
+        }
+        
+        CHECK_FALSE(queue.push(0, 4));
+        CHECK_FALSE(queue.push(0, 5));
+        
+        size_t offset = 0;
+        int value = 0;
+        
+        for(int i = 2; i < 6; ++i)
+        {
+            CHECK(queue.pop(0, 64, offset, value));
+            CHECK(value == i);
+        }
+        
+        CHECK_FALSE(queue.pop(0, 64, offset, value));
+        CHECK(queue.push(0, 6));
+    }
+    
+    SECTION("Processors split their blocks at the events")
+    {
+        Chain chain;
+        
+        std::vector<sample_t> output;
+        std::shared_ptr<Step> step(new Step(chain.getSampleClock(), output));
+        
+        chain.addProcessor(step);
+        chain.prepare(44100, 64);
+        
+        chain.tick();
+        
+        CHECK(output == std::vector<sample_t>(64, 0.));
+        
+        const uint64_t next_block = chain.getSampleClock().getBlockPosition() + 64;
+        
+        step->m_events.push(next_block + 10, 1.);
+        step->m_events.push(next_block + 40, 2.);
+        step->m_events.push(next_block + 64 + 5, 3.);
+        
+        chain.tick();
+        
+        std::vector<sample_t> expected(64, 0.);
+        std::fill(expected.begin() + 10, expected.end(), 1.);
+        std::fill(expected.begin() + 40, expected.end(), 2.);
+        
+        CHECK(output == expected);
+        
+        chain.tick();
+        
+        expected.assign(64, 2.);
+        std::fill(expected.begin() + 5, expected.end(), 3.);
+        
+        CHECK(output == expected);
+        
+        chain.release();
+    }
+    
+    SECTION("Events pushed concurrently keep their order and offsets")
+    {
+        const size_t block_size = 64;
+        const int count = 100000;
+        
+        EventQueue<int> queue(16);
+        
+        std::atomic<uint64_t> block_position(0);
+        
+        std::thread control_thread([&queue, &block_position, block_size, count]()
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                // the events are stamped in the block after the one being performed,
+                // the oldest ones are discarded when the processor is late.
+                
+                const uint64_t position = block_position.load() + block_size + (i % block_size);
+                
+                queue.push(position, i);
+            }
+        });
+        
+        int last = -1;
+        size_t errors = 0;
+        
+        while(last < count - 1)
+        {
+            const uint64_t position = block_position.load();
+            
+            size_t offset = 0;
+            size_t previous_offset = 0;
+            int value = 0;
+            
+            while(queue.pop(position, block_size, offset, value))
+            {
+                errors += (value <= last) || (offset < previous_offset) || (offset >= block_size);
+                previous_offset = offset;
+                last = value;
+            }
+            
+            block_position.store(position + block_size);
+        }
+        
+        control_thread.join();
+        
+        CHECK(errors == 0);
+    }
+}
@@ -0,0 +1,220 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#include <x86intrin.h>
+#define KIWI_TEST_RDTSC 1
+#endif
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Oscillator.h>
+
+using namespace kiwi;
+using namespace dsp;
+
+// ================================================================================ //
+//                                     OSCILLATOR                                   //
+// ================================================================================ //
+
+//! @brief Returns the distance between two phases in [0, 1).
+static double phaseDistance(double lhs, double rhs)
+{
+    const double distance = std::abs(lhs - rhs);
+    return std::min(distance, 1. - distance);
+}
+
+TEST_CASE("Dsp - Oscillator", "[Dsp, Oscillator]")
+{
+    SECTION("Phases with a constant increment are wrapped")
+    {
+        std::vector<sample_t> phases(37);
+        
+        const sample_t next = oscillator::phase(phases.data(), phases.size(), 0.75, 0.125);
+        
+        for(size_t i = 0; i < phases.size(); ++i)
+        {
+            const double expected = std::fmod(0.75 + i * 0.125, 1.);
+            
+            CHECK(phases[i] >= 0.);
+            CHECK(phases[i] < 1.);
+            CHECK(std::abs(phases[i] - (expected)) < 1e-6);
+        }
+        
+        CHECK(std::abs(next - (std::fmod(0.75 + 37 * 0.125, 1.))) < 1e-6);
+    }
+    
+    SECTION("Negative increments and phases")
+    {
+        std::vector<sample_t> phases(19);
+        
+        const sample_t next = oscillator::phase(phases.data(), phases.size(), -2.25, -0.1);
+        
+        for(size_t i = 0; i < phases.size(); ++i)
+        {
+            const double x = -2.25 - i * 0.1;
+            const double expected = x - std::floor(x);
+            
+            CHECK(phases[i] >= 0.);
+            CHECK(phases[i] < 1.);
+            CHECK(phaseDistance(phases[i], expected) < 1e-5);
+        }
+        
+        CHECK(next >= 0.);
+        CHECK(next < 1.);
+    }
+    
+    SECTION("Phases with a frequency signal")
+    {
+        std::vector<sample_t> frequencies(21, 441.);
+        std::vector<sample_t> phases(21);
+        
+        frequencies[10] = -882.;
+        
+        const sample_t next = oscillator::phase(phases.data(), phases.size(), 0.5,
+                                                frequencies.data(), sample_t(1. / 4410.));
+        
+        double expected = 0.5;
+        
+        for(size_t i = 0; i < phases.size(); ++i)
+        {
+            CHECK(phaseDistance(phases[i], expected) < 1e-5);
+            expected += frequencies[i] / 4410.;
+            expected -= std::floor(expected);
+        }
+        
+        CHECK(phaseDistance(next, expected) < 1e-5);
+        
+        // the output can be the frequencies.
+        
+        oscillator::phase(frequencies.data(), frequencies.size(), 0.5, frequencies.data(), sample_t(1. / 4410.));
+        
+        CHECK(frequencies == phases);
+    }
+    
+    SECTION("Fast cosine is close to the exact one")
+    {
+        std::vector<sample_t> phases(10001);
+        std::vector<sample_t> exact(phases.size());
+        std::vector<sample_t> fast(phases.size());
+        
+        for(size_t i = 0; i < phases.size(); ++i)
+        {
+            phases[i] = -5. + i * 0.001;
+        }
+        
+        oscillator::cosine(phases.data(), exact.data(), phases.size());
+        oscillator::fastCosine(phases.data(), fast.data(), phases.size());
+        
+        double max_error = 0.;
+        
+        for(size_t i = 0; i < phases.size(); ++i)
+        {
+            // the reference is computed in double precision.
+            
+            const double reference = std::cos(2. * 3.14159265358979323846 * double(phases[i]));
+            
+            CHECK(std::abs(double(exact[i]) - reference) < 1e-5);
+            max_error = std::max(max_error, std::abs(double(fast[i]) - reference));
+        }
+        
+        CHECK(max_error < 1e-6);
+        
+        // inplace
+        
+        oscillator::fastCosine(phases.data(), phases.data(), phases.size());
+        
+        CHECK(phases == fast);
+    }
+}
+
+// ================================================================================ //
+//                               OSCILLATOR - BENCHMARK                             //
+// ================================================================================ //
+
+//! @brief Returns the number of cycles (or nanoseconds) per sample of a kernel.
+template<class Kernel>
+static double measure(Kernel&& kernel, size_t vector_size, size_t repetitions)
+{
+    #if KIWI_TEST_RDTSC
+    const auto start = __rdtsc();
+    #else
+    const auto start = std::chrono::steady_clock::now();
+    #endif
+    
+    for(size_t i = 0; i < repetitions; ++i)
+    {
+        kernel();
+    }
+    
+    #if KIWI_TEST_RDTSC
+    const double duration = static_cast<double>(__rdtsc() - start);
+    #else
+    const double duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    #endif
+    
+    return duration / (vector_size * repetitions);
+}
+
+TEST_CASE("Dsp - Oscillator - Benchmark", "[Dsp, Oscillator]")
+{
+    const size_t vector_size = 64;
+    const size_t repetitions = 20000;
+    
+    std::vector<sample_t> phases(vector_size);
+    std::vector<sample_t> output(vector_size);
+    sample_t phase = 0.;
+    
+    const double exact = measure([&]()
+    {
+        phase = oscillator::phase(phases.data(), vector_size, phase, sample_t(440. / 44100.));
+        oscillator::cosine(phases.data(), output.data(), vector_size);
+    }, vector_size, repetitions);
+    
+    const double fast = measure([&]()
+    {
+        phase = oscillator::phase(phases.data(), vector_size, phase, sample_t(440. / 44100.));
+        oscillator::fastCosine(phases.data(), output.data(), vector_size);
+    }, vector_size, repetitions);
+    
+    const double ramp = measure([&]()
+    {
+        phase = oscillator::phase(output.data(), vector_size, phase, sample_t(440. / 44100.));
+    }, vector_size, repetitions);
+    
+    #if KIWI_TEST_RDTSC
+    const std::string unit = " cycles per sample";
+    #else
+    const std::string unit = " ns per sample";
+    #endif
+    
+    std::cout << "Oscillator - exact cosine : " << exact << unit << '\n';
+    std::cout << "Oscillator - fast cosine : " << fast << unit << '\n';
+    std::cout << "Oscillator - phasor : " << ramp << unit << '\n';
+    
+    CHECK(output[0] == output[0]);
+}
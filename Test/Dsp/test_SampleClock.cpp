@@ -0,0 +1,162 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_Chain.h>
+#include <KiwiDsp/KiwiDsp_ThreadPool.h>
+#include <KiwiDsp/KiwiDsp_SampleClock.h>
+
+#include "Processors.h"
+
+using namespace kiwi;
+using namespace dsp;
+
+// ================================================================================ //
+//                                    SAMPLE CLOCK                                  //
+// ================================================================================ //
+
+TEST_CASE("Dsp - SampleClock", "[Dsp, SampleClock]")
+{
+    using time_point_t = SampleClock::time_point_t;
+    
+    const time_point_t start = SampleClock::clock_t::now();
+    
+    SECTION("Events are applied in the next block at their offset")
+    {
+        SampleClock clock;
+        
+        CHECK(clock.getBlockPosition() == 0);
+        CHECK(clock.getPosition(start) == 0);
+        
+        clock.tick(start, 44100, 64);
+        
+        CHECK(clock.getBlockPosition() == 0);
+        CHECK(clock.getPosition(start) == 64);
+        CHECK(clock.getPosition(start + std::chrono::milliseconds(1)) == 64 + 44);
+        
+        clock.tick(start + std::chrono::microseconds(1451), 44100, 64);
+        
+        CHECK(clock.getBlockPosition() == 64);
+        CHECK(clock.getPosition(start + std::chrono::microseconds(1451)) == 128);
+        CHECK(clock.getPosition(start + std::chrono::microseconds(1951)) == 128 + 22);
+    }
+    
+    SECTION("Positions are kept in the next block")
+    {
+        SampleClock clock;
+        
+        clock.tick(start, 44100, 64);
+        
+        // late events are applied at the beginning, events beyond the block at its end.
+        
+        CHECK(clock.getPosition(start - std::chrono::milliseconds(10)) == 64);
+        CHECK(clock.getPosition(start + std::chrono::seconds(10)) == 127);
+    }
+    
+    SECTION("The vector size can change")
+    {
+        SampleClock clock;
+        
+        clock.tick(start, 48000, 64);
+        clock.tick(start, 48000, 256);
+        clock.tick(start, 48000, 32);
+        
+        CHECK(clock.getBlockPosition() == 64 + 256);
+        CHECK(clock.getPosition(start) == 64 + 256 + 32);
+    }
+    
+    SECTION("Chains tick their clock")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::shared_ptr<Processor> plus(new PlusScalar(1.));
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(plus);
+        chain.connect(*sig, 0, *plus, 0);
+        
+        // an unprepared chain doesn't tick its clock.
+        
+        chain.tick();
+        
+        CHECK(chain.getSampleClock().getPosition(start) == 0);
+        
+        chain.prepare(44100, 64);
+        
+        chain.tick();
+        CHECK(chain.getSampleClock().getBlockPosition() == 0);
+        
+        chain.tick();
+        chain.tick();
+        CHECK(chain.getSampleClock().getBlockPosition() == 128);
+        
+        ThreadPool pool(1);
+        
+        pool.tick({&chain});
+        CHECK(chain.getSampleClock().getBlockPosition() == 192);
+        
+        chain.release();
+    }
+    
+    SECTION("Positions read concurrently never decrease")
+    {
+        SampleClock clock;
+        
+        std::atomic<bool> ticking(true);
+        
+        std::thread audio_thread([&clock, &ticking]()
+        {
+            while(ticking.load())
+            {
+                clock.tick(SampleClock::clock_t::now(), 44100, 64);
+                std::this_thread::yield();
+            }
+        });
+        
+        uint64_t previous = 0;
+        size_t decreases = 0;
+        
+        for(size_t i = 0; i < 100000; ++i)
+        {
+            const uint64_t position = clock.getPosition(SampleClock::clock_t::now());
+            
+            if(position < previous)
+            {
+                ++decreases;
+            }
+            
+            previous = position;
+        }
+        
+        ticking.store(false);
+        audio_thread.join();
+        
+        CHECK(decreases == 0);
+    }
+}
@@ -0,0 +1,288 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <memory>
+#include <thread>
+
+#include "../catch.hpp"
+
+#include <KiwiDsp/KiwiDsp_ThreadPool.h>
+#include <KiwiDsp/KiwiDsp_Misc.h>
+
+#include "Processors.h"
+
+using namespace kiwi;
+using namespace dsp;
+
+// ==================================================================================== //
+//                                   TEST THREAD POOL                                   //
+// ==================================================================================== //
+
+TEST_CASE("Dsp - ThreadPool", "[Dsp, ThreadPool]")
+{
+    const size_t samplerate = 44100ul;
+    const size_t vectorsize = 4ul;
+    
+    ThreadPool pool(3);
+    
+    SECTION("Parallel branches")
+    {
+        Chain chain;
+        chain.setParallel(true);
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        chain.addProcessor(sig);
+        
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        chain.addProcessor(print);
+        
+        std::vector<std::shared_ptr<Processor>> processors;
+        
+        for(size_t branch = 0; branch < 16; ++branch)
+        {
+            Processor* previous = sig.get();
+            
+            for(size_t stage = 0; stage < 8; ++stage)
+            {
+                processors.emplace_back(new PlusScalar(1., stage % 2));
+                chain.addProcessor(processors.back());
+                chain.connect(*previous, 0, *processors.back(), 0);
+                previous = processors.back().get();
+            }
+            
+            chain.connect(*previous, 0, *print, 0);
+        }
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        // the signals of a branch are reused two stages later, never by the other branches.
+        CHECK(chain.getNumberOfSignals() == 1 + 16 * 2);
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            result.clear();
+            pool.tick({&chain});
+            CHECK(result == "[144.000000, 144.000000, 144.000000, 144.000000]");
+        }
+        
+        chain.release();
+    }
+    
+    SECTION("Signals are reused along the dependencies")
+    {
+        Chain chain;
+        chain.setParallel(true);
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::shared_ptr<Processor> sum(new PlusSignal());
+        
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(sum);
+        chain.addProcessor(print);
+        
+        std::vector<std::shared_ptr<Processor>> processors;
+        
+        for(size_t branch = 0; branch < 2; ++branch)
+        {
+            Processor* previous = sig.get();
+            
+            for(size_t stage = 0; stage < 8; ++stage)
+            {
+                processors.emplace_back(new PlusScalar(1.));
+                chain.addProcessor(processors.back());
+                chain.connect(*previous, 0, *processors.back(), 0);
+                previous = processors.back().get();
+            }
+            
+            chain.connect(*previous, 0, *sum, branch);
+        }
+        
+        chain.connect(*sum, 0, *print, 0);
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        CHECK(chain.getNumberOfSignals() <= 6);
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            result.clear();
+            pool.tick({&chain});
+            CHECK(result == "[18.000000, 18.000000, 18.000000, 18.000000]");
+        }
+        
+        chain.release();
+    }
+    
+    SECTION("Sequential processors keep the order of the chains")
+    {
+        sample_t sum = 0.;
+        std::vector<size_t> order;
+        std::vector<size_t> expected_order;
+        
+        Chain chain_1;
+        Chain chain_2;
+        chain_1.setParallel(true);
+        
+        std::vector<std::shared_ptr<Processor>> processors;
+        
+        size_t id = 0;
+        
+        for(Chain* chain : {&chain_1, &chain_2})
+        {
+            for(size_t branch = 0; branch < 8; ++branch)
+            {
+                processors.emplace_back(new Sig(0.1 * (id + 1)));
+                std::shared_ptr<Processor> sig = processors.back();
+                
+                processors.emplace_back(new PlusScalar(1.));
+                std::shared_ptr<Processor> plus = processors.back();
+                
+                processors.emplace_back(new Accumulate(sum, order, id++));
+                std::shared_ptr<Processor> accumulate = processors.back();
+                
+                chain->addProcessor(sig);
+                chain->addProcessor(plus);
+                chain->addProcessor(accumulate);
+                chain->connect(*sig, 0, *plus, 0);
+                chain->connect(*plus, 0, *accumulate, 0);
+            }
+        }
+        
+        chain_1.prepare(samplerate, vectorsize);
+        chain_2.prepare(samplerate, vectorsize);
+        
+        order.reserve(16);
+        
+        chain_1.tick();
+        chain_2.tick();
+        
+        expected_order = order;
+        const sample_t expected_sum = sum;
+        
+        CHECK(expected_order.size() == 16);
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            sum = 0.;
+            order.clear();
+            
+            pool.tick({&chain_1, &chain_2});
+            
+            CHECK(order == expected_order);
+            CHECK(sum == expected_sum);
+        }
+        
+        chain_1.release();
+        chain_2.release();
+    }
+    
+    SECTION("Chain not parallel")
+    {
+        Chain chain;
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::shared_ptr<Processor> plus_1(new PlusScalar(1.));
+        std::shared_ptr<Processor> plus_2(new PlusScalar(2.));
+        std::shared_ptr<Processor> plus_signal(new PlusSignal());
+        
+        std::string result;
+        std::shared_ptr<Processor> print(new Print(result));
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(plus_1);
+        chain.addProcessor(plus_2);
+        chain.addProcessor(plus_signal);
+        chain.addProcessor(print);
+        
+        chain.connect(*sig, 0, *plus_1, 0);
+        chain.connect(*sig, 0, *plus_2, 0);
+        chain.connect(*plus_1, 0, *plus_signal, 0);
+        chain.connect(*plus_2, 0, *plus_signal, 1);
+        chain.connect(*plus_signal, 0, *print, 0);
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        pool.tick({&chain});
+        
+        CHECK(result == "[5.000000, 5.000000, 5.000000, 5.000000]");
+        
+        chain.release();
+    }
+    
+    SECTION("Updating while ticking")
+    {
+        Chain chain;
+        chain.setParallel(true);
+        chain.setUpdateMode(Chain::UpdateMode::Incremental);
+        
+        std::shared_ptr<Processor> sig(new Sig(1.));
+        std::shared_ptr<Processor> plus(new PlusScalar(1.));
+        
+        chain.addProcessor(sig);
+        chain.addProcessor(plus);
+        chain.connect(*sig, 0, *plus, 0);
+        
+        chain.prepare(samplerate, vectorsize);
+        
+        std::atomic<bool> ticking(true);
+        std::atomic<size_t> ticks(0);
+        
+        std::thread audio_thread([&pool, &chain, &ticking, &ticks]()
+        {
+            while(ticking.load())
+            {
+                pool.tick({&chain});
+                ticks.fetch_add(1);
+            }
+        });
+        
+        while(ticks.load() == 0)
+        {
+            std::this_thread::yield();
+        }
+        
+        for(size_t i = 0; i < 50; ++i)
+        {
+            std::shared_ptr<Processor> branch(new PlusScalar(1.));
+            std::shared_ptr<Processor> sum(new PlusSignal());
+            
+            chain.addProcessor(branch);
+            chain.addProcessor(sum);
+            chain.connect(*sig, 0, *branch, 0);
+            chain.connect(*branch, 0, *sum, 0);
+            chain.connect(*plus, 0, *sum, 1);
+            chain.update();
+            
+            chain.removeProcessor(*sum);
+            chain.removeProcessor(*branch);
+            chain.update();
+        }
+        
+        ticking.store(false);
+        audio_thread.join();
+        
+        chain.release();
+    }
+}
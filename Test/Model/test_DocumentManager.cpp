@@ -0,0 +1,194 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "../catch.hpp"
+#include "../KiwiBenchmark.h"
+
+#include "flip/Document.h"
+
+#include <KiwiTool/KiwiTool_Atom.h>
+
+#include <KiwiModel/KiwiModel_DataModel.h>
+#include <KiwiModel/KiwiModel_Patcher.h>
+#include <KiwiModel/KiwiModel_DocumentManager.h>
+#include <KiwiModel/KiwiModel_Factory.h>
+
+using namespace kiwi;
+
+// ==================================================================================== //
+//                                   DOCUMENT MANAGER                                   //
+// ==================================================================================== //
+
+//! @brief Moves the first objects of the patcher step by step within a gesture.
+static void moveObjects(model::Patcher& patcher, size_t number_of_objects, size_t number_of_steps)
+{
+    model::DocumentManager::startCommitGesture(patcher);
+    
+    for(size_t step = 0; step < number_of_steps; ++step)
+    {
+        size_t moved = 0;
+        
+        for(auto& object : patcher.getObjects())
+        {
+            if(moved++ == number_of_objects)
+                break;
+            
+            object.setPosition(object.getX() + 1., object.getY() + 1.);
+        }
+        
+        model::DocumentManager::commitGesture(patcher, "Move selected objects");
+    }
+    
+    model::DocumentManager::endCommitGesture(patcher);
+}
+
+TEST_CASE("Model DocumentManager", "[DocumentManager]")
+{
+    flip::Document document(model::DataModel::use(), 123456789, 'appl', 'gui ');
+    
+    model::Patcher& patcher = document.root<model::Patcher>();
+    auto& manager = patcher.entity().emplace<model::DocumentManager>(document);
+    
+    for(size_t i = 0; i < 10; ++i)
+    {
+        patcher.addObject(model::Factory::create(tool::AtomHelper::parse("+")));
+    }
+    
+    model::DocumentManager::commit(patcher);
+    
+    SECTION("A gesture is undone in one step")
+    {
+        moveObjects(patcher, 5, 20);
+        
+        size_t index = 0;
+        
+        for(auto& object : patcher.getObjects())
+        {
+            CHECK(object.getX() == (index++ < 5 ? 20. : 0.));
+        }
+        
+        REQUIRE(manager.canUndo());
+        CHECK(manager.getUndoLabel() == "Move selected objects");
+        
+        manager.undo();
+        document.commit();
+        
+        for(auto& object : patcher.getObjects())
+        {
+            CHECK(object.getX() == 0.);
+            CHECK(object.getY() == 0.);
+        }
+        
+        CHECK(!manager.canUndo());
+        
+        manager.redo();
+        document.commit();
+        
+        CHECK(patcher.getObjects().begin()->getX() == 20.);
+    }
+    
+    SECTION("A gesture restarted reverts the previous changes")
+    {
+        model::DocumentManager::startCommitGesture(patcher);
+        
+        patcher.getObjects().begin()->setPosition(50., 50.);
+        model::DocumentManager::commitGesture(patcher, "Move selected objects");
+        
+        model::DocumentManager::startCommitGesture(patcher);
+        
+        CHECK(patcher.getObjects().begin()->getX() == 0.);
+        
+        patcher.getObjects().begin()->setPosition(10., 10.);
+        model::DocumentManager::commitGesture(patcher, "Move selected objects");
+        
+        model::DocumentManager::endCommitGesture(patcher);
+        
+        CHECK(patcher.getObjects().begin()->getX() == 10.);
+        
+        manager.undo();
+        document.commit();
+        
+        CHECK(patcher.getObjects().begin()->getX() == 0.);
+        CHECK(!manager.canUndo());
+    }
+    
+    SECTION("A gesture that changes nothing isn't added to the history")
+    {
+        model::DocumentManager::startCommitGesture(patcher);
+        
+        auto& object = *patcher.getObjects().begin();
+        
+        object.setPosition(30., 30.);
+        model::DocumentManager::commitGesture(patcher, "Move selected objects");
+        
+        object.setPosition(0., 0.);
+        model::DocumentManager::commitGesture(patcher, "Move selected objects");
+        
+        model::DocumentManager::endCommitGesture(patcher);
+        
+        CHECK(!manager.canUndo());
+    }
+    
+    patcher.entity().erase<model::DocumentManager>();
+}
+
+// ==================================================================================== //
+//                              DOCUMENT MANAGER - BENCHMARK                            //
+// ==================================================================================== //
+
+TEST_CASE("Model DocumentManager - Benchmark", "[DocumentManager]")
+{
+    Benchmark bench;
+    
+    bench.startTestCase("DocumentManager - 100 gesture steps moving 10 objects");
+    
+    for(size_t count : {100ul, 1000ul, 2000ul})
+    {
+        flip::Document document(model::DataModel::use(), 123456789, 'appl', 'gui ');
+        
+        model::Patcher& patcher = document.root<model::Patcher>();
+        auto& manager = patcher.entity().emplace<model::DocumentManager>(document);
+        
+        for(size_t i = 0; i < count; ++i)
+        {
+            patcher.addObject(model::Factory::create(tool::AtomHelper::parse("+")));
+        }
+        
+        model::DocumentManager::commit(patcher);
+        
+        bench.startUnit("gesture (" + std::to_string(count) + " objects)");
+        
+        moveObjects(patcher, 10, 100);
+        
+        bench.endUnit();
+        
+        CHECK(patcher.getObjects().begin()->getX() == 100.);
+        CHECK(manager.canUndo());
+        
+        patcher.entity().erase<model::DocumentManager>();
+    }
+    
+    bench.endTestCase();
+}
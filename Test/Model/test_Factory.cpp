@@ -20,6 +20,7 @@
  */
 
 #include "../catch.hpp"
+#include "../KiwiBenchmark.h"
 
 #include <KiwiModel/KiwiModel_Factory.h>
 
@@ -51,3 +52,112 @@ TEST_CASE("Model Factory", "[Names]")
         CHECK(kiwi_name == model::Factory::toKiwiName(model_name));
     }
 }
+
+// ==================================================================================== //
+//                                     FACTORY - LOOKUP                                 //
+// ==================================================================================== //
+
+TEST_CASE("Model Factory - Lookup", "[Factory]")
+{
+    SECTION("Names, aliases and type ids")
+    {
+        model::ObjectClass const* trigger = model::Factory::getClassByName("trigger");
+        
+        REQUIRE(trigger != nullptr);
+        CHECK(model::Factory::getClassByName("t") == trigger);
+        CHECK(model::Factory::getClassByName("t", true) == nullptr);
+        CHECK(model::Factory::has("t"));
+        CHECK_FALSE(model::Factory::has("not.an.object"));
+        
+        auto object = model::Factory::create(tool::AtomHelper::parse("t b b"));
+        
+        CHECK(&object->getClass() == trigger);
+        CHECK(object->getName() == "trigger");
+    }
+}
+
+// ==================================================================================== //
+//                                   FACTORY - BENCHMARK                                //
+// ==================================================================================== //
+
+//! @brief Finds a class by scanning the names and the aliases of all the classes.
+static model::ObjectClass const* findByScan(std::vector<model::ObjectClass const*> const& classes,
+                                            std::string const& name)
+{
+    for(auto const* object_class : classes)
+    {
+        if(object_class->getName() == name || object_class->hasAlias(name))
+            return object_class;
+    }
+    
+    return nullptr;
+}
+
+TEST_CASE("Model Factory - Benchmark", "[Factory]")
+{
+    const size_t count = 5000;
+    
+    const std::vector<std::string> texts
+    {
+        "+ 1", "osc~ 440", "t b b", "s foo", "r foo", "sel 1 2", "metro 100", "print", "unknown.object"
+    };
+    
+    std::vector<std::vector<tool::Atom>> patch;
+    
+    for(size_t i = 0; i < count; ++i)
+    {
+        patch.emplace_back(tool::AtomHelper::parse(texts[i % texts.size()]));
+    }
+    
+    std::vector<model::ObjectClass const*> classes;
+    
+    for(std::string const& name : model::Factory::getNames(true, false))
+    {
+        classes.push_back(model::Factory::getClassByName(name, true));
+    }
+    
+    Benchmark bench;
+    
+    bench.startTestCase("Factory - " + std::to_string(count) + " objects ("
+                        + std::to_string(classes.size()) + " classes)");
+    
+    bench.startUnit("lookup by scan");
+    
+    size_t scan_found = 0;
+    
+    for(auto const& atoms : patch)
+    {
+        scan_found += findByScan(classes, atoms[0].getString()) != nullptr;
+    }
+    
+    bench.endUnit();
+    
+    bench.startUnit("lookup by index");
+    
+    size_t index_found = 0;
+    
+    for(auto const& atoms : patch)
+    {
+        index_found += model::Factory::getClassByName(atoms[0].getString()) != nullptr;
+    }
+    
+    bench.endUnit();
+    
+    bench.startUnit("create");
+    
+    std::vector<std::unique_ptr<model::Object>> objects;
+    objects.reserve(count);
+    
+    for(auto const& atoms : patch)
+    {
+        objects.emplace_back(model::Factory::create(atoms));
+    }
+    
+    bench.endUnit();
+    
+    bench.endTestCase();
+    
+    CHECK(scan_found == index_found);
+    CHECK(objects.size() == count);
+    CHECK(objects[texts.size() - 1]->getName() == "errorbox");
+}
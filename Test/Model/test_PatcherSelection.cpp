@@ -0,0 +1,518 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+
+#include <map>
+#include <memory>
+#include <random>
+
+#include "../catch.hpp"
+#include "../KiwiBenchmark.h"
+
+#include "flip/Document.h"
+#include "flip/DocumentObserver.h"
+#include "flip/DocumentServer.h"
+#include "flip/PortDirect.h"
+#include "flip/CarrierDirect.h"
+
+#include <KiwiTool/KiwiTool_Atom.h>
+
+#include <KiwiModel/KiwiModel_DataModel.h>
+#include <KiwiModel/KiwiModel_PatcherUser.h>
+#include <KiwiModel/KiwiModel_PatcherView.h>
+#include <KiwiModel/KiwiModel_PatcherValidator.h>
+#include <KiwiModel/KiwiModel_PatcherSelection.h>
+#include <KiwiModel/KiwiModel_Factory.h>
+
+using namespace kiwi;
+
+// ==================================================================================== //
+//                                   REFERENCE SELECTION                                //
+// ==================================================================================== //
+
+using Selection = std::map<model::Object const*, std::pair<bool, std::set<uint64_t>>>;
+
+//! @brief Computes the selection of all the objects as the patcher view used to.
+static Selection computeSelection(model::Patcher const& patcher,
+                                  uint64_t local_user,
+                                  model::Patcher::View const& local_view,
+                                  std::unordered_set<uint64_t> const& connected_users)
+{
+    Selection selection;
+    
+    for(auto const& object : patcher.getObjects())
+    {
+        if(object.removed())
+        {
+            continue;
+        }
+        
+        bool local = false;
+        std::set<uint64_t> users;
+        
+        for(auto const& user : patcher.getUsers())
+        {
+            const uint64_t user_id = user.getId();
+            const bool is_distant_user = user_id != local_user;
+            
+            if(user.removed() || (is_distant_user && connected_users.count(user_id) == 0))
+            {
+                continue;
+            }
+            
+            for(auto const& view : user.getViews())
+            {
+                if(view.removed() || !view.isSelected(object))
+                {
+                    continue;
+                }
+                
+                if(is_distant_user)
+                {
+                    users.insert(user_id);
+                    break;
+                }
+                else if(&view == &local_view)
+                {
+                    local = true;
+                }
+                else
+                {
+                    users.insert(user_id);
+                }
+            }
+        }
+        
+        if(local || !users.empty())
+        {
+            selection[&object] = std::make_pair(local, users);
+        }
+    }
+    
+    return selection;
+}
+
+//! @brief Returns the selection of all the objects tracked by a PatcherSelection.
+static Selection getSelection(model::Patcher const& patcher, model::PatcherSelection const& patcher_selection)
+{
+    Selection selection;
+    
+    for(auto const& object : patcher.getObjects())
+    {
+        const bool local = patcher_selection.isSelectedLocally(object);
+        const std::set<uint64_t> users = patcher_selection.getUsers(object);
+        
+        if(local || !users.empty())
+        {
+            selection[&object] = std::make_pair(local, users);
+        }
+    }
+    
+    return selection;
+}
+
+// ==================================================================================== //
+//                                         SESSION                                      //
+// ==================================================================================== //
+
+//! @brief A patcher shared by a server, distant users and a local user whose document is observed.
+class Session : public flip::DocumentObserver<model::Patcher>
+{
+public: // classes
+    
+    enum class Mode
+    {
+        Incremental,
+        FullScan
+    };
+    
+    //! @brief A distant user editing the patcher in its own view.
+    struct Client
+    {
+        flip::PortDirect                        port;
+        std::unique_ptr<flip::Document>         document;
+        std::unique_ptr<flip::CarrierDirect>    carrier;
+        model::Patcher::View*                   view = nullptr;
+        std::vector<model::Object*>             objects;
+    };
+    
+public: // methods
+    
+    Session(Mode mode, size_t users, size_t objects)
+    : m_mode(mode)
+    , m_server(model::DataModel::use(), m_validator, 123456789ULL)
+    , m_local(model::DataModel::use(), *this, m_validator, local_user, 23, 24)
+    {
+        for(size_t i = 0; i < objects; ++i)
+        {
+            m_server.root<model::Patcher>().addObject(model::Factory::create(tool::AtomHelper::parse("+")));
+        }
+        
+        m_server.commit();
+        
+        m_server.port_factory_add(m_local_port);
+        m_local_carrier.reset(new flip::CarrierDirect(m_local, m_local_port));
+        m_local.pull();
+        
+        for(size_t i = 0; i < users; ++i)
+        {
+            m_clients.emplace_back(new Client());
+            Client& client = *m_clients.back();
+            
+            m_server.port_factory_add(client.port);
+            client.document.reset(new flip::Document(model::DataModel::use(), m_validator, 11 + i, 23, 24));
+            client.carrier.reset(new flip::CarrierDirect(*client.document, client.port));
+            client.document->pull();
+            
+            model::Patcher& patcher = client.document->root<model::Patcher>();
+            client.view = &patcher.useSelfUser().addView();
+            
+            for(auto& object : patcher.getObjects())
+            {
+                client.objects.push_back(&object);
+            }
+            
+            client.document->commit();
+            client.document->push();
+            
+            m_connected_users.insert(11 + i);
+        }
+        
+        model::Patcher& patcher = m_local.root<model::Patcher>();
+        m_local_view = &patcher.useSelfUser().addView();
+        m_selection.reset(new model::PatcherSelection(local_user, *m_local_view));
+        
+        for(auto& object : patcher.getObjects())
+        {
+            m_local_objects.push_back(&object);
+        }
+        
+        m_local.commit();
+        m_local.push();
+        m_local.pull();
+    }
+    
+    ~Session()
+    {
+        m_server.port_factory_remove(m_local_port);
+        
+        for(auto& client : m_clients)
+        {
+            m_server.port_factory_remove(client->port);
+        }
+    }
+    
+    //! @brief Sends the changes of a client to the local user.
+    void push(Client& client)
+    {
+        client.document->commit();
+        client.document->push();
+        m_local.pull();
+    }
+    
+    //! @brief Commits the changes of the local user.
+    void commitLocal()
+    {
+        m_local.commit();
+        m_local.push();
+    }
+    
+    //! @brief Connects or disconnects a distant user.
+    void setConnected(uint64_t user, bool connected)
+    {
+        if(connected)
+        {
+            m_connected_users.insert(user);
+        }
+        else
+        {
+            m_connected_users.erase(user);
+        }
+        
+        if(m_mode == Mode::Incremental)
+        {
+            m_selection->update(patcher(), m_connected_users);
+            m_changed.insert(m_selection->getChangedObjects().begin(), m_selection->getChangedObjects().end());
+        }
+    }
+    
+    model::Patcher& patcher() { return m_local.root<model::Patcher>(); }
+    
+    static constexpr uint64_t local_user = 10;
+    
+    Mode                                        m_mode;
+    model::PatcherValidator                     m_validator;
+    flip::DocumentServer                        m_server;
+    flip::Document                              m_local;
+    flip::PortDirect                            m_local_port;
+    std::unique_ptr<flip::CarrierDirect>        m_local_carrier;
+    model::Patcher::View*                       m_local_view = nullptr;
+    std::vector<model::Object*>                 m_local_objects;
+    std::vector<std::unique_ptr<Client>>        m_clients;
+    std::unordered_set<uint64_t>                m_connected_users;
+    std::unique_ptr<model::PatcherSelection>    m_selection;
+    std::unordered_set<model::Object const*>    m_changed;
+    Selection                                   m_full_selection;
+    
+private: // methods
+    
+    void document_changed(model::Patcher& patcher) override
+    {
+        if(m_selection == nullptr)
+        {
+            return;
+        }
+        
+        if(m_mode == Mode::Incremental)
+        {
+            m_selection->update(patcher, m_connected_users);
+            m_changed.insert(m_selection->getChangedObjects().begin(), m_selection->getChangedObjects().end());
+        }
+        else
+        {
+            m_full_selection = computeSelection(patcher, local_user, *m_local_view, m_connected_users);
+        }
+    }
+};
+
+constexpr uint64_t Session::local_user;
+
+//! @brief An action of the recorded session.
+struct Step
+{
+    enum class Action
+    {
+        Select,
+        Unselect,
+        UnselectAll,
+        Move,
+        SelectLocally,
+        Disconnect
+    };
+    
+    Action  action;
+    size_t  user;
+    size_t  object;
+};
+
+//! @brief Records a session where users mostly move the objects and change their selections.
+static std::vector<Step> recordSession(size_t steps, size_t users, size_t objects)
+{
+    std::mt19937 generator(4242);
+    std::discrete_distribution<int> actions {30, 10, 2, 50, 6, 2};
+    std::uniform_int_distribution<size_t> user(0, users - 1);
+    std::uniform_int_distribution<size_t> object(0, objects - 1);
+    
+    std::vector<Step> session;
+    
+    for(size_t i = 0; i < steps; ++i)
+    {
+        const Step::Action action = static_cast<Step::Action>(actions(generator));
+        const size_t user_index = user(generator);
+        session.push_back(Step{action, user_index, object(generator)});
+    }
+    
+    return session;
+}
+
+//! @brief Replays a step of a recorded session.
+static void replay(Session& session, Step const& step)
+{
+    Session::Client& client = *session.m_clients[step.user];
+    model::Object& object = *client.objects[step.object];
+    
+    switch(step.action)
+    {
+        case Step::Action::Select: client.view->selectObject(object); break;
+        case Step::Action::Unselect: client.view->unselectObject(object); break;
+        case Step::Action::UnselectAll: client.view->unselectAll(); break;
+        case Step::Action::Move: object.setPosition(object.getX() + 1., object.getY()); break;
+        case Step::Action::SelectLocally:
+        {
+            session.m_local_view->selectObject(*session.m_local_objects[step.object]);
+            session.commitLocal();
+            return;
+        }
+        case Step::Action::Disconnect:
+        {
+            const uint64_t user_id = 11 + step.user;
+            session.setConnected(user_id, session.m_connected_users.count(user_id) == 0);
+            return;
+        }
+    }
+    
+    session.push(client);
+}
+
+// ==================================================================================== //
+//                                    PATCHER SELECTION                                 //
+// ==================================================================================== //
+
+TEST_CASE("Model Patcher Selection", "[PatcherSelection]")
+{
+    SECTION("Distant and local selections")
+    {
+        Session session(Session::Mode::Incremental, 2, 3);
+        
+        Session::Client& client = *session.m_clients[0];
+        model::Object const& object = *session.m_local_objects[1];
+        
+        client.view->selectObject(*client.objects[1]);
+        session.m_changed.clear();
+        session.push(client);
+        
+        CHECK(session.m_changed.size() == 1);
+        CHECK(session.m_changed.count(&object) == 1);
+        CHECK(session.m_selection->getUsers(object) == std::set<uint64_t>{11});
+        CHECK_FALSE(session.m_selection->isSelectedLocally(object));
+        
+        session.m_local_view->selectObject(*session.m_local_objects[1]);
+        session.commitLocal();
+        
+        CHECK(session.m_selection->isSelectedLocally(object));
+        
+        // objects moved by a user don't change the selection.
+        client.objects[1]->setPosition(20., 20.);
+        session.m_changed.clear();
+        session.push(client);
+        
+        CHECK(session.m_changed.empty());
+        
+        session.setConnected(11, false);
+        
+        CHECK(session.m_selection->getUsers(object).empty());
+        CHECK(session.m_selection->isSelectedLocally(object));
+        
+        session.setConnected(11, true);
+        
+        CHECK(session.m_selection->getUsers(object) == std::set<uint64_t>{11});
+    }
+    
+    SECTION("Removed objects are unselected")
+    {
+        Session session(Session::Mode::Incremental, 1, 3);
+        
+        Session::Client& client = *session.m_clients[0];
+        model::Object const* object = session.m_local_objects[2];
+        
+        client.view->selectObject(*client.objects[2]);
+        session.push(client);
+        
+        CHECK(session.m_selection->getUsers(*object) == std::set<uint64_t>{11});
+        
+        client.document->root<model::Patcher>().removeObject(*client.objects[2], client.view);
+        session.m_changed.clear();
+        session.push(client);
+        
+        CHECK(session.m_changed.count(object) == 1);
+        CHECK(getSelection(session.patcher(), *session.m_selection).empty());
+    }
+    
+    SECTION("Replayed session matches a full recomputation")
+    {
+        const size_t users = 4;
+        const size_t objects = 50;
+        
+        Session session(Session::Mode::Incremental, users, objects);
+        
+        Selection previous;
+        size_t errors = 0;
+        
+        for(Step const& step : recordSession(2000, users, objects))
+        {
+            session.m_changed.clear();
+            
+            replay(session, step);
+            
+            model::Patcher& patcher = session.patcher();
+            
+            const Selection selection = getSelection(patcher, *session.m_selection);
+            const Selection expected = computeSelection(patcher, Session::local_user,
+                                                        *session.m_local_view,
+                                                        session.m_connected_users);
+            
+            errors += (selection != expected);
+            
+            // the objects notified are exactly the ones whose selection changed.
+            for(auto const& object : patcher.getObjects())
+            {
+                const auto it = previous.find(&object);
+                const auto expected_it = expected.find(&object);
+                
+                const bool changed = (it == previous.end()) != (expected_it == expected.end())
+                || (it != previous.end() && it->second != expected_it->second);
+                
+                errors += (changed != (session.m_changed.count(&object) != 0));
+            }
+            
+            previous = expected;
+        }
+        
+        CHECK(errors == 0);
+    }
+}
+
+// ==================================================================================== //
+//                               PATCHER SELECTION - BENCHMARK                          //
+// ==================================================================================== //
+
+TEST_CASE("Model Patcher Selection - Benchmark", "[PatcherSelection]")
+{
+    const size_t users = 6;
+    const size_t objects = 3000;
+    const size_t steps = 1000;
+    
+    const std::vector<Step> recorded_session = recordSession(steps, users, objects);
+    
+    Session full_scan(Session::Mode::FullScan, users, objects);
+    Session incremental(Session::Mode::Incremental, users, objects);
+    
+    Benchmark bench;
+    
+    bench.startTestCase("Patcher Selection - " + std::to_string(users) + " users, "
+                        + std::to_string(objects) + " objects ("
+                        + std::to_string(steps) + " recorded steps)");
+    
+    bench.startUnit("full scan");
+    
+    for(Step const& step : recorded_session)
+    {
+        replay(full_scan, step);
+    }
+    
+    bench.endUnit();
+    
+    bench.startUnit("incremental");
+    
+    for(Step const& step : recorded_session)
+    {
+        replay(incremental, step);
+    }
+    
+    bench.endUnit();
+    
+    bench.endTestCase();
+    
+    CHECK(getSelection(incremental.patcher(), *incremental.m_selection)
+          == computeSelection(incremental.patcher(), Session::local_user,
+                              *incremental.m_local_view, incremental.m_connected_users));
+}
@@ -0,0 +1,209 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include "../catch.hpp"
+#include "../KiwiBenchmark.h"
+
+#include "flip/Document.h"
+#include "flip/DocumentServer.h"
+#include "flip/PortDirect.h"
+#include "flip/CarrierDirect.h"
+
+#include <KiwiTool/KiwiTool_Atom.h>
+
+#include <KiwiModel/KiwiModel_DataModel.h>
+#include <KiwiModel/KiwiModel_PatcherUser.h>
+#include <KiwiModel/KiwiModel_PatcherView.h>
+#include <KiwiModel/KiwiModel_PatcherValidator.h>
+#include <KiwiModel/KiwiModel_Factory.h>
+
+using namespace kiwi;
+
+// ==================================================================================== //
+//                                      PATCHER VIEW                                    //
+// ==================================================================================== //
+
+TEST_CASE("Model Patcher View", "[PatcherView]")
+{
+    SECTION("Selection")
+    {
+        flip::Document document(model::DataModel::use(), 123456789, 'appl', 'gui ');
+        
+        model::Patcher& patcher = document.root<model::Patcher>();
+        model::Patcher::View& view = patcher.useSelfUser().addView();
+        
+        model::Object& object_1 = patcher.addObject(model::Factory::create(tool::AtomHelper::parse("+")));
+        model::Object& object_2 = patcher.addObject(model::Factory::create(tool::AtomHelper::parse("+")));
+        model::Link& link = *patcher.addLink(object_1, 0, object_2, 0);
+        
+        view.selectObject(object_1);
+        view.selectObject(object_1);
+        
+        CHECK(view.isSelected(object_1));
+        CHECK_FALSE(view.isSelected(object_2));
+        CHECK_FALSE(view.isSelected(link));
+        CHECK(view.getSelectedObjects().size() == 1);
+        
+        view.unselectObject(object_1);
+        view.unselectObject(object_2);
+        
+        CHECK_FALSE(view.isSelected(object_1));
+        
+        view.selectAll();
+        
+        CHECK(view.isSelected(object_1));
+        CHECK(view.isSelected(object_2));
+        CHECK(view.isSelected(link));
+        
+        patcher.removeObject(object_2, &view);
+        
+        CHECK_FALSE(view.isSelected(link));
+        
+        view.unselectAll();
+        
+        CHECK_FALSE(view.isSelected(object_1));
+        CHECK(view.getSelectedObjects().empty());
+        
+        document.commit();
+    }
+    
+    SECTION("Selection changed by another document")
+    {
+        model::PatcherValidator validator;
+        flip::DocumentServer server (model::DataModel::use(), validator, 123456789ULL);
+        
+        server.root<model::Patcher>().addObject(model::Factory::create(tool::AtomHelper::parse("+")));
+        server.commit();
+        
+        flip::PortDirect port_01;
+        server.port_factory_add (port_01);
+        
+        flip::Document document_01 (model::DataModel::use(), validator, 11, 23, 24);
+        flip::CarrierDirect carrier_01 (document_01, port_01);
+        
+        document_01.pull();
+        
+        flip::PortDirect port_02;
+        server.port_factory_add (port_02);
+        
+        flip::Document document_02 (model::DataModel::use(), validator, 12, 23, 24);
+        flip::CarrierDirect carrier_02 (document_02, port_02);
+        
+        document_02.pull();
+        
+        // client 1 selects the object in its view
+        model::Patcher& patcher_01 = document_01.root<model::Patcher>();
+        model::Patcher::View& view_01 = patcher_01.useSelfUser().addView();
+        view_01.selectObject(*patcher_01.getObjects().begin());
+        
+        document_01.commit();
+        document_01.push();
+        
+        // client 2 reads the view of client 1
+        model::Patcher& patcher_02 = document_02.root<model::Patcher>();
+        
+        document_02.pull();
+        
+        model::Patcher::View* view_02 = nullptr;
+        
+        for(auto& user : patcher_02.getUsers())
+        {
+            if(user.getId() == 11)
+            {
+                view_02 = &(*user.getViews().begin());
+            }
+        }
+        
+        REQUIRE(view_02 != nullptr);
+        
+        CHECK(view_02->isSelected(*patcher_02.getObjects().begin()));
+        
+        server.port_factory_remove (port_01);
+        server.port_factory_remove (port_02);
+    }
+}
+
+// ==================================================================================== //
+//                                PATCHER VIEW - BENCHMARK                              //
+// ==================================================================================== //
+
+TEST_CASE("Model Patcher View - Benchmark", "[PatcherView]")
+{
+    const size_t count = 10000;
+    
+    flip::Document document(model::DataModel::use(), 123456789, 'appl', 'gui ');
+    
+    model::Patcher& patcher = document.root<model::Patcher>();
+    model::Patcher::View& view = patcher.useSelfUser().addView();
+    
+    std::vector<model::Object*> objects;
+    
+    for(size_t i = 0; i < count; ++i)
+    {
+        objects.push_back(&patcher.addObject(model::Factory::create(tool::AtomHelper::parse("+"))));
+    }
+    
+    document.commit();
+    
+    Benchmark bench;
+    
+    bench.startTestCase("Patcher View - " + std::to_string(count) + " objects");
+    
+    bench.startUnit("select one by one");
+    
+    for(model::Object* object : objects)
+    {
+        view.selectObject(*object);
+    }
+    
+    bench.endUnit();
+    
+    bench.startUnit("query");
+    
+    size_t selected = 0;
+    
+    for(model::Object* object : objects)
+    {
+        selected += view.isSelected(*object);
+    }
+    
+    bench.endUnit();
+    
+    bench.startUnit("unselect all");
+    
+    view.unselectAll();
+    
+    bench.endUnit();
+    
+    bench.startUnit("select all");
+    
+    view.selectAll();
+    
+    bench.endUnit();
+    
+    bench.endTestCase();
+    
+    CHECK(selected == count);
+    CHECK(view.isSelected(*objects.back()));
+    
+    document.commit();
+}
@@ -24,6 +24,8 @@
 // ==================================================================================== //
 
 #include <iostream>
+#include <thread>
+#include <atomic>
 
 #include "../catch.hpp"
 
@@ -33,6 +35,344 @@ namespace beast = boost::beast;
 
 #include <KiwiNetwork/KiwiNetwork_Http.h>
 
+// ================================================================================ //
+//                                    STUB SERVER                                   //
+// ================================================================================ //
+
+//! @brief A local server that answers the requests with their target.
+//! @details The target "/slow" is answered after 200 ms, the connection is closed
+//! after answering the target "/close".
+class StubServer
+{
+public:
+    
+    using tcp = boost::asio::ip::tcp;
+    
+    StubServer()
+    : m_io_context()
+    , m_acceptor(m_io_context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0))
+    , m_port(std::to_string(m_acceptor.local_endpoint().port()))
+    , m_connections(0)
+    , m_pipelined(0)
+    {
+        accept();
+        
+        m_thread = std::thread([this]()
+        {
+            m_io_context.run();
+        });
+    }
+    
+    ~StubServer()
+    {
+        m_io_context.stop();
+        m_thread.join();
+    }
+    
+    std::string const& getPort() const
+    {
+        return m_port;
+    }
+    
+    //! @brief Returns the number of connections accepted.
+    size_t getNumberOfConnections() const
+    {
+        return m_connections.load();
+    }
+    
+    //! @brief Returns the number of requests received before the response of the previous one was sent.
+    size_t getNumberOfPipelinedRequests() const
+    {
+        return m_pipelined.load();
+    }
+    
+private:
+    
+    class Session : public std::enable_shared_from_this<Session>
+    {
+    public:
+        
+        Session(StubServer& server, tcp::socket socket)
+        : m_server(server)
+        , m_socket(std::move(socket))
+        , m_timer(server.m_io_context)
+        {
+        }
+        
+        void read()
+        {
+            auto self = shared_from_this();
+            
+            m_request = {};
+            
+            beast::http::async_read(m_socket, m_buffer, m_request, [self](beast::error_code ec, std::size_t)
+            {
+                if (ec)
+                {
+                    return;
+                }
+                
+                if (self->m_request.target() == "/slow")
+                {
+                    self->m_timer.expires_after(std::chrono::milliseconds(200));
+                    self->m_timer.async_wait([self](beast::error_code)
+                    {
+                        self->write();
+                    });
+                }
+                else
+                {
+                    self->write();
+                }
+            });
+        }
+        
+        void write()
+        {
+            auto self = shared_from_this();
+            
+            beast::error_code ec;
+            
+            if (m_buffer.size() > 0 || m_socket.available(ec) > 0)
+            {
+                ++m_server.m_pipelined;
+            }
+            
+            m_response = {};
+            m_response.version(11);
+            m_response.result(beast::http::status::ok);
+            m_response.keep_alive(m_request.keep_alive() && m_request.target() != "/close");
+            m_response.body() = m_request.target().to_string();
+            m_response.prepare_payload();
+            
+            beast::http::async_write(m_socket, m_response, [self](beast::error_code ec, std::size_t)
+            {
+                if (ec)
+                {
+                    return;
+                }
+                
+                if (!self->m_response.keep_alive())
+                {
+                    self->m_socket.shutdown(tcp::socket::shutdown_send, ec);
+                    return;
+                }
+                
+                self->read();
+            });
+        }
+        
+    private:
+        
+        StubServer&                                     m_server;
+        tcp::socket                                     m_socket;
+        boost::asio::steady_timer                       m_timer;
+        beast::flat_buffer                              m_buffer;
+        beast::http::request<beast::http::string_body>  m_request;
+        beast::http::response<beast::http::string_body> m_response;
+    };
+    
+    void accept()
+    {
+        m_acceptor.async_accept([this](beast::error_code ec, tcp::socket socket)
+        {
+            if (!ec)
+            {
+                ++m_connections;
+                std::make_shared<Session>(*this, std::move(socket))->read();
+            }
+            
+            accept();
+        });
+    }
+    
+    boost::asio::io_context m_io_context;
+    tcp::acceptor           m_acceptor;
+    std::string             m_port;
+    std::atomic<size_t>     m_connections;
+    std::atomic<size_t>     m_pipelined;
+    std::thread             m_thread;
+};
+
+// ================================================================================ //
+//                                      CLIENT                                      //
+// ================================================================================ //
+
+TEST_CASE("Network - Http Client", "[Network, Http]")
+{
+    using namespace kiwi::network;
+    
+    using Query = http::Query<beast::http::string_body, beast::http::string_body>;
+    using Response = http::Response<beast::http::string_body>;
+    
+    StubServer server;
+    
+    auto makeRequest = [](std::string const& target)
+    {
+        auto request = std::make_unique<http::Request<beast::http::string_body>>();
+        request->method(beast::http::verb::get);
+        request->target(target);
+        request->version(11);
+        request->set(beast::http::field::host, "127.0.0.1");
+        return request;
+    };
+    
+    SECTION("Queries reuse the connection of their host")
+    {
+        http::Client client(2, 4, 1);
+        
+        for (int i = 0; i < 10; ++i)
+        {
+            const std::string target = "/" + std::to_string(i);
+            
+            Query query(makeRequest(target), server.getPort(), client);
+            
+            Response response = query.writeQuery();
+            
+            REQUIRE(!response.error);
+            CHECK(response.result() == beast::http::status::ok);
+            CHECK(response.body() == target);
+        }
+        
+        CHECK(client.getNumberOfConnections() == 1);
+        CHECK(server.getNumberOfConnections() == 1);
+    }
+    
+    SECTION("Queries are pipelined on a kept alive connection")
+    {
+        http::Client client(2, 1, 8);
+        
+        Query first(makeRequest("/first"), server.getPort(), client);
+        REQUIRE(!first.writeQuery().error);
+        
+        const size_t count = 16;
+        
+        std::vector<std::unique_ptr<Query>> queries;
+        std::vector<std::string> bodies(count);
+        
+        for (size_t i = 0; i < count; ++i)
+        {
+            const std::string target = (i == 0) ? "/slow" : "/" + std::to_string(i);
+            
+            queries.emplace_back(new Query(makeRequest(target), server.getPort(), client));
+            
+            queries.back()->writeQueryAsync([&bodies, i](Response const& response)
+            {
+                bodies[i] = response.error ? "error" : response.body();
+            });
+        }
+        
+        for (auto& query : queries)
+        {
+            CHECK(!query->writeQuery().error);
+        }
+        
+        CHECK(bodies[0] == "/slow");
+        
+        for (size_t i = 1; i < count; ++i)
+        {
+            CHECK(bodies[i] == "/" + std::to_string(i));
+        }
+        
+        CHECK(client.getNumberOfConnections() == 1);
+        CHECK(server.getNumberOfConnections() == 1);
+        CHECK(server.getNumberOfPipelinedRequests() > 0);
+    }
+    
+    SECTION("Connections closed by the server are opened again")
+    {
+        http::Client client(2, 1, 8);
+        
+        Query closing(makeRequest("/close"), server.getPort(), client);
+        Query next(makeRequest("/next"), server.getPort(), client);
+        
+        Response closing_response = closing.writeQuery();
+        Response next_response = next.writeQuery();
+        
+        REQUIRE(!closing_response.error);
+        REQUIRE(!next_response.error);
+        CHECK(next_response.body() == "/next");
+        CHECK(server.getNumberOfConnections() == 2);
+    }
+    
+    SECTION("Cancelling a sent query completes it immediately")
+    {
+        http::Client client(2, 1, 8);
+        
+        std::atomic<int> callbacks(0);
+        
+        Query slow(makeRequest("/slow"), server.getPort(), client);
+        
+        slow.writeQueryAsync([&callbacks](Response const& response)
+        {
+            CHECK(response.error == boost::asio::error::basic_errors::timed_out);
+            ++callbacks;
+        });
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        
+        slow.cancel();
+        
+        CHECK(slow.executed());
+        CHECK(callbacks == 1);
+        
+        Query next(makeRequest("/next"), server.getPort(), client);
+        
+        Response response = next.writeQuery();
+        
+        REQUIRE(!response.error);
+        CHECK(response.body() == "/next");
+        CHECK(callbacks == 1);
+    }
+    
+    SECTION("Reaching the timeout of a query")
+    {
+        http::Client client(2, 1, 8);
+        
+        Query slow(makeRequest("/slow"), server.getPort(), client);
+        
+        Response response = slow.writeQuery(http::Timeout(50));
+        
+        CHECK(response.error == boost::asio::error::basic_errors::timed_out);
+    }
+    
+    SECTION("Destroying the client aborts the pending queries")
+    {
+        std::unique_ptr<http::Client> client(new http::Client(2, 1, 8));
+        
+        Query slow(makeRequest("/slow"), server.getPort(), *client);
+        
+        slow.writeQueryAsync([](Response const& response)
+        {
+            CHECK(response.error == boost::asio::error::operation_aborted);
+        });
+        
+        client.reset();
+        
+        CHECK(slow.executed());
+    }
+    
+    SECTION("Sessions share the client of the process")
+    {
+        const size_t connections = http::Client::use().getNumberOfConnections();
+        
+        for (int i = 0; i < 4; ++i)
+        {
+            http::Session session;
+            session.setHost("127.0.0.1");
+            session.setPort(server.getPort());
+            session.setTarget("/get");
+            
+            http::Session::Response response = session.Get();
+            
+            REQUIRE(!response.error);
+            CHECK(response.body() == "/get");
+        }
+        
+        CHECK(http::Client::use().getNumberOfConnections() == connections + 1);
+    }
+}
+
 TEST_CASE("Network - Http Query", "[Network, Http]")
 {
     using namespace kiwi::network;
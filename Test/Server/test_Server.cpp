@@ -20,16 +20,27 @@
  */
 
 #include "../catch.hpp"
+#include "../KiwiBenchmark.h"
 
+#include <algorithm>
+#include <functional>
 #include <thread>
+#include <random>
+#include <set>
+#include <utility>
 
 #include <json.hpp>
 
 #include <KiwiServer/KiwiServer_Server.h>
 #include <KiwiModel/KiwiModel_DataModel.h>
 #include <KiwiModel/KiwiModel_Def.h>
+#include <KiwiModel/KiwiModel_Factory.h>
+#include <KiwiModel/KiwiModel_PatcherValidator.h>
 
 #include <flip/Document.h>
+#include <flip/DocumentServer.h>
+#include <flip/PortDirect.h>
+#include <flip/CarrierDirect.h>
 #include <flip/contrib/transport_tcp/CarrierTransportSocketTcp.h>
 
 using namespace kiwi;
@@ -263,3 +274,277 @@ TEST_CASE("Server - Server", "[Server, Server]")
         }
     }
 }
+
+// ==================================================================================== //
+//                                  SERVER - VALIDATION                                 //
+// ==================================================================================== //
+
+//! @brief The validation done before links were checked in a single pass,
+//! all the links are scanned for each removed object.
+class ScanPatcherValidator : public flip::DocumentValidator<model::Patcher>
+{
+public:
+    
+    void validate(model::Patcher& patcher) override
+    {
+        if(patcher.changed() && patcher.objectsChanged())
+        {
+            for(model::Object const& object : patcher.getObjects())
+            {
+                if(object.removed())
+                {
+                    for(model::Link const& link : patcher.getLinks())
+                    {
+                        if((link.getSenderObject().ref() == object.ref()
+                            || link.getReceiverObject().ref() == object.ref())
+                           && !link.removed())
+                        {
+                            flip_VALIDATION_FAILED ("Removing object without removing its links");
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+//! @brief A validator that accepts every transaction, so that the server validates alone.
+class AcceptPatcherValidator : public flip::DocumentValidator<model::Patcher>
+{
+public:
+    
+    void validate(model::Patcher&) override
+    {
+    }
+};
+
+using objects_and_links_t = std::pair<size_t, size_t>;
+
+//! @brief Pushes the deletion of objects to a server, keeping the links given by the filter.
+//! @return The number of objects and links left on the server.
+static objects_and_links_t removeObjectsKeepingLinks(std::vector<size_t> const& removed,
+                                                     std::function<bool(size_t, size_t)> keep_link)
+{
+    model::PatcherValidator validator;
+    AcceptPatcherValidator accept_validator;
+    
+    flip::DocumentServer server (model::DataModel::use(), validator, 123456789ULL);
+    
+    model::Patcher& server_patcher = server.root<model::Patcher>();
+    
+    // four objects chained by three links: 0 -> 1 -> 2 -> 3.
+    
+    std::vector<model::Object*> server_objects;
+    
+    for(size_t i = 0; i < 4; ++i)
+    {
+        server_objects.push_back(&server_patcher.addObject(model::Factory::create(tool::AtomHelper::parse("+"))));
+    }
+    
+    for(size_t i = 0; i < 3; ++i)
+    {
+        server_patcher.addLink(*server_objects[i], 0, *server_objects[i + 1], 0);
+    }
+    
+    server.commit();
+    
+    std::vector<flip::Ref> refs;
+    
+    for(auto* object : server_objects)
+    {
+        refs.push_back(object->ref());
+    }
+    
+    flip::PortDirect port;
+    server.port_factory_add (port);
+    
+    flip::Document document (model::DataModel::use(), accept_validator, 11, 23, 24);
+    flip::CarrierDirect carrier (document, port);
+    
+    document.pull();
+    
+    model::Patcher& patcher = document.root<model::Patcher>();
+    
+    auto index = [&refs](flip::Ref const& ref)
+    {
+        return static_cast<size_t>(std::find(refs.begin(), refs.end(), ref) - refs.begin());
+    };
+    
+    auto& patcher_objects = patcher.getObjects();
+    
+    for(auto object_it = patcher_objects.begin(); object_it != patcher_objects.end();)
+    {
+        if(std::count(removed.begin(), removed.end(), index(object_it->ref())) != 0)
+        {
+            object_it = patcher_objects.erase(object_it);
+        }
+        else
+        {
+            ++object_it;
+        }
+    }
+    
+    auto& patcher_links = patcher.getLinks();
+    
+    for(auto link_it = patcher_links.begin(); link_it != patcher_links.end();)
+    {
+        const size_t sender = index(link_it->getSenderObject().ref());
+        const size_t receiver = index(link_it->getReceiverObject().ref());
+        
+        if((std::count(removed.begin(), removed.end(), sender) != 0
+            || std::count(removed.begin(), removed.end(), receiver) != 0)
+           && !keep_link(sender, receiver))
+        {
+            link_it = patcher_links.erase(link_it);
+        }
+        else
+        {
+            ++link_it;
+        }
+    }
+    
+    document.commit();
+    document.push();
+    
+    const size_t objects_left = server_patcher.getObjects().count_if([](model::Object &){return true;});
+    const size_t links_left = server_patcher.getLinks().count_if([](model::Link &){return true;});
+    
+    server.port_factory_remove (port);
+    
+    return {objects_left, links_left};
+}
+
+TEST_CASE("Server - Validation", "[Server, Server]")
+{
+    auto keep_none = [](size_t, size_t) { return false; };
+    
+    SECTION("Removing objects with their links is accepted")
+    {
+        CHECK((removeObjectsKeepingLinks({1, 2}, keep_none) == objects_and_links_t(2, 0)));
+    }
+    
+    SECTION("Removing objects while keeping a link to one of them fails")
+    {
+        // the link 2 -> 3 leads to an object that isn't removed.
+        auto keep = [](size_t sender, size_t receiver) { return sender == 2 && receiver == 3; };
+        
+        CHECK((removeObjectsKeepingLinks({1, 2}, keep) == objects_and_links_t(4, 3)));
+    }
+    
+    SECTION("Removing objects while keeping a link between them fails")
+    {
+        auto keep = [](size_t sender, size_t receiver) { return sender == 1 && receiver == 2; };
+        
+        CHECK((removeObjectsKeepingLinks({1, 2}, keep) == objects_and_links_t(4, 3)));
+    }
+}
+
+//! @brief Pushes the deletion of objects and of their links to a server.
+//! @return The number of objects left on the server.
+static size_t removeObjects(Benchmark& bench, std::string const& name,
+                            flip::DocumentValidatorBase& validator,
+                            size_t objects, size_t links, size_t removed)
+{
+    flip::DocumentServer server (model::DataModel::use(), validator, 123456789ULL);
+    
+    model::Patcher& server_patcher = server.root<model::Patcher>();
+    
+    std::vector<model::Object*> server_objects;
+    
+    for(size_t i = 0; i < objects; ++i)
+    {
+        server_objects.push_back(&server_patcher.addObject(model::Factory::create(tool::AtomHelper::parse("+"))));
+    }
+    
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<size_t> object_distribution(0, objects - 1);
+    
+    for(size_t i = 0; i < links; ++i)
+    {
+        server_patcher.addLink(*server_objects[object_distribution(random)], 0,
+                               *server_objects[object_distribution(random)], i % 2);
+    }
+    
+    server.commit();
+    
+    flip::PortDirect port;
+    server.port_factory_add (port);
+    
+    flip::Document document (model::DataModel::use(), validator, 11, 23, 24);
+    flip::CarrierDirect carrier (document, port);
+    
+    document.pull();
+    
+    // the links are removed in one pass so that only the validation is measured.
+    
+    model::Patcher& patcher = document.root<model::Patcher>();
+    
+    std::set<flip::Ref> removed_objects;
+    
+    auto& patcher_objects = patcher.getObjects();
+    
+    for(auto object_it = patcher_objects.begin(); object_it != patcher_objects.end();)
+    {
+        if(removed_objects.size() < removed)
+        {
+            removed_objects.insert(object_it->ref());
+            object_it = patcher_objects.erase(object_it);
+        }
+        else
+        {
+            ++object_it;
+        }
+    }
+    
+    auto& patcher_links = patcher.getLinks();
+    
+    for(auto link_it = patcher_links.begin(); link_it != patcher_links.end();)
+    {
+        if(removed_objects.count(link_it->getSenderObject().ref()) != 0
+           || removed_objects.count(link_it->getReceiverObject().ref()) != 0)
+        {
+            link_it = patcher_links.erase(link_it);
+        }
+        else
+        {
+            ++link_it;
+        }
+    }
+    
+    document.commit();
+    
+    bench.startUnit(name);
+    
+    document.push();
+    
+    bench.endUnit();
+    
+    const size_t objects_left = server_patcher.getObjects().count_if([](model::Object &){return true;});
+    
+    server.port_factory_remove (port);
+    
+    return objects_left;
+}
+
+TEST_CASE("Server - Validation Benchmark", "[Server, Server]")
+{
+    const size_t objects = 5000;
+    const size_t links = 10000;
+    const size_t removed = 2000;
+    
+    Benchmark bench;
+    
+    bench.startTestCase("Validation - removing " + std::to_string(removed) + " objects ("
+                        + std::to_string(objects) + " objects, " + std::to_string(links) + " links)");
+    
+    ScanPatcherValidator scan_validator;
+    model::PatcherValidator validator;
+    
+    CHECK(removeObjects(bench, "scan per removed object", scan_validator, objects, links, removed)
+          == objects - removed);
+    
+    CHECK(removeObjects(bench, "PatcherValidator", validator, objects, links, removed)
+          == objects - removed);
+    
+    bench.endTestCase();
+}
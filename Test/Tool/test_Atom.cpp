@@ -20,8 +20,13 @@
  */
 
 #include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <unordered_set>
 
 #include "../catch.hpp"
+#include "../KiwiBenchmark.h"
 
 #include <KiwiTool/KiwiTool_Atom.h>
 
@@ -800,3 +805,136 @@ TEST_CASE("Atom Parse Dollar", "[Atom]")
         CHECK(atoms[1].isDollar());
     }
 }
+
+// ================================================================================ //
+//                                      SYMBOL                                      //
+// ================================================================================ //
+
+TEST_CASE("Symbol", "[Atom]")
+{
+    SECTION("Symbols with the same name are equal")
+    {
+        const std::string name = "kiwi";
+        
+        CHECK(Symbol("kiwi") == Symbol(name));
+        CHECK(Symbol("kiwi") != Symbol("kiwis"));
+        CHECK(&Symbol("kiwi").getName() == &Symbol(std::string(name)).getName());
+        CHECK(Symbol("kiwi").getName() == "kiwi");
+        
+        CHECK(Symbol() == Symbol(""));
+        CHECK(Symbol().getName().empty());
+    }
+    
+    SECTION("Pre-interned symbols")
+    {
+        CHECK(Symbol::bang() == Symbol("bang"));
+        CHECK(Symbol::set() == Symbol("set"));
+        CHECK(Symbol::clear() == Symbol("clear"));
+        CHECK(Symbol::stop() == Symbol("stop"));
+        CHECK(Symbol::print() == Symbol("print"));
+    }
+    
+    SECTION("Hash")
+    {
+        std::unordered_set<Symbol> symbols {Symbol("a"), Symbol("b"), Symbol("a")};
+        
+        CHECK(symbols.size() == 2);
+        CHECK(symbols.count(Symbol("b")) == 1);
+    }
+    
+    SECTION("String atoms share the symbol")
+    {
+        Atom atom("foo");
+        Atom copy(atom);
+        Atom other;
+        other = copy;
+        
+        CHECK(&atom.getString() == &copy.getString());
+        CHECK(&atom.getString() == &other.getString());
+        CHECK(atom.getSymbol() == Symbol("foo"));
+        CHECK(Atom(Symbol("foo")).getString() == "foo");
+        CHECK(Atom(42).getSymbol() == Symbol());
+        
+        CHECK(Atom(Symbol::bang()).isBang());
+        CHECK(Atom(std::string("bang")).isBang());
+        CHECK(!Atom("bangs").isBang());
+        CHECK(!Atom(1).isBang());
+    }
+}
+
+// ================================================================================ //
+//                                  ATOM - BENCHMARK                                //
+// ================================================================================ //
+
+//! @brief A string atom that owns a copy of its string as the atoms used to.
+class StringAtom
+{
+public:
+    
+    StringAtom(char const* name) : m_string(new std::string(name)) {}
+    StringAtom(StringAtom const& other) : m_string(new std::string(*other.m_string)) {}
+    bool isBang() const { return *m_string == "bang"; }
+    
+private:
+    
+    std::unique_ptr<std::string> m_string;
+};
+
+//! @brief Sends messages to several receivers that copy them.
+template<class Message, class Create>
+static size_t fanOut(Create create, size_t messages, size_t receivers)
+{
+    size_t bangs = 0;
+    
+    for(size_t i = 0; i < messages; ++i)
+    {
+        const std::vector<Message> message = create();
+        
+        for(size_t j = 0; j < receivers; ++j)
+        {
+            const std::vector<Message> received(message);
+            bangs += received[0].isBang() ? 1 : 0;
+        }
+    }
+    
+    return bangs;
+}
+
+TEST_CASE("Atom - Benchmark", "[Atom]")
+{
+    const size_t messages = 100000;
+    const size_t receivers = 8;
+    
+    Benchmark bench;
+    
+    bench.startTestCase("Atom - bang fan-out ("
+                        + std::to_string(messages) + " messages to "
+                        + std::to_string(receivers) + " receivers)");
+    
+    bench.startUnit("owned strings");
+    
+    const size_t owned = fanOut<StringAtom>([]() { return std::vector<StringAtom>{"bang"}; },
+                                            messages, receivers);
+    
+    bench.endUnit();
+    
+    bench.startUnit("interned strings");
+    
+    const size_t interned = fanOut<Atom>([]() { return std::vector<Atom>{"bang"}; },
+                                         messages, receivers);
+    
+    bench.endUnit();
+    
+    bench.startUnit("pre-interned symbol");
+    
+    const size_t pre_interned = fanOut<Atom>([]() { return std::vector<Atom>{Symbol::bang()}; },
+                                             messages, receivers);
+    
+    bench.endUnit();
+    
+    bench.endTestCase();
+    
+    CHECK(owned == messages * receivers);
+    CHECK(interned == messages * receivers);
+    CHECK(pre_interned == messages * receivers);
+}
@@ -0,0 +1,353 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <thread>
+
+#include "../catch.hpp"
+#include "../KiwiBenchmark.h"
+
+#include <KiwiTool/KiwiTool_AtomList.h>
+
+#include "Allocations.h"
+
+using namespace kiwi::tool;
+
+// ================================================================================ //
+//                                     ATOM LIST                                    //
+// ================================================================================ //
+
+TEST_CASE("AtomList", "[AtomList]")
+{
+    SECTION("Short lists are stored inline")
+    {
+        AtomList list {1, 2.5, "foo"};
+        
+        CHECK(list.size() == 3);
+        CHECK(list.isInline());
+        CHECK(list.capacity() == AtomList::inline_capacity);
+        
+        CHECK(list[0].getInt() == 1);
+        CHECK(list[1].getFloat() == 2.5);
+        CHECK(list.back().getString() == "foo");
+        
+        AtomList empty;
+        CHECK(empty.empty());
+        CHECK(empty.begin() == empty.end());
+    }
+    
+    SECTION("Long lists grow")
+    {
+        AtomList list;
+        
+        for(int i = 0; i < 100; ++i)
+        {
+            list.push_back(i);
+        }
+        
+        CHECK(list.size() == 100);
+        CHECK(!list.isInline());
+        CHECK(list.capacity() >= 100);
+        
+        for(int i = 0; i < 100; ++i)
+        {
+            CHECK(list[i].getInt() == i);
+        }
+        
+        // the atom appended may be an atom of the list.
+        AtomList full {0, 1, 2, 3, 4, 5, 6, 7};
+        full.push_back(full[3]);
+        CHECK(full.size() == 9);
+        CHECK(full.back().getInt() == 3);
+    }
+    
+    SECTION("Ranges and vectors")
+    {
+        const std::vector<Atom> atoms {"a", "b", "c", "d"};
+        
+        AtomList from_vector(atoms);
+        AtomList from_range(atoms.begin() + 1, atoms.end());
+        
+        CHECK(from_vector.size() == 4);
+        CHECK(from_range.size() == 3);
+        CHECK(from_range.front().getString() == "b");
+        
+        CHECK(from_vector.toVector().size() == 4);
+        CHECK(from_vector.toVector()[3].getString() == "d");
+    }
+    
+    SECTION("Copy and move")
+    {
+        for(size_t size : {3ul, 20ul})
+        {
+            AtomList list;
+            
+            for(size_t i = 0; i < size; ++i)
+            {
+                list.emplace_back(static_cast<int>(i));
+            }
+            
+            AtomList copy(list);
+            CHECK(copy.size() == size);
+            CHECK(copy.back().getInt() == static_cast<int>(size - 1));
+            
+            AtomList assigned {"x"};
+            assigned = list;
+            CHECK(assigned.size() == size);
+            
+            Atom const* data = list.data();
+            AtomList moved(std::move(list));
+            
+            CHECK(moved.size() == size);
+            CHECK(list.empty());
+            CHECK((moved.data() == data) == (size > AtomList::inline_capacity));
+            
+            AtomList move_assigned;
+            move_assigned = std::move(moved);
+            CHECK(move_assigned.size() == size);
+            CHECK(move_assigned[1].getInt() == 1);
+            CHECK(moved.empty());
+        }
+    }
+    
+    SECTION("Resize and clear")
+    {
+        AtomList list {1, 2, 3};
+        
+        list.resize(12);
+        CHECK(list.size() == 12);
+        CHECK(list[2].getInt() == 3);
+        CHECK(list[11].isNull());
+        
+        list.resize(2);
+        CHECK(list.size() == 2);
+        
+        list.pop_back();
+        CHECK(list.size() == 1);
+        
+        list.clear();
+        CHECK(list.empty());
+    }
+    
+    SECTION("Long lists freed by other threads")
+    {
+        std::vector<AtomList> lists(64);
+        
+        for(AtomList& list : lists)
+        {
+            list.resize(40);
+        }
+        
+        std::thread thread([&lists]()
+        {
+            lists.clear();
+            
+            AtomList list;
+            list.resize(40);
+        });
+        
+        thread.join();
+        
+        CHECK(lists.empty());
+    }
+}
+
+// ================================================================================ //
+//                                ATOM LIST - BENCHMARK                             //
+// ================================================================================ //
+
+//! @brief A minimal object that forwards the messages it receives as engine objects do.
+template<class List>
+class Node
+{
+public:
+    
+    virtual ~Node() = default;
+    
+    virtual void receive(size_t index, List const& args) = 0;
+    
+    void connect(size_t outlet, Node& receiver)
+    {
+        m_outlets[outlet] = &receiver;
+    }
+    
+protected:
+    
+    void send(size_t outlet, List const& args)
+    {
+        if(m_outlets[outlet] != nullptr)
+        {
+            m_outlets[outlet]->receive(0, args);
+        }
+    }
+    
+private:
+    
+    Node* m_outlets[2] {nullptr, nullptr};
+};
+
+//! @brief [trigger b l]
+template<class List>
+class TriggerNode : public Node<List>
+{
+public:
+    
+    void receive(size_t, List const& args) override
+    {
+        this->send(1, List(args));
+        this->send(0, List{Symbol::bang()});
+    }
+};
+
+//! @brief [route foo]
+template<class List>
+class RouteNode : public Node<List>
+{
+public:
+    
+    void receive(size_t, List const& args) override
+    {
+        if(!args.empty() && args[0].getSymbol() == m_selector)
+        {
+            this->send(0, List(args.begin() + 1, args.end()));
+        }
+    }
+    
+private:
+    
+    const Symbol m_selector {"foo"};
+};
+
+//! @brief [pack foo 0 0. s], the selector is kept.
+template<class List>
+class PackNode : public Node<List>
+{
+public:
+    
+    void receive(size_t, List const& args) override
+    {
+        for(size_t i = 0; i < args.size() && i + 1 < m_list.size(); ++i)
+        {
+            m_list[i + 1] = args[i];
+        }
+        
+        this->send(0, m_list);
+    }
+    
+private:
+    
+    List m_list {"foo", 0, 0., "s"};
+};
+
+//! @brief Counts the bangs.
+template<class List>
+class CounterNode : public Node<List>
+{
+public:
+    
+    void receive(size_t, List const& args) override
+    {
+        m_count += args[0].isBang() ? 1 : 0;
+    }
+    
+    size_t m_count = 0;
+};
+
+//! @brief Sends messages through a chain of trigger, route and pack stages.
+//! @return The number of allocations per message.
+template<class List>
+static double runChain(Benchmark& bench, std::string const& name, size_t stages, size_t messages)
+{
+    std::vector<std::unique_ptr<Node<List>>> nodes;
+    CounterNode<List> counter;
+    
+    Node<List>* previous = nullptr;
+    Node<List>* first = nullptr;
+    
+    for(size_t i = 0; i < stages; ++i)
+    {
+        nodes.emplace_back(new TriggerNode<List>());
+        Node<List>* trigger = nodes.back().get();
+        nodes.emplace_back(new RouteNode<List>());
+        Node<List>* route = nodes.back().get();
+        nodes.emplace_back(new PackNode<List>());
+        Node<List>* pack = nodes.back().get();
+        
+        trigger->connect(0, counter);
+        trigger->connect(1, *route);
+        route->connect(0, *pack);
+        
+        if(previous != nullptr)
+        {
+            previous->connect(0, *trigger);
+        }
+        else
+        {
+            first = trigger;
+        }
+        
+        previous = pack;
+    }
+    
+    const List message {"foo", 1, 2.5, "bar"};
+    
+    bench.startUnit(name);
+    
+    const size_t allocations = getNumberOfAllocations();
+    
+    for(size_t i = 0; i < messages; ++i)
+    {
+        first->receive(0, message);
+    }
+    
+    const size_t chain_allocations = getNumberOfAllocations() - allocations;
+    
+    bench.endUnit();
+    
+    CHECK(counter.m_count == stages * messages);
+    
+    return static_cast<double>(chain_allocations) / messages;
+}
+
+TEST_CASE("AtomList - Benchmark", "[AtomList]")
+{
+    const size_t stages = 10;
+    const size_t messages = 100000;
+    
+    Benchmark bench;
+    
+    bench.startTestCase("AtomList - " + std::to_string(stages)
+                        + " trigger/route/pack stages ("
+                        + std::to_string(messages) + " messages)");
+    
+    const double vector_allocations = runChain<std::vector<Atom>>(bench, "std::vector<Atom>", stages, messages);
+    const double list_allocations = runChain<AtomList>(bench, "AtomList", stages, messages);
+    
+    bench.endTestCase();
+    
+    std::cout << "allocations per message : std::vector<Atom> " << vector_allocations
+    << ", AtomList " << list_allocations << '\n' << '\n';
+    
+    CHECK(list_allocations == 0.);
+}
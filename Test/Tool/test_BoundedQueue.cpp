@@ -0,0 +1,144 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <KiwiTool/KiwiTool_BoundedQueue.h>
+
+using namespace kiwi;
+
+// ==================================================================================== //
+//                                    BOUNDED QUEUE                                     //
+// ==================================================================================== //
+
+TEST_CASE("BoundedQueue", "[BoundedQueue]")
+{
+    SECTION("Capacity is a power of two")
+    {
+        CHECK(tool::BoundedQueue<int>(1).capacity() == 1);
+        CHECK(tool::BoundedQueue<int>(100).capacity() == 128);
+    }
+    
+    SECTION("Values are popped in order")
+    {
+        tool::BoundedQueue<int> queue(4);
+        
+        int value = 0;
+        CHECK_FALSE(queue.pop(value));
+        
+        for(int turn = 0; turn < 3; ++turn)
+        {
+            for(int i = 0; i < 3; ++i)
+            {
+                CHECK(queue.push(turn * 10 + i));
+            }
+            
+            CHECK(queue.size() == 3);
+            
+            for(int i = 0; i < 3; ++i)
+            {
+                REQUIRE(queue.pop(value));
+                CHECK(value == turn * 10 + i);
+            }
+            
+            CHECK(queue.size() == 0);
+        }
+    }
+    
+    SECTION("A full queue rejects the values")
+    {
+        tool::BoundedQueue<std::string> queue(2);
+        
+        CHECK(queue.push(std::string("a")));
+        CHECK(queue.push(std::string("b")));
+        
+        std::string rejected("c");
+        CHECK_FALSE(queue.push(std::move(rejected)));
+        CHECK(rejected == "c");
+        
+        std::string value;
+        REQUIRE(queue.pop(value));
+        CHECK(value == "a");
+        
+        CHECK(queue.push(std::move(rejected)));
+        
+        REQUIRE(queue.pop(value));
+        CHECK(value == "b");
+        REQUIRE(queue.pop(value));
+        CHECK(value == "c");
+        CHECK_FALSE(queue.pop(value));
+    }
+    
+    SECTION("Concurrent producers and a consumer")
+    {
+        const size_t producers = 4;
+        const size_t count = 50000;
+        
+        tool::BoundedQueue<std::pair<size_t, size_t>> queue(256);
+        
+        std::vector<std::thread> threads;
+        
+        for(size_t producer = 0; producer < producers; ++producer)
+        {
+            threads.emplace_back([&queue, producer, count]()
+            {
+                for(size_t i = 0; i < count;)
+                {
+                    if(queue.push(std::make_pair(producer, i)))
+                    {
+                        ++i;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        
+        std::vector<size_t> expected(producers, 0);
+        std::pair<size_t, size_t> value;
+        size_t received = 0;
+        bool ordered = true;
+        
+        while(received < producers * count)
+        {
+            if(queue.pop(value))
+            {
+                ordered = ordered && value.second == expected[value.first]++;
+                ++received;
+            }
+        }
+        
+        for(auto& thread : threads)
+        {
+            thread.join();
+        }
+        
+        CHECK(ordered);
+        CHECK_FALSE(queue.pop(value));
+    }
+}
@@ -0,0 +1,172 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <random>
+#include <vector>
+
+#include "../catch.hpp"
+#include "../KiwiBenchmark.h"
+
+#include <KiwiTool/KiwiTool_OrderStatistics.h>
+
+using namespace kiwi;
+
+// ==================================================================================== //
+//                                  ORDER STATISTICS                                    //
+// ==================================================================================== //
+
+TEST_CASE("OrderStatistics", "[OrderStatistics]")
+{
+    SECTION("Ranks and positions skip the removed elements")
+    {
+        tool::OrderStatistics stats(6);
+        
+        CHECK(stats.size() == 6);
+        CHECK(stats.count() == 6);
+        
+        CHECK(stats.erase(1));
+        CHECK(stats.erase(4));
+        CHECK_FALSE(stats.erase(4));
+        CHECK_FALSE(stats.erase(6));
+        
+        CHECK(stats.count() == 4);
+        CHECK_FALSE(stats.contains(1));
+        CHECK(stats.contains(2));
+        
+        CHECK(stats.select(0) == 0);
+        CHECK(stats.select(1) == 2);
+        CHECK(stats.select(2) == 3);
+        CHECK(stats.select(3) == 5);
+        
+        CHECK(stats.rank(0) == 0);
+        CHECK(stats.rank(2) == 1);
+        CHECK(stats.rank(5) == 3);
+        CHECK(stats.rank(6) == 4);
+        
+        stats.push_back();
+        CHECK(stats.size() == 7);
+        CHECK(stats.select(4) == 6);
+        
+        stats.clear();
+        CHECK(stats.size() == 0);
+        CHECK(stats.count() == 0);
+    }
+    
+    SECTION("Random appends and removals match a vector")
+    {
+        std::mt19937 random(7);
+        
+        tool::OrderStatistics stats;
+        std::vector<size_t> present;
+        size_t size = 0;
+        bool valid = true;
+        
+        for(size_t step = 0; step < 5000; ++step)
+        {
+            if(present.empty() || random() % 3 != 0)
+            {
+                stats.push_back();
+                present.push_back(size++);
+            }
+            else
+            {
+                const size_t rank = random() % present.size();
+                valid = valid && stats.erase(stats.select(rank));
+                present.erase(present.begin() + rank);
+            }
+            
+            if(step % 50 == 0)
+            {
+                for(size_t rank = 0; rank < present.size(); ++rank)
+                {
+                    valid = valid && stats.select(rank) == present[rank];
+                    valid = valid && stats.rank(present[rank]) == rank;
+                }
+            }
+        }
+        
+        CHECK(valid);
+        CHECK(stats.count() == present.size());
+        CHECK(stats.size() == size);
+    }
+}
+
+// ==================================================================================== //
+//                             ORDER STATISTICS - BENCHMARK                             //
+// ==================================================================================== //
+
+TEST_CASE("OrderStatistics - Benchmark", "[OrderStatistics]")
+{
+    const size_t size = 1000000;
+    const size_t removals = 2000;
+    
+    std::mt19937 random(11);
+    std::vector<size_t> ranks(removals);
+    
+    for(size_t i = 0; i < removals; ++i)
+    {
+        ranks[i] = random() % (size - i);
+    }
+    
+    Benchmark bench;
+    
+    bench.startTestCase("OrderStatistics - remove " + std::to_string(removals)
+                        + " rows of " + std::to_string(size));
+    
+    std::vector<size_t> rows(size);
+    
+    for(size_t i = 0; i < size; ++i)
+    {
+        rows[i] = i;
+    }
+    
+    bench.startUnit("std::vector erase");
+    
+    for(size_t rank : ranks)
+    {
+        rows.erase(rows.begin() + rank);
+    }
+    
+    bench.endUnit();
+    
+    tool::OrderStatistics stats(size);
+    
+    bench.startUnit("OrderStatistics erase");
+    
+    for(size_t rank : ranks)
+    {
+        stats.erase(stats.select(rank));
+    }
+    
+    bench.endUnit();
+    
+    bench.endTestCase();
+    
+    bool same = stats.count() == rows.size();
+    
+    for(size_t rank = 0; same && rank < rows.size(); rank += 997)
+    {
+        same = stats.select(rank) == rows[rank];
+    }
+    
+    CHECK(same);
+}
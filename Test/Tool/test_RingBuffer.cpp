@@ -0,0 +1,133 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+#include <thread>
+#include <vector>
+
+#include "../catch.hpp"
+
+#include <KiwiTool/KiwiTool_RingBuffer.h>
+
+using namespace kiwi;
+
+// ==================================================================================== //
+//                                     RING BUFFER                                      //
+// ==================================================================================== //
+
+TEST_CASE("RingBuffer", "[RingBuffer]")
+{
+    SECTION("Capacity is a power of two")
+    {
+        CHECK(tool::RingBuffer<float>(1).capacity() == 1);
+        CHECK(tool::RingBuffer<float>(5).capacity() == 8);
+        CHECK(tool::RingBuffer<float>(1024).capacity() == 1024);
+    }
+    
+    SECTION("Write and read across the end")
+    {
+        tool::RingBuffer<int> buffer(8);
+        
+        const std::vector<int> block_1 {1, 2, 3, 4, 5, 6};
+        const std::vector<int> block_2 {7, 8, 9, 10};
+        std::vector<int> result(8, 0);
+        
+        CHECK(buffer.write(block_1.data(), block_1.size()));
+        CHECK(buffer.size() == 6);
+        
+        CHECK(buffer.read(result.data(), 4) == 4);
+        CHECK(std::vector<int>(result.begin(), result.begin() + 4) == std::vector<int>({1, 2, 3, 4}));
+        
+        CHECK(buffer.write(block_2.data(), block_2.size()));
+        CHECK(buffer.size() == 6);
+        
+        CHECK(buffer.read(result.data(), 8) == 6);
+        CHECK(std::vector<int>(result.begin(), result.begin() + 6) == std::vector<int>({5, 6, 7, 8, 9, 10}));
+        
+        CHECK(buffer.size() == 0);
+        CHECK(buffer.read(result.data(), 8) == 0);
+    }
+    
+    SECTION("A block that doesn't fit isn't written")
+    {
+        tool::RingBuffer<int> buffer(4);
+        
+        const std::vector<int> block {1, 2, 3};
+        std::vector<int> result(4, 0);
+        
+        CHECK(buffer.write(block.data(), block.size()));
+        CHECK(!buffer.write(block.data(), block.size()));
+        CHECK(buffer.size() == 3);
+        
+        CHECK(buffer.read(result.data(), 4) == 3);
+        CHECK(buffer.write(block.data(), block.size()));
+    }
+    
+    SECTION("Concurrent writer and reader")
+    {
+        tool::RingBuffer<size_t> buffer(64);
+        
+        const size_t count = 7 * 20000;
+        const size_t block_size = 7;
+        
+        std::thread writer([&buffer, count, block_size]()
+        {
+            std::vector<size_t> block(block_size);
+            size_t value = 0;
+            
+            while(value < count)
+            {
+                for(size_t i = 0; i < block_size; ++i)
+                {
+                    block[i] = value + i;
+                }
+                
+                if(buffer.write(block.data(), block_size))
+                {
+                    value += block_size;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        
+        std::vector<size_t> block(16);
+        size_t expected = 0;
+        bool ordered = true;
+        
+        while(expected < count)
+        {
+            const size_t read = buffer.read(block.data(), block.size());
+            
+            for(size_t i = 0; i < read; ++i)
+            {
+                ordered = ordered && block[i] == expected++;
+            }
+        }
+        
+        writer.join();
+        
+        CHECK(ordered);
+        CHECK(expected == count);
+    }
+}
@@ -25,10 +25,17 @@
 #include <iostream>
 #include <thread>
 #include <memory>
+#include <random>
+#include <string>
+#include <algorithm>
 
 #include "../catch.hpp"
+#include "../KiwiBenchmark.h"
 
 #include <KiwiTool/KiwiTool_Scheduler.h>
+#include <KiwiTool/KiwiTool_AtomList.h>
+
+#include "Allocations.h"
 
 using namespace kiwi;
 ;
@@ -160,6 +167,54 @@ TEST_CASE("Scheduler - mono thread", "[Scheduler]")
         
         CHECK(i_reschedule == 1);
     }
+    
+    SECTION("Pooled tasks")
+    {
+        int counter = 0;
+        
+        auto first = sch.makeTask<CallBack>([&counter]() { ++counter; });
+        CallBack const* address = first.get();
+        
+        sch.schedule(std::move(first));
+        sch.process();
+        
+        CHECK(counter == 1);
+        
+        // the block of the executed task is reused by the next task of the same type.
+        
+        auto second = sch.makeTask<CallBack>([&counter]() { ++counter; });
+        CHECK(second.get() == address);
+        
+        const size_t allocations = getNumberOfAllocations();
+        
+        second.reset();
+        
+        for(int i = 0; i < 10; ++i)
+        {
+            sch.schedule(sch.makeTask<CallBack>([&counter]() { ++counter; }));
+            sch.process();
+        }
+        
+        const size_t steady_allocations = getNumberOfAllocations() - allocations;
+        
+        CHECK(steady_allocations == 0);
+        CHECK(counter == 11);
+    }
+    
+    SECTION("Pooled tasks can outlive the scheduler")
+    {
+        int counter = 0;
+        
+        std::shared_ptr<CallBack> task;
+        
+        {
+            Scheduler scheduler;
+            task = scheduler.makeTask<CallBack>([&counter]() { ++counter; });
+        }
+        
+        CHECK(task.use_count() == 1);
+        task.reset();
+    }
 }
 
 
@@ -171,6 +226,40 @@ TEST_CASE("Scheduler - Multithread", "[Scheduler]")
 {
     Scheduler sch;
     
+    SECTION("Pooled tasks made and released concurrently")
+    {
+        std::atomic<size_t> counter(0);
+        
+        auto produce = [&sch, &counter]()
+        {
+            for(int i = 0; i < 10000; ++i)
+            {
+                auto task = sch.makeTask<CallBack>([&counter]() { ++counter; });
+                ++counter;
+            }
+        };
+        
+        std::thread producer_1(produce);
+        std::thread producer_2(produce);
+        std::thread producer_3(produce);
+        
+        producer_1.join();
+        producer_2.join();
+        producer_3.join();
+        
+        CHECK(counter.load() == 30000);
+        
+        // the released blocks are in the free list and reused.
+        
+        const size_t allocations = getNumberOfAllocations();
+        
+        auto task = sch.makeTask<CallBack>([&counter]() { ++counter; });
+        
+        const size_t task_allocations = getNumberOfAllocations() - allocations;
+        
+        CHECK(task_allocations == 0);
+    }
+    
     SECTION("multiproducer - multiconsumer")
     {
         std::atomic<size_t> count_producer_1(0);
@@ -450,6 +539,144 @@ TEST_CASE("Scheduler - Defering tasks", "[Scheduler]")
     }
 }
 
+// ==================================================================================== //
+//                                 SCHEDULER - WAITING                                  //
+// ==================================================================================== //
+
+TEST_CASE("Scheduler - Waiting", "[Scheduler]")
+{
+    Scheduler sch;
+    
+    SECTION("Waits until the next event")
+    {
+        bool executed = false;
+        
+        const auto start = Scheduler::clock_t::now();
+        
+        sch.schedule([&executed]() { executed = true; }, std::chrono::milliseconds(50));
+        
+        while(!executed)
+        {
+            sch.waitAndProcess(std::chrono::seconds(10));
+        }
+        
+        const auto elapsed = Scheduler::clock_t::now() - start;
+        
+        CHECK(elapsed >= std::chrono::milliseconds(50));
+        CHECK(elapsed < std::chrono::seconds(1));
+    }
+    
+    SECTION("Wakes up when a task is scheduled")
+    {
+        std::atomic<bool> executed(false);
+        
+        std::thread consumer([&sch, &executed]() {
+            
+            sch.setThreadAsConsumer();
+            
+            while(!executed.load())
+            {
+                sch.waitAndProcess(std::chrono::seconds(10));
+            }
+        });
+        
+        while(sch.isThisConsumerThread()){}
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        
+        const auto start = Scheduler::clock_t::now();
+        
+        sch.schedule([&executed]() { executed.store(true); });
+        
+        consumer.join();
+        
+        CHECK(Scheduler::clock_t::now() - start < std::chrono::seconds(1));
+    }
+    
+    SECTION("Wakes up when asked")
+    {
+        std::atomic<bool> quit(false);
+        
+        std::thread consumer([&sch, &quit]() {
+            
+            sch.setThreadAsConsumer();
+            
+            while(!quit.load())
+            {
+                sch.waitAndProcess(std::chrono::seconds(10));
+            }
+        });
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        
+        const auto start = Scheduler::clock_t::now();
+        
+        quit.store(true);
+        sch.wakeUp();
+        
+        consumer.join();
+        
+        CHECK(Scheduler::clock_t::now() - start < std::chrono::seconds(1));
+    }
+    
+    SECTION("Wake ups preceding the wait don't accumulate")
+    {
+        sch.setThreadAsConsumer();
+        
+        for(int i = 0; i < 100; ++i)
+        {
+            sch.wakeUp();
+        }
+        
+        const auto start = Scheduler::clock_t::now();
+        
+        sch.waitAndProcess(std::chrono::milliseconds(20));
+        
+        CHECK(Scheduler::clock_t::now() - start >= std::chrono::milliseconds(20));
+    }
+    
+    SECTION("Periodic task lateness")
+    {
+        const auto period = std::chrono::milliseconds(5);
+        
+        size_t count = 0;
+        Scheduler::duration_t lateness(0);
+        Scheduler::time_point_t expected_time = Scheduler::clock_t::now() + period;
+        
+        std::shared_ptr<CallBack> task;
+        
+        task = std::make_shared<CallBack>([&sch, &task, &count, &lateness, &expected_time, period]() {
+            
+            const auto now = Scheduler::clock_t::now();
+            
+            lateness += now - expected_time;
+            ++count;
+            
+            expected_time = now + period;
+            sch.schedule(task, period);
+        });
+        
+        sch.schedule(task, period);
+        
+        while(count < 50)
+        {
+            sch.waitAndProcess(std::chrono::seconds(1));
+        }
+        
+        sch.unschedule(task);
+        sch.process();
+        
+        const auto mean_lateness = lateness / count;
+        
+        std::cout << "Scheduler - mean lateness of a periodic task : "
+        << std::chrono::duration_cast<std::chrono::microseconds>(mean_lateness).count() << " us\n";
+        
+        CHECK(mean_lateness < std::chrono::milliseconds(1));
+        
+        task.reset();
+    }
+}
+
 // ==================================================================================== //
 //                              SCHEDULER - CUSTOM CLOCK                                //
 // ==================================================================================== //
@@ -511,4 +738,504 @@ TEST_CASE("Scheduler - custom clock", "[Scheduler]")
         CHECK(order[1] == 3);
         CHECK(order[2] == 0);
     }
+    
+    SECTION("Events know the time they were scheduled at")
+    {
+        TickClock::start();
+        
+        const TickClock::time_point start = TickClock::now();
+        
+        TickScheduler scheduler;
+        
+        std::vector<TickClock::time_point> times;
+        
+        scheduler.schedule([&scheduler, &times]()
+        {
+            times.push_back(scheduler.getEventTime());
+        }, std::chrono::milliseconds(2));
+        
+        scheduler.schedule([&scheduler, &times]()
+        {
+            times.push_back(scheduler.getEventTime());
+        }, std::chrono::milliseconds(3));
+        
+        // the consumer is late, both events are processed at once.
+        
+        for(int i = 0; i < 5; ++i)
+        {
+            TickClock::tick();
+        }
+        
+        scheduler.process();
+        
+        REQUIRE(times.size() == 2);
+        CHECK(times[0] == start + std::chrono::milliseconds(2));
+        CHECK(times[1] == start + std::chrono::milliseconds(3));
+        CHECK(scheduler.getEventTime() == start + std::chrono::milliseconds(5));
+    }
+}
+
+// ==================================================================================== //
+//                                  SCHEDULER - TIMER                                   //
+// ==================================================================================== //
+
+//! @brief A timer that records the time of its callbacks.
+template<class Clock>
+class RecordingTimer final : public tool::Scheduler<Clock>::Timer
+{
+public: // methods
+    
+    RecordingTimer(tool::Scheduler<Clock>& scheduler, std::function<void(size_t)> on_call = nullptr):
+    tool::Scheduler<Clock>::Timer(scheduler),
+    m_times(),
+    m_on_call(on_call)
+    {
+    }
+    
+    std::vector<typename Clock::time_point> m_times;
+    
+private: // methods
+    
+    void timerCallBack() override
+    {
+        m_times.push_back(Clock::now());
+        
+        if(m_on_call)
+        {
+            m_on_call(m_times.size());
+        }
+    }
+    
+private: // members
+    
+    std::function<void(size_t)> m_on_call;
+};
+
+TEST_CASE("Scheduler - Timer", "[Scheduler]")
+{
+    using TickScheduler = tool::Scheduler<TickClock>;
+    using duration_t = TickScheduler::duration_t;
+    
+    const auto milliseconds = [](double ms)
+    {
+        return std::chrono::duration_cast<duration_t>(std::chrono::duration<double, std::milli>(ms));
+    };
+    
+    SECTION("Deadlines don't drift")
+    {
+        // ten minutes at a fractional period, the clock only advances by one millisecond.
+        
+        const size_t ticks = 600000;
+        const duration_t period = milliseconds(2.5);
+        
+        TickClock::start();
+        const TickClock::time_point start = TickClock::now();
+        
+        TickScheduler scheduler;
+        RecordingTimer<TickClock> timer(scheduler);
+        
+        size_t relative_count = 0;
+        std::shared_ptr<TickScheduler::CallBack> relative;
+        
+        relative = std::make_shared<TickScheduler::CallBack>([&scheduler, &relative, &relative_count, period]()
+        {
+            ++relative_count;
+            scheduler.schedule(relative, period);
+        });
+        
+        timer.startTimer(period);
+        scheduler.schedule(relative, period);
+        
+        for(size_t i = 0; i < ticks; ++i)
+        {
+            TickClock::tick();
+            scheduler.process();
+        }
+        
+        timer.stopTimer();
+        scheduler.unschedule(relative);
+        scheduler.process();
+        relative.reset();
+        
+        REQUIRE(timer.m_times.size() == ticks * 2 / 5);
+        
+        duration_t min_lateness = duration_t::max();
+        duration_t max_lateness = duration_t::min();
+        
+        for(size_t i = 0; i < timer.m_times.size(); ++i)
+        {
+            const duration_t lateness = timer.m_times[i] - (start + period * (i + 1));
+            
+            min_lateness = std::min(min_lateness, lateness);
+            max_lateness = std::max(max_lateness, lateness);
+        }
+        
+        CHECK(min_lateness >= duration_t::zero());
+        CHECK(max_lateness < std::chrono::milliseconds(1));
+        CHECK(timer.m_times.back() == start + std::chrono::milliseconds(ticks));
+        
+        std::cout << "Scheduler - callbacks of a 2.5 ms period in 10 minutes : "
+        << timer.m_times.size() << " with absolute deadlines, "
+        << relative_count << " with relative delays\n";
+    }
+    
+    SECTION("Latency of the callbacks doesn't accumulate")
+    {
+        const duration_t period = milliseconds(2.5);
+        
+        TickClock::start();
+        const TickClock::time_point start = TickClock::now();
+        
+        TickScheduler scheduler;
+        
+        // each callback takes one millisecond.
+        
+        RecordingTimer<TickClock> timer(scheduler, [](size_t) { TickClock::tick(); });
+        
+        timer.startTimer(period);
+        
+        while(timer.m_times.size() < 1000)
+        {
+            TickClock::tick();
+            scheduler.process();
+        }
+        
+        timer.stopTimer();
+        scheduler.process();
+        
+        duration_t min_lateness = duration_t::max();
+        duration_t max_lateness = duration_t::min();
+        
+        for(size_t i = 0; i < timer.m_times.size(); ++i)
+        {
+            const duration_t lateness = timer.m_times[i] - (start + period * (i + 1));
+            
+            min_lateness = std::min(min_lateness, lateness);
+            max_lateness = std::max(max_lateness, lateness);
+        }
+        
+        CHECK(min_lateness >= duration_t::zero());
+        CHECK(max_lateness < period);
+    }
+    
+    SECTION("Missed deadlines are skipped")
+    {
+        const duration_t period = std::chrono::milliseconds(2);
+        
+        TickClock::start();
+        const TickClock::time_point start = TickClock::now();
+        
+        TickScheduler scheduler;
+        
+        // the fifth callback blocks the consumer for nine milliseconds.
+        
+        RecordingTimer<TickClock> timer(scheduler, [](size_t count)
+        {
+            for(size_t i = 0; count == 5 && i < 9; ++i)
+            {
+                TickClock::tick();
+            }
+        });
+        
+        timer.startTimer(period);
+        
+        for(size_t i = 0; i < 100; ++i)
+        {
+            TickClock::tick();
+            scheduler.process();
+        }
+        
+        timer.stopTimer();
+        scheduler.process();
+        
+        REQUIRE(timer.m_times.size() > 5);
+        
+        // no burst after the stall and the callbacks stay on the grid of the period.
+        
+        CHECK(timer.m_times[5] - timer.m_times[4] == std::chrono::milliseconds(10));
+        
+        for(size_t i = 0; i < timer.m_times.size(); ++i)
+        {
+            CHECK((timer.m_times[i] - start) % period == duration_t::zero());
+            
+            if(i > 0)
+            {
+                CHECK(timer.m_times[i] - timer.m_times[i - 1] >= period);
+            }
+        }
+    }
+    
+    SECTION("Timer period can change")
+    {
+        TickClock::start();
+        
+        TickScheduler scheduler;
+        RecordingTimer<TickClock> timer(scheduler);
+        
+        timer.startTimer(std::chrono::milliseconds(10));
+        
+        for(size_t i = 0; i < 10; ++i)
+        {
+            TickClock::tick();
+            scheduler.process();
+        }
+        
+        REQUIRE(timer.m_times.size() == 1);
+        
+        // the deadline following the callback is already scheduled.
+        
+        timer.setTimerPeriod(std::chrono::milliseconds(5));
+        
+        for(size_t i = 0; i < 15; ++i)
+        {
+            TickClock::tick();
+            scheduler.process();
+        }
+        
+        timer.stopTimer();
+        scheduler.process();
+        
+        CHECK(timer.m_times.size() == 3);
+    }
+    
+    SECTION("Jitter with the system clock")
+    {
+        using Clock = Scheduler::clock_t;
+        
+        const Scheduler::duration_t period
+        = std::chrono::duration_cast<Scheduler::duration_t>(std::chrono::duration<double, std::milli>(2.5));
+        
+        Scheduler scheduler;
+        RecordingTimer<Clock> timer(scheduler);
+        
+        const Clock::time_point start = Clock::now();
+        
+        timer.startTimer(period);
+        
+        while(timer.m_times.size() < 400)
+        {
+            scheduler.waitAndProcess(std::chrono::seconds(1));
+        }
+        
+        timer.stopTimer();
+        scheduler.process();
+        
+        // the lateness is measured from the closest deadline before the callback.
+        
+        Scheduler::duration_t total_lateness(0);
+        Scheduler::duration_t max_lateness(0);
+        
+        for(Clock::time_point const& time : timer.m_times)
+        {
+            const Scheduler::duration_t lateness = (time - start) % period;
+            
+            total_lateness += lateness;
+            max_lateness = std::max(max_lateness, lateness);
+        }
+        
+        const auto mean_lateness = total_lateness / timer.m_times.size();
+        
+        std::cout << "Scheduler - timer jitter over " << timer.m_times.size() << " periods of 2.5 ms : mean "
+        << std::chrono::duration_cast<std::chrono::microseconds>(mean_lateness).count() << " us, max "
+        << std::chrono::duration_cast<std::chrono::microseconds>(max_lateness).count() << " us, missed deadlines "
+        << (timer.m_times.back() - start) / period - timer.m_times.size() << "\n";
+        
+        CHECK(mean_lateness < std::chrono::milliseconds(1));
+    }
+}
+
+// ==================================================================================== //
+//                                SCHEDULER - BENCHMARK                                 //
+// ==================================================================================== //
+
+TEST_CASE("Scheduler - Benchmark", "[Scheduler]")
+{
+    using TickScheduler = tool::Scheduler<TickClock>;
+    
+    Benchmark bench;
+    
+    bench.startTestCase("Scheduler - pending tasks");
+    
+    for(size_t count : {1000ul, 10000ul, 100000ul})
+    {
+        TickClock::start();
+        
+        TickScheduler scheduler;
+        
+        std::mt19937 generator(static_cast<unsigned>(count));
+        std::uniform_int_distribution<int> delays(1, 1000);
+        
+        size_t executed = 0;
+        
+        std::vector<std::shared_ptr<TickScheduler::CallBack>> tasks;
+        tasks.reserve(count);
+        
+        for(size_t i = 0; i < count; ++i)
+        {
+            tasks.emplace_back(std::make_shared<TickScheduler::CallBack>([&executed]() { ++executed; }));
+        }
+        
+        const std::string suffix = " (" + std::to_string(count) + " tasks)";
+        
+        bench.startUnit("schedule" + suffix);
+        
+        for(auto const& task : tasks)
+        {
+            scheduler.schedule(task, std::chrono::milliseconds(delays(generator)));
+        }
+        
+        scheduler.process();
+        
+        bench.endUnit();
+        
+        bench.startUnit("reschedule" + suffix);
+        
+        for(auto const& task : tasks)
+        {
+            scheduler.schedule(task, std::chrono::milliseconds(delays(generator)));
+        }
+        
+        scheduler.process();
+        
+        bench.endUnit();
+        
+        bench.startUnit("unschedule half" + suffix);
+        
+        for(size_t i = 0; i < count; i += 2)
+        {
+            scheduler.unschedule(tasks[i]);
+        }
+        
+        scheduler.process();
+        
+        bench.endUnit();
+        
+        CHECK(executed == 0);
+        
+        bench.startUnit("execute" + suffix);
+        
+        while(executed < count / 2)
+        {
+            TickClock::tick();
+            scheduler.process();
+        }
+        
+        bench.endUnit();
+        
+        CHECK(executed == count / 2);
+    }
+    
+    bench.endTestCase();
+}
+
+// ==================================================================================== //
+//                             SCHEDULER - POOLED TASKS BENCHMARK                       //
+// ==================================================================================== //
+
+//! @brief A message delayed by a pipe that holds its atoms.
+class PipeMessage final : public tool::Scheduler<TickClock>::Task
+{
+public: // methods
+    
+    PipeMessage(size_t& received, tool::AtomList const& args):
+    m_received(received),
+    m_args(args)
+    {
+    }
+    
+    void execute() override
+    {
+        m_received += m_args.size();
+    }
+    
+private: // members
+    
+    size_t&         m_received;
+    tool::AtomList  m_args;
+};
+
+//! @brief Streams messages through a pipe at 10 messages per millisecond.
+//! @return The number of allocations per message once the scheduler reached its steady state.
+template<class ScheduleFunction>
+double runPipe(Benchmark& bench, std::string const& name, ScheduleFunction schedule_message)
+{
+    using TickScheduler = tool::Scheduler<TickClock>;
+    
+    const size_t messages_per_tick = 10;
+    const size_t warmup_ticks = 1000;
+    const size_t ticks = 10000;
+    const std::chrono::milliseconds delay(100);
+    
+    TickClock::start();
+    
+    TickScheduler scheduler;
+    
+    const tool::AtomList message {"note", 60, 100, 0.5};
+    
+    size_t received = 0;
+    size_t allocations = 0;
+    
+    bench.startUnit(name);
+    
+    for(size_t tick = 0; tick < warmup_ticks + ticks; ++tick)
+    {
+        if(tick == warmup_ticks)
+        {
+            allocations = getNumberOfAllocations();
+        }
+        
+        for(size_t i = 0; i < messages_per_tick; ++i)
+        {
+            schedule_message(scheduler, received, message, delay);
+        }
+        
+        TickClock::tick();
+        scheduler.process();
+    }
+    
+    allocations = getNumberOfAllocations() - allocations;
+    
+    bench.endUnit();
+    
+    // the messages scheduled during the last delay are still pending.
+    
+    const size_t delivered = warmup_ticks + ticks - delay.count() + 1;
+    
+    CHECK(received == delivered * messages_per_tick * message.size());
+    
+    return static_cast<double>(allocations) / (ticks * messages_per_tick);
+}
+
+TEST_CASE("Scheduler - Pooled tasks benchmark", "[Scheduler]")
+{
+    using TickScheduler = tool::Scheduler<TickClock>;
+    using duration_t = TickScheduler::duration_t;
+    
+    Benchmark bench;
+    
+    bench.startTestCase("Scheduler - pipe of 10k messages per second");
+    
+    const double callback_allocations = runPipe(bench, "std::function callback",
+                                                [](TickScheduler& scheduler, size_t& received,
+                                                   tool::AtomList const& args, duration_t delay)
+    {
+        scheduler.schedule(std::make_shared<TickScheduler::CallBack>([&received, args]()
+        {
+            received += args.size();
+        }), delay);
+    });
+    
+    const double pooled_allocations = runPipe(bench, "pooled task",
+                                              [](TickScheduler& scheduler, size_t& received,
+                                                 tool::AtomList const& args, duration_t delay)
+    {
+        scheduler.schedule(scheduler.makeTask<PipeMessage>(received, args), delay);
+    });
+    
+    bench.endTestCase();
+    
+    std::cout << "allocations per message : std::function callback " << callback_allocations
+    << ", pooled task " << pooled_allocations << '\n' << '\n';
+    
+    CHECK(pooled_allocations == 0.);
 }
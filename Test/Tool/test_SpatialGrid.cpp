@@ -0,0 +1,308 @@
+/*
+ ==============================================================================
+ 
+ This file is part of the KIWI library.
+ - Copyright (c) 2014-2016, Pierre Guillot & Eliott Paris.
+ - Copyright (c) 2016-2019, CICM, ANR MUSICOLL, Eliott Paris, Pierre Guillot, Jean Millot.
+ 
+ Permission is granted to use this software under the terms of the GPL v3
+ (or any later version). Details can be found at: www.gnu.org/licenses
+ 
+ KIWI is distributed in the hope that it will be useful, but WITHOUT ANY
+ WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ 
+ ------------------------------------------------------------------------------
+ 
+ Contact : cicm.mshparisnord@gmail.com
+ 
+ ==============================================================================
+ */
+
+
+
+#include <vector>
+#include <random>
+
+#include "../catch.hpp"
+#include "../KiwiBenchmark.h"
+
+#include <KiwiTool/KiwiTool_SpatialGrid.h>
+
+using namespace kiwi::tool;
+
+using Grid = SpatialGrid<int>;
+
+// ================================================================================ //
+//                                   SPATIAL GRID                                   //
+// ================================================================================ //
+
+//! @brief Finds the items under a point by testing all of them.
+static std::vector<int> findAll(std::vector<Grid::Bounds> const& items, int x, int y)
+{
+    std::vector<int> found;
+    
+    for(size_t i = 0; i < items.size(); ++i)
+    {
+        Grid::Bounds const& bounds = items[i];
+        
+        if(x >= bounds.x && x <= bounds.x + bounds.width
+           && y >= bounds.y && y <= bounds.y + bounds.height)
+        {
+            found.push_back(static_cast<int>(i));
+        }
+    }
+    
+    return found;
+}
+
+//! @brief Finds the items that overlap an area by testing all of them.
+static std::vector<int> findAll(std::vector<Grid::Bounds> const& items, Grid::Bounds const& area)
+{
+    std::vector<int> found;
+    
+    for(size_t i = 0; i < items.size(); ++i)
+    {
+        Grid::Bounds const& bounds = items[i];
+        
+        if(bounds.x <= area.x + area.width && area.x <= bounds.x + bounds.width
+           && bounds.y <= area.y + area.height && area.y <= bounds.y + bounds.height)
+        {
+            found.push_back(static_cast<int>(i));
+        }
+    }
+    
+    return found;
+}
+
+//! @brief Returns the bounds of random items spread over a patcher.
+static std::vector<Grid::Bounds> makeItems(size_t count, int size)
+{
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> position(-size / 4, size);
+    std::uniform_int_distribution<int> width(10, 150);
+    std::uniform_int_distribution<int> height(10, 40);
+    
+    std::vector<Grid::Bounds> items;
+    
+    for(size_t i = 0; i < count; ++i)
+    {
+        items.push_back(Grid::Bounds{position(generator), position(generator), width(generator), height(generator)});
+    }
+    
+    return items;
+}
+
+TEST_CASE("SpatialGrid", "[SpatialGrid]")
+{
+    SECTION("Points and areas")
+    {
+        Grid grid(50);
+        
+        grid.insert(1, {0, 0, 20, 20});
+        grid.insert(2, {10, 10, 100, 20});
+        grid.insert(3, {-80, -30, 40, 40});
+        
+        CHECK(grid.size() == 3);
+        
+        std::vector<int> items;
+        
+        grid.find(15, 15, items);
+        CHECK((items == std::vector<int>{1, 2}));
+        
+        grid.find(105, 25, items);
+        CHECK((items == std::vector<int>{2}));
+        
+        grid.find(-50, -10, items);
+        CHECK((items == std::vector<int>{3}));
+        
+        grid.find(200, 200, items);
+        CHECK(items.empty());
+        
+        grid.find(Grid::Bounds{-100, -100, 200, 105}, items);
+        CHECK((items == std::vector<int>{1, 3}));
+        
+        grid.find(Grid::Bounds{-1000, -1000, 2000, 2000}, items);
+        CHECK((items == std::vector<int>{1, 2, 3}));
+    }
+    
+    SECTION("Bounds changes and removal")
+    {
+        Grid grid(50);
+        
+        grid.insert(1, {0, 0, 20, 20});
+        grid.insert(2, {0, 0, 20, 20});
+        
+        grid.setBounds(1, {300, 300, 20, 20});
+        grid.setBounds(4, {0, 0, 10, 10});
+        
+        CHECK_FALSE(grid.contains(4));
+        
+        std::vector<int> items;
+        
+        grid.find(10, 10, items);
+        CHECK((items == std::vector<int>{2}));
+        
+        grid.find(310, 310, items);
+        CHECK((items == std::vector<int>{1}));
+        
+        grid.remove(1);
+        grid.remove(1);
+        
+        grid.find(310, 310, items);
+        CHECK(items.empty());
+        CHECK(grid.size() == 1);
+        
+        grid.clear();
+        
+        grid.find(10, 10, items);
+        CHECK(items.empty());
+    }
+    
+    SECTION("Items are found from the bottom to the top")
+    {
+        Grid grid(50);
+        
+        grid.insert(1, {0, 0, 20, 20});
+        grid.insert(2, {0, 0, 20, 20});
+        grid.insertBelow(3, {0, 0, 20, 20}, 2);
+        grid.insertBelow(4, {0, 0, 20, 20}, 1);
+        grid.insertBelow(5, {0, 0, 20, 20}, 42);
+        
+        std::vector<int> items;
+        
+        grid.find(10, 10, items);
+        CHECK((items == std::vector<int>{4, 1, 3, 2, 5}));
+        
+        // enough insertions at the same place to renumber the items.
+        for(int i = 0; i < 100; ++i)
+        {
+            grid.insertBelow(100 + i, {0, 0, 20, 20}, 3);
+        }
+        
+        grid.find(Grid::Bounds{5, 5, 1, 1}, items);
+        
+        REQUIRE(items.size() == 105);
+        CHECK(items[1] == 1);
+        CHECK(items[2] == 100);
+        CHECK(items[101] == 199);
+        CHECK(items[102] == 3);
+        CHECK(items[104] == 5);
+    }
+    
+    SECTION("Same items as a linear search")
+    {
+        const int size = 2000;
+        std::vector<Grid::Bounds> items = makeItems(1000, size);
+        
+        Grid grid(64);
+        
+        for(size_t i = 0; i < items.size(); ++i)
+        {
+            grid.insert(static_cast<int>(i), items[i]);
+        }
+        
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int> position(-size / 2, size);
+        std::uniform_int_distribution<int> extent(0, size);
+        
+        size_t errors = 0;
+        std::vector<int> found;
+        
+        for(int i = 0; i < 1000; ++i)
+        {
+            // move an item.
+            const size_t moved = static_cast<size_t>(i) % items.size();
+            items[moved].x = position(generator);
+            items[moved].y = position(generator);
+            grid.setBounds(static_cast<int>(moved), items[moved]);
+            
+            const int x = position(generator);
+            const int y = position(generator);
+            
+            grid.find(x, y, found);
+            errors += (found != findAll(items, x, y));
+            
+            const Grid::Bounds area {x, y, extent(generator) / 4, extent(generator) / 4};
+            
+            grid.find(area, found);
+            errors += (found != findAll(items, area));
+        }
+        
+        CHECK(errors == 0);
+    }
+}
+
+// ================================================================================ //
+//                               SPATIAL GRID - BENCHMARK                           //
+// ================================================================================ //
+
+TEST_CASE("SpatialGrid - Benchmark", "[SpatialGrid]")
+{
+    const size_t count = 10000;
+    const int size = 8000;
+    const int moves = 10000;
+    
+    const std::vector<Grid::Bounds> items = makeItems(count, size);
+    
+    Grid grid(64);
+    
+    for(size_t i = 0; i < items.size(); ++i)
+    {
+        grid.insert(static_cast<int>(i), items[i]);
+    }
+    
+    // the mouse hovers the patcher.
+    std::vector<std::pair<int, int>> points;
+    
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> position(0, size);
+    
+    for(int i = 0; i < moves; ++i)
+    {
+        points.emplace_back(position(generator), position(generator));
+    }
+    
+    Benchmark bench;
+    
+    bench.startTestCase("SpatialGrid - hover " + std::to_string(count) + " items ("
+                        + std::to_string(moves) + " mouse moves)");
+    
+    size_t linear_hits = 0;
+    
+    bench.startUnit("linear search");
+    
+    for(auto const& point : points)
+    {
+        linear_hits += findAll(items, point.first, point.second).size();
+    }
+    
+    bench.endUnit();
+    
+    size_t grid_hits = 0;
+    std::vector<int> found;
+    
+    bench.startUnit("spatial grid");
+    
+    for(auto const& point : points)
+    {
+        grid.find(point.first, point.second, found);
+        grid_hits += found.size();
+    }
+    
+    bench.endUnit();
+    
+    bench.startUnit("spatial grid - 1000 lasso areas");
+    
+    for(int i = 0; i < 1000; ++i)
+    {
+        auto const& point = points[i];
+        grid.find(Grid::Bounds{point.first, point.second, 400, 300}, found);
+    }
+    
+    bench.endUnit();
+    
+    bench.endTestCase();
+    
+    CHECK(linear_hits == grid_hits);
+}